@@ -174,6 +174,13 @@ void setup() {
       F("  sizeof(CompleteZoneProcessor::MatchingEra): "));
   SERIAL_PORT_MONITOR.println(sizeof(CompleteZoneProcessor::MatchingEra));
 
+  // Flat
+  SERIAL_PORT_MONITOR.println(F("Flat:"));
+  SERIAL_PORT_MONITOR.print(F("  sizeof(FlatZoneProcessor): "));
+  SERIAL_PORT_MONITOR.println(sizeof(FlatZoneProcessor));
+  SERIAL_PORT_MONITOR.print(F("  sizeof(FlatZoneProcessor::FlatTransition): "));
+  SERIAL_PORT_MONITOR.println(sizeof(FlatZoneProcessor::FlatTransition));
+
   // ace_time::basic and ace_time::extended classes
 
   SERIAL_PORT_MONITOR.println(F("BENCHMARKS"));
@@ -63,6 +63,23 @@ using ace_common::PrintStr;
   #define ENABLE_COMPLETE_ZONE_PROCESSOR 1
 #endif
 
+// The FlatZoneProcessor needs several kB of RAM, which is more than the AVR
+// microcontrollers have.
+#if defined(ARDUINO_ARCH_AVR)
+  #define ENABLE_FLAT_ZONE_PROCESSOR 0
+#else
+  #define ENABLE_FLAT_ZONE_PROCESSOR 1
+#endif
+
+// The ZoneIdIndex needs about 8 bytes of RAM per registry entry, and must be
+// large enough for the registries in *_registry.cpp.
+#if defined(ARDUINO_ARCH_AVR)
+  #define ENABLE_ZONE_ID_INDEX 0
+#else
+  #define ENABLE_ZONE_ID_INDEX 1
+#endif
+const uint16_t kMaxRegistrySize = 100;
+
 #if defined(ARDUINO_ARCH_AVR)
 const uint32_t COUNT = 1000;
 #elif defined(ARDUINO_ARCH_SAMD)
@@ -170,7 +187,9 @@ static void printMicrosPerIteration(long elapsedMillis) {
   ace_common::printPad3To(SERIAL_PORT_MONITOR, frac, '0');
 }
 
-#if ENABLE_EXTENDED_ZONE_PROCESSOR == 0
+#if ENABLE_EXTENDED_ZONE_PROCESSOR == 0 \
+    || ENABLE_FLAT_ZONE_PROCESSOR == 0 \
+    || ENABLE_ZONE_ID_INDEX == 0
 // Print -1 to indicate that the benchmark was not executed, due to memory.
 static void printNullResult(const __FlashStringHelper* label) {
   SERIAL_PORT_MONITOR.print(label);
@@ -296,6 +315,72 @@ static void runOffsetDateTimeToEpochSeconds() {
       forEpochDaysMillis);
 }
 
+// OffsetDateTime::printTo() into a PrintStr
+static void runOffsetDateTimePrintTo() {
+  unsigned long printToMillis = runLambda([]() {
+    fakeEpochSeconds = millis() & 0xffff;
+    OffsetDateTime odt = OffsetDateTime::forEpochSeconds(
+        fakeEpochSeconds, TimeOffset::forHours(-8));
+    PrintStr<OffsetDateTime::kFormatBufferSize> printStr;
+    odt.printTo(printStr);
+    disableOptimization(printStr.length());
+  });
+  unsigned long forEpochSecondsMillis = runLambda([]() {
+    fakeEpochSeconds = millis() & 0xffff;
+    OffsetDateTime odt = OffsetDateTime::forEpochSeconds(
+        fakeEpochSeconds, TimeOffset::forHours(-8));
+    disableOptimization(odt);
+  });
+
+  printResult(F("OffsetDateTime::printTo(PrintStr)"), printToMillis,
+      forEpochSecondsMillis);
+}
+
+// OffsetDateTime::formatTo() into a char buffer
+static void runOffsetDateTimeFormatTo() {
+  unsigned long formatToMillis = runLambda([]() {
+    fakeEpochSeconds = millis() & 0xffff;
+    OffsetDateTime odt = OffsetDateTime::forEpochSeconds(
+        fakeEpochSeconds, TimeOffset::forHours(-8));
+    char buf[OffsetDateTime::kFormatBufferSize];
+    size_t len = odt.formatTo(buf, sizeof(buf));
+    disableOptimization(len);
+  });
+  unsigned long forEpochSecondsMillis = runLambda([]() {
+    fakeEpochSeconds = millis() & 0xffff;
+    OffsetDateTime odt = OffsetDateTime::forEpochSeconds(
+        fakeEpochSeconds, TimeOffset::forHours(-8));
+    disableOptimization(odt);
+  });
+
+  printResult(F("OffsetDateTime::formatTo()"), formatToMillis,
+      forEpochSecondsMillis);
+}
+
+static const char kDateString[] = "2018-08-31T13:48:01-07:00";
+
+// OffsetDateTime::forDateString()
+static void runOffsetDateTimeForDateString() {
+  unsigned long forDateStringMillis = runLambda([]() {
+    OffsetDateTime odt = OffsetDateTime::forDateString(kDateString);
+    disableOptimization(odt);
+  });
+
+  printResult(F("OffsetDateTime::forDateString()"), forDateStringMillis,
+      emptyLoopMillis);
+}
+
+// IsoDateTimeParser::parse()
+static void runIsoDateTimeParserParse() {
+  unsigned long parseMillis = runLambda([]() {
+    IsoDateTimeParser parser;
+    parser.parse(kDateString, sizeof(kDateString) - 1);
+    disableOptimization(parser.dateTime());
+  });
+
+  printResult(F("IsoDateTimeParser::parse()"), parseMillis, emptyLoopMillis);
+}
+
 // ZonedDateTime::forEpochSeconds(seconds)
 static void runZonedDateTimeForEpochSecondsUTC() {
   unsigned long forEpochSecondsMillis = runLambda([]() {
@@ -373,6 +458,11 @@ static BasicZoneProcessor* basicZoneProcessor;
   static CompleteZoneProcessor* completeZoneProcessor;
 #endif
 
+#if ENABLE_FLAT_ZONE_PROCESSOR == 1
+  // Too big for the stack of some microcontrollers (e.g. ESP32).
+  static FlatZoneProcessor flatZoneProcessor;
+#endif
+
 //-----------------------------------------------------------------------------
 
 // ZonedDateTime::forEpochSeconds(seconds, tz), Basic uncached
@@ -465,6 +555,68 @@ static void runZonedDateTimeForEpochSecondsExtendedCached() {
 #endif
 }
 
+// Number of epochSeconds converted per iteration by the *_x4 benchmarks.
+static const uint8_t kNumBatch = 4;
+
+// ZonedDateTime::forEpochSeconds(seconds, tz) called kNumBatch times on sorted
+// epochSeconds, Extended cached
+static void runZonedDateTimeForEpochSecondsExtendedLoop() {
+#if ENABLE_EXTENDED_ZONE_PROCESSOR == 0
+  printNullResult(F("ZonedDateTime::forEpochSeconds(Extended_x4)"));
+
+#else
+	ExtendedZoneProcessor processor;
+  extendedZoneProcessor = &processor;
+  fakeEpochSeconds = millis() & 0xffff;
+
+  unsigned long forEpochSecondsMillis = runLambda([]() {
+    TimeZone tzLosAngeles = TimeZone::forZoneInfo(
+        &zonedbx::kZoneAmerica_Los_Angeles,
+        extendedZoneProcessor);
+    for (uint8_t i = 0; i < kNumBatch; i++) {
+      ZonedDateTime dateTime = ZonedDateTime::forEpochSeconds(
+          fakeEpochSeconds + i * 3600, tzLosAngeles);
+      disableOptimization(dateTime);
+    }
+  });
+
+  printResult(F("ZonedDateTime::forEpochSeconds(Extended_x4)"),
+      forEpochSecondsMillis, emptyLoopMillis);
+#endif
+}
+
+// ZonedDateTime::forEpochSecondsBatch() on kNumBatch sorted epochSeconds,
+// Extended cached
+static void runZonedDateTimeForEpochSecondsBatchExtended() {
+#if ENABLE_EXTENDED_ZONE_PROCESSOR == 0
+  printNullResult(F("ZonedDateTime::forEpochSecondsBatch(Extended_x4)"));
+
+#else
+	ExtendedZoneProcessor processor;
+  extendedZoneProcessor = &processor;
+  fakeEpochSeconds = millis() & 0xffff;
+
+  unsigned long forEpochSecondsMillis = runLambda([]() {
+    TimeZone tzLosAngeles = TimeZone::forZoneInfo(
+        &zonedbx::kZoneAmerica_Los_Angeles,
+        extendedZoneProcessor);
+    acetime_t epochSeconds[kNumBatch];
+    for (uint8_t i = 0; i < kNumBatch; i++) {
+      epochSeconds[i] = fakeEpochSeconds + i * 3600;
+    }
+    ZonedDateTime dateTimes[kNumBatch];
+    ZonedDateTime::forEpochSecondsBatch(
+        epochSeconds, dateTimes, kNumBatch, tzLosAngeles);
+    for (uint8_t i = 0; i < kNumBatch; i++) {
+      disableOptimization(dateTimes[i]);
+    }
+  });
+
+  printResult(F("ZonedDateTime::forEpochSecondsBatch(Extended_x4)"),
+      forEpochSecondsMillis, emptyLoopMillis);
+#endif
+}
+
 // ZonedDateTime::forEpochSeconds(seconds, tz), Complete uncached
 static void runZonedDateTimeForEpochSecondsCompleteNoCache() {
 #if ENABLE_COMPLETE_ZONE_PROCESSOR == 0
@@ -515,6 +667,52 @@ static void runZonedDateTimeForEpochSecondsCompleteCached() {
 #endif
 }
 
+// ZonedDateTime::forEpochSeconds(seconds, tz), Flat, alternating years
+static void runZonedDateTimeForEpochSecondsFlatNoCache() {
+#if ENABLE_FLAT_ZONE_PROCESSOR == 0
+  printNullResult(F("ZonedDateTime::forEpochSeconds(Flat_nocache)"));
+
+#else
+  offset = 0;
+
+  unsigned long forEpochSecondsMillis = runLambda([]() {
+    offset = (offset) ? 0 : kTwoYears;
+    fakeEpochSeconds = millis() + offset;
+    TimeZone tzLosAngeles = TimeZone::forZoneInfo(
+        &zonedbx::kZoneAmerica_Los_Angeles,
+        &flatZoneProcessor);
+    ZonedDateTime dateTime = ZonedDateTime::forEpochSeconds(
+        fakeEpochSeconds, tzLosAngeles);
+    disableOptimization(dateTime);
+  });
+
+  printResult(F("ZonedDateTime::forEpochSeconds(Flat_nocache)"),
+      forEpochSecondsMillis, emptyLoopMillis);
+#endif
+}
+
+// ZonedDateTime::forEpochSeconds(seconds, tz), Flat, same year
+static void runZonedDateTimeForEpochSecondsFlatCached() {
+#if ENABLE_FLAT_ZONE_PROCESSOR == 0
+  printNullResult(F("ZonedDateTime::forEpochSeconds(Flat_cached)"));
+
+#else
+  fakeEpochSeconds = millis() & 0xffff;
+
+  unsigned long forEpochSecondsMillis = runLambda([]() {
+    TimeZone tzLosAngeles = TimeZone::forZoneInfo(
+        &zonedbx::kZoneAmerica_Los_Angeles,
+        &flatZoneProcessor);
+    ZonedDateTime dateTime = ZonedDateTime::forEpochSeconds(
+        fakeEpochSeconds, tzLosAngeles);
+    disableOptimization(dateTime);
+  });
+
+  printResult(F("ZonedDateTime::forEpochSeconds(Flat_cached)"),
+      forEpochSecondsMillis, emptyLoopMillis);
+#endif
+}
+
 //-----------------------------------------------------------------------------
 
 // ZonedDateTime::forComponents(year, m, d, h, m, s, tz), Basic uncached
@@ -1028,6 +1226,94 @@ void runBasicRegistrarFindIndexForIdLinear() {
       emptyLoopMillis);
 }
 
+static void runBasicRegistrarFindIndexForNameHash() {
+  const __FlashStringHelper* const label =
+      F("BasicZoneRegistrar::findIndexForName(hash)");
+
+#if ENABLE_ZONE_ID_INDEX == 0
+  printNullResult(label);
+
+#else
+  static basic::ZoneIdIndex<kMaxRegistrySize> zoneIdIndex(
+      kBasicRegistrySize, kBasicRegistry);
+  basic::ZoneRegistrar registrar(
+      kBasicRegistrySize, kBasicRegistry, &zoneIdIndex);
+  basicZoneRegistrar = &registrar;
+
+  unsigned long runMillis = runLambda([]() {
+    PrintStr<40> printStr;
+    uint16_t randomIndex = random(kBasicRegistrySize);
+    const basic::Info::ZoneInfo* info =
+        basicZoneRegistrar->getZoneInfoForIndex(randomIndex);
+    BasicZone(info).printNameTo(printStr);
+
+    uint16_t index = basicZoneRegistrar->findIndexForName(printStr.cstr());
+    if (index == basic::ZoneRegistrar::kInvalidIndex) {
+      SERIAL_PORT_MONITOR.println(F("Not found"));
+    }
+    disableOptimization(index);
+  });
+
+  unsigned long emptyLoopMillis = runLambda([]() {
+    PrintStr<40> printStr;
+    uint16_t randomIndex = random(kBasicRegistrySize);
+    const basic::Info::ZoneInfo* info =
+        basicZoneRegistrar->getZoneInfoForIndex(randomIndex);
+    BasicZone(info).printNameTo(printStr);
+
+    uint16_t len = printStr.length();
+    const char* s = printStr.cstr();
+    uint32_t tmp = s[0]
+      + ((len > 1) ? ((uint32_t) s[1] << 8) : 0)
+      + ((len > 2) ? ((uint32_t) s[2] << 16) : 0)
+      + ((len > 3) ? ((uint32_t) s[3] << 24) : 0);
+    disableOptimization((uint32_t) tmp);
+  });
+
+  printResult(label, runMillis, emptyLoopMillis);
+#endif
+}
+
+static void runBasicRegistrarFindIndexForIdHash() {
+  const __FlashStringHelper* const label =
+      F("BasicZoneRegistrar::findIndexForIdHash()");
+
+#if ENABLE_ZONE_ID_INDEX == 0
+  printNullResult(label);
+
+#else
+  static basic::ZoneIdIndex<kMaxRegistrySize> zoneIdIndex(
+      kBasicRegistrySize, kBasicRegistry);
+  basic::ZoneRegistrar registrar(
+      kBasicRegistrySize, kBasicRegistry, &zoneIdIndex);
+  basicZoneRegistrar = &registrar;
+
+  unsigned long runMillis = runLambda([]() {
+    uint16_t randomIndex = random(kBasicRegistrySize);
+    const basic::Info::ZoneInfo* info =
+        basicZoneRegistrar->getZoneInfoForIndex(randomIndex);
+    uint32_t zoneId = BasicZone(info).zoneId();
+
+    uint16_t index = basicZoneRegistrar->findIndexForId(zoneId);
+    if (index == basic::ZoneRegistrar::kInvalidIndex) {
+      SERIAL_PORT_MONITOR.println(F("Not found"));
+    }
+    disableOptimization(index);
+  });
+
+  unsigned long emptyLoopMillis = runLambda([]() {
+    uint16_t randomIndex = random(kBasicRegistrySize);
+    const basic::Info::ZoneInfo* info =
+        basicZoneRegistrar->getZoneInfoForIndex(randomIndex);
+    uint32_t zoneId = BasicZone(info).zoneId();
+
+    disableOptimization(zoneId);
+  });
+
+  printResult(label, runMillis, emptyLoopMillis);
+#endif
+}
+
 //-----------------------------------------------------------------------------
 
 #if ENABLE_EXTENDED_ZONE_PROCESSOR == 1
@@ -1151,6 +1437,94 @@ void runExtendedRegistrarFindIndexForIdLinear() {
 #endif
 }
 
+static void runExtendedRegistrarFindIndexForNameHash() {
+  const __FlashStringHelper* const label =
+      F("ExtendedZoneRegistrar::findIndexForName(hash)");
+
+#if ENABLE_EXTENDED_ZONE_PROCESSOR == 0 || ENABLE_ZONE_ID_INDEX == 0
+  printNullResult(label);
+
+#else
+  static extended::ZoneIdIndex<kMaxRegistrySize> zoneIdIndex(
+      kExtendedRegistrySize, kExtendedRegistry);
+  extended::ZoneRegistrar registrar(
+      kExtendedRegistrySize, kExtendedRegistry, &zoneIdIndex);
+  extendedZoneRegistrar = &registrar;
+
+  unsigned long runMillis = runLambda([]() {
+    PrintStr<40> printStr;
+    uint16_t randomIndex = random(kExtendedRegistrySize);
+    const extended::Info::ZoneInfo* info =
+        extendedZoneRegistrar->getZoneInfoForIndex(randomIndex);
+    ExtendedZone(info).printNameTo(printStr);
+
+    uint16_t index = extendedZoneRegistrar->findIndexForName(printStr.cstr());
+    if (index == extended::ZoneRegistrar::kInvalidIndex) {
+      SERIAL_PORT_MONITOR.println(F("Not found"));
+    }
+    disableOptimization(index);
+  });
+
+  unsigned long emptyLoopMillis = runLambda([]() {
+    PrintStr<40> printStr;
+    uint16_t randomIndex = random(kExtendedRegistrySize);
+    const extended::Info::ZoneInfo* info =
+        extendedZoneRegistrar->getZoneInfoForIndex(randomIndex);
+    ExtendedZone(info).printNameTo(printStr);
+
+    uint16_t len = printStr.length();
+    const char* s = printStr.cstr();
+    uint32_t tmp = s[0]
+      + ((len > 1) ? ((uint32_t) s[1] << 8) : 0)
+      + ((len > 2) ? ((uint32_t) s[2] << 16) : 0)
+      + ((len > 3) ? ((uint32_t) s[3] << 24) : 0);
+    disableOptimization((uint32_t) tmp);
+  });
+
+  printResult(label, runMillis, emptyLoopMillis);
+#endif
+}
+
+static void runExtendedRegistrarFindIndexForIdHash() {
+  const __FlashStringHelper* const label =
+      F("ExtendedZoneRegistrar::findIndexForIdHash()");
+
+#if ENABLE_EXTENDED_ZONE_PROCESSOR == 0 || ENABLE_ZONE_ID_INDEX == 0
+  printNullResult(label);
+
+#else
+  static extended::ZoneIdIndex<kMaxRegistrySize> zoneIdIndex(
+      kExtendedRegistrySize, kExtendedRegistry);
+  extended::ZoneRegistrar registrar(
+      kExtendedRegistrySize, kExtendedRegistry, &zoneIdIndex);
+  extendedZoneRegistrar = &registrar;
+
+  unsigned long runMillis = runLambda([]() {
+    uint16_t randomIndex = random(kExtendedRegistrySize);
+    const extended::Info::ZoneInfo* info =
+        extendedZoneRegistrar->getZoneInfoForIndex(randomIndex);
+    uint32_t zoneId = ExtendedZone(info).zoneId();
+
+    uint16_t index = extendedZoneRegistrar->findIndexForId(zoneId);
+    if (index == extended::ZoneRegistrar::kInvalidIndex) {
+      SERIAL_PORT_MONITOR.println(F("Not found"));
+    }
+    disableOptimization(index);
+  });
+
+  unsigned long emptyLoopMillis = runLambda([]() {
+    uint16_t randomIndex = random(kExtendedRegistrySize);
+    const extended::Info::ZoneInfo* info =
+        extendedZoneRegistrar->getZoneInfoForIndex(randomIndex);
+    uint32_t zoneId = ExtendedZone(info).zoneId();
+
+    disableOptimization(zoneId);
+  });
+
+  printResult(label, runMillis, emptyLoopMillis);
+#endif
+}
+
 //-----------------------------------------------------------------------------
 
 #if ENABLE_EXTENDED_ZONE_PROCESSOR == 1
@@ -1274,6 +1648,94 @@ void runCompleteRegistrarFindIndexForIdLinear() {
 #endif
 }
 
+static void runCompleteRegistrarFindIndexForNameHash() {
+  const __FlashStringHelper* const label =
+      F("CompleteZoneRegistrar::findIndexForName(hash)");
+
+#if ENABLE_EXTENDED_ZONE_PROCESSOR == 0 || ENABLE_ZONE_ID_INDEX == 0
+  printNullResult(label);
+
+#else
+  static complete::ZoneIdIndex<kMaxRegistrySize> zoneIdIndex(
+      kCompleteRegistrySize, kCompleteRegistry);
+  complete::ZoneRegistrar registrar(
+      kCompleteRegistrySize, kCompleteRegistry, &zoneIdIndex);
+  completeZoneRegistrar = &registrar;
+
+  unsigned long runMillis = runLambda([]() {
+    PrintStr<40> printStr;
+    uint16_t randomIndex = random(kCompleteRegistrySize);
+    const complete::Info::ZoneInfo* info =
+        completeZoneRegistrar->getZoneInfoForIndex(randomIndex);
+    CompleteZone(info).printNameTo(printStr);
+
+    uint16_t index = completeZoneRegistrar->findIndexForName(printStr.cstr());
+    if (index == complete::ZoneRegistrar::kInvalidIndex) {
+      SERIAL_PORT_MONITOR.println(F("Not found"));
+    }
+    disableOptimization(index);
+  });
+
+  unsigned long emptyLoopMillis = runLambda([]() {
+    PrintStr<40> printStr;
+    uint16_t randomIndex = random(kCompleteRegistrySize);
+    const complete::Info::ZoneInfo* info =
+        completeZoneRegistrar->getZoneInfoForIndex(randomIndex);
+    CompleteZone(info).printNameTo(printStr);
+
+    uint16_t len = printStr.length();
+    const char* s = printStr.cstr();
+    uint32_t tmp = s[0]
+      + ((len > 1) ? ((uint32_t) s[1] << 8) : 0)
+      + ((len > 2) ? ((uint32_t) s[2] << 16) : 0)
+      + ((len > 3) ? ((uint32_t) s[3] << 24) : 0);
+    disableOptimization((uint32_t) tmp);
+  });
+
+  printResult(label, runMillis, emptyLoopMillis);
+#endif
+}
+
+static void runCompleteRegistrarFindIndexForIdHash() {
+  const __FlashStringHelper* const label =
+      F("CompleteZoneRegistrar::findIndexForIdHash()");
+
+#if ENABLE_EXTENDED_ZONE_PROCESSOR == 0 || ENABLE_ZONE_ID_INDEX == 0
+  printNullResult(label);
+
+#else
+  static complete::ZoneIdIndex<kMaxRegistrySize> zoneIdIndex(
+      kCompleteRegistrySize, kCompleteRegistry);
+  complete::ZoneRegistrar registrar(
+      kCompleteRegistrySize, kCompleteRegistry, &zoneIdIndex);
+  completeZoneRegistrar = &registrar;
+
+  unsigned long runMillis = runLambda([]() {
+    uint16_t randomIndex = random(kCompleteRegistrySize);
+    const complete::Info::ZoneInfo* info =
+        completeZoneRegistrar->getZoneInfoForIndex(randomIndex);
+    uint32_t zoneId = CompleteZone(info).zoneId();
+
+    uint16_t index = completeZoneRegistrar->findIndexForId(zoneId);
+    if (index == complete::ZoneRegistrar::kInvalidIndex) {
+      SERIAL_PORT_MONITOR.println(F("Not found"));
+    }
+    disableOptimization(index);
+  });
+
+  unsigned long emptyLoopMillis = runLambda([]() {
+    uint16_t randomIndex = random(kCompleteRegistrySize);
+    const complete::Info::ZoneInfo* info =
+        completeZoneRegistrar->getZoneInfoForIndex(randomIndex);
+    uint32_t zoneId = CompleteZone(info).zoneId();
+
+    disableOptimization(zoneId);
+  });
+
+  printResult(label, runMillis, emptyLoopMillis);
+#endif
+}
+
 //-----------------------------------------------------------------------------
 
 void runBenchmarks() {
@@ -1285,6 +1747,10 @@ void runBenchmarks() {
 
   runOffsetDateTimeForEpochSeconds();
   runOffsetDateTimeToEpochSeconds();
+  runOffsetDateTimePrintTo();
+  runOffsetDateTimeFormatTo();
+  runOffsetDateTimeForDateString();
+  runIsoDateTimeParserParse();
 
   runZonedDateTimeToEpochSeconds();
   runZonedDateTimeToEpochDays();
@@ -1294,8 +1760,12 @@ void runBenchmarks() {
   runZonedDateTimeForEpochSecondsBasicCached();
   runZonedDateTimeForEpochSecondsExtendedNoCache();
   runZonedDateTimeForEpochSecondsExtendedCached();
+  runZonedDateTimeForEpochSecondsExtendedLoop();
+  runZonedDateTimeForEpochSecondsBatchExtended();
   runZonedDateTimeForEpochSecondsCompleteNoCache();
   runZonedDateTimeForEpochSecondsCompleteCached();
+  runZonedDateTimeForEpochSecondsFlatNoCache();
+  runZonedDateTimeForEpochSecondsFlatCached();
 
   runZonedDateTimeForComponentsBasicNoCache();
   runZonedDateTimeForComponentsBasicCached();
@@ -1321,14 +1791,20 @@ void runBenchmarks() {
   runBasicRegistrarFindIndexForName();
   runBasicRegistrarFindIndexForIdBinary();
   runBasicRegistrarFindIndexForIdLinear();
+  runBasicRegistrarFindIndexForNameHash();
+  runBasicRegistrarFindIndexForIdHash();
 
   runExtendedRegistrarFindIndexForName();
   runExtendedRegistrarFindIndexForIdBinary();
   runExtendedRegistrarFindIndexForIdLinear();
+  runExtendedRegistrarFindIndexForNameHash();
+  runExtendedRegistrarFindIndexForIdHash();
 
   runCompleteRegistrarFindIndexForName();
   runCompleteRegistrarFindIndexForIdBinary();
   runCompleteRegistrarFindIndexForIdLinear();
+  runCompleteRegistrarFindIndexForNameHash();
+  runCompleteRegistrarFindIndexForIdHash();
 
   SERIAL_PORT_MONITOR.print(F("Iterations_per_run "));
   SERIAL_PORT_MONITOR.println(COUNT);
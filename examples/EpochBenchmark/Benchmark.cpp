@@ -3,6 +3,7 @@
  *
  * * EpochConverterJulian
  * * EpochConverterHinnant
+ * * EpochConverterHinnant::toEpochDaysBatch(), fromEpochDaysBatch()
  */
 
 #include <Arduino.h>
@@ -155,10 +156,66 @@ void runConverterHinnant(const __FlashStringHelper* label) {
   printMicrosPerIteration(label, elapsedMillis, iterations);
 }
 
+// The batch conversions need about 6kB of RAM for one year of days, too much
+// for the 8-bit AVR processors.
+#if defined(ARDUINO_ARCH_AVR)
+  #define ENABLE_BATCH_CONVERTER 0
+#else
+  #define ENABLE_BATCH_CONVERTER 1
+#endif
+
+#if ENABLE_BATCH_CONVERTER
+
+static int16_t years[366];
+static uint8_t months[366];
+static uint8_t days[366];
+static int32_t epochDays[366];
+static int16_t obsYears[366];
+static uint8_t obsMonths[366];
+static uint8_t obsDays[366];
+
+// Benchmark EpochConverterHinnant::toEpochDaysBatch() and fromEpochDaysBatch()
+// using the same dates as runConverterHinnant(), converting one year at a time.
+void runConverterHinnantBatch(const __FlashStringHelper* label) {
+  uint32_t startMillis = millis();
+
+  uint32_t iterations = 0;
+  for (int16_t year = 2000 - 127; year <= 2000 + 127; year += YEAR_STEP) {
+    uint16_t n = 0;
+    for (uint8_t month = 1; month <= 12; month++) {
+      uint8_t daysInMonth = LocalDate::daysInMonth(year, month);
+      for (uint8_t day = 1; day <= daysInMonth; day++) {
+        years[n] = year;
+        months[n] = month;
+        days[n] = day;
+        n++;
+      }
+    }
+
+    EpochConverterHinnant::toEpochDaysBatch(years, months, days, n, epochDays);
+    EpochConverterHinnant::fromEpochDaysBatch(
+        epochDays, n, obsYears, obsMonths, obsDays);
+
+    for (uint16_t i = 0; i < n; i++) {
+      guard ^= obsYears[i];
+      guard ^= obsMonths[i];
+      guard ^= obsDays[i];
+    }
+    iterations += n;
+  }
+  uint32_t elapsedMillis = millis() - startMillis;
+  printMicrosPerIteration(label, elapsedMillis, iterations);
+}
+
+#endif
+
 //-----------------------------------------------------------------------------
 
 void runBenchmarks() {
   runEmptyLoop(F("EmptyLoop"));
   runConverterJulian(F("EpochConverterJulian"));
   runConverterHinnant(F("EpochConverterHinnant"));
+#if ENABLE_BATCH_CONVERTER
+  runConverterHinnantBatch(F("EpochConverterHinnantBatch"));
+#endif
 }
@@ -3,6 +3,7 @@
  *
  *  * EpochConverterJulian
  *  * EpochConverterHinnant
+ *  * EpochConverterHinnant (batch)
  *
  * This should compile on all microcontrollers supported by the Arduino IDE.
  */
@@ -0,0 +1,1319 @@
+/*
+ * The scenarios of AutoBenchmark, EpochBenchmark and ComparisonBenchmark,
+ * measured with the statistical harness of this program. Each run*() function
+ * corresponds to the function of the same name in AutoBenchmark (which also
+ * gives the registrar benchmarks friend access into the ZoneRegistrar).
+ *
+ * A benchmark calls body(i) in a loop of `iterations` calls per sample, where
+ * `iterations` is calibrated so that a sample takes about sampleNanos. The
+ * index `i` keeps increasing across the samples, and is used to generate the
+ * input of each call, in place of the millis() and random() calls of
+ * AutoBenchmark, so that the inputs are identical from run to run. If a
+ * baseline is given, it is timed over the same inputs right after each
+ * sample, and subtracted from that sample.
+ */
+
+#include <Arduino.h>
+
+#if defined(EPOXY_DUINO)
+
+#include <stdint.h>
+#include <stdio.h> // snprintf()
+#include <stdlib.h> // getenv(), atoi()
+#include <string.h> // strstr()
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <AceCommon.h> // PrintStr
+#include <AceTime.h>
+#include "Stats.h"
+#include "Benchmark.h"
+
+using namespace ace_time;
+using ace_common::PrintStr;
+
+//-----------------------------------------------------------------------------
+// Configuration, overridden by the HOST_BENCHMARK_* environment variables.
+//-----------------------------------------------------------------------------
+
+// Number of samples per benchmark.
+static uint16_t numSamples = 201;
+
+// Target duration of a single sample.
+static uint32_t sampleNanos = 200000;
+
+// Upper limit of the number of threads of the multithreaded benchmarks.
+static uint16_t maxThreads = 8;
+
+// Run only the benchmarks whose name contains this string, if not null.
+static const char* filter = nullptr;
+
+// Index of the CPU (among the CPUs allowed by the affinity mask of the
+// process) that the single-threaded benchmarks are pinned to.
+static uint16_t cpuIndex = 0;
+
+// CPU number after pinning, or -1 if the benchmarks are not pinned.
+static int pinnedCpu = -1;
+
+static PerfCounters perfCounters;
+
+static bool isFirstResult = true;
+
+//-----------------------------------------------------------------------------
+
+// The compiler is extremely good about removing code that does nothing. This
+// volatile variable is used to create side-effects that prevent the compiler
+// from optimizing out the code that's being tested.
+volatile uint8_t guard;
+
+static void disableOptimization(const LocalDate& ld) {
+  guard ^= ld.year();
+  guard ^= ld.month();
+  guard ^= ld.day();
+}
+
+static void disableOptimization(const LocalDateTime& dt) {
+  guard ^= dt.year();
+  guard ^= dt.month();
+  guard ^= dt.day();
+  guard ^= dt.hour();
+  guard ^= dt.minute();
+  guard ^= dt.second();
+}
+
+static void disableOptimization(const OffsetDateTime& dt) {
+  disableOptimization(dt.localDateTime());
+}
+
+static void disableOptimization(const ZonedDateTime& dt) {
+  disableOptimization(dt.localDateTime());
+}
+
+static void disableOptimization(uint32_t value) {
+  guard ^= value & 0xff;
+  guard ^= (value >> 8) & 0xff;
+  guard ^= (value >> 16) & 0xff;
+  guard ^= (value >> 24) & 0xff;
+}
+
+static void disableOptimization(const ZonedExtra& extra) {
+  guard ^= extra.type() & 0xff;
+  guard ^= extra.timeOffset().toMinutes() & 0xff;
+  guard ^= *extra.abbrev();
+}
+
+// Map the loop index to a pseudo-random index in [0, size), replacing the
+// random() of AutoBenchmark.
+static uint16_t scatter(uint32_t i, uint16_t size) {
+  return (uint16_t) ((i * 2654435761u) % size);
+}
+
+//-----------------------------------------------------------------------------
+// Harness
+//-----------------------------------------------------------------------------
+
+static bool isSelected(const char* name) {
+  return filter == nullptr || strstr(name, filter) != nullptr;
+}
+
+// Call body(i) for i in [start, start + iterations), return the elapsed nanos.
+template <typename F>
+static int64_t timeLoop(F& body, uint32_t start, uint32_t iterations) {
+  uint64_t startNanos = nowNanos();
+  for (uint32_t i = start; i != start + iterations; i++) {
+    body(i);
+  }
+  return (int64_t) (nowNanos() - startNanos);
+}
+
+// Return the number of iterations, a power of 2, which take at least
+// sampleNanos. The first call is not timed, because it may perform lazy
+// initialization (e.g. the transition table of FlatZoneProcessor).
+template <typename F>
+static uint32_t calibrate(F& body) {
+  body(0);
+  uint32_t iterations = 1;
+  while (iterations < ((uint32_t) 1 << 24)
+      && timeLoop(body, 0, iterations) < (int64_t) sampleNanos) {
+    iterations *= 2;
+  }
+  return iterations;
+}
+
+static void printDouble(const char* key, double value) {
+  char buf[48];
+  snprintf(buf, sizeof(buf), ", \"%s\": %.3f", key, value);
+  SERIAL_PORT_MONITOR.print(buf);
+}
+
+static void printUint(const char* key, uint32_t value) {
+  char buf[48];
+  snprintf(buf, sizeof(buf), ", \"%s\": %u", key, (unsigned) value);
+  SERIAL_PORT_MONITOR.print(buf);
+}
+
+// Print the JSON object of one benchmark. The counters are optional.
+static void printResult(
+    const char* name,
+    uint16_t numThreads,
+    uint32_t iterations,
+    uint32_t opsPerIteration,
+    const Stats& stats,
+    const uint64_t* counters
+) {
+  SERIAL_PORT_MONITOR.print(isFirstResult ? "\n    " : ",\n    ");
+  isFirstResult = false;
+
+  SERIAL_PORT_MONITOR.print("{\"name\": \"");
+  SERIAL_PORT_MONITOR.print(name);
+  SERIAL_PORT_MONITOR.print('"');
+  printUint("threads", numThreads);
+  printUint("samples", stats.numSamples);
+  printUint("iterations_per_sample", iterations);
+  printUint("ops_per_iteration", opsPerIteration);
+  printDouble("median_ns", stats.median);
+  printDouble("p99_ns", stats.p99);
+  printDouble("mean_ns", stats.mean);
+  printDouble("stddev_ns", stats.stddev);
+  if (counters) {
+    double numOps = (double) stats.numSamples * iterations * opsPerIteration;
+    char key[32];
+    for (uint8_t c = 0; c < PerfCounters::kNumCounters; c++) {
+      if (! perfCounters.isValid(c)) continue;
+      snprintf(key, sizeof(key), "%s_per_op", PerfCounters::kNames[c]);
+      printDouble(key, counters[c] / numOps);
+    }
+  }
+  SERIAL_PORT_MONITOR.print('}');
+}
+
+// Measure body(i), minus baseline(i) if hasBaseline, on the pinned CPU.
+// Each call of body() performs opsPerIteration operations.
+template <typename F, typename B>
+static void measureImpl(
+    const char* name,
+    uint32_t opsPerIteration,
+    F& body,
+    B& baseline,
+    bool hasBaseline
+) {
+  if (! isSelected(name)) return;
+
+  uint32_t iterations = calibrate(body);
+  std::vector<double> samples(numSamples);
+  uint32_t start = 0;
+  timeLoop(body, start, iterations); // warm up
+
+  perfCounters.reset();
+  for (uint16_t s = 0; s < numSamples; s++) {
+    start += iterations;
+    perfCounters.enable();
+    int64_t elapsed = timeLoop(body, start, iterations);
+    perfCounters.disable();
+    if (hasBaseline) {
+      elapsed -= timeLoop(baseline, start, iterations);
+    }
+    samples[s] = (double) elapsed / ((double) iterations * opsPerIteration);
+  }
+  uint64_t counters[PerfCounters::kNumCounters];
+  perfCounters.read(counters);
+
+  Stats stats;
+  calcStats(samples.data(), numSamples, stats);
+  printResult(name, 1, iterations, opsPerIteration, stats,
+      perfCounters.isValid() ? counters : nullptr);
+}
+
+template <typename F>
+static void measure(const char* name, uint32_t opsPerIteration, F body) {
+  measureImpl(name, opsPerIteration, body, body, false);
+}
+
+template <typename F, typename B>
+static void measure(
+    const char* name, uint32_t opsPerIteration, F body, B baseline) {
+  measureImpl(name, opsPerIteration, body, baseline, true);
+}
+
+// Measure body(t, i) concurrently on numThreads threads, each pinned to its
+// own CPU if possible. The samples of all threads are combined into a single
+// Stats. The hardware counters are per-thread, so they are not reported.
+template <typename F>
+static void measureThreads(const char* name, uint16_t numThreads, F body) {
+  if (! isSelected(name)) return;
+
+  auto single = [&body](uint32_t i) { body(0, i); };
+  uint32_t iterations = calibrate(single);
+  std::vector<double> samples((size_t) numThreads * numSamples);
+  std::atomic<uint16_t> numReady(0);
+
+  std::vector<std::thread> threads;
+  for (uint16_t t = 0; t < numThreads; t++) {
+    threads.emplace_back([&, t]() {
+      pinToAllowedCpu(cpuIndex + t);
+      auto threadBody = [&body, t](uint32_t i) { body(t, i); };
+      uint32_t start = t * iterations;
+      timeLoop(threadBody, start, iterations); // warm up
+
+      // Start the samples of all threads at about the same time.
+      numReady++;
+      while (numReady.load() < numThreads) {}
+
+      for (uint16_t s = 0; s < numSamples; s++) {
+        start += numThreads * iterations;
+        int64_t elapsed = timeLoop(threadBody, start, iterations);
+        samples[(size_t) t * numSamples + s] = (double) elapsed / iterations;
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  Stats stats;
+  calcStats(samples.data(), samples.size(), stats);
+  printResult(name, numThreads, iterations, 1, stats, nullptr);
+}
+
+//-----------------------------------------------------------------------------
+// LocalDate, OffsetDateTime, and UTC ZonedDateTime
+//-----------------------------------------------------------------------------
+
+static void runEmptyLoop() {
+  measure("EmptyLoop", 1, [](uint32_t i) {
+    disableOptimization(i);
+  });
+}
+
+static LocalDate localDateAt(uint32_t i) {
+  return LocalDate::forEpochDays(i & 0xffff);
+}
+
+static void runLocalDateForEpochDays() {
+  measure("LocalDate::forEpochDays()", 1, [](uint32_t i) {
+    disableOptimization(localDateAt(i));
+  });
+}
+
+static void runLocalDateToEpochDays() {
+  measure("LocalDate::toEpochDays()", 1,
+    [](uint32_t i) {
+      disableOptimization(localDateAt(i).toEpochDays());
+    },
+    [](uint32_t i) {
+      disableOptimization(localDateAt(i));
+    }
+  );
+}
+
+static void runLocalDateDaysOfWeek() {
+  measure("LocalDate::dayOfWeek()", 1,
+    [](uint32_t i) {
+      LocalDate localDate = localDateAt(i);
+      disableOptimization(localDate);
+      disableOptimization(localDate.dayOfWeek());
+    },
+    [](uint32_t i) {
+      disableOptimization(localDateAt(i));
+    }
+  );
+}
+
+static OffsetDateTime offsetDateTimeAt(uint32_t i) {
+  return OffsetDateTime::forEpochSeconds(i & 0xffff, TimeOffset::forHours(-8));
+}
+
+static void runOffsetDateTimeForEpochSeconds() {
+  measure("OffsetDateTime::forEpochSeconds()", 1, [](uint32_t i) {
+    disableOptimization(offsetDateTimeAt(i));
+  });
+}
+
+static void runOffsetDateTimeToEpochSeconds() {
+  measure("OffsetDateTime::toEpochSeconds()", 1,
+    [](uint32_t i) {
+      disableOptimization(offsetDateTimeAt(i).toEpochSeconds());
+    },
+    [](uint32_t i) {
+      disableOptimization(offsetDateTimeAt(i));
+    }
+  );
+}
+
+static void runOffsetDateTimePrintTo() {
+  measure("OffsetDateTime::printTo(PrintStr)", 1,
+    [](uint32_t i) {
+      PrintStr<OffsetDateTime::kFormatBufferSize> printStr;
+      offsetDateTimeAt(i).printTo(printStr);
+      disableOptimization(printStr.length());
+    },
+    [](uint32_t i) {
+      disableOptimization(offsetDateTimeAt(i));
+    }
+  );
+}
+
+static void runOffsetDateTimeFormatTo() {
+  measure("OffsetDateTime::formatTo()", 1,
+    [](uint32_t i) {
+      char buf[OffsetDateTime::kFormatBufferSize];
+      disableOptimization(offsetDateTimeAt(i).formatTo(buf, sizeof(buf)));
+    },
+    [](uint32_t i) {
+      disableOptimization(offsetDateTimeAt(i));
+    }
+  );
+}
+
+static const char kDateString[] = "2018-08-31T13:48:01-07:00";
+
+static void runOffsetDateTimeForDateString() {
+  measure("OffsetDateTime::forDateString()", 1, [](uint32_t /*i*/) {
+    disableOptimization(OffsetDateTime::forDateString(kDateString));
+  });
+}
+
+static void runIsoDateTimeParserParse() {
+  measure("IsoDateTimeParser::parse()", 1, [](uint32_t /*i*/) {
+    IsoDateTimeParser parser;
+    parser.parse(kDateString, sizeof(kDateString) - 1);
+    disableOptimization(parser.dateTime());
+  });
+}
+
+static ZonedDateTime zonedDateTimeUtcAt(uint32_t i) {
+  return ZonedDateTime::forEpochSeconds(i & 0xffff, TimeZone());
+}
+
+static void runZonedDateTimeForEpochSecondsUTC() {
+  measure("ZonedDateTime::forEpochSeconds(UTC)", 1, [](uint32_t i) {
+    disableOptimization(zonedDateTimeUtcAt(i));
+  });
+}
+
+static void runZonedDateTimeToEpochDays() {
+  measure("ZonedDateTime::toEpochDays()", 1,
+    [](uint32_t i) {
+      disableOptimization(zonedDateTimeUtcAt(i).toEpochDays());
+    },
+    [](uint32_t i) {
+      disableOptimization(zonedDateTimeUtcAt(i));
+    }
+  );
+}
+
+static void runZonedDateTimeToEpochSeconds() {
+  measure("ZonedDateTime::toEpochSeconds()", 1,
+    [](uint32_t i) {
+      disableOptimization(zonedDateTimeUtcAt(i).toEpochSeconds());
+    },
+    [](uint32_t i) {
+      disableOptimization(zonedDateTimeUtcAt(i));
+    }
+  );
+}
+
+//-----------------------------------------------------------------------------
+// ZonedDateTime and ZonedExtra using the various ZoneProcessors
+//-----------------------------------------------------------------------------
+
+static const acetime_t kTwoYears = 2 * 365 * 24 * 3600L;
+
+// Alternate between 2 years on each iteration to defeat the cache of the
+// ZoneProcessor (nocache), or stay within the same year (cached).
+static acetime_t epochSecondsAt(uint32_t i, bool cached) {
+  return (acetime_t) (i & 0xffff) + ((cached || (i & 1) == 0) ? 0 : kTwoYears);
+}
+
+static int16_t yearAt(uint32_t i, bool cached) {
+  return (cached || (i & 1) == 0) ? 2000 : 2002;
+}
+
+template <typename P, typename ZI>
+static void runZonedDateTimeForEpochSeconds(
+    const char* name, const ZI* zoneInfo, bool cached) {
+  P processor;
+  TimeZone tz = TimeZone::forZoneInfo(zoneInfo, &processor);
+  measure(name, 1, [&tz, cached](uint32_t i) {
+    disableOptimization(
+        ZonedDateTime::forEpochSeconds(epochSecondsAt(i, cached), tz));
+  });
+}
+
+template <typename P, typename ZI>
+static void runZonedDateTimeForComponents(
+    const char* name, const ZI* zoneInfo, bool cached) {
+  P processor;
+  TimeZone tz = TimeZone::forZoneInfo(zoneInfo, &processor);
+  measure(name, 1, [&tz, cached](uint32_t i) {
+    disableOptimization(
+        ZonedDateTime::forComponents(yearAt(i, cached), 3, 1, 0, 0, 0, tz));
+  });
+}
+
+template <typename P, typename ZI>
+static void runZonedExtraForEpochSeconds(
+    const char* name, const ZI* zoneInfo, bool cached) {
+  P processor;
+  TimeZone tz = TimeZone::forZoneInfo(zoneInfo, &processor);
+  measure(name, 1, [&tz, cached](uint32_t i) {
+    disableOptimization(
+        ZonedExtra::forEpochSeconds(epochSecondsAt(i, cached), tz));
+  });
+}
+
+template <typename P, typename ZI>
+static void runZonedExtraForComponents(
+    const char* name, const ZI* zoneInfo, bool cached) {
+  P processor;
+  TimeZone tz = TimeZone::forZoneInfo(zoneInfo, &processor);
+  measure(name, 1, [&tz, cached](uint32_t i) {
+    disableOptimization(
+        ZonedExtra::forComponents(yearAt(i, cached), 3, 1, 0, 0, 0, tz));
+  });
+}
+
+static void runZonedDateTimeForEpochSecondsBasicNoCache() {
+  runZonedDateTimeForEpochSeconds<BasicZoneProcessor>(
+      "ZonedDateTime::forEpochSeconds(Basic_nocache)",
+      &zonedb::kZoneAmerica_Los_Angeles, false);
+}
+
+static void runZonedDateTimeForEpochSecondsBasicCached() {
+  runZonedDateTimeForEpochSeconds<BasicZoneProcessor>(
+      "ZonedDateTime::forEpochSeconds(Basic_cached)",
+      &zonedb::kZoneAmerica_Los_Angeles, true);
+}
+
+static void runZonedDateTimeForEpochSecondsBasicMultiYear() {
+  runZonedDateTimeForEpochSeconds<BasicZoneProcessorMultiYear<2>>(
+      "ZonedDateTime::forEpochSeconds(Basic_multiyear)",
+      &zonedb::kZoneAmerica_Los_Angeles, false);
+}
+
+static void runZonedDateTimeForEpochSecondsExtendedNoCache() {
+  runZonedDateTimeForEpochSeconds<ExtendedZoneProcessor>(
+      "ZonedDateTime::forEpochSeconds(Extended_nocache)",
+      &zonedbx::kZoneAmerica_Los_Angeles, false);
+}
+
+static void runZonedDateTimeForEpochSecondsExtendedCached() {
+  runZonedDateTimeForEpochSeconds<ExtendedZoneProcessor>(
+      "ZonedDateTime::forEpochSeconds(Extended_cached)",
+      &zonedbx::kZoneAmerica_Los_Angeles, true);
+}
+
+static void runZonedDateTimeForEpochSecondsCompleteNoCache() {
+  runZonedDateTimeForEpochSeconds<CompleteZoneProcessor>(
+      "ZonedDateTime::forEpochSeconds(Complete_nocache)",
+      &zonedbc::kZoneAmerica_Los_Angeles, false);
+}
+
+static void runZonedDateTimeForEpochSecondsCompleteCached() {
+  runZonedDateTimeForEpochSeconds<CompleteZoneProcessor>(
+      "ZonedDateTime::forEpochSeconds(Complete_cached)",
+      &zonedbc::kZoneAmerica_Los_Angeles, true);
+}
+
+static void runZonedDateTimeForEpochSecondsFlatNoCache() {
+  runZonedDateTimeForEpochSeconds<FlatZoneProcessor>(
+      "ZonedDateTime::forEpochSeconds(Flat_nocache)",
+      &zonedbx::kZoneAmerica_Los_Angeles, false);
+}
+
+static void runZonedDateTimeForEpochSecondsFlatCached() {
+  runZonedDateTimeForEpochSeconds<FlatZoneProcessor>(
+      "ZonedDateTime::forEpochSeconds(Flat_cached)",
+      &zonedbx::kZoneAmerica_Los_Angeles, true);
+}
+
+// ZonedDateTime::forEpochSeconds() called in a loop, and
+// ZonedDateTime::forEpochSecondsBatch(), on NUM sorted epochSeconds one hour
+// apart. The ns/op is per converted epochSeconds.
+template <uint16_t NUM>
+static void runZonedDateTimeForEpochSecondsExtendedLoop(const char* name) {
+  ExtendedZoneProcessor processor;
+  TimeZone tz = TimeZone::forZoneInfo(
+      &zonedbx::kZoneAmerica_Los_Angeles, &processor);
+  measure(name, NUM, [&tz](uint32_t i) {
+    acetime_t start = i & 0xffff;
+    for (uint16_t k = 0; k < NUM; k++) {
+      disableOptimization(ZonedDateTime::forEpochSeconds(start + k * 3600, tz));
+    }
+  });
+}
+
+template <uint16_t NUM>
+static void runZonedDateTimeForEpochSecondsBatchExtended(const char* name) {
+  ExtendedZoneProcessor processor;
+  TimeZone tz = TimeZone::forZoneInfo(
+      &zonedbx::kZoneAmerica_Los_Angeles, &processor);
+  measure(name, NUM, [&tz](uint32_t i) {
+    acetime_t start = i & 0xffff;
+    acetime_t epochSeconds[NUM];
+    for (uint16_t k = 0; k < NUM; k++) {
+      epochSeconds[k] = start + k * 3600;
+    }
+    ZonedDateTime dateTimes[NUM];
+    ZonedDateTime::forEpochSecondsBatch(epochSeconds, dateTimes, NUM, tz);
+    for (uint16_t k = 0; k < NUM; k++) {
+      disableOptimization(dateTimes[k]);
+    }
+  });
+}
+
+static void runZonedDateTimeForComponentsBasicNoCache() {
+  runZonedDateTimeForComponents<BasicZoneProcessor>(
+      "ZonedDateTime::forComponents(Basic_nocache)",
+      &zonedb::kZoneAmerica_Los_Angeles, false);
+}
+
+static void runZonedDateTimeForComponentsBasicCached() {
+  runZonedDateTimeForComponents<BasicZoneProcessor>(
+      "ZonedDateTime::forComponents(Basic_cached)",
+      &zonedb::kZoneAmerica_Los_Angeles, true);
+}
+
+static void runZonedDateTimeForComponentsBasicMultiYear() {
+  runZonedDateTimeForComponents<BasicZoneProcessorMultiYear<2>>(
+      "ZonedDateTime::forComponents(Basic_multiyear)",
+      &zonedb::kZoneAmerica_Los_Angeles, false);
+}
+
+static void runZonedDateTimeForComponentsExtendedNoCache() {
+  runZonedDateTimeForComponents<ExtendedZoneProcessor>(
+      "ZonedDateTime::forComponents(Extended_nocache)",
+      &zonedbx::kZoneAmerica_Los_Angeles, false);
+}
+
+static void runZonedDateTimeForComponentsExtendedCached() {
+  runZonedDateTimeForComponents<ExtendedZoneProcessor>(
+      "ZonedDateTime::forComponents(Extended_cached)",
+      &zonedbx::kZoneAmerica_Los_Angeles, true);
+}
+
+static void runZonedDateTimeForComponentsCompleteNoCache() {
+  runZonedDateTimeForComponents<CompleteZoneProcessor>(
+      "ZonedDateTime::forComponents(Complete_nocache)",
+      &zonedbc::kZoneAmerica_Los_Angeles, false);
+}
+
+static void runZonedDateTimeForComponentsCompleteCached() {
+  runZonedDateTimeForComponents<CompleteZoneProcessor>(
+      "ZonedDateTime::forComponents(Complete_cached)",
+      &zonedbc::kZoneAmerica_Los_Angeles, true);
+}
+
+static void runZonedExtraForEpochSecondsBasicNoCache() {
+  runZonedExtraForEpochSeconds<BasicZoneProcessor>(
+      "ZonedExtra::forEpochSeconds(Basic_nocache)",
+      &zonedb::kZoneAmerica_Los_Angeles, false);
+}
+
+static void runZonedExtraForEpochSecondsBasicCached() {
+  runZonedExtraForEpochSeconds<BasicZoneProcessor>(
+      "ZonedExtra::forEpochSeconds(Basic_cached)",
+      &zonedb::kZoneAmerica_Los_Angeles, true);
+}
+
+static void runZonedExtraForEpochSecondsExtendedNoCache() {
+  runZonedExtraForEpochSeconds<ExtendedZoneProcessor>(
+      "ZonedExtra::forEpochSeconds(Extended_nocache)",
+      &zonedbx::kZoneAmerica_Los_Angeles, false);
+}
+
+static void runZonedExtraForEpochSecondsExtendedCached() {
+  runZonedExtraForEpochSeconds<ExtendedZoneProcessor>(
+      "ZonedExtra::forEpochSeconds(Extended_cached)",
+      &zonedbx::kZoneAmerica_Los_Angeles, true);
+}
+
+static void runZonedExtraForEpochSecondsCompleteNoCache() {
+  runZonedExtraForEpochSeconds<CompleteZoneProcessor>(
+      "ZonedExtra::forEpochSeconds(Complete_nocache)",
+      &zonedbc::kZoneAmerica_Los_Angeles, false);
+}
+
+static void runZonedExtraForEpochSecondsCompleteCached() {
+  runZonedExtraForEpochSeconds<CompleteZoneProcessor>(
+      "ZonedExtra::forEpochSeconds(Complete_cached)",
+      &zonedbc::kZoneAmerica_Los_Angeles, true);
+}
+
+static void runZonedExtraForComponentsBasicNoCache() {
+  runZonedExtraForComponents<BasicZoneProcessor>(
+      "ZonedExtra::forComponents(Basic_nocache)",
+      &zonedb::kZoneAmerica_Los_Angeles, false);
+}
+
+static void runZonedExtraForComponentsBasicCached() {
+  runZonedExtraForComponents<BasicZoneProcessor>(
+      "ZonedExtra::forComponents(Basic_cached)",
+      &zonedb::kZoneAmerica_Los_Angeles, true);
+}
+
+static void runZonedExtraForComponentsExtendedNoCache() {
+  runZonedExtraForComponents<ExtendedZoneProcessor>(
+      "ZonedExtra::forComponents(Extended_nocache)",
+      &zonedbx::kZoneAmerica_Los_Angeles, false);
+}
+
+static void runZonedExtraForComponentsExtendedCached() {
+  runZonedExtraForComponents<ExtendedZoneProcessor>(
+      "ZonedExtra::forComponents(Extended_cached)",
+      &zonedbx::kZoneAmerica_Los_Angeles, true);
+}
+
+static void runZonedExtraForComponentsCompleteNoCache() {
+  runZonedExtraForComponents<CompleteZoneProcessor>(
+      "ZonedExtra::forComponents(Complete_nocache)",
+      &zonedbc::kZoneAmerica_Los_Angeles, false);
+}
+
+static void runZonedExtraForComponentsCompleteCached() {
+  runZonedExtraForComponents<CompleteZoneProcessor>(
+      "ZonedExtra::forComponents(Complete_cached)",
+      &zonedbc::kZoneAmerica_Los_Angeles, true);
+}
+
+//-----------------------------------------------------------------------------
+// ZoneRegistrar, using the full registries of zonedb, zonedbx and zonedbc.
+// The baseline extracts the name or zoneId of the zone being searched.
+//-----------------------------------------------------------------------------
+
+// Large enough for the zone and link registries.
+static const uint16_t kMaxRegistrySize = 1024;
+
+// Copy the name of the zone at registry index i into printStr.
+template <typename D>
+static void printZoneName(const typename D::ZoneInfo* const* registry,
+    uint16_t index, PrintStr<64>& printStr) {
+  const typename D::ZoneRegistryBroker broker(registry);
+  typename D::ZoneInfoBroker(broker.zoneInfo(index)).printNameTo(printStr);
+}
+
+template <typename D>
+static uint32_t zoneIdAt(const typename D::ZoneInfo* const* registry,
+    uint16_t index) {
+  const typename D::ZoneRegistryBroker broker(registry);
+  return typename D::ZoneInfoBroker(broker.zoneInfo(index)).zoneId();
+}
+
+// findIndexForName() using binary search, or the ZoneIdIndex if not null.
+template <typename D>
+static void runRegistrarFindIndexForName(
+    const char* name,
+    uint16_t registrySize,
+    const typename D::ZoneInfo* const* registry,
+    const ZoneIdIndexBase* zoneIdIndex) {
+  ZoneRegistrarTemplate<D> registrar(registrySize, registry, zoneIdIndex);
+  measure(name, 1,
+    [&](uint32_t i) {
+      PrintStr<64> printStr;
+      printZoneName<D>(registry, scatter(i, registrySize), printStr);
+      disableOptimization(registrar.findIndexForName(printStr.cstr()));
+    },
+    [&](uint32_t i) {
+      PrintStr<64> printStr;
+      printZoneName<D>(registry, scatter(i, registrySize), printStr);
+      disableOptimization((uint32_t) printStr.cstr()[0]);
+    }
+  );
+}
+
+// findIndexForId() using the ZoneIdIndex.
+template <typename D>
+static void runRegistrarFindIndexForIdHash(
+    const char* name,
+    uint16_t registrySize,
+    const typename D::ZoneInfo* const* registry,
+    const ZoneIdIndexBase* zoneIdIndex) {
+  ZoneRegistrarTemplate<D> registrar(registrySize, registry, zoneIdIndex);
+  measure(name, 1,
+    [&](uint32_t i) {
+      uint32_t zoneId = zoneIdAt<D>(registry, scatter(i, registrySize));
+      disableOptimization(registrar.findIndexForId(zoneId));
+    },
+    [&](uint32_t i) {
+      disableOptimization(zoneIdAt<D>(registry, scatter(i, registrySize)));
+    }
+  );
+}
+
+// non-static to allow friend access into basic::ZoneRegistrar
+void runBasicRegistrarFindIndexForName() {
+  runRegistrarFindIndexForName<basic::Info>(
+      "BasicZoneRegistrar::findIndexForName(binary)",
+      zonedb::kZoneAndLinkRegistrySize, zonedb::kZoneAndLinkRegistry, nullptr);
+}
+
+// non-static to allow friend access into basic::ZoneRegistrar
+void runBasicRegistrarFindIndexForIdBinary() {
+  basic::ZoneRegistrar registrar(
+      zonedb::kZoneAndLinkRegistrySize, zonedb::kZoneAndLinkRegistry);
+  measure("BasicZoneRegistrar::findIndexForIdBinary()", 1,
+    [&registrar](uint32_t i) {
+      uint32_t zoneId = zoneIdAt<basic::Info>(zonedb::kZoneAndLinkRegistry,
+          scatter(i, zonedb::kZoneAndLinkRegistrySize));
+      disableOptimization(registrar.findIndexForIdBinary(zoneId));
+    },
+    [](uint32_t i) {
+      disableOptimization(zoneIdAt<basic::Info>(zonedb::kZoneAndLinkRegistry,
+          scatter(i, zonedb::kZoneAndLinkRegistrySize)));
+    }
+  );
+}
+
+// non-static to allow friend access into basic::ZoneRegistrar
+void runBasicRegistrarFindIndexForIdLinear() {
+  basic::ZoneRegistrar registrar(
+      zonedb::kZoneAndLinkRegistrySize, zonedb::kZoneAndLinkRegistry);
+  measure("BasicZoneRegistrar::findIndexForIdLinear()", 1,
+    [&registrar](uint32_t i) {
+      uint32_t zoneId = zoneIdAt<basic::Info>(zonedb::kZoneAndLinkRegistry,
+          scatter(i, zonedb::kZoneAndLinkRegistrySize));
+      disableOptimization(registrar.findIndexForIdLinear(zoneId));
+    },
+    [](uint32_t i) {
+      disableOptimization(zoneIdAt<basic::Info>(zonedb::kZoneAndLinkRegistry,
+          scatter(i, zonedb::kZoneAndLinkRegistrySize)));
+    }
+  );
+}
+
+static void runBasicRegistrarFindIndexForNameHash() {
+  static basic::ZoneIdIndex<kMaxRegistrySize> zoneIdIndex(
+      zonedb::kZoneAndLinkRegistrySize, zonedb::kZoneAndLinkRegistry);
+  runRegistrarFindIndexForName<basic::Info>(
+      "BasicZoneRegistrar::findIndexForName(hash)",
+      zonedb::kZoneAndLinkRegistrySize, zonedb::kZoneAndLinkRegistry,
+      &zoneIdIndex);
+}
+
+static void runBasicRegistrarFindIndexForIdHash() {
+  static basic::ZoneIdIndex<kMaxRegistrySize> zoneIdIndex(
+      zonedb::kZoneAndLinkRegistrySize, zonedb::kZoneAndLinkRegistry);
+  runRegistrarFindIndexForIdHash<basic::Info>(
+      "BasicZoneRegistrar::findIndexForIdHash()",
+      zonedb::kZoneAndLinkRegistrySize, zonedb::kZoneAndLinkRegistry,
+      &zoneIdIndex);
+}
+
+// non-static to allow friend access into extended::ZoneRegistrar
+void runExtendedRegistrarFindIndexForName() {
+  runRegistrarFindIndexForName<extended::Info>(
+      "ExtendedZoneRegistrar::findIndexForName(binary)",
+      zonedbx::kZoneAndLinkRegistrySize, zonedbx::kZoneAndLinkRegistry,
+      nullptr);
+}
+
+// non-static to allow friend access into extended::ZoneRegistrar
+void runExtendedRegistrarFindIndexForIdBinary() {
+  extended::ZoneRegistrar registrar(
+      zonedbx::kZoneAndLinkRegistrySize, zonedbx::kZoneAndLinkRegistry);
+  measure("ExtendedZoneRegistrar::findIndexForIdBinary()", 1,
+    [&registrar](uint32_t i) {
+      uint32_t zoneId = zoneIdAt<extended::Info>(
+          zonedbx::kZoneAndLinkRegistry,
+          scatter(i, zonedbx::kZoneAndLinkRegistrySize));
+      disableOptimization(registrar.findIndexForIdBinary(zoneId));
+    },
+    [](uint32_t i) {
+      disableOptimization(zoneIdAt<extended::Info>(
+          zonedbx::kZoneAndLinkRegistry,
+          scatter(i, zonedbx::kZoneAndLinkRegistrySize)));
+    }
+  );
+}
+
+// non-static to allow friend access into extended::ZoneRegistrar
+void runExtendedRegistrarFindIndexForIdLinear() {
+  extended::ZoneRegistrar registrar(
+      zonedbx::kZoneAndLinkRegistrySize, zonedbx::kZoneAndLinkRegistry);
+  measure("ExtendedZoneRegistrar::findIndexForIdLinear()", 1,
+    [&registrar](uint32_t i) {
+      uint32_t zoneId = zoneIdAt<extended::Info>(
+          zonedbx::kZoneAndLinkRegistry,
+          scatter(i, zonedbx::kZoneAndLinkRegistrySize));
+      disableOptimization(registrar.findIndexForIdLinear(zoneId));
+    },
+    [](uint32_t i) {
+      disableOptimization(zoneIdAt<extended::Info>(
+          zonedbx::kZoneAndLinkRegistry,
+          scatter(i, zonedbx::kZoneAndLinkRegistrySize)));
+    }
+  );
+}
+
+static void runExtendedRegistrarFindIndexForNameHash() {
+  static extended::ZoneIdIndex<kMaxRegistrySize> zoneIdIndex(
+      zonedbx::kZoneAndLinkRegistrySize, zonedbx::kZoneAndLinkRegistry);
+  runRegistrarFindIndexForName<extended::Info>(
+      "ExtendedZoneRegistrar::findIndexForName(hash)",
+      zonedbx::kZoneAndLinkRegistrySize, zonedbx::kZoneAndLinkRegistry,
+      &zoneIdIndex);
+}
+
+static void runExtendedRegistrarFindIndexForIdHash() {
+  static extended::ZoneIdIndex<kMaxRegistrySize> zoneIdIndex(
+      zonedbx::kZoneAndLinkRegistrySize, zonedbx::kZoneAndLinkRegistry);
+  runRegistrarFindIndexForIdHash<extended::Info>(
+      "ExtendedZoneRegistrar::findIndexForIdHash()",
+      zonedbx::kZoneAndLinkRegistrySize, zonedbx::kZoneAndLinkRegistry,
+      &zoneIdIndex);
+}
+
+// non-static to allow friend access into complete::ZoneRegistrar
+void runCompleteRegistrarFindIndexForName() {
+  runRegistrarFindIndexForName<complete::Info>(
+      "CompleteZoneRegistrar::findIndexForName(binary)",
+      zonedbc::kZoneAndLinkRegistrySize, zonedbc::kZoneAndLinkRegistry,
+      nullptr);
+}
+
+// non-static to allow friend access into complete::ZoneRegistrar
+void runCompleteRegistrarFindIndexForIdBinary() {
+  complete::ZoneRegistrar registrar(
+      zonedbc::kZoneAndLinkRegistrySize, zonedbc::kZoneAndLinkRegistry);
+  measure("CompleteZoneRegistrar::findIndexForIdBinary()", 1,
+    [&registrar](uint32_t i) {
+      uint32_t zoneId = zoneIdAt<complete::Info>(
+          zonedbc::kZoneAndLinkRegistry,
+          scatter(i, zonedbc::kZoneAndLinkRegistrySize));
+      disableOptimization(registrar.findIndexForIdBinary(zoneId));
+    },
+    [](uint32_t i) {
+      disableOptimization(zoneIdAt<complete::Info>(
+          zonedbc::kZoneAndLinkRegistry,
+          scatter(i, zonedbc::kZoneAndLinkRegistrySize)));
+    }
+  );
+}
+
+// non-static to allow friend access into complete::ZoneRegistrar
+void runCompleteRegistrarFindIndexForIdLinear() {
+  complete::ZoneRegistrar registrar(
+      zonedbc::kZoneAndLinkRegistrySize, zonedbc::kZoneAndLinkRegistry);
+  measure("CompleteZoneRegistrar::findIndexForIdLinear()", 1,
+    [&registrar](uint32_t i) {
+      uint32_t zoneId = zoneIdAt<complete::Info>(
+          zonedbc::kZoneAndLinkRegistry,
+          scatter(i, zonedbc::kZoneAndLinkRegistrySize));
+      disableOptimization(registrar.findIndexForIdLinear(zoneId));
+    },
+    [](uint32_t i) {
+      disableOptimization(zoneIdAt<complete::Info>(
+          zonedbc::kZoneAndLinkRegistry,
+          scatter(i, zonedbc::kZoneAndLinkRegistrySize)));
+    }
+  );
+}
+
+static void runCompleteRegistrarFindIndexForNameHash() {
+  static complete::ZoneIdIndex<kMaxRegistrySize> zoneIdIndex(
+      zonedbc::kZoneAndLinkRegistrySize, zonedbc::kZoneAndLinkRegistry);
+  runRegistrarFindIndexForName<complete::Info>(
+      "CompleteZoneRegistrar::findIndexForName(hash)",
+      zonedbc::kZoneAndLinkRegistrySize, zonedbc::kZoneAndLinkRegistry,
+      &zoneIdIndex);
+}
+
+static void runCompleteRegistrarFindIndexForIdHash() {
+  static complete::ZoneIdIndex<kMaxRegistrySize> zoneIdIndex(
+      zonedbc::kZoneAndLinkRegistrySize, zonedbc::kZoneAndLinkRegistry);
+  runRegistrarFindIndexForIdHash<complete::Info>(
+      "CompleteZoneRegistrar::findIndexForIdHash()",
+      zonedbc::kZoneAndLinkRegistrySize, zonedbc::kZoneAndLinkRegistry,
+      &zoneIdIndex);
+}
+
+//-----------------------------------------------------------------------------
+// EpochBenchmark and ComparisonBenchmark. The epoch converters round-trip
+// dates spread over the years [1873, 2127], like EpochBenchmark.
+//-----------------------------------------------------------------------------
+
+static void dateAt(uint32_t i, int16_t& year, uint8_t& month, uint8_t& day) {
+  year = 1873 + (int16_t) ((i / 336) % 255);
+  month = 1 + (uint8_t) ((i / 28) % 12);
+  day = 1 + (uint8_t) (i % 28);
+}
+
+template <typename C>
+static void runConverter(const char* name) {
+  measure(name, 1, [](uint32_t i) {
+    int16_t year;
+    uint8_t month;
+    uint8_t day;
+    dateAt(i, year, month, day);
+    int32_t epochDays = C::toEpochDays(year, month, day);
+
+    int16_t obsYear;
+    uint8_t obsMonth;
+    uint8_t obsDay;
+    C::fromEpochDays(epochDays, obsYear, obsMonth, obsDay);
+    guard ^= obsYear;
+    guard ^= obsMonth;
+    guard ^= obsDay;
+  });
+}
+
+static void runConverterJulian() {
+  runConverter<EpochConverterJulian>("EpochConverterJulian");
+}
+
+static void runConverterHinnant() {
+  runConverter<EpochConverterHinnant>("EpochConverterHinnant");
+}
+
+// The same dates as runConverterHinnant(), kNumBatchDates at a time.
+static void runConverterHinnantBatch() {
+  static const uint16_t kNumBatchDates = 256;
+  measure("EpochConverterHinnantBatch", kNumBatchDates, [](uint32_t i) {
+    int16_t years[kNumBatchDates];
+    uint8_t months[kNumBatchDates];
+    uint8_t days[kNumBatchDates];
+    for (uint16_t k = 0; k < kNumBatchDates; k++) {
+      dateAt(i * kNumBatchDates + k, years[k], months[k], days[k]);
+    }
+
+    int32_t epochDays[kNumBatchDates];
+    EpochConverterHinnant::toEpochDaysBatch(
+        years, months, days, kNumBatchDates, epochDays);
+    int16_t obsYears[kNumBatchDates];
+    uint8_t obsMonths[kNumBatchDates];
+    uint8_t obsDays[kNumBatchDates];
+    EpochConverterHinnant::fromEpochDaysBatch(
+        epochDays, kNumBatchDates, obsYears, obsMonths, obsDays);
+
+    for (uint16_t k = 0; k < kNumBatchDates; k++) {
+      guard ^= obsYears[k];
+      guard ^= obsMonths[k];
+      guard ^= obsDays[k];
+    }
+  });
+}
+
+// ComparisonBenchmark: one conversion per day, starting at 2000-01-01.
+static acetime_t comparisonSecondsAt(uint32_t i) {
+  static const acetime_t kStartSeconds =
+      LocalDate::forComponents(2000, 1, 1).toEpochSeconds();
+  return kStartSeconds + (acetime_t) (i % 36500) * 86400;
+}
+
+static void runAceTimeForEpochSeconds() {
+  measure("LocalDateTime::forEpochSeconds()", 1, [](uint32_t i) {
+    disableOptimization(LocalDateTime::forEpochSeconds(comparisonSecondsAt(i)));
+  });
+}
+
+static void runAceTimeToEpochSeconds() {
+  measure("LocalDateTime::toEpochSeconds()", 1,
+    [](uint32_t i) {
+      LocalDateTime dt = LocalDateTime::forEpochSeconds(comparisonSecondsAt(i));
+      disableOptimization(dt.toEpochSeconds());
+    },
+    [](uint32_t i) {
+      disableOptimization(LocalDateTime::forEpochSeconds(comparisonSecondsAt(i)));
+    }
+  );
+}
+
+//-----------------------------------------------------------------------------
+// Multithreaded, following MultiThreadBenchmark. Each thread converts
+// epochSeconds spread over 2000 to 2040 in 8 zones, round-robin.
+//-----------------------------------------------------------------------------
+
+static const extended::Info::ZoneInfo* const kThreadZones[] = {
+  &zonedbx::kZoneAmerica_Los_Angeles,
+  &zonedbx::kZoneAmerica_New_York,
+  &zonedbx::kZoneEurope_London,
+  &zonedbx::kZoneEurope_Berlin,
+  &zonedbx::kZoneAsia_Tokyo,
+  &zonedbx::kZoneAsia_Kolkata,
+  &zonedbx::kZoneAustralia_Sydney,
+  &zonedbx::kZonePacific_Auckland,
+};
+static const uint8_t kNumThreadZones =
+    sizeof(kThreadZones) / sizeof(kThreadZones[0]);
+
+static acetime_t spreadEpochSecondsAt(uint32_t i) {
+  static const acetime_t kStartSeconds =
+      LocalDate::forComponents(2000, 1, 1).toEpochSeconds();
+  return kStartSeconds + (acetime_t) ((i * 2654435761u) % (40 * 366)) * 86400;
+}
+
+static void runThreadsExtendedMutex(uint16_t numThreads) {
+  static ExtendedZoneProcessor processors[kNumThreadZones];
+  static TimeZone timeZones[kNumThreadZones];
+  static std::mutex mutexes[kNumThreadZones];
+  for (uint8_t z = 0; z < kNumThreadZones; z++) {
+    timeZones[z] = TimeZone::forZoneInfo(kThreadZones[z], &processors[z]);
+  }
+
+  measureThreads("ZonedDateTime::forEpochSeconds(Extended_mutex)", numThreads,
+    [](uint16_t t, uint32_t i) {
+      uint8_t z = (t + i) % kNumThreadZones;
+      std::lock_guard<std::mutex> lock(mutexes[z]);
+      disableOptimization(ZonedDateTime::forEpochSeconds(
+          spreadEpochSecondsAt(i), timeZones[z]));
+    }
+  );
+}
+
+static void runThreadsExtendedThreadLocal(uint16_t numThreads) {
+  static ThreadLocalExtendedZoneProcessor<kNumThreadZones>
+      processors[kNumThreadZones];
+  static TimeZone timeZones[kNumThreadZones];
+  for (uint8_t z = 0; z < kNumThreadZones; z++) {
+    timeZones[z] = TimeZone::forZoneInfo(kThreadZones[z], &processors[z]);
+  }
+
+  measureThreads("ZonedDateTime::forEpochSeconds(Extended_threadlocal)",
+    numThreads,
+    [](uint16_t t, uint32_t i) {
+      uint8_t z = (t + i) % kNumThreadZones;
+      disableOptimization(ZonedDateTime::forEpochSeconds(
+          spreadEpochSecondsAt(i), timeZones[z]));
+    }
+  );
+}
+
+static void runThreadsFlatShared(uint16_t numThreads) {
+  static FlatZoneProcessor processors[kNumThreadZones];
+  static TimeZone timeZones[kNumThreadZones];
+  for (uint8_t z = 0; z < kNumThreadZones; z++) {
+    // Bind and build each table before sharing it.
+    processors[z].setZoneKey((uintptr_t) kThreadZones[z]);
+    processors[z].initTransitions();
+    timeZones[z] = TimeZone::forZoneInfo(kThreadZones[z], &processors[z]);
+  }
+
+  measureThreads("ZonedDateTime::forEpochSeconds(Flat_shared)", numThreads,
+    [](uint16_t t, uint32_t i) {
+      uint8_t z = (t + i) % kNumThreadZones;
+      disableOptimization(ZonedDateTime::forEpochSeconds(
+          spreadEpochSecondsAt(i), timeZones[z]));
+    }
+  );
+}
+
+static void runThreadsPrecomputedShared(uint16_t numThreads) {
+  static PrecomputedExtendedZoneManager manager(
+      zonedbx::kZoneAndLinkRegistrySize, zonedbx::kZoneAndLinkRegistry);
+  static TimeZone timeZones[kNumThreadZones];
+  if (manager.status() != PrecomputedZoneTable::kStatusOk) {
+    manager.build(2000, 2100);
+  }
+  for (uint8_t z = 0; z < kNumThreadZones; z++) {
+    timeZones[z] = manager.createForZoneInfo(kThreadZones[z]);
+  }
+
+  measureThreads("ZonedDateTime::forEpochSeconds(Precomputed_shared)",
+    numThreads,
+    [](uint16_t t, uint32_t i) {
+      uint8_t z = (t + i) % kNumThreadZones;
+      disableOptimization(ZonedDateTime::forEpochSeconds(
+          spreadEpochSecondsAt(i), timeZones[z]));
+    }
+  );
+}
+
+//-----------------------------------------------------------------------------
+// All zones and links of zonedbc, picked pseudo-randomly on each iteration.
+// The ZoneProcessorCache of the CompleteZoneManager is evicted on almost every
+// lookup, while the PrecomputedZoneManager has a ZoneProcessor for every zone.
+//-----------------------------------------------------------------------------
+
+static void runPrecomputedZoneManagerBuild() {
+  PrecomputedZoneManager manager(
+      zonedbc::kZoneAndLinkRegistrySize, zonedbc::kZoneAndLinkRegistry);
+  measure("PrecomputedZoneManager::build(2000-2100)", 1,
+    [&manager](uint32_t /*i*/) {
+      manager.build(2000, 2100);
+      disableOptimization((uint32_t) manager.table().size());
+    }
+  );
+}
+
+static void runZonedDateTimeForEpochSecondsAllZonesComplete() {
+  CompleteZoneProcessorCache<4> cache;
+  CompleteZoneManager manager(
+      zonedbc::kZoneAndLinkRegistrySize, zonedbc::kZoneAndLinkRegistry, cache);
+  measure("ZonedDateTime::forEpochSeconds(Complete_cache4_allzones)", 1,
+    [&manager](uint32_t i) {
+      TimeZone tz = manager.createForZoneIndex(
+          scatter(i, zonedbc::kZoneAndLinkRegistrySize));
+      disableOptimization(
+          ZonedDateTime::forEpochSeconds(spreadEpochSecondsAt(i), tz));
+    }
+  );
+}
+
+static void runZonedDateTimeForEpochSecondsAllZonesPrecomputed() {
+  PrecomputedZoneManager manager(
+      zonedbc::kZoneAndLinkRegistrySize, zonedbc::kZoneAndLinkRegistry);
+  manager.build(2000, 2100);
+  measure("ZonedDateTime::forEpochSeconds(Precomputed_allzones)", 1,
+    [&manager](uint32_t i) {
+      TimeZone tz = manager.createForZoneIndex(
+          scatter(i, zonedbc::kZoneAndLinkRegistrySize));
+      disableOptimization(
+          ZonedDateTime::forEpochSeconds(spreadEpochSecondsAt(i), tz));
+    }
+  );
+}
+
+//-----------------------------------------------------------------------------
+
+static void readConfig() {
+  const char* value;
+  if ((value = getenv("HOST_BENCHMARK_SAMPLES")) && atoi(value) > 0) {
+    numSamples = atoi(value);
+  }
+  if ((value = getenv("HOST_BENCHMARK_SAMPLE_NANOS")) && atoi(value) > 0) {
+    sampleNanos = atoi(value);
+  }
+  if ((value = getenv("HOST_BENCHMARK_THREADS")) && atoi(value) > 0) {
+    maxThreads = atoi(value);
+  }
+  if ((value = getenv("HOST_BENCHMARK_CPU")) && atoi(value) >= 0) {
+    cpuIndex = atoi(value);
+  }
+  if ((value = getenv("HOST_BENCHMARK_FILTER")) && value[0] != '\0') {
+    filter = value;
+  }
+}
+
+static void printContext() {
+  SERIAL_PORT_MONITOR.print("{\n  \"context\": {\"library_version\": \"");
+  SERIAL_PORT_MONITOR.print(ACE_TIME_VERSION_STRING);
+  SERIAL_PORT_MONITOR.print("\", \"tzdb_version\": \"");
+  SERIAL_PORT_MONITOR.print(zonedbx::kTzDatabaseVersion);
+  SERIAL_PORT_MONITOR.print("\", \"compiler\": \"");
+  SERIAL_PORT_MONITOR.print(__VERSION__);
+  SERIAL_PORT_MONITOR.print("\", \"epoch_year\": ");
+  SERIAL_PORT_MONITOR.print(Epoch::currentEpochYear());
+  SERIAL_PORT_MONITOR.print(", \"cpu\": ");
+  SERIAL_PORT_MONITOR.print(pinnedCpu);
+  SERIAL_PORT_MONITOR.print(", \"allowed_cpus\": ");
+  SERIAL_PORT_MONITOR.print(numAllowedCpus());
+  SERIAL_PORT_MONITOR.print(", \"samples\": ");
+  SERIAL_PORT_MONITOR.print(numSamples);
+  SERIAL_PORT_MONITOR.print(", \"sample_ns\": ");
+  SERIAL_PORT_MONITOR.print(sampleNanos);
+  SERIAL_PORT_MONITOR.print(", \"perf_counters\": ");
+  SERIAL_PORT_MONITOR.print(perfCounters.isValid() ? "true" : "false");
+  SERIAL_PORT_MONITOR.print("},\n  \"benchmarks\": [");
+}
+
+void runBenchmarks() {
+  readConfig();
+
+  // Pin before opening the counters, so that they count on the same CPU.
+  uint16_t numCpus = numAllowedCpus();
+  pinnedCpu = pinToAllowedCpu(cpuIndex);
+  perfCounters.open();
+  printContext();
+
+  runEmptyLoop();
+
+  runLocalDateForEpochDays();
+  runLocalDateToEpochDays();
+  runLocalDateDaysOfWeek();
+
+  runOffsetDateTimeForEpochSeconds();
+  runOffsetDateTimeToEpochSeconds();
+  runOffsetDateTimePrintTo();
+  runOffsetDateTimeFormatTo();
+  runOffsetDateTimeForDateString();
+  runIsoDateTimeParserParse();
+
+  runZonedDateTimeToEpochSeconds();
+  runZonedDateTimeToEpochDays();
+  runZonedDateTimeForEpochSecondsUTC();
+
+  runZonedDateTimeForEpochSecondsBasicNoCache();
+  runZonedDateTimeForEpochSecondsBasicCached();
+  runZonedDateTimeForEpochSecondsBasicMultiYear();
+  runZonedDateTimeForEpochSecondsExtendedNoCache();
+  runZonedDateTimeForEpochSecondsExtendedCached();
+  runZonedDateTimeForEpochSecondsExtendedLoop<4>(
+      "ZonedDateTime::forEpochSeconds(Extended_x4)");
+  runZonedDateTimeForEpochSecondsBatchExtended<4>(
+      "ZonedDateTime::forEpochSecondsBatch(Extended_x4)");
+  runZonedDateTimeForEpochSecondsExtendedLoop<64>(
+      "ZonedDateTime::forEpochSeconds(Extended_x64)");
+  runZonedDateTimeForEpochSecondsBatchExtended<64>(
+      "ZonedDateTime::forEpochSecondsBatch(Extended_x64)");
+  runZonedDateTimeForEpochSecondsCompleteNoCache();
+  runZonedDateTimeForEpochSecondsCompleteCached();
+  runZonedDateTimeForEpochSecondsFlatNoCache();
+  runZonedDateTimeForEpochSecondsFlatCached();
+
+  runZonedDateTimeForComponentsBasicNoCache();
+  runZonedDateTimeForComponentsBasicCached();
+  runZonedDateTimeForComponentsBasicMultiYear();
+  runZonedDateTimeForComponentsExtendedNoCache();
+  runZonedDateTimeForComponentsExtendedCached();
+  runZonedDateTimeForComponentsCompleteNoCache();
+  runZonedDateTimeForComponentsCompleteCached();
+
+  runZonedExtraForEpochSecondsBasicNoCache();
+  runZonedExtraForEpochSecondsBasicCached();
+  runZonedExtraForEpochSecondsExtendedNoCache();
+  runZonedExtraForEpochSecondsExtendedCached();
+  runZonedExtraForEpochSecondsCompleteNoCache();
+  runZonedExtraForEpochSecondsCompleteCached();
+
+  runZonedExtraForComponentsBasicNoCache();
+  runZonedExtraForComponentsBasicCached();
+  runZonedExtraForComponentsExtendedNoCache();
+  runZonedExtraForComponentsExtendedCached();
+  runZonedExtraForComponentsCompleteNoCache();
+  runZonedExtraForComponentsCompleteCached();
+
+  runBasicRegistrarFindIndexForName();
+  runBasicRegistrarFindIndexForIdBinary();
+  runBasicRegistrarFindIndexForIdLinear();
+  runBasicRegistrarFindIndexForNameHash();
+  runBasicRegistrarFindIndexForIdHash();
+
+  runExtendedRegistrarFindIndexForName();
+  runExtendedRegistrarFindIndexForIdBinary();
+  runExtendedRegistrarFindIndexForIdLinear();
+  runExtendedRegistrarFindIndexForNameHash();
+  runExtendedRegistrarFindIndexForIdHash();
+
+  runCompleteRegistrarFindIndexForName();
+  runCompleteRegistrarFindIndexForIdBinary();
+  runCompleteRegistrarFindIndexForIdLinear();
+  runCompleteRegistrarFindIndexForNameHash();
+  runCompleteRegistrarFindIndexForIdHash();
+
+  runConverterJulian();
+  runConverterHinnant();
+  runConverterHinnantBatch();
+
+  runAceTimeForEpochSeconds();
+  runAceTimeToEpochSeconds();
+
+  runPrecomputedZoneManagerBuild();
+  runZonedDateTimeForEpochSecondsAllZonesComplete();
+  runZonedDateTimeForEpochSecondsAllZonesPrecomputed();
+
+  // More threads than CPUs would measure the scheduler instead.
+  uint16_t threadLimit = (maxThreads < numCpus) ? maxThreads : numCpus;
+  if (threadLimit == 0) threadLimit = 1;
+  for (uint16_t n = 1; n <= threadLimit; n *= 2) {
+    runThreadsExtendedMutex(n);
+    runThreadsExtendedThreadLocal(n);
+    runThreadsFlatShared(n);
+    runThreadsPrecomputedShared(n);
+  }
+
+  SERIAL_PORT_MONITOR.println("\n  ]\n}");
+  perfCounters.close();
+}
+
+#endif
@@ -0,0 +1,6 @@
+#ifndef HOST_BENCHMARK_BENCHMARK_H
+#define HOST_BENCHMARK_BENCHMARK_H
+
+extern void runBenchmarks();
+
+#endif
@@ -0,0 +1,35 @@
+/*
+ * A program to measure the AceTime library natively on Linux (or MacOS) using
+ * EpoxyDuino. It covers the scenarios of AutoBenchmark, EpochBenchmark, and
+ * the AceTime parts of ComparisonBenchmark, plus batch and multithreaded
+ * variants, and prints the median, 99th percentile, mean, and standard
+ * deviation of ns/op of each benchmark as JSON, with hardware counters from
+ * perf_event_open(2) when the kernel allows them. See README.md.
+ *
+ * Requires a POSIX host, so this does nothing on a microcontroller.
+ */
+
+#include <Arduino.h>
+#include "Benchmark.h"
+
+void setup() {
+#if ! defined(EPOXY_DUINO)
+  delay(1000);
+#endif
+
+  SERIAL_PORT_MONITOR.begin(115200);
+  while (!SERIAL_PORT_MONITOR); // Wait until ready - Leonardo/Micro
+#if defined(EPOXY_DUINO)
+  SERIAL_PORT_MONITOR.setLineModeUnix();
+#endif
+
+#if defined(EPOXY_DUINO)
+  runBenchmarks();
+  exit(0);
+#else
+  SERIAL_PORT_MONITOR.println(F("Requires EpoxyDuino on Linux or MacOS"));
+#endif
+}
+
+void loop() {
+}
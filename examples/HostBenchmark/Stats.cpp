@@ -0,0 +1,187 @@
+#if defined(EPOXY_DUINO)
+
+#if defined(__linux__) && ! defined(_GNU_SOURCE)
+  #define _GNU_SOURCE // sched_setaffinity(), CPU_SET()
+#endif
+
+#include <math.h>
+#include <string.h>
+#include <time.h>
+#include <algorithm> // std::sort()
+#include <thread> // std::thread::hardware_concurrency()
+#include "Stats.h"
+
+#if defined(__linux__)
+  #include <sched.h>
+  #include <unistd.h>
+  #include <sys/ioctl.h>
+  #include <sys/syscall.h>
+  #include <linux/perf_event.h>
+#endif
+
+void calcStats(double* samples, uint32_t numSamples, Stats& stats) {
+  stats.numSamples = numSamples;
+  if (numSamples == 0) {
+    stats.median = stats.p99 = stats.mean = stats.stddev = 0;
+    return;
+  }
+
+  std::sort(samples, samples + numSamples);
+  stats.median = (numSamples % 2)
+      ? samples[numSamples / 2]
+      : (samples[numSamples / 2 - 1] + samples[numSamples / 2]) / 2;
+
+  // Nearest-rank method: the smallest sample which is >= 99% of the samples.
+  uint32_t rank = (uint32_t) ceil(0.99 * numSamples);
+  stats.p99 = samples[rank - 1];
+
+  double sum = 0;
+  for (uint32_t i = 0; i < numSamples; i++) sum += samples[i];
+  stats.mean = sum / numSamples;
+
+  double sumSquares = 0;
+  for (uint32_t i = 0; i < numSamples; i++) {
+    double delta = samples[i] - stats.mean;
+    sumSquares += delta * delta;
+  }
+  stats.stddev = (numSamples > 1) ? sqrt(sumSquares / (numSamples - 1)) : 0;
+}
+
+uint64_t nowNanos() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t) ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+//-----------------------------------------------------------------------------
+
+#if defined(__linux__)
+
+// The CPUs in the affinity mask of the process at startup, before any of the
+// threads are pinned.
+static uint16_t allowedCpus[CPU_SETSIZE];
+static uint16_t numCpus = 0;
+
+static void initAllowedCpus() {
+  if (numCpus) return;
+  cpu_set_t mask;
+  if (sched_getaffinity(0, sizeof(mask), &mask) == 0) {
+    for (uint16_t cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+      if (CPU_ISSET(cpu, &mask)) allowedCpus[numCpus++] = cpu;
+    }
+  }
+}
+
+uint16_t numAllowedCpus() {
+  initAllowedCpus();
+  return numCpus;
+}
+
+int pinToAllowedCpu(uint16_t index) {
+  initAllowedCpus();
+  if (numCpus == 0) return -1;
+
+  uint16_t cpu = allowedCpus[index % numCpus];
+  cpu_set_t mask;
+  CPU_ZERO(&mask);
+  CPU_SET(cpu, &mask);
+  if (sched_setaffinity(0, sizeof(mask), &mask) != 0) return -1;
+  return cpu;
+}
+
+//-----------------------------------------------------------------------------
+
+const char* const PerfCounters::kNames[kNumCounters] = {
+  "cycles",
+  "instructions",
+  "branch_misses",
+  "cache_misses",
+};
+
+static const uint64_t kPerfConfigs[PerfCounters::kNumCounters] = {
+  PERF_COUNT_HW_CPU_CYCLES,
+  PERF_COUNT_HW_INSTRUCTIONS,
+  PERF_COUNT_HW_BRANCH_MISSES,
+  PERF_COUNT_HW_CACHE_MISSES,
+};
+
+void PerfCounters::open() {
+  for (uint8_t i = 0; i < kNumCounters; i++) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = kPerfConfigs[i];
+    attr.disabled = (i == 0); // members follow the group leader
+    attr.exclude_kernel = 1; // allowed with perf_event_paranoid <= 2
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP;
+
+    int groupFd = (i == 0) ? -1 : mFds[0];
+    mFds[i] = (int) syscall(__NR_perf_event_open, &attr, 0, -1, groupFd, 0);
+    if (i == 0 && mFds[0] < 0) return;
+  }
+}
+
+void PerfCounters::close() {
+  for (uint8_t i = 0; i < kNumCounters; i++) {
+    if (mFds[i] >= 0) ::close(mFds[i]);
+    mFds[i] = -1;
+  }
+}
+
+void PerfCounters::reset() {
+  if (isValid()) ioctl(mFds[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+}
+
+void PerfCounters::enable() {
+  if (isValid()) ioctl(mFds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+}
+
+void PerfCounters::disable() {
+  if (isValid()) ioctl(mFds[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+}
+
+void PerfCounters::read(uint64_t* values) {
+  memset(values, 0, kNumCounters * sizeof(uint64_t));
+  if (! isValid()) return;
+
+  // PERF_FORMAT_GROUP: {nr, value[nr]} in the order the counters were opened
+  uint64_t buf[1 + kNumCounters];
+  if (::read(mFds[0], buf, sizeof(buf)) < (ssize_t) sizeof(uint64_t)) return;
+  uint64_t n = 0;
+  for (uint8_t i = 0; i < kNumCounters && n < buf[0]; i++) {
+    if (mFds[i] >= 0) values[i] = buf[1 + n++];
+  }
+}
+
+#else
+
+// MacOS: no CPU pinning, no perf_event_open().
+
+uint16_t numAllowedCpus() {
+  return std::max(1u, std::thread::hardware_concurrency());
+}
+
+int pinToAllowedCpu(uint16_t /*index*/) { return -1; }
+
+const char* const PerfCounters::kNames[kNumCounters] = {
+  "cycles",
+  "instructions",
+  "branch_misses",
+  "cache_misses",
+};
+
+void PerfCounters::open() {}
+void PerfCounters::close() {}
+void PerfCounters::reset() {}
+void PerfCounters::enable() {}
+void PerfCounters::disable() {}
+
+void PerfCounters::read(uint64_t* values) {
+  memset(values, 0, kNumCounters * sizeof(uint64_t));
+}
+
+#endif
+
+#endif
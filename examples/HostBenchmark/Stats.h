@@ -0,0 +1,76 @@
+#ifndef HOST_BENCHMARK_STATS_H
+#define HOST_BENCHMARK_STATS_H
+
+#include <stdint.h>
+
+/** Summary statistics of the ns/op samples of a single benchmark. */
+struct Stats {
+  uint32_t numSamples;
+  double median;
+  double p99;
+  double mean;
+  double stddev;
+};
+
+/**
+ * Calculate the median, 99th percentile, mean, and sample standard deviation
+ * of the given samples. The samples array is sorted in place.
+ */
+void calcStats(double* samples, uint32_t numSamples, Stats& stats);
+
+/** Return a monotonic timestamp in nanoseconds. */
+uint64_t nowNanos();
+
+/** Return the number of CPUs that this process is allowed to run on. */
+uint16_t numAllowedCpus();
+
+/**
+ * Pin the calling thread to the index'th CPU (modulo numAllowedCpus()) of
+ * the CPUs that the process was originally allowed to run on. Return the
+ * CPU number, or -1 if pinning is not supported (e.g. MacOS).
+ */
+int pinToAllowedCpu(uint16_t index);
+
+/**
+ * A group of hardware performance counters of the calling thread, read using
+ * perf_event_open(2) on Linux. If the kernel does not allow access to the
+ * counters (see /proc/sys/kernel/perf_event_paranoid), or the machine does
+ * not have them (e.g. some virtual machines), isValid() returns false and the
+ * benchmarks are reported without counters.
+ */
+class PerfCounters {
+  public:
+    static const uint8_t kNumCounters = 4;
+
+    /** Names of the counters, used as JSON keys. */
+    static const char* const kNames[kNumCounters];
+
+    /** Open the counters of the calling thread. */
+    void open();
+
+    /** Close the counters. */
+    void close();
+
+    /** Return true if at least the cycle counter is available. */
+    bool isValid() const { return mFds[0] >= 0; }
+
+    /** Return true if the given counter is available. */
+    bool isValid(uint8_t i) const { return mFds[i] >= 0; }
+
+    /** Set the counters to 0. */
+    void reset();
+
+    /** Start counting. */
+    void enable();
+
+    /** Stop counting. */
+    void disable();
+
+    /** Read the accumulated counts into values[kNumCounters]. */
+    void read(uint64_t* values);
+
+  private:
+    int mFds[kNumCounters] = {-1, -1, -1, -1};
+};
+
+#endif
@@ -0,0 +1,54 @@
+#!/usr/bin/python3
+#
+# Compare 2 JSON files written by HostBenchmark, e.g. from 2 versions of the
+# library or of the TZ database, and print the change of the median ns/op of
+# each benchmark. A change larger than the threshold (default 5%) and larger
+# than the stddev of the new run is flagged with '<<' (slower) or '>>'
+# (faster).
+#
+# Usage: ./compare.py [--threshold 0.05] old.json new.json
+
+import argparse
+import json
+
+
+def load(filename):
+    with open(filename) as f:
+        results = json.load(f)
+    return results['context'], {
+        (b['name'], b['threads']): b for b in results['benchmarks']
+    }
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Compare HostBenchmark runs')
+    parser.add_argument('--threshold', type=float, default=0.05)
+    parser.add_argument('old')
+    parser.add_argument('new')
+    args = parser.parse_args()
+
+    old_context, old = load(args.old)
+    new_context, new = load(args.new)
+    print(f"old: AceTime {old_context['library_version']}, "
+          f"TZDB {old_context['tzdb_version']}")
+    print(f"new: AceTime {new_context['library_version']}, "
+          f"TZDB {new_context['tzdb_version']}")
+
+    print(f"{'name':<55} {'thr':>3} {'old_ns':>9} {'new_ns':>9} {'change':>8}")
+    for key, n in new.items():
+        o = old.get(key)
+        if o is None:
+            continue
+        old_ns = o['median_ns']
+        new_ns = n['median_ns']
+        change = (new_ns - old_ns) / old_ns if old_ns > 0 else 0.0
+        flag = ''
+        if abs(change) > args.threshold \
+                and abs(new_ns - old_ns) > n['stddev_ns']:
+            flag = '<<' if change > 0 else '>>'
+        print(f"{key[0]:<55} {key[1]:>3} {old_ns:>9.3f} {new_ns:>9.3f} "
+              f"{change:>+8.1%} {flag}")
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,175 @@
+/*
+ * A program to determine how well the time zone lookups scale across multiple
+ * threads sharing the same TimeZone objects. Each thread converts epochSeconds
+ * to OffsetDateTime in a loop over a set of zones, and the program prints the
+ * total throughput for 1, 2, 4, ..., 32 threads using:
+ *
+ *  * a single ExtendedZoneProcessor per zone guarded by a mutex (baseline)
+ *  * ThreadLocalExtendedZoneProcessor, one per-thread cache per thread
+ *  * FlatZoneProcessor, an immutable table shared by all threads
+ *
+ * Requires real threads, so this runs only on Linux or MacOS using EpoxyDuino.
+ */
+
+#include <Arduino.h>
+#include <AceTime.h>
+
+#if defined(EPOXY_DUINO)
+
+#include <chrono>
+#include <mutex>
+#include <thread>
+
+using namespace ace_time;
+
+// Zones converted by each thread, in round-robin order.
+static const extended::Info::ZoneInfo* const kZones[] = {
+  &zonedbx::kZoneAmerica_Los_Angeles,
+  &zonedbx::kZoneAmerica_New_York,
+  &zonedbx::kZoneEurope_London,
+  &zonedbx::kZoneEurope_Berlin,
+  &zonedbx::kZoneAsia_Tokyo,
+  &zonedbx::kZoneAsia_Kolkata,
+  &zonedbx::kZoneAustralia_Sydney,
+  &zonedbx::kZonePacific_Auckland,
+};
+static const uint8_t kNumZones = sizeof(kZones) / sizeof(kZones[0]);
+
+static const uint8_t kMaxThreads = 32;
+static const uint32_t kLookupsPerThread = 200000;
+
+// Keep the compiler from optimizing away the lookups.
+static volatile int32_t guard;
+
+// Spread the lookups over 2000 to 2040 to defeat the year cache.
+static acetime_t epochSecondsAt(uint32_t i) {
+  static const acetime_t start =
+      LocalDate::forComponents(2000, 1, 1).toEpochSeconds();
+  return start + (acetime_t) ((i * 2654435761u) % (40 * 366)) * 86400;
+}
+
+// Run lookup(threadIndex, i) on numThreads threads, return lookups per second.
+template <typename F>
+static double runThreads(uint8_t numThreads, F lookup) {
+  std::thread threads[kMaxThreads];
+  auto start = std::chrono::steady_clock::now();
+  for (uint8_t t = 0; t < numThreads; t++) {
+    threads[t] = std::thread([t, &lookup]() {
+      int32_t sum = 0;
+      for (uint32_t i = 0; i < kLookupsPerThread; i++) {
+        sum += lookup(t, i);
+      }
+      guard = sum;
+    });
+  }
+  for (uint8_t t = 0; t < numThreads; t++) {
+    threads[t].join();
+  }
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+  return (double) numThreads * kLookupsPerThread / elapsed.count();
+}
+
+static void printResult(const char* label, uint8_t numThreads,
+    double lookupsPerSecond, double baseline) {
+  char buf[80];
+  snprintf(buf, sizeof(buf), "%s %u %.0f %.2f", label, numThreads,
+      lookupsPerSecond, lookupsPerSecond / baseline);
+  SERIAL_PORT_MONITOR.println(buf);
+}
+
+static void runMutexExtended() {
+  static ExtendedZoneProcessor processors[kNumZones];
+  static TimeZone timeZones[kNumZones];
+  static std::mutex mutexes[kNumZones];
+  for (uint8_t z = 0; z < kNumZones; z++) {
+    timeZones[z] = TimeZone::forZoneInfo(kZones[z], &processors[z]);
+  }
+
+  auto lookup = [](uint8_t t, uint32_t i) {
+    uint8_t z = (t + i) % kNumZones;
+    std::lock_guard<std::mutex> lock(mutexes[z]);
+    return timeZones[z].getOffsetDateTime(epochSecondsAt(i))
+        .timeOffset().toSeconds();
+  };
+  double baseline = 0;
+  for (uint8_t n = 1; n <= kMaxThreads; n *= 2) {
+    double result = runThreads(n, lookup);
+    if (n == 1) baseline = result;
+    printResult("Extended_mutex", n, result, baseline);
+  }
+}
+
+static void runThreadLocalExtended() {
+  static ThreadLocalExtendedZoneProcessor<kNumZones> processors[kNumZones];
+  static TimeZone timeZones[kNumZones];
+  for (uint8_t z = 0; z < kNumZones; z++) {
+    timeZones[z] = TimeZone::forZoneInfo(kZones[z], &processors[z]);
+  }
+
+  auto lookup = [](uint8_t t, uint32_t i) {
+    uint8_t z = (t + i) % kNumZones;
+    return timeZones[z].getOffsetDateTime(epochSecondsAt(i))
+        .timeOffset().toSeconds();
+  };
+  double baseline = 0;
+  for (uint8_t n = 1; n <= kMaxThreads; n *= 2) {
+    double result = runThreads(n, lookup);
+    if (n == 1) baseline = result;
+    printResult("Extended_threadlocal", n, result, baseline);
+  }
+}
+
+static void runFlat() {
+  static FlatZoneProcessor processors[kNumZones];
+  static TimeZone timeZones[kNumZones];
+  for (uint8_t z = 0; z < kNumZones; z++) {
+    // Bind and build each table before sharing it.
+    processors[z].setZoneKey((uintptr_t) kZones[z]);
+    processors[z].initTransitions();
+    timeZones[z] = TimeZone::forZoneInfo(kZones[z], &processors[z]);
+  }
+
+  auto lookup = [](uint8_t t, uint32_t i) {
+    uint8_t z = (t + i) % kNumZones;
+    return timeZones[z].getOffsetDateTime(epochSecondsAt(i))
+        .timeOffset().toSeconds();
+  };
+  double baseline = 0;
+  for (uint8_t n = 1; n <= kMaxThreads; n *= 2) {
+    double result = runThreads(n, lookup);
+    if (n == 1) baseline = result;
+    printResult("Flat_shared", n, result, baseline);
+  }
+}
+
+#endif
+
+void setup() {
+#if ! defined(EPOXY_DUINO)
+  delay(1000);
+#endif
+
+  SERIAL_PORT_MONITOR.begin(115200);
+  while (!SERIAL_PORT_MONITOR); // Wait until ready - Leonardo/Micro
+#if defined(EPOXY_DUINO)
+  SERIAL_PORT_MONITOR.setLineModeUnix();
+#endif
+
+#if defined(EPOXY_DUINO)
+  SERIAL_PORT_MONITOR.print(F("hardware_concurrency "));
+  SERIAL_PORT_MONITOR.println(std::thread::hardware_concurrency());
+  SERIAL_PORT_MONITOR.println(F("BENCHMARKS"));
+  SERIAL_PORT_MONITOR.println(F("method threads lookups/sec speedup"));
+  runMutexExtended();
+  runThreadLocalExtended();
+  runFlat();
+  SERIAL_PORT_MONITOR.println(F("END"));
+  exit(0);
+#else
+  SERIAL_PORT_MONITOR.println(F("Requires EpoxyDuino on Linux or MacOS"));
+#endif
+}
+
+void loop() {
+}
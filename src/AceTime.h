@@ -32,6 +32,7 @@
 #include "ace_time/common/DateConv.h"
 #include "ace_time/EpochConverterJulian.h"
 #include "ace_time/EpochConverterHinnant.h"
+#include "ace_time/EpochContext.h"
 #include "ace_time/Epoch.h"
 #include "ace_time/LocalDate.h"
 #include "ace_time/local_date_mutation.h"
@@ -41,15 +42,31 @@
 #include "ace_time/time_offset_mutation.h"
 #include "ace_time/OffsetDateTime.h"
 #include "ace_time/offset_date_time_mutation.h"
+#include "ace_time/IsoDateTimeParser.h"
 //
+#include "ace_time/ZoneStats.h"
 #include "ace_time/ZoneProcessor.h"
 #include "ace_time/BasicZoneProcessor.h"
 #include "ace_time/ExtendedZoneProcessor.h"
 #include "ace_time/CompleteZoneProcessor.h"
+#include "ace_time/FlatZoneProcessor.h"
+#include "ace_time/PrecomputedZoneTable.h"
+#include "ace_time/PrecomputedZoneProcessor.h"
+#include "ace_time/MappedZoneProcessor.h"
+#include "ace_time/MappedZoneDatabase.h"
+#include "ace_time/MappedZoneDatabaseWriter.h"
+#include "ace_time/PosixTimeZone.h"
+#include "ace_time/TzifZoneInfo.h"
+#include "ace_time/TzifZoneProcessor.h"
 #include "ace_time/ZoneProcessorCache.h"
+#include "ace_time/ThreadLocalZoneProcessor.h"
+#include "ace_time/ZoneIdIndex.h"
 #include "ace_time/ZoneRegistrar.h"
 #include "ace_time/Zone.h"
 #include "ace_time/ZoneManager.h"
+#include "ace_time/TzifZoneManager.h"
+#include "ace_time/PrecomputedZoneManager.h"
+#include "ace_time/SwappableZoneDatabase.h"
 #include "ace_time/ZoneSorterByName.h"
 #include "ace_time/ZoneSorterByOffsetAndName.h"
 #include "ace_time/TimeZoneData.h"
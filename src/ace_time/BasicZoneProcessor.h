@@ -15,6 +15,7 @@
 #include "LocalDate.h"
 #include "OffsetDateTime.h"
 #include "ZoneProcessor.h"
+#include "ZoneStats.h"
 
 #ifndef ACE_TIME_BASIC_ZONE_PROCESSOR_DEBUG
 #define ACE_TIME_BASIC_ZONE_PROCESSOR_DEBUG 0
@@ -317,7 +318,7 @@ class BasicZoneProcessorTemplate: public ZoneProcessor {
 
       mZoneInfoBroker = mZoneInfoStore->createZoneInfoBroker(zoneKey);
       mYear = LocalDate::kInvalidYear;
-      mNumTransitions = 0;
+      clearYearSlots();
     }
 
     bool equalsZoneKey(uintptr_t zoneKey) const override {
@@ -330,10 +331,11 @@ class BasicZoneProcessorTemplate: public ZoneProcessor {
         logging::printf("BasicZoneProcessor:\n");
         logging::printf("  mEpochYear: %d\n", mEpochYear);
         logging::printf("  mYear: %d\n", mYear);
-        logging::printf("  mNumTransitions: %d\n", mNumTransitions);
-        for (int i = 0; i < mNumTransitions; i++) {
+        const YearSlot* slot = mCurrentYearSlot;
+        logging::printf("  numTransitions: %d\n", slot->numTransitions);
+        for (int i = 0; i < slot->numTransitions; i++) {
           logging::printf("  mT[%d]=", i);
-          mTransitions[i].log();
+          slot->transitions[i].log();
         }
       }
     }
@@ -348,7 +350,70 @@ class BasicZoneProcessorTemplate: public ZoneProcessor {
       mZoneInfoStore = zoneInfoStore;
     }
 
+    /**
+     * Number of years whose transitions can be cached at the same time. This
+     * is 1 for the plain processor, and larger for a subclass which supplies
+     * additional year slots (e.g. BasicZoneProcessorMultiYear).
+     */
+    uint8_t getNumYearSlots() const {
+      return 1 + mNumExtraYearSlots;
+    }
+
+  #if ACE_TIME_ZONE_STATS
+    /**
+     * Return the hot path statistics, which can be read without a lock while
+     * another thread uses this ZoneProcessor. Available only if
+     * ACE_TIME_ZONE_STATS is enabled.
+     */
+    const ZoneProcessorStats& getStats() const { return mStats; }
+
+    /** Reset the hot path statistics to 0. */
+    void resetStats() { mStats.reset(); }
+  #endif
+
   protected:
+    /**
+     * Maximum size of Transition cache across supported zones. This number (5)
+     * is derived from the following:
+     *
+     *    * 1 transition prior to the current year
+     *    * 1 transition at the start of the current year if the zone
+     *      switches to a new ZoneEra (e.g. into a new ZonePolicy)
+     *    * 2 DST transitions (spring and autumn)
+     *    * 1 transition at start of the next year
+     */
+    static const uint8_t kMaxCacheEntries = 5;
+
+    /**
+     * The Transitions calculated by initForLocalDate() for a single year. The
+     * processor always contains one YearSlot. A subclass can supply additional
+     * slots using setExtraYearSlots() so that multiple years can be cached at
+     * the same time.
+     */
+    struct YearSlot {
+      /** Year of the cached transitions, kInvalidYear if empty. */
+      int16_t year = LocalDate::kInvalidYear;
+
+      /** Epoch::currentEpochYear() when the transitions were calculated. */
+      int16_t epochYear = LocalDate::kInvalidYear;
+
+      /**
+       * The [start, until) epochSeconds covered by the slot, from Jan 2 of
+       * the year to Jan 2 of the following year (see initForLocalDate()).
+       * Empty if the two are equal.
+       */
+      acetime_t startSeconds = 0;
+      acetime_t untilSeconds = 0;
+
+      /** Value of mYearSlotClock when this slot was last used. */
+      uint16_t lastUsed = 0;
+
+      /** Number of valid entries in transitions. */
+      uint8_t numTransitions = 0;
+
+      /** The Transitions, sorted by startEpochSeconds. */
+      Transition transitions[kMaxCacheEntries];
+    };
 
     /**
      * Constructor. When first initialized inside a cache, the zoneInfoStore may
@@ -372,6 +437,17 @@ class BasicZoneProcessorTemplate: public ZoneProcessor {
       setZoneKey(zoneKey);
     }
 
+    /**
+     * Add `numSlots` additional year slots, pointed to by `slots`, to the one
+     * built into this object. The `slots` array must live as long as this
+     * processor. Intended to be called from the constructor of a subclass.
+     */
+    void setExtraYearSlots(YearSlot* slots, uint8_t numSlots) {
+      mExtraYearSlots = slots;
+      mNumExtraYearSlots = numSlots;
+      clearYearSlots();
+    }
+
   private:
     friend class ::BasicZoneProcessorTest_priorYearOfRule;
     friend class ::BasicZoneProcessorTest_compareRulesBeforeYear;
@@ -382,18 +458,6 @@ class BasicZoneProcessorTemplate: public ZoneProcessor {
     friend class ::BasicZoneProcessorTest_setZoneKey;
     friend class ::BasicZoneProcessorTest_calcRuleOffsetMinutes;
 
-    /**
-     * Maximum size of Transition cache across supported zones. This number (5)
-     * is derived from the following:
-     *
-     *    * 1 transition prior to the current year
-     *    * 1 transition at the start of the current year if the zone
-     *      switches to a new ZoneEra (e.g. into a new ZonePolicy)
-     *    * 2 DST transitions (spring and autumn)
-     *    * 1 transition at start of the next year
-     */
-    static const uint8_t kMaxCacheEntries = 5;
-
     /**
      * The smallest Transition.startEpochSeconds which represents -Infinity.
      * Can't use INT32_MIN because that is used internally to indicate
@@ -456,15 +520,36 @@ class BasicZoneProcessorTemplate: public ZoneProcessor {
         return false;
       }
 
-      if (isFilled(year)) return true;
+      int16_t epochYear = Epoch::currentEpochYear();
+      YearSlot* slot = findYearSlot(year, epochYear);
+      if (slot) {
+      #if ACE_TIME_ZONE_STATS
+        mStats.yearCacheHits.increment();
+      #endif
+        useYearSlot(slot);
+        return true;
+      }
+
       if (ACE_TIME_BASIC_ZONE_PROCESSOR_DEBUG) {
         logging::printf("initForLocalDate(): %d (new year %d)\n",
             ld.year(), year);
       }
+      slot = findYearSlotToEvict(epochYear);
+    #if ACE_TIME_ZONE_STATS
+      uint32_t startMicros = micros();
+      mStats.rebuilds.increment();
+      if (slot->year != LocalDate::kInvalidYear) mStats.evictions.increment();
+    #endif
 
       mYear = year;
-      mEpochYear = Epoch::currentEpochYear();
-      mNumTransitions = 0; // clear cache
+      mEpochYear = epochYear;
+      setYearBounds(86400); // the year starts on Jan 2
+      slot->year = year;
+      slot->epochYear = epochYear;
+      slot->startSeconds = mYearStartSeconds;
+      slot->untilSeconds = mYearUntilSeconds;
+      slot->numTransitions = 0; // clear cache
+      useYearSlot(slot);
 
       typename D::ZoneEraBroker priorEra = addTransitionPriorToYear(year);
       typename D::ZoneEraBroker currentEra =
@@ -477,15 +562,32 @@ class BasicZoneProcessorTemplate: public ZoneProcessor {
         log();
       }
 
+    #if ACE_TIME_ZONE_STATS
+      mStats.transitionsGenerated.add(slot->numTransitions);
+      mStats.transitionsHighWater.recordMax(slot->numTransitions);
+      mStats.rebuildMicros.record(micros() - startMicros);
+    #endif
       return true;
     }
 
     /**
      * Initialize the transition cache, by converting the epochSeconds to
      * year-month-day in UTC, then calling initForLocalDate() with the 'year'
-     * component.
+     * component. The conversion is skipped if the epochSeconds is within the
+     * bounds of one of the cached years, each of which runs from Jan 2 to
+     * Jan 1 of the following year (see initForLocalDate()).
      */
     bool initForEpochSeconds(acetime_t epochSeconds) const {
+      YearSlot* slot = isFilledForEpochSeconds(epochSeconds)
+          ? mCurrentYearSlot
+          : findYearSlotForEpochSeconds(epochSeconds);
+      if (slot) {
+      #if ACE_TIME_ZONE_STATS
+        mStats.yearCacheHits.increment();
+      #endif
+        if (slot != mCurrentYearSlot) useYearSlot(slot);
+        return true;
+      }
       LocalDate ld = LocalDate::forEpochSeconds(epochSeconds);
       return initForLocalDate(ld);
     }
@@ -616,7 +718,7 @@ class BasicZoneProcessorTemplate: public ZoneProcessor {
       }
 
       // Find all directly matching transitions (i.e. the [from, to] overlap
-      // with the current year) and add them to mTransitions, in sorted order
+      // with the current year) and add them to the transitions, in sorted order
       // according to the ZoneRule::inMonth field.
       uint8_t numRules = zonePolicy.numRules();
       for (uint8_t i = 0; i < numRules; i++) {
@@ -673,11 +775,11 @@ class BasicZoneProcessorTemplate: public ZoneProcessor {
     }
 
     /**
-     * Add the Transition(era, rule) to the mTransitions cache, in sorted order
-     * according to the 'ZoneRule::inMonth' field. This assumes that there are
-     * no more than one transition per month, so tzcompiler.py removes
-     * ZonePolicies which have multiple transitions in one month (e.g. Egypt,
-     * Palestine, Spain, Tunisia).
+     * Add the Transition(era, rule) to the transitions of the current year
+     * slot, in sorted order according to the 'ZoneRule::inMonth' field. This
+     * assumes that there are no more than one transition per month, so
+     * tzcompiler.py removes ZonePolicies which have multiple transitions in
+     * one month (e.g. Egypt, Palestine, Spain, Tunisia).
      *
      * Essentially, this method is doing an Insertion Sort of the Transition
      * elements. Even through it is O(N^2), for small number of Transition
@@ -715,23 +817,25 @@ class BasicZoneProcessorTemplate: public ZoneProcessor {
       // history. But it seems like too much work right now to try to dig that
       // out, just to implement the explicit check for kMaxCacheEntries. It
       // would mean maintaining another version of zone_processor.py.
-      if (mNumTransitions >= kMaxCacheEntries) return;
+      YearSlot* slot = mCurrentYearSlot;
+      if (slot->numTransitions >= kMaxCacheEntries) return;
 
       // Insert new element at the end of the list.
       // NOTE: It is probably tempting to pass a pointer (or reference) to
-      // mTransitions[mNumTransitions] into createTransition(), instead of
+      // transitions[numTransitions] into createTransition(), instead of
       // returning it by value. However, MemoryBenchmark shows that directly
       // updating the Transition through the pointer increases flash memory
       // consumption by ~110 bytes on AVR processors. It seems that creating a
       // local copy of Transition on the stack, filling it, and then copying it
       // by value takes fewer instructions.
-      mTransitions[mNumTransitions] = createTransition(year, month, era, rule);
-      mNumTransitions++;
+      slot->transitions[slot->numTransitions] =
+          createTransition(year, month, era, rule);
+      slot->numTransitions++;
 
       // perform an insertion sort based on ZoneRule.inMonth()
-      for (uint8_t i = mNumTransitions - 1; i > 0; i--) {
-        Transition& left = mTransitions[i - 1];
-        Transition& right = mTransitions[i];
+      for (uint8_t i = slot->numTransitions - 1; i > 0; i--) {
+        Transition& left = slot->transitions[i - 1];
+        Transition& right = slot->transitions[i];
         // assume only 1 rule per month
         if (basic::compareYearMonth(left.year, left.month,
             right.year, right.month) > 0) {
@@ -811,11 +915,12 @@ class BasicZoneProcessorTemplate: public ZoneProcessor {
       }
 
       // Set the initial startEpochSeconds to be -Infinity
-      Transition* prevTransition = &mTransitions[0];
+      YearSlot* slot = mCurrentYearSlot;
+      Transition* prevTransition = &slot->transitions[0];
       prevTransition->startEpochSeconds = kMinEpochSeconds;
 
-      for (uint8_t i = 1; i < mNumTransitions; i++) {
-        Transition& transition = mTransitions[i];
+      for (uint8_t i = 1; i < slot->numTransitions; i++) {
+        Transition& transition = slot->transitions[i];
         const int16_t year = transition.year;
 
         if (transition.rule.isNull()) {
@@ -827,7 +932,7 @@ class BasicZoneProcessorTemplate: public ZoneProcessor {
           // transition's offset to calculate the startDateTime of this
           // transition.
           //
-          // Also, when transition.rule == nullptr, the mNumTransitions should
+          // Also, when transition.rule == nullptr, the numTransitions should
           // be 1, since only a single transition is added by
           // addTransitionsForYear().
           const int16_t prevTotalOffsetMinutes = prevTransition->offsetMinutes
@@ -892,8 +997,9 @@ class BasicZoneProcessorTemplate: public ZoneProcessor {
         logging::printf("calcAbbreviations():\n");
       }
 
-      for (uint8_t i = 0; i < mNumTransitions; i++) {
-        Transition* transition = &mTransitions[i];
+      YearSlot* slot = mCurrentYearSlot;
+      for (uint8_t i = 0; i < slot->numTransitions; i++) {
+        Transition* transition = &slot->transitions[i];
         createAbbreviation(
             transition->abbrev,
             kAbbrevSize,
@@ -904,16 +1010,111 @@ class BasicZoneProcessorTemplate: public ZoneProcessor {
       }
     }
 
-    /** Search the cache and find closest Transition. */
+    /**
+     * Search the Transitions of the current year slot for the last one which
+     * starts at or before epochSeconds, using a binary search since they are
+     * sorted by startEpochSeconds. Return the first Transition if
+     * epochSeconds is earlier than all of them, and nullptr if there are no
+     * Transitions.
+     */
     const Transition* findMatch(acetime_t epochSeconds) const {
-      const Transition* closestMatch = nullptr;
-      for (uint8_t i = 0; i < mNumTransitions; i++) {
-        const Transition* m = &mTransitions[i];
-        if (closestMatch == nullptr || m->startEpochSeconds <= epochSeconds) {
-          closestMatch = m;
+      const YearSlot* slot = mCurrentYearSlot;
+      if (slot->numTransitions == 0) return nullptr;
+
+      // Find the number of Transitions whose start is <= epochSeconds.
+      uint8_t lo = 0;
+      uint8_t hi = slot->numTransitions;
+      while (lo < hi) {
+        uint8_t mid = (lo + hi) / 2;
+        if (slot->transitions[mid].startEpochSeconds <= epochSeconds) {
+          lo = mid + 1;
+        } else {
+          hi = mid;
+        }
+      }
+      return &slot->transitions[(lo > 0) ? lo - 1 : 0];
+    }
+
+    /** Return the year slot at index `i`, where 0 is the built-in slot. */
+    YearSlot* yearSlotAt(uint8_t i) const {
+      return (i == 0) ? &mYearSlot : &mExtraYearSlots[i - 1];
+    }
+
+    /** Invalidate all year slots, e.g. when the zone changes. */
+    void clearYearSlots() {
+      clearYearBounds();
+      for (uint8_t i = 0; i < getNumYearSlots(); i++) {
+        YearSlot* slot = yearSlotAt(i);
+        slot->year = LocalDate::kInvalidYear;
+        slot->startSeconds = 0;
+        slot->untilSeconds = 0;
+        slot->numTransitions = 0;
+      }
+      mCurrentYearSlot = &mYearSlot;
+    }
+
+    /** Return the slot which holds the given year, or nullptr. */
+    YearSlot* findYearSlot(int16_t year, int16_t epochYear) const {
+      // Check the most recently used slot first, it is the common case.
+      if (mCurrentYearSlot->year == year
+          && mCurrentYearSlot->epochYear == epochYear) {
+        return mCurrentYearSlot;
+      }
+      for (uint8_t i = 0; i < getNumYearSlots(); i++) {
+        YearSlot* slot = yearSlotAt(i);
+        if (slot->year == year && slot->epochYear == epochYear) return slot;
+      }
+      return nullptr;
+    }
+
+    /**
+     * Return the slot whose bounds contain the given epochSeconds, or
+     * nullptr. This avoids converting the epochSeconds into a year.
+     */
+    YearSlot* findYearSlotForEpochSeconds(acetime_t epochSeconds) const {
+      int16_t epochYear = Epoch::currentEpochYear();
+      for (uint8_t i = 0; i < getNumYearSlots(); i++) {
+        YearSlot* slot = yearSlotAt(i);
+        if (epochSeconds >= slot->startSeconds
+            && epochSeconds < slot->untilSeconds
+            && slot->epochYear == epochYear) {
+          return slot;
         }
       }
-      return closestMatch;
+      return nullptr;
+    }
+
+    /**
+     * Return an empty or stale slot if one exists, otherwise the least
+     * recently used slot.
+     */
+    YearSlot* findYearSlotToEvict(int16_t epochYear) const {
+      YearSlot* lruSlot = &mYearSlot;
+      uint16_t maxAge = 0;
+      for (uint8_t i = 0; i < getNumYearSlots(); i++) {
+        YearSlot* slot = yearSlotAt(i);
+        if (slot->year == LocalDate::kInvalidYear
+            || slot->epochYear != epochYear) {
+          return slot;
+        }
+        // Unsigned subtraction handles the wrap around of mYearSlotClock.
+        uint16_t age = mYearSlotClock - slot->lastUsed;
+        if (age >= maxAge) {
+          maxAge = age;
+          lruSlot = slot;
+        }
+      }
+      return lruSlot;
+    }
+
+    /** Make the given slot the current one, and update its LRU timestamp. */
+    void useYearSlot(YearSlot* slot) const {
+      slot->lastUsed = ++mYearSlotClock;
+      mCurrentYearSlot = slot;
+      mYear = slot->year;
+      mEpochYear = slot->epochYear;
+      mYearStartSeconds = slot->startSeconds;
+      mYearUntilSeconds = slot->untilSeconds;
     }
 
   private:
@@ -922,8 +1123,15 @@ class BasicZoneProcessorTemplate: public ZoneProcessor {
     const typename D::ZoneInfoStore* mZoneInfoStore; // nullable
     typename D::ZoneInfoBroker mZoneInfoBroker;
 
-    mutable uint8_t mNumTransitions = 0;
-    mutable Transition mTransitions[kMaxCacheEntries];
+    mutable YearSlot mYearSlot; // built-in year slot
+    YearSlot* mExtraYearSlots = nullptr; // optional, supplied by subclass
+    mutable YearSlot* mCurrentYearSlot = &mYearSlot; // most recently used
+    mutable uint16_t mYearSlotClock = 0; // LRU timestamp
+    uint8_t mNumExtraYearSlots = 0;
+
+  #if ACE_TIME_ZONE_STATS
+    mutable ZoneProcessorStats mStats;
+  #endif
 };
 
 /**
@@ -945,6 +1153,32 @@ class BasicZoneProcessor: public BasicZoneProcessorTemplate<basic::Info> {
     basic::Info::ZoneInfoStore mZoneInfoStore;
 };
 
+/**
+ * A BasicZoneProcessor which caches the transitions of up to NUM_YEARS
+ * different years, instead of only the most recent year. This is useful when
+ * the requested times alternate between a small number of years. The least
+ * recently used year is evicted when the cache is full. Each extra year costs
+ * a YearSlot of kMaxCacheEntries Transitions. See
+ * ExtendedZoneProcessorMultiYear for details.
+ *
+ * @tparam NUM_YEARS number of years cached, must be at least 2
+ */
+template <uint8_t NUM_YEARS>
+class BasicZoneProcessorMultiYear : public BasicZoneProcessor {
+  static_assert(NUM_YEARS >= 2, "NUM_YEARS must be >= 2");
+
+  public:
+    explicit BasicZoneProcessorMultiYear(
+        const basic::Info::ZoneInfo* zoneInfo = nullptr)
+      : BasicZoneProcessor(zoneInfo)
+    {
+      setExtraYearSlots(mExtraYearSlots, NUM_YEARS - 1);
+    }
+
+  private:
+    YearSlot mExtraYearSlots[NUM_YEARS - 1];
+};
+
 } // namespace ace_time
 
 #endif
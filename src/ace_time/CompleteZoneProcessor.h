@@ -33,6 +33,29 @@ class CompleteZoneProcessor: public
     complete::Info::ZoneInfoStore mZoneInfoStore;
 };
 
+/**
+ * A CompleteZoneProcessor which caches the transitions of up to NUM_YEARS
+ * different years, evicting the least recently used year when full. See
+ * ExtendedZoneProcessorMultiYear for details.
+ *
+ * @tparam NUM_YEARS number of years cached, must be at least 2
+ */
+template <uint8_t NUM_YEARS>
+class CompleteZoneProcessorMultiYear : public CompleteZoneProcessor {
+  static_assert(NUM_YEARS >= 2, "NUM_YEARS must be >= 2");
+
+  public:
+    explicit CompleteZoneProcessorMultiYear(
+        const complete::Info::ZoneInfo* zoneInfo = nullptr)
+      : CompleteZoneProcessor(zoneInfo)
+    {
+      setExtraYearSlots(mExtraYearSlots, NUM_YEARS - 1);
+    }
+
+  private:
+    YearSlot mExtraYearSlots[NUM_YEARS - 1];
+};
+
 }
 
 #endif
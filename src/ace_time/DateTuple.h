@@ -99,6 +99,27 @@ inline bool operator==(const DateTuple& a, const DateTuple& b) {
       && a.suffix == b.suffix;
 }
 
+/**
+ * Pack the components of a DateTuple into a 64-bit integer which sorts in the
+ * same order as operator<(), so that a DateTuple comparison becomes a single
+ * integer comparison. The suffix is ignored. The year occupies the top 16
+ * bits, followed by 4 bits of month, 5 bits of day, and 39 bits of seconds
+ * offset by 2^38, which holds any int32_t seconds (the seconds of a
+ * DateTuple may be negative or larger than 24 hours before normalization).
+ */
+inline int64_t packDateTuple(
+    int16_t year, uint8_t month, uint8_t day, int32_t seconds) {
+  return (int64_t) year * ((int64_t) 1 << 48)
+      + ((int64_t) month << 44)
+      + ((int64_t) day << 39)
+      + ((int64_t) seconds + ((int64_t) 1 << 38));
+}
+
+/** Pack the given DateTuple, ignoring the suffix. See packDateTuple(). */
+inline int64_t packDateTuple(const DateTuple& dt) {
+  return packDateTuple(dt.year, dt.month, dt.day, dt.seconds);
+}
+
 /**
  * Normalize DateTuple::seconds if abs(seconds) >= 24 hours. In other words,
  * we want `-24h < seconds < 24h`, and small negative seconds are allowed.
@@ -195,6 +216,17 @@ inline acetime_t subtractDateTuple(const DateTuple& a, const DateTuple& b) {
   return (epochDaysA - epochDaysB) * 86400 + a.seconds - b.seconds;
 }
 
+/**
+ * Return the number of seconds from the Unix epoch (1970-01-01 00:00:00) to
+ * the DateTuple, ignoring suffix. The calculation is performed using 64-bit
+ * integers, so it is valid for all years [1, 10000), regardless of the
+ * Epoch::currentEpochYear().
+ */
+inline int64_t dateTupleToUnixSeconds64(const DateTuple& dt) {
+  return LocalDate::forComponents(dt.year, dt.month, dt.day).toUnixSeconds64()
+      + dt.seconds;
+}
+
 /**
   * Determine the relationship of t to the time interval defined by `[start,
   * until)`. The comparison is fuzzy, with a slop of about one month so that
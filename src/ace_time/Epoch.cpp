@@ -2,9 +2,24 @@
 
 namespace ace_time {
 
-int16_t Epoch::sCurrentEpochYear = 2050;
+// Constant initialized, so that a thread-local instance needs no dynamic
+// initialization.
+ACE_TIME_EPOCH_STORAGE EpochContext Epoch::sCurrentContext(2050);
 
 // Number of days from 2000-01-01 to 2050-01-01: 50*365 + 13 leap days = 18263.
-int32_t Epoch::sDaysToCurrentEpochFromInternalEpoch = 18263;
+static_assert(EpochContext(2050).daysToEpochFromInternalEpoch() == 18263,
+    "EpochContext(2050)");
+static_assert(EpochContext(1970).daysToEpochFromUnixEpoch() == 0,
+    "EpochContext(1970)");
+static_assert(EpochContext(2000).daysToEpochFromUnixEpoch()
+    == ACE_TIME_EPOCH_CONVERTER::kDaysToInternalEpochFromUnixEpoch,
+    "EpochContext(2000)");
+
+static_assert(Epoch::daysToYearStartFromInternalEpoch(2050) == 18263,
+    "daysToYearStartFromInternalEpoch(2050)");
+static_assert(Epoch::daysToYearStartFromInternalEpoch(1970) == -10957,
+    "daysToYearStartFromInternalEpoch(1970)");
+static_assert(Epoch::daysToYearStartFromInternalEpoch(1) == -730119,
+    "daysToYearStartFromInternalEpoch(1)");
 
 }
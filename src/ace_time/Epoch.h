@@ -8,12 +8,32 @@
 
 #include <stdint.h>
 #include "EpochConverterHinnant.h"
+#include "EpochContext.h"
 
 /**
  * Select the epoch converter:  EpochConverterHinnant or EpochConverterJulian
  */
 #define ACE_TIME_EPOCH_CONVERTER EpochConverterHinnant
 
+/**
+ * Set to 1 to give each thread its own current epoch, so that threads can call
+ * `Epoch::currentEpochYear(year)` without affecting each other. The ZoneProcessors
+ * already key their caches on the epoch year, so a thread-local epoch is
+ * safe with thread-confined ZoneProcessors (e.g. ThreadLocalZoneProcessor).
+ * Requires a toolchain which supports `thread_local` (see
+ * ACE_TIME_HAS_THREAD_LOCAL). Disabled by default, because the epoch set by
+ * the main thread would not be seen by other threads.
+ */
+#ifndef ACE_TIME_EPOCH_THREAD_LOCAL
+  #define ACE_TIME_EPOCH_THREAD_LOCAL 0
+#endif
+
+#if ACE_TIME_EPOCH_THREAD_LOCAL
+  #define ACE_TIME_EPOCH_STORAGE thread_local
+#else
+  #define ACE_TIME_EPOCH_STORAGE
+#endif
+
 namespace ace_time {
 
 /**
@@ -25,13 +45,25 @@ class Epoch {
   public:
     /** Get the current epoch year. */
     static int16_t currentEpochYear() {
-      return sCurrentEpochYear;
+      return sCurrentContext.epochYear();
     }
 
     /** Set the current epoch year. */
     static void currentEpochYear(int16_t year) {
-      sCurrentEpochYear = year;
-      sDaysToCurrentEpochFromInternalEpoch = daysFromInternalEpoch(year);
+      sCurrentContext = EpochContext(year);
+    }
+
+    /**
+     * Return the current EpochContext, which can be saved and passed to the
+     * methods which accept an explicit EpochContext.
+     */
+    static const EpochContext& currentContext() {
+      return sCurrentContext;
+    }
+
+    /** Set the current epoch from an EpochContext. */
+    static void currentContext(const EpochContext& context) {
+      sCurrentContext = context;
     }
 
     /**
@@ -42,13 +74,36 @@ class Epoch {
       return ACE_TIME_EPOCH_CONVERTER::toEpochDays(year, 1, 1);
     }
 
+    /**
+     * Return the number of days from the internal epoch (2000-01-01) to
+     * {year}-01-01, for year >= 1. This is the same as daysFromInternalEpoch(),
+     * but uses a closed-form expression which is a constexpr, so that it is
+     * evaluated at compile time for a constant year. At runtime, it needs only
+     * divisions by constants, instead of the month and day arithmetic of the
+     * epoch converter.
+     */
+    static constexpr int32_t daysToYearStartFromInternalEpoch(int16_t year) {
+      return EpochContext::daysToYearStartFromInternalEpoch(year);
+    }
+
+    /**
+     * Return the epochSeconds of {year}-01-01T00:00:00 UTC relative to the
+     * current epoch, or INT32_MIN (LocalDate::kInvalidEpochSeconds) if it
+     * cannot be represented with a margin of one day on both sides. Used by
+     * the ZoneProcessors to find the year boundaries of an epochSeconds
+     * without a full date conversion.
+     */
+    static int32_t yearStartEpochSeconds(int16_t year) {
+      return sCurrentContext.yearStartEpochSeconds(year);
+    }
+
     /**
      * Number of days from the internal epoch (2000-01-01) to the current
      * epoch. This is an internal implementation that is public for testing
      * purposes.
      */
     static int32_t daysToCurrentEpochFromInternalEpoch() {
-      return sDaysToCurrentEpochFromInternalEpoch;
+      return sCurrentContext.daysToEpochFromInternalEpoch();
     }
 
     /**
@@ -56,8 +111,7 @@ class Epoch {
      * the current epoch.
      */
     static int32_t daysToCurrentEpochFromUnixEpoch() {
-      return ACE_TIME_EPOCH_CONVERTER::kDaysToInternalEpochFromUnixEpoch
-          + sDaysToCurrentEpochFromInternalEpoch;
+      return sCurrentContext.daysToEpochFromUnixEpoch();
     }
 
     /**
@@ -67,7 +121,7 @@ class Epoch {
      * 2038.
      */
     static int64_t secondsToCurrentEpochFromUnixEpoch64() {
-      return daysToCurrentEpochFromUnixEpoch() * (int64_t) 86400;
+      return sCurrentContext.secondsToEpochFromUnixEpoch64();
     }
 
     /**
@@ -87,7 +141,7 @@ class Epoch {
      * be verified to avoid underflow or overflow problems.
      */
     static int16_t epochValidYearLower() {
-      return currentEpochYear() - 50;
+      return sCurrentContext.validYearLower();
     }
 
     /**
@@ -107,15 +161,15 @@ class Epoch {
      * verified to avoid underflow or overflow problems.
      */
     static int16_t epochValidYearUpper() {
-      return currentEpochYear() + 50;
+      return sCurrentContext.validYearUpper();
     }
 
   private:
-    /** Base year `yyyy` of current epoch {yyyy}-01-01T00:00:00. */
-    static int16_t sCurrentEpochYear;
-
-    /** Number of days from kInternalEpochYear to sCurrentEpochYear. */
-    static int32_t sDaysToCurrentEpochFromInternalEpoch;
+    /**
+     * The current epoch, 2050-01-01T00:00:00 UTC by default. Thread-local if
+     * ACE_TIME_EPOCH_THREAD_LOCAL is enabled.
+     */
+    static ACE_TIME_EPOCH_STORAGE EpochContext sCurrentContext;
 };
 
 }
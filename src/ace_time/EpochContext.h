@@ -0,0 +1,121 @@
+/*
+ * MIT License
+ * Copyright (c) 2026 Brian T. Park
+ */
+
+#ifndef ACE_TIME_EPOCH_CONTEXT_H
+#define ACE_TIME_EPOCH_CONTEXT_H
+
+#include <stdint.h>
+
+namespace ace_time {
+
+/**
+ * An immutable description of an epoch {yyyy}-01-01T00:00:00 UTC, holding the
+ * epoch year and the precomputed number of days from the internal epoch
+ * (2000-01-01) of the epoch converters. The Epoch class holds the current
+ * EpochContext used by the methods which do not take an explicit one.
+ *
+ * The constructor is a constexpr, so an EpochContext can be a compile-time
+ * constant which is passed explicitly to the conversion methods of LocalDate,
+ * LocalDateTime, and OffsetDateTime (e.g.
+ * `LocalDateTime::toEpochSeconds(const EpochContext&)`). Those calls do not
+ * read the current epoch, so they are not affected by other components (or
+ * other threads) calling `Epoch::currentEpochYear(year)`, and the compiler
+ * can fold the epoch offsets into the calculation:
+ *
+ * @code
+ * static constexpr EpochContext kEpoch2100(2100);
+ *
+ * acetime_t epochSeconds = ldt.toEpochSeconds(kEpoch2100);
+ * @endcode
+ */
+class EpochContext {
+  public:
+    /**
+     * Constructor.
+     * @param epochYear base year of the epoch {yyyy}-01-01, must be >= 1
+     */
+    explicit constexpr EpochContext(int16_t epochYear = 2050) :
+        mEpochYear(epochYear),
+        mDaysToEpochFromInternalEpoch(
+            daysToYearStartFromInternalEpoch(epochYear))
+    {}
+
+    /** Return the epoch year. */
+    constexpr int16_t epochYear() const { return mEpochYear; }
+
+    /** Number of days from the internal epoch (2000-01-01) to this epoch. */
+    constexpr int32_t daysToEpochFromInternalEpoch() const {
+      return mDaysToEpochFromInternalEpoch;
+    }
+
+    /** Number of days from the Unix epoch (1970-01-01) to this epoch. */
+    constexpr int32_t daysToEpochFromUnixEpoch() const {
+      return mDaysToEpochFromInternalEpoch + kDaysToInternalEpochFromUnixEpoch;
+    }
+
+    /** Number of seconds from the Unix epoch (1970-01-01) to this epoch. */
+    constexpr int64_t secondsToEpochFromUnixEpoch64() const {
+      return daysToEpochFromUnixEpoch() * (int64_t) 86400;
+    }
+
+    /**
+     * Return the epochSeconds of {year}-01-01T00:00:00 UTC relative to this
+     * epoch, or INT32_MIN (LocalDate::kInvalidEpochSeconds) if it cannot be
+     * represented with a margin of one day on both sides.
+     */
+    constexpr int32_t yearStartEpochSeconds(int16_t year) const {
+      return isYearStartDaysValid(daysToYearStartFromInternalEpoch(year)
+              - mDaysToEpochFromInternalEpoch)
+          ? (daysToYearStartFromInternalEpoch(year)
+              - mDaysToEpochFromInternalEpoch) * (int32_t) 86400
+          : INT32_MIN;
+    }
+
+    /** See Epoch::epochValidYearLower(). */
+    constexpr int16_t validYearLower() const { return mEpochYear - 50; }
+
+    /** See Epoch::epochValidYearUpper(). */
+    constexpr int16_t validYearUpper() const { return mEpochYear + 50; }
+
+    /**
+     * Return the number of days from the internal epoch (2000-01-01) to
+     * {year}-01-01, for year >= 1, using a closed-form expression which is
+     * evaluated at compile time for a constant year.
+     */
+    static constexpr int32_t daysToYearStartFromInternalEpoch(int16_t year) {
+      return (int32_t) 365 * (year - 2000)
+          + leapDaysBefore(year) - leapDaysBefore(2000);
+    }
+
+  private:
+    /** Number of days from 1970-01-01 to 2000-01-01. */
+    static const int32_t kDaysToInternalEpochFromUnixEpoch = 10957;
+
+    /**
+     * Largest number of days from the epoch accepted by
+     * yearStartEpochSeconds(), so that 1 day can be added or subtracted from
+     * the result without overflowing 32 bits.
+     */
+    static const int32_t kMaxYearStartDays = INT32_MAX / 86400 - 1;
+
+    /** Number of leap days in the years [1, year) of the Gregorian calendar. */
+    static constexpr int32_t leapDaysBefore(int16_t year) {
+      return (year - 1) / 4 - (year - 1) / 100 + (year - 1) / 400;
+    }
+
+    static constexpr bool isYearStartDaysValid(int32_t days) {
+      return days >= -kMaxYearStartDays && days <= kMaxYearStartDays;
+    }
+
+    /** Base year `yyyy` of the epoch {yyyy}-01-01T00:00:00. */
+    int16_t mEpochYear;
+
+    /** Number of days from the internal epoch to mEpochYear. */
+    int32_t mDaysToEpochFromInternalEpoch;
+};
+
+}
+
+#endif
@@ -0,0 +1,264 @@
+/*
+ * MIT License
+ * Copyright (c) 2026 Brian T. Park
+ */
+
+#include <string.h> // memcpy()
+#include "EpochConverterHinnant.h"
+
+#if ACE_TIME_HAS_X86_SIMD
+  #include <immintrin.h>
+#endif
+
+namespace ace_time {
+
+// Offset from epochDays to the 'dayOfEpochPrime' which starts at 0000-03-01.
+static const int32_t kDaysToEpochPrime =
+    (EpochConverterHinnant::kInternalEpochYear / 400) * 146097 - 60;
+
+#if ACE_TIME_HAS_X86_SIMD
+
+// The SIMD kernels evaluate the same formulas as the scalar versions, 4 or 8
+// days at a time. The x86 has no vector integer division, so the divisions are
+// performed in single precision floating point. All operands are non-negative
+// and less than 2^22 for the years [1,9999], so the truncated quotient is
+// exact.
+
+#define ACE_TIME_TARGET_SSE41 __attribute__((target("sse4.1")))
+#define ACE_TIME_TARGET_AVX2 __attribute__((target("avx2")))
+
+ACE_TIME_TARGET_SSE41
+static inline __m128i div128(__m128i a, float d) {
+  return _mm_cvttps_epi32(_mm_div_ps(_mm_cvtepi32_ps(a), _mm_set1_ps(d)));
+}
+
+ACE_TIME_TARGET_SSE41
+static inline __m128i mul128(__m128i a, int32_t m) {
+  return _mm_mullo_epi32(a, _mm_set1_epi32(m));
+}
+
+ACE_TIME_TARGET_SSE41
+static size_t toEpochDaysSse41(
+    const int16_t* years, const uint8_t* months, const uint8_t* days,
+    size_t n, int32_t* epochDays) {
+
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    int32_t m4, d4;
+    memcpy(&m4, months + i, 4);
+    memcpy(&d4, days + i, 4);
+    __m128i y = _mm_cvtepi16_epi32(
+        _mm_loadl_epi64((const __m128i*) (years + i)));
+    __m128i m = _mm_cvtepu8_epi32(_mm_cvtsi32_si128(m4));
+    __m128i d = _mm_cvtepu8_epi32(_mm_cvtsi32_si128(d4));
+
+    __m128i isEarly = _mm_cmpgt_epi32(_mm_set1_epi32(3), m); // month <= 2
+    __m128i yearPrime = _mm_add_epi32(y, isEarly);
+    __m128i era = div128(yearPrime, 400);
+    __m128i yearOfEra = _mm_sub_epi32(yearPrime, mul128(era, 400));
+    __m128i monthPrime = _mm_add_epi32(_mm_sub_epi32(m, _mm_set1_epi32(3)),
+        _mm_and_si128(isEarly, _mm_set1_epi32(12)));
+    __m128i daysUntilMonthPrime = div128(
+        _mm_add_epi32(mul128(monthPrime, 153), _mm_set1_epi32(2)), 5);
+    __m128i dayOfYearPrime = _mm_add_epi32(daysUntilMonthPrime,
+        _mm_sub_epi32(d, _mm_set1_epi32(1)));
+    __m128i dayOfEra = _mm_add_epi32(
+        _mm_sub_epi32(
+            _mm_add_epi32(mul128(yearOfEra, 365), _mm_srli_epi32(yearOfEra, 2)),
+            div128(yearOfEra, 100)),
+        dayOfYearPrime);
+    __m128i result = _mm_add_epi32(
+        _mm_add_epi32(dayOfEra, mul128(era, 146097)),
+        _mm_set1_epi32(-kDaysToEpochPrime));
+    _mm_storeu_si128((__m128i*) (epochDays + i), result);
+  }
+  return i;
+}
+
+ACE_TIME_TARGET_SSE41
+static size_t fromEpochDaysSse41(const int32_t* epochDays, size_t n,
+    int16_t* years, uint8_t* months, uint8_t* days) {
+
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m128i dayOfEpochPrime = _mm_add_epi32(
+        _mm_loadu_si128((const __m128i*) (epochDays + i)),
+        _mm_set1_epi32(kDaysToEpochPrime));
+    __m128i era = div128(dayOfEpochPrime, 146097);
+    __m128i dayOfEra = _mm_sub_epi32(dayOfEpochPrime, mul128(era, 146097));
+    __m128i yearOfEra = div128(
+        _mm_sub_epi32(
+            _mm_add_epi32(
+                _mm_sub_epi32(dayOfEra, div128(dayOfEra, 1460)),
+                div128(dayOfEra, 36524)),
+            div128(dayOfEra, 146096)),
+        365);
+    __m128i yearPrime = _mm_add_epi32(yearOfEra, mul128(era, 400));
+    __m128i dayOfYearPrime = _mm_sub_epi32(dayOfEra,
+        _mm_sub_epi32(
+            _mm_add_epi32(mul128(yearOfEra, 365), _mm_srli_epi32(yearOfEra, 2)),
+            div128(yearOfEra, 100)));
+    __m128i monthPrime = div128(
+        _mm_add_epi32(mul128(dayOfYearPrime, 5), _mm_set1_epi32(2)), 153);
+    __m128i daysUntilMonthPrime = div128(
+        _mm_add_epi32(mul128(monthPrime, 153), _mm_set1_epi32(2)), 5);
+    __m128i d = _mm_add_epi32(
+        _mm_sub_epi32(dayOfYearPrime, daysUntilMonthPrime),
+        _mm_set1_epi32(1));
+    __m128i isLate = _mm_cmpgt_epi32(monthPrime, _mm_set1_epi32(9));
+    __m128i m = _mm_add_epi32(_mm_add_epi32(monthPrime, _mm_set1_epi32(3)),
+        _mm_and_si128(isLate, _mm_set1_epi32(-12)));
+    __m128i y = _mm_sub_epi32(yearPrime,
+        _mm_cmpgt_epi32(_mm_set1_epi32(3), m)); // month <= 2
+
+    // years: [y0..y3] as int16; months, days: [m0..m3, d0..d3] as uint8
+    _mm_storel_epi64((__m128i*) (years + i), _mm_packs_epi32(y, y));
+    __m128i md = _mm_packus_epi16(_mm_packs_epi32(m, d), _mm_setzero_si128());
+    int32_t m4 = _mm_cvtsi128_si32(md);
+    int32_t d4 = _mm_extract_epi32(md, 1);
+    memcpy(months + i, &m4, 4);
+    memcpy(days + i, &d4, 4);
+  }
+  return i;
+}
+
+ACE_TIME_TARGET_AVX2
+static inline __m256i div256(__m256i a, float d) {
+  return _mm256_cvttps_epi32(
+      _mm256_div_ps(_mm256_cvtepi32_ps(a), _mm256_set1_ps(d)));
+}
+
+ACE_TIME_TARGET_AVX2
+static inline __m256i mul256(__m256i a, int32_t m) {
+  return _mm256_mullo_epi32(a, _mm256_set1_epi32(m));
+}
+
+ACE_TIME_TARGET_AVX2
+static size_t toEpochDaysAvx2(
+    const int16_t* years, const uint8_t* months, const uint8_t* days,
+    size_t n, int32_t* epochDays) {
+
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m256i y = _mm256_cvtepi16_epi32(
+        _mm_loadu_si128((const __m128i*) (years + i)));
+    __m256i m = _mm256_cvtepu8_epi32(
+        _mm_loadl_epi64((const __m128i*) (months + i)));
+    __m256i d = _mm256_cvtepu8_epi32(
+        _mm_loadl_epi64((const __m128i*) (days + i)));
+
+    __m256i isEarly = _mm256_cmpgt_epi32(_mm256_set1_epi32(3), m);
+    __m256i yearPrime = _mm256_add_epi32(y, isEarly);
+    __m256i era = div256(yearPrime, 400);
+    __m256i yearOfEra = _mm256_sub_epi32(yearPrime, mul256(era, 400));
+    __m256i monthPrime = _mm256_add_epi32(
+        _mm256_sub_epi32(m, _mm256_set1_epi32(3)),
+        _mm256_and_si256(isEarly, _mm256_set1_epi32(12)));
+    __m256i daysUntilMonthPrime = div256(
+        _mm256_add_epi32(mul256(monthPrime, 153), _mm256_set1_epi32(2)), 5);
+    __m256i dayOfYearPrime = _mm256_add_epi32(daysUntilMonthPrime,
+        _mm256_sub_epi32(d, _mm256_set1_epi32(1)));
+    __m256i dayOfEra = _mm256_add_epi32(
+        _mm256_sub_epi32(
+            _mm256_add_epi32(
+                mul256(yearOfEra, 365), _mm256_srli_epi32(yearOfEra, 2)),
+            div256(yearOfEra, 100)),
+        dayOfYearPrime);
+    __m256i result = _mm256_add_epi32(
+        _mm256_add_epi32(dayOfEra, mul256(era, 146097)),
+        _mm256_set1_epi32(-kDaysToEpochPrime));
+    _mm256_storeu_si256((__m256i*) (epochDays + i), result);
+  }
+  return i;
+}
+
+ACE_TIME_TARGET_AVX2
+static size_t fromEpochDaysAvx2(const int32_t* epochDays, size_t n,
+    int16_t* years, uint8_t* months, uint8_t* days) {
+
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m256i dayOfEpochPrime = _mm256_add_epi32(
+        _mm256_loadu_si256((const __m256i*) (epochDays + i)),
+        _mm256_set1_epi32(kDaysToEpochPrime));
+    __m256i era = div256(dayOfEpochPrime, 146097);
+    __m256i dayOfEra = _mm256_sub_epi32(dayOfEpochPrime, mul256(era, 146097));
+    __m256i yearOfEra = div256(
+        _mm256_sub_epi32(
+            _mm256_add_epi32(
+                _mm256_sub_epi32(dayOfEra, div256(dayOfEra, 1460)),
+                div256(dayOfEra, 36524)),
+            div256(dayOfEra, 146096)),
+        365);
+    __m256i yearPrime = _mm256_add_epi32(yearOfEra, mul256(era, 400));
+    __m256i dayOfYearPrime = _mm256_sub_epi32(dayOfEra,
+        _mm256_sub_epi32(
+            _mm256_add_epi32(
+                mul256(yearOfEra, 365), _mm256_srli_epi32(yearOfEra, 2)),
+            div256(yearOfEra, 100)));
+    __m256i monthPrime = div256(
+        _mm256_add_epi32(mul256(dayOfYearPrime, 5), _mm256_set1_epi32(2)), 153);
+    __m256i daysUntilMonthPrime = div256(
+        _mm256_add_epi32(mul256(monthPrime, 153), _mm256_set1_epi32(2)), 5);
+    __m256i d = _mm256_add_epi32(
+        _mm256_sub_epi32(dayOfYearPrime, daysUntilMonthPrime),
+        _mm256_set1_epi32(1));
+    __m256i isLate = _mm256_cmpgt_epi32(monthPrime, _mm256_set1_epi32(9));
+    __m256i m = _mm256_add_epi32(
+        _mm256_add_epi32(monthPrime, _mm256_set1_epi32(3)),
+        _mm256_and_si256(isLate, _mm256_set1_epi32(-12)));
+    __m256i y = _mm256_sub_epi32(yearPrime,
+        _mm256_cmpgt_epi32(_mm256_set1_epi32(3), m));
+
+    // The packs operate within each 128-bit lane, so gather the low 64 bits
+    // of both lanes afterwards.
+    __m256i y16 = _mm256_permute4x64_epi64(_mm256_packs_epi32(y, y), 0x08);
+    _mm_storeu_si128((__m128i*) (years + i), _mm256_castsi256_si128(y16));
+    __m256i md = _mm256_packus_epi16(
+        _mm256_packs_epi32(m, d), _mm256_setzero_si256());
+    md = _mm256_permutevar8x32_epi32(md,
+        _mm256_setr_epi32(0, 4, 1, 5, 2, 3, 6, 7));
+    __m128i md128 = _mm256_castsi256_si128(md);
+    _mm_storel_epi64((__m128i*) (months + i), md128);
+    _mm_storel_epi64((__m128i*) (days + i), _mm_srli_si128(md128, 8));
+  }
+  return i;
+}
+
+#endif
+
+void EpochConverterHinnant::toEpochDaysBatch(
+    const int16_t* years, const uint8_t* months, const uint8_t* days,
+    size_t n, int32_t* epochDays) {
+
+  size_t i = 0;
+#if ACE_TIME_HAS_X86_SIMD
+  if (__builtin_cpu_supports("avx2")) {
+    i = toEpochDaysAvx2(years, months, days, n, epochDays);
+  } else if (__builtin_cpu_supports("sse4.1")) {
+    i = toEpochDaysSse41(years, months, days, n, epochDays);
+  }
+#endif
+  for (; i < n; i++) {
+    epochDays[i] = toEpochDays(years[i], months[i], days[i]);
+  }
+}
+
+void EpochConverterHinnant::fromEpochDaysBatch(
+    const int32_t* epochDays, size_t n,
+    int16_t* years, uint8_t* months, uint8_t* days) {
+
+  size_t i = 0;
+#if ACE_TIME_HAS_X86_SIMD
+  if (__builtin_cpu_supports("avx2")) {
+    i = fromEpochDaysAvx2(epochDays, n, years, months, days);
+  } else if (__builtin_cpu_supports("sse4.1")) {
+    i = fromEpochDaysSse41(epochDays, n, years, months, days);
+  }
+#endif
+  for (; i < n; i++) {
+    fromEpochDays(epochDays[i], years[i], months[i], days[i]);
+  }
+}
+
+}
@@ -7,6 +7,22 @@
 #define ACE_TIME_EPOCH_CONVERTER_HINNANT_H
 
 #include <stdint.h>
+#include <stddef.h> // size_t
+
+/**
+ * Set to 1 if the x86 SSE4.1 and AVX2 kernels of
+ * EpochConverterHinnant::fromEpochDaysBatch() and toEpochDaysBatch() are
+ * compiled. They are selected at runtime according to the CPU, so the rest of
+ * the program does not need to be compiled with `-mavx2`. Enabled by default
+ * for GCC and Clang on x86-64 (e.g. EpoxyDuino on Linux).
+ */
+#ifndef ACE_TIME_HAS_X86_SIMD
+  #if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+    #define ACE_TIME_HAS_X86_SIMD 1
+  #else
+    #define ACE_TIME_HAS_X86_SIMD 0
+  #endif
+#endif
 
 namespace ace_time {
 
@@ -92,6 +108,38 @@ class EpochConverterHinnant {
       year = yearPrime + ((month <= 2) ? 1 : 0); // [1,9999]
     }
 
+    /**
+     * Convert an array of (year, month, day), stored as 3 separate arrays, to
+     * an array of epoch days. Equivalent to calling toEpochDays() on each
+     * element, but uses SIMD instructions when ACE_TIME_HAS_X86_SIMD is
+     * enabled and the CPU supports them. The year is restricted to [1,9999].
+     *
+     * @param years array of years [1,9999]
+     * @param months array of months [1,12]
+     * @param days array of days of month [1,31]
+     * @param n number of elements
+     * @param epochDays output array of days from the internal epoch
+     */
+    static void toEpochDaysBatch(
+        const int16_t* years, const uint8_t* months, const uint8_t* days,
+        size_t n, int32_t* epochDays);
+
+    /**
+     * Convert an array of epoch days to (year, month, day), stored as 3
+     * separate arrays. Equivalent to calling fromEpochDays() on each element,
+     * but uses SIMD instructions when ACE_TIME_HAS_X86_SIMD is enabled and the
+     * CPU supports them. The epochDays must correspond to the years
+     * [1,9999].
+     *
+     * @param epochDays array of days from the internal epoch
+     * @param n number of elements
+     * @param years output array of years
+     * @param months output array of months
+     * @param days output array of days of month
+     */
+    static void fromEpochDaysBatch(const int32_t* epochDays, size_t n,
+        int16_t* years, uint8_t* months, uint8_t* days);
+
     /**
      * Return the number days before the given monthPrime.
      * This uses the original formula from Hinnant's paper.
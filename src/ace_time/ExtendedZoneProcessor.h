@@ -7,6 +7,7 @@
 #define ACE_TIME_EXTENDED_ZONE_PROCESSOR_H
 
 #include <stdint.h> // uintptr_t
+#include <string.h> // strcmp(), memcpy()
 #include <AceCommon.h> // copyReplaceString()
 #include "../zoneinfo/infos.h"
 #include "common/common.h" // kAbbrevSize
@@ -14,6 +15,7 @@
 #include "LocalDate.h"
 #include "ZoneProcessor.h"
 #include "Transition.h"
+#include "ZoneStats.h"
 
 #ifndef ACE_TIME_EXTENDED_ZONE_PROCESSOR_DEBUG
 #define ACE_TIME_EXTENDED_ZONE_PROCESSOR_DEBUG 0
@@ -35,6 +37,8 @@ class ExtendedZoneProcessorTest_compareTransitionToMatch;
 class ExtendedZoneProcessorTest_processTransitionCompareStatus;
 class ExtendedZoneProcessorTest_fixTransitionTimes_generateStartUntilTimes;
 class ExtendedZoneProcessorTest_setZoneKey;
+class ExtendedZoneProcessorTest_findNextTransition_yearCache;
+class ExtendedZoneProcessorTest_findNextTransition_multiYear;
 class ExtendedTransitionValidation;
 class CompleteTransitionValidation;
 
@@ -129,7 +133,7 @@ class ExtendedZoneProcessorTemplate: public ZoneProcessor {
 
       // Find the Transition(s) in the gap or overlap.
       TransitionForDateTime transitionForDateTime =
-          mTransitionStorage.findTransitionForDateTime(ldt);
+          mCurrentYearSlot->transitionStorage.findTransitionForDateTime(ldt);
 
       // Extract the target Transition, depending on the requested ldt.fold
       // and the result.num.
@@ -201,27 +205,235 @@ class ExtendedZoneProcessorTemplate: public ZoneProcessor {
      * no ambiguity when searching on epochSeconds so fold will always be 0.
      */
     FindResult findByEpochSeconds(acetime_t epochSeconds) const override {
+      // Fast path: inside the interval of the previous lookup.
+      if (epochSeconds >= mValidStartSeconds
+          && epochSeconds < mValidUntilSeconds
+          && mValidEpochYear == Epoch::currentEpochYear()) {
+      #if ACE_TIME_ZONE_STATS
+        mStats.validIntervalHits.increment();
+      #endif
+        return createValidFindResult();
+      }
+
       FindResult result;
       bool success = initForEpochSeconds(epochSeconds);
       if (!success) return result;
 
+      uint8_t index = 0;
       TransitionForSeconds transitionForSeconds =
-          mTransitionStorage.findTransitionForSeconds(epochSeconds);
-      const Transition* transition = transitionForSeconds.curr;
-      if (!transition) return result;
+          mCurrentYearSlot->transitionStorage.findTransitionForSecondsFrom(
+              epochSeconds, &index);
+      if (transitionForSeconds.num == 1) {
+        setValidInterval(index);
+      }
+      return createFindResult(transitionForSeconds);
+    }
 
-      result.stdOffsetSeconds = transition->offsetSeconds;
-      result.dstOffsetSeconds = transition->deltaSeconds;
-      result.reqStdOffsetSeconds = transition->offsetSeconds;
-      result.reqDstOffsetSeconds = transition->deltaSeconds;
-      result.abbrev = transition->abbrev;
-      result.fold = transitionForSeconds.fold;
-      if (transitionForSeconds.num == 2) {
-        result.type = FindResult::kTypeOverlap;
-      } else {
-        result.type = FindResult::kTypeExact;
+    /**
+     * @copydoc ZoneProcessor::findByUnixSeconds64()
+     *
+     * This implementation calculates the Transitions for the UTC year of
+     * unixSeconds, then compares unixSeconds against the 64-bit start times
+     * derived from the DateTuple of each Transition, instead of its 32-bit
+     * startEpochSeconds. It is valid for all years in [1, 9999], and does not
+     * use or update the cached interval of findByEpochSeconds().
+     */
+    FindResult findByUnixSeconds64(int64_t unixSeconds) const override {
+      FindResult result;
+      if (unixSeconds == LocalDate::kInvalidUnixSeconds64) return result;
+
+      LocalDate ld = LocalDate::forUnixSeconds64(unixSeconds);
+      bool success = initForYear(ld.year());
+      if (!success) return result;
+
+      TransitionForSeconds transitionForSeconds =
+          mCurrentYearSlot->transitionStorage.findTransitionForUnixSeconds64(
+              unixSeconds);
+      return createFindResult(transitionForSeconds);
+    }
+
+    /**
+     * @copydoc ZoneProcessor::findByEpochSecondsBatch()
+     *
+     * This implementation splits the elements into runs of the same year,
+     * and calls initForEpochSeconds() once at the start of each run. Within a
+     * run, the search for the matching Transition resumes from the Transition
+     * of the previous element, so sorted input is processed in a single
+     * forward walk over the Transitions. The position of the walk is kept
+     * across calls, so a caller which splits a long array into chunks (e.g.
+     * TimeZone::getOffsetDateTimeBatch()) does not restart the walk at each
+     * chunk.
+     */
+    void findByEpochSecondsBatch(
+        const acetime_t* epochSeconds,
+        FindResult* results,
+        size_t num) const override {
+      // The [start, until) interval of the year of the current transitions.
+      // Starts empty to force the first initForEpochSeconds().
+      acetime_t startSeconds = 0;
+      acetime_t untilSeconds = 0;
+      // Any index is safe: findTransitionForSecondsFrom() restarts from the
+      // first Transition if the index is past the requested epochSeconds.
+      uint8_t index = mBatchIndex;
+
+      for (size_t i = 0; i < num; i++) {
+        acetime_t seconds = epochSeconds[i];
+        if (seconds < startSeconds || seconds >= untilSeconds) {
+          if (! initForEpochSeconds(seconds)) {
+            results[i] = FindResult();
+            continue;
+          }
+          startSeconds = mYearStartSeconds;
+          untilSeconds = mYearUntilSeconds;
+        }
+
+        TransitionForSeconds transitionForSeconds =
+            mCurrentYearSlot->transitionStorage.findTransitionForSecondsFrom(
+                seconds, &index);
+        results[i] = createFindResult(transitionForSeconds);
       }
-      return result;
+      mBatchIndex = index;
+    }
+
+    /**
+     * @copydoc ZoneProcessor::findNextTransition()
+     *
+     * This implementation scans the active Transitions of each year, starting
+     * with the UTC year of epochSeconds, skipping the Transitions which do not
+     * change the offsets or the abbreviation (e.g. the start of a ZoneEra with
+     * the same offsets). The scan is limited to the years in which the ZoneEra
+     * and ZoneRule records can produce a change, which are calculated once per
+     * zone, so a zone without DST does not scan through every remaining year.
+     *
+     * Each year is loaded through initForYear(), so a cached year is reused,
+     * and a missing year replaces the least recently used YearSlot, instead of
+     * using a temporary YearSlot on the stack which is too large for small
+     * microcontrollers. The single YearSlot of the ExtendedZoneProcessor
+     * therefore ends up holding the last year scanned. An
+     * ExtendedZoneProcessorMultiYear keeps its other years.
+     */
+    ZoneTransition findNextTransition(acetime_t epochSeconds) const override {
+      if (epochSeconds == LocalDate::kInvalidEpochSeconds
+          || epochSeconds == LocalDate::kMaxEpochSeconds) {
+        return ZoneTransition();
+      }
+
+      // Start with the year of the earliest possible transition, so that
+      // a search from the last second of a year skips that year.
+      int16_t startYear;
+      int16_t endYear;
+      getEpochChangeYears(startYear, endYear);
+      int16_t year = yearOfEpochSeconds(epochSeconds + 1);
+      if (year < startYear) year = startYear;
+
+      for (; year <= endYear; year++) {
+        YearSlot* slot = initYearSlot(year);
+        if (! slot) break;
+
+        // Transitions after the end of the year are handled by the next year.
+        acetime_t untilSeconds = Epoch::yearStartEpochSeconds(year + 1);
+        const Transition* const* begin =
+            slot->transitionStorage.getActivePoolBegin();
+        const Transition* const* end =
+            slot->transitionStorage.getActivePoolEnd();
+        for (const Transition* const* iter = begin + 1; iter < end; iter++) {
+          const Transition* curr = *iter;
+          if (curr->startEpochSeconds <= epochSeconds) continue;
+          if (curr->startEpochSeconds >= untilSeconds) break;
+          const Transition* prev = *(iter - 1);
+          if (isChange(prev, curr)) return createZoneTransition(prev, curr);
+        }
+      }
+      return ZoneTransition();
+    }
+
+    /**
+     * @copydoc ZoneProcessor::findPrevTransition()
+     *
+     * This implementation scans the years backwards. See
+     * findNextTransition().
+     */
+    ZoneTransition findPrevTransition(acetime_t epochSeconds) const override {
+      if (epochSeconds == LocalDate::kInvalidEpochSeconds) {
+        return ZoneTransition();
+      }
+
+      int16_t startYear;
+      int16_t endYear;
+      getEpochChangeYears(startYear, endYear);
+      int16_t year = yearOfEpochSeconds(epochSeconds);
+      if (year > endYear) year = endYear;
+
+      for (; year >= startYear; year--) {
+        YearSlot* slot = initYearSlot(year);
+        if (! slot) break;
+
+        // Transitions before the start of the year are handled by the
+        // previous year.
+        acetime_t startSeconds = Epoch::yearStartEpochSeconds(year);
+        const Transition* const* begin =
+            slot->transitionStorage.getActivePoolBegin();
+        const Transition* const* end =
+            slot->transitionStorage.getActivePoolEnd();
+        for (const Transition* const* iter = end - 1; iter > begin; iter--) {
+          const Transition* curr = *iter;
+          if (curr->startEpochSeconds > epochSeconds) continue;
+          if (curr->startEpochSeconds < startSeconds) break;
+          const Transition* prev = *(iter - 1);
+          if (isChange(prev, curr)) return createZoneTransition(prev, curr);
+        }
+      }
+      return ZoneTransition();
+    }
+
+    /**
+     * @copydoc ZoneProcessor::findTransitionsForYear()
+     *
+     * This implementation supports every year in [1, 9999], comparing the
+     * 64-bit Transition::startUnixSeconds64(), so the years outside of the
+     * current epoch can be iterated. The year is loaded by initForYear(), so
+     * it is calculated at most once per call, into the least recently used
+     * YearSlot if it is not cached. The years which cannot contain a change
+     * return 0 without any calculation.
+     */
+    uint8_t findTransitionsForYear(
+        int16_t year,
+        int64_t afterUnixSeconds,
+        ZoneTransition* transitions,
+        uint8_t size) const override {
+      int16_t startYear;
+      int16_t endYear;
+      getChangeYears(startYear, endYear);
+      if (year < startYear || year > endYear) return 0;
+
+      YearSlot* slot = initYearSlot(year);
+      if (! slot) return 0;
+
+      // Transitions outside of the year are handled by the adjacent years.
+      int64_t startSeconds =
+          LocalDate::forComponents(year, 1, 1).toUnixSeconds64();
+      int64_t untilSeconds =
+          LocalDate::forComponents(year + 1, 1, 1).toUnixSeconds64();
+      if (afterUnixSeconds >= startSeconds) startSeconds = afterUnixSeconds + 1;
+
+      uint8_t numTransitions = 0;
+      const Transition* const* begin =
+          slot->transitionStorage.getActivePoolBegin();
+      const Transition* const* end =
+          slot->transitionStorage.getActivePoolEnd();
+      for (const Transition* const* iter = begin + 1;
+          iter < end && numTransitions < size;
+          iter++) {
+        const Transition* curr = *iter;
+        int64_t currSeconds = curr->startUnixSeconds64();
+        if (currSeconds < startSeconds) continue;
+        if (currSeconds >= untilSeconds) break;
+        const Transition* prev = *(iter - 1);
+        if (isChange(prev, curr)) {
+          transitions[numTransitions++] = createZoneTransition(prev, curr);
+        }
+      }
+      return numTransitions;
     }
 
     void printNameTo(Print& printer) const override {
@@ -240,37 +452,71 @@ class ExtendedZoneProcessorTemplate: public ZoneProcessor {
 
     /** Used only for debugging. */
     void log() const {
-      if (ACE_TIME_EXTENDED_ZONE_PROCESSOR_DEBUG) {
-        logging::printf("ExtendedZoneProcessor:\n");
-        logging::printf("  mEpochYear: %d\n", mEpochYear);
-        logging::printf("  mYear: %d\n", mYear);
-        logging::printf("  mNumMatches: %d\n", mNumMatches);
-        for (int i = 0; i < mNumMatches; i++) {
-          logging::printf("  Match %d: ", i);
-          mMatches[i].log();
-          logging::printf("\n");
-        }
-        mTransitionStorage.log();
-      }
+      logYearSlot(mCurrentYearSlot);
     }
 
     /** Reset the TransitionStorage high water mark. For debugging. */
     void resetTransitionAllocSize() {
-      mTransitionStorage.resetAllocSize();
+      for (uint8_t i = 0; i < getNumYearSlots(); i++) {
+        yearSlotAt(i)->transitionStorage.resetAllocSize();
+      }
     }
 
-    /** Get the largest allocation size of TransitionStorage. For debugging. */
+    /**
+     * Get the largest allocation size of TransitionStorage over all year
+     * slots. For debugging.
+     */
     uint8_t getTransitionAllocSize() const {
-      return mTransitionStorage.getAllocSize();
+      uint8_t allocSize = 0;
+      for (uint8_t i = 0; i < getNumYearSlots(); i++) {
+        uint8_t size = yearSlotAt(i)->transitionStorage.getAllocSize();
+        if (size > allocSize) allocSize = size;
+      }
+      return allocSize;
+    }
+
+    /**
+     * Return the beginning of the active Transitions calculated by the most
+     * recent call to initForYear(). Intended for classes which post-process
+     * the Transitions, such as FlatZoneProcessorTemplate.
+     */
+    const Transition* const* getActiveTransitionsBegin() const {
+      return mCurrentYearSlot->transitionStorage.getActivePoolBegin();
+    }
+
+    /** Return the end of the active Transitions. */
+    const Transition* const* getActiveTransitionsEnd() const {
+      return mCurrentYearSlot->transitionStorage.getActivePoolEnd();
+    }
+
+    /**
+     * Number of years whose transitions can be cached at the same time. This
+     * is 1 for the plain processor, and larger for a subclass which supplies
+     * additional year slots (e.g. ExtendedZoneProcessorMultiYear).
+     */
+    uint8_t getNumYearSlots() const {
+      return 1 + mNumExtraYearSlots;
     }
 
+  #if ACE_TIME_ZONE_STATS
+    /**
+     * Return the hot path statistics, which can be read without a lock while
+     * another thread uses this ZoneProcessor. Available only if
+     * ACE_TIME_ZONE_STATS is enabled.
+     */
+    const ZoneProcessorStats& getStats() const { return mStats; }
+
+    /** Reset the hot path statistics to 0. */
+    void resetStats() { mStats.reset(); }
+  #endif
+
     void setZoneKey(uintptr_t zoneKey) override {
       if (! mZoneInfoStore) return;
       if (mZoneInfoBroker.equals(zoneKey)) return;
 
       mZoneInfoBroker = mZoneInfoStore->createZoneInfoBroker(zoneKey);
       mYear = LocalDate::kInvalidYear;
-      mNumMatches = 0;
+      clearYearSlots();
       resetTransitionAllocSize(); // clear the alloc size for new zone
     }
 
@@ -289,11 +535,19 @@ class ExtendedZoneProcessorTemplate: public ZoneProcessor {
     }
 
     /**
-     * Initialize using the epochSeconds.  The epochSeconds is converted to
-     * the LocalDate for UTC time, and the year is used to call initForYear().
-     * Exposed for debugging.
+     * Initialize using the epochSeconds. If the epochSeconds is within the
+     * year of the current year slot, this is a comparison against the bounds
+     * of that year. Otherwise, the epochSeconds is converted to the LocalDate
+     * for UTC time, and the year is used to call initForYear(). Exposed for
+     * debugging.
      */
     bool initForEpochSeconds(acetime_t epochSeconds) const {
+      if (isFilledForEpochSeconds(epochSeconds)) {
+      #if ACE_TIME_ZONE_STATS
+        mStats.yearCacheHits.increment();
+      #endif
+        return true;
+      }
       LocalDate ld = LocalDate::forEpochSeconds(epochSeconds);
       return initForYear(ld.year());
     }
@@ -315,58 +569,36 @@ class ExtendedZoneProcessorTemplate: public ZoneProcessor {
         return false;
       }
 
-      if (isFilled(year)) return true;
-      if (ACE_TIME_EXTENDED_ZONE_PROCESSOR_DEBUG) {
-        logging::printf("initForYear(): %d\n", year);
-      }
-      mYear = year;
-      mEpochYear = Epoch::currentEpochYear();
-      mNumMatches = 0; // clear cache
-      mTransitionStorage.init();
-
-      // Fill transitions over a 14-month window straddling the given year.
-      extended::YearMonthTuple startYm = { (int16_t) (year - 1), 12 };
-      extended::YearMonthTuple untilYm =  { (int16_t) (year + 1), 2 };
-
-      // Step 1. The equivalent steps for the Python version are in the
-      // acetimepy project, under zone_processor.ZoneProcessor.init_for_year().
-      if (ACE_TIME_EXTENDED_ZONE_PROCESSOR_DEBUG) {
-        logging::printf("==== Step 1: findMatches()\n");
-      }
-      mNumMatches = findMatches(mZoneInfoBroker, startYm, untilYm, mMatches,
-          kMaxMatches);
-      if (ACE_TIME_EXTENDED_ZONE_PROCESSOR_DEBUG) { log(); }
-
-      // Step 2
-      if (ACE_TIME_EXTENDED_ZONE_PROCESSOR_DEBUG) {
-        logging::printf("==== Step 2: createTransitions()\n");
-      }
-      createTransitions(mTransitionStorage, mMatches, mNumMatches);
-      if (ACE_TIME_EXTENDED_ZONE_PROCESSOR_DEBUG) { log(); }
-
-      // Step 3
-      if (ACE_TIME_EXTENDED_ZONE_PROCESSOR_DEBUG) {
-        logging::printf("==== Step 3: fixTransitionTimes()\n");
-      }
-      Transition** begin = mTransitionStorage.getActivePoolBegin();
-      Transition** end = mTransitionStorage.getActivePoolEnd();
-      fixTransitionTimes(begin, end);
-      if (ACE_TIME_EXTENDED_ZONE_PROCESSOR_DEBUG) { log(); }
-
-      // Step 4
-      if (ACE_TIME_EXTENDED_ZONE_PROCESSOR_DEBUG) {
-        logging::printf("==== Step 4: generateStartUntilTimes()\n");
+      int16_t epochYear = Epoch::currentEpochYear();
+      YearSlot* slot = findYearSlot(year, epochYear);
+      if (slot) {
+      #if ACE_TIME_ZONE_STATS
+        mStats.yearCacheHits.increment();
+      #endif
+        useYearSlot(slot);
+        return true;
       }
-      generateStartUntilTimes(begin, end);
-      if (ACE_TIME_EXTENDED_ZONE_PROCESSOR_DEBUG) { log(); }
 
-      // Step 5
       if (ACE_TIME_EXTENDED_ZONE_PROCESSOR_DEBUG) {
-        logging::printf("==== Step 5: calcAbbreviations()\n");
+        logging::printf("initForYear(): %d\n", year);
       }
-      calcAbbreviations(begin, end);
-      if (ACE_TIME_EXTENDED_ZONE_PROCESSOR_DEBUG) { log(); }
-
+      slot = findYearSlotToEvict(epochYear);
+    #if ACE_TIME_ZONE_STATS
+      uint32_t startMicros = micros();
+      mStats.rebuilds.increment();
+      if (slot->year != LocalDate::kInvalidYear) mStats.evictions.increment();
+    #endif
+      fillYearSlot(slot, year, epochYear);
+      useYearSlot(slot);
+
+    #if ACE_TIME_ZONE_STATS
+      Transition** begin = slot->transitionStorage.getActivePoolBegin();
+      Transition** end = slot->transitionStorage.getActivePoolEnd();
+      mStats.transitionsGenerated.add((uint32_t) (end - begin));
+      mStats.transitionsHighWater.recordMax(
+          slot->transitionStorage.getAllocSize());
+      mStats.rebuildMicros.record(micros() - startMicros);
+    #endif
       return true;
     }
 
@@ -410,6 +642,8 @@ class ExtendedZoneProcessorTemplate: public ZoneProcessor {
     friend class ::ExtendedZoneProcessorTest_processTransitionCompareStatus;
     friend class ::ExtendedZoneProcessorTest_fixTransitionTimes_generateStartUntilTimes;
     friend class ::ExtendedZoneProcessorTest_setZoneKey;
+    friend class ::ExtendedZoneProcessorTest_findNextTransition_yearCache;
+    friend class ::ExtendedZoneProcessorTest_findNextTransition_multiYear;
     friend class ::ExtendedTransitionValidation;
     friend class ::CompleteTransitionValidation;
 
@@ -431,11 +665,258 @@ class ExtendedZoneProcessorTemplate: public ZoneProcessor {
      */
     static const uint8_t kMaxInteriorYears = 4;
 
+  protected:
+    /**
+     * The MatchingEras and Transitions calculated by initForYear() for a
+     * single year. The processor always contains one YearSlot. A subclass can
+     * supply additional slots using setExtraYearSlots() so that multiple years
+     * can be cached at the same time.
+     */
+    struct YearSlot {
+      /** Year of the cached transitions, kInvalidYear if empty. */
+      int16_t year = LocalDate::kInvalidYear;
+
+      /** Epoch::currentEpochYear() when the transitions were calculated. */
+      int16_t epochYear = LocalDate::kInvalidYear;
+
+      /** Value of mYearSlotClock when this slot was last used. */
+      uint16_t lastUsed = 0;
+
+      /** Actual number of matches. */
+      uint8_t numMatches = 0;
+
+      MatchingEra matches[kMaxMatches];
+      TransitionStorage transitionStorage;
+    };
+
+    /**
+     * Add `numSlots` additional year slots, pointed to by `slots`, to the one
+     * built into this object. The `slots` array must live as long as this
+     * processor. Intended to be called from the constructor of a subclass.
+     */
+    void setExtraYearSlots(YearSlot* slots, uint8_t numSlots) {
+      mExtraYearSlots = slots;
+      mNumExtraYearSlots = numSlots;
+      clearYearSlots();
+    }
+
+  private:
     bool equals(const ZoneProcessor& other) const override {
       return mZoneInfoBroker.equals(
           ((const ExtendedZoneProcessorTemplate&) other).mZoneInfoBroker);
     }
 
+    /** Convert the TransitionForSeconds into a FindResult. */
+    static FindResult createFindResult(
+        const TransitionForSeconds& transitionForSeconds) {
+      FindResult result;
+      const Transition* transition = transitionForSeconds.curr;
+      if (!transition) return result;
+
+      result.stdOffsetSeconds = transition->offsetSeconds;
+      result.dstOffsetSeconds = transition->deltaSeconds;
+      result.reqStdOffsetSeconds = transition->offsetSeconds;
+      result.reqDstOffsetSeconds = transition->deltaSeconds;
+      result.abbrev = transition->abbrev;
+      result.fold = transitionForSeconds.fold;
+      if (transitionForSeconds.num == 2) {
+        result.type = FindResult::kTypeOverlap;
+      } else {
+        result.type = FindResult::kTypeExact;
+      }
+      return result;
+    }
+
+    /** Return true if 'curr' changes the offsets or abbreviation of 'prev'. */
+    static bool isChange(const Transition* prev, const Transition* curr) {
+      return prev->offsetSeconds != curr->offsetSeconds
+          || prev->deltaSeconds != curr->deltaSeconds
+          || strcmp(prev->abbrev, curr->abbrev) != 0;
+    }
+
+    /**
+     * Calculate the MatchingEras and Transitions of the given year into the
+     * slot, without making it the current slot.
+     */
+    void fillYearSlot(YearSlot* slot, int16_t year, int16_t epochYear) const {
+      slot->year = year;
+      slot->epochYear = epochYear;
+      slot->numMatches = 0; // clear cache
+      slot->transitionStorage.init();
+
+      // Fill transitions over a 14-month window straddling the given year.
+      extended::YearMonthTuple startYm = { (int16_t) (year - 1), 12 };
+      extended::YearMonthTuple untilYm =  { (int16_t) (year + 1), 2 };
+
+      // Step 1. The equivalent steps for the Python version are in the
+      // acetimepy project, under zone_processor.ZoneProcessor.init_for_year().
+      if (ACE_TIME_EXTENDED_ZONE_PROCESSOR_DEBUG) {
+        logging::printf("==== Step 1: findMatches()\n");
+      }
+      slot->numMatches = findMatches(mZoneInfoBroker, startYm, untilYm,
+          slot->matches, kMaxMatches);
+      if (ACE_TIME_EXTENDED_ZONE_PROCESSOR_DEBUG) { logYearSlot(slot); }
+
+      // Step 2
+      if (ACE_TIME_EXTENDED_ZONE_PROCESSOR_DEBUG) {
+        logging::printf("==== Step 2: createTransitions()\n");
+      }
+      createTransitions(slot->transitionStorage, slot->matches,
+          slot->numMatches);
+      if (ACE_TIME_EXTENDED_ZONE_PROCESSOR_DEBUG) { logYearSlot(slot); }
+
+      // Step 3
+      if (ACE_TIME_EXTENDED_ZONE_PROCESSOR_DEBUG) {
+        logging::printf("==== Step 3: fixTransitionTimes()\n");
+      }
+      Transition** begin = slot->transitionStorage.getActivePoolBegin();
+      Transition** end = slot->transitionStorage.getActivePoolEnd();
+      fixTransitionTimes(begin, end);
+      if (ACE_TIME_EXTENDED_ZONE_PROCESSOR_DEBUG) { logYearSlot(slot); }
+
+      // Step 4
+      if (ACE_TIME_EXTENDED_ZONE_PROCESSOR_DEBUG) {
+        logging::printf("==== Step 4: generateStartUntilTimes()\n");
+      }
+      generateStartUntilTimes(begin, end);
+      slot->transitionStorage.compactActivePool();
+      if (ACE_TIME_EXTENDED_ZONE_PROCESSOR_DEBUG) { logYearSlot(slot); }
+
+      // Step 5
+      if (ACE_TIME_EXTENDED_ZONE_PROCESSOR_DEBUG) {
+        logging::printf("==== Step 5: calcAbbreviations()\n");
+      }
+      calcAbbreviations(begin, end);
+      if (ACE_TIME_EXTENDED_ZONE_PROCESSOR_DEBUG) { logYearSlot(slot); }
+    }
+
+    /**
+     * Make the given year the current one using initForYear(), and return its
+     * slot. Returns nullptr if the year is outside of [1, 9999].
+     */
+    YearSlot* initYearSlot(int16_t year) const {
+      if (! initForYear(year)) return nullptr;
+      return mCurrentYearSlot;
+    }
+
+    /**
+     * Return the years which can contain a change, calculated once per zone
+     * by calcChangeYears(). The range is empty (startYear > endYear) if the
+     * zone never changes.
+     */
+    void getChangeYears(int16_t& startYear, int16_t& endYear) const {
+      if (mChangeStartYear == LocalDate::kInvalidYear) {
+        calcChangeYears(mChangeStartYear, mChangeEndYear);
+      }
+      startYear = mChangeStartYear;
+      endYear = mChangeEndYear;
+    }
+
+    /**
+     * Return the years of getChangeYears(), clamped to the years supported by
+     * the current epoch.
+     */
+    void getEpochChangeYears(int16_t& startYear, int16_t& endYear) const {
+      getChangeYears(startYear, endYear);
+      int16_t validLower = Epoch::epochValidYearLower();
+      int16_t validUpper = Epoch::epochValidYearUpper() - 1;
+      if (startYear < validLower) startYear = validLower;
+      if (endYear > validUpper) endYear = validUpper;
+    }
+
+    /**
+     * Return the UTC year of epochSeconds, using the bounds of the current
+     * slot to avoid the conversion to a LocalDate if possible.
+     */
+    int16_t yearOfEpochSeconds(acetime_t epochSeconds) const {
+      if (isFilledForEpochSeconds(epochSeconds)) return mYear;
+      return LocalDate::forEpochSeconds(epochSeconds).year();
+    }
+
+    /** Log the given year slot. Used only for debugging. */
+    void logYearSlot(const YearSlot* slot) const {
+      if (ACE_TIME_EXTENDED_ZONE_PROCESSOR_DEBUG) {
+        logging::printf("ExtendedZoneProcessor:\n");
+        logging::printf("  mEpochYear: %d\n", slot->epochYear);
+        logging::printf("  mYear: %d\n", slot->year);
+        logging::printf("  numMatches: %d\n", slot->numMatches);
+        for (int i = 0; i < slot->numMatches; i++) {
+          logging::printf("  Match %d: ", i);
+          slot->matches[i].log();
+          logging::printf("\n");
+        }
+        slot->transitionStorage.log();
+      }
+    }
+
+    /** Create the ZoneTransition from 'prev' to 'curr'. */
+    static ZoneTransition createZoneTransition(
+        const Transition* prev, const Transition* curr) {
+      ZoneTransition transition;
+      transition.unixSeconds = curr->startUnixSeconds64();
+      // startEpochSeconds is clamped for the years outside of the epoch.
+      transition.epochSeconds = (
+          curr->startEpochSeconds > LocalDate::kMinEpochSeconds
+          && curr->startEpochSeconds < LocalDate::kMaxEpochSeconds)
+          ? curr->startEpochSeconds
+          : LocalDate::kInvalidEpochSeconds;
+      transition.stdOffsetSecondsBefore = prev->offsetSeconds;
+      transition.dstOffsetSecondsBefore = prev->deltaSeconds;
+      transition.stdOffsetSecondsAfter = curr->offsetSeconds;
+      transition.dstOffsetSecondsAfter = curr->deltaSeconds;
+      memcpy(transition.abbrevBefore, prev->abbrev, kAbbrevSize);
+      memcpy(transition.abbrevAfter, curr->abbrev, kAbbrevSize);
+      return transition;
+    }
+
+    /**
+     * Calculate the years [startYear, endYear] which can contain a change of
+     * the offsets or abbreviation, using the UNTIL years of the ZoneEras, and
+     * the FROM and TO years of the ZoneRules clipped to their ZoneEra. The
+     * range is widened by one year on each side because a transition near
+     * the end of a year in local time can occur in the adjacent year in UTC,
+     * then clamped to [1, 9999]. The range is empty (startYear > endYear) if
+     * the zone never changes. The result depends only on the zone, so it is
+     * cached by getEpochChangeYears().
+     */
+    void calcChangeYears(int16_t& startYear, int16_t& endYear) const {
+      int16_t lower = LocalDate::kMaxYear;
+      int16_t upper = LocalDate::kMinYear;
+      int16_t eraStartYear = LocalDate::kMinYear;
+      uint8_t numEras = mZoneInfoBroker.numEras();
+      for (uint8_t i = 0; i < numEras; i++) {
+        const typename D::ZoneEraBroker era = mZoneInfoBroker.era(i);
+        int16_t eraUntilYear = LocalDate::kMaxYear;
+        if (i + 1 < numEras) {
+          eraUntilYear = era.untilYear();
+          if (eraUntilYear < lower) lower = eraUntilYear;
+          if (eraUntilYear > upper) upper = eraUntilYear;
+        }
+
+        const typename D::ZonePolicyBroker policy = era.zonePolicy();
+        if (policy.isNull()) continue;
+        uint8_t numRules = policy.numRules();
+        for (uint8_t j = 0; j < numRules; j++) {
+          const typename D::ZoneRuleBroker rule = policy.rule(j);
+          int16_t fromYear = rule.fromYear();
+          int16_t toYear = rule.toYear();
+          if (fromYear < eraStartYear) fromYear = eraStartYear;
+          if (toYear > eraUntilYear) toYear = eraUntilYear;
+          if (fromYear > toYear) continue;
+          if (fromYear < lower) lower = fromYear;
+          if (toYear > upper) upper = toYear;
+        }
+        eraStartYear = eraUntilYear;
+      }
+
+      // Clamp to the years supported by initForYear(), which also prevents
+      // an overflow of the "max" year of a ZoneRule.
+      int16_t minYear = LocalDate::kMinYear + 1;
+      int16_t maxYear = LocalDate::kMaxYear - 1;
+      startYear = (lower <= minYear) ? minYear : lower - 1;
+      endYear = (upper >= maxYear) ? maxYear : upper + 1;
+    }
+
     /**
      * Find the ZoneEras which overlap [startYm, untilYm), ignoring day, time
      * and timeSuffix. The start and until fields of the ZoneEra are
@@ -1081,6 +1562,9 @@ class ExtendedZoneProcessorTemplate: public ZoneProcessor {
         const extended::DateTuple& tt = t->transitionTime;
         if (isAfterFirst) {
           prev->untilDateTime = tt;
+        #if ACE_TIME_TRANSITION_SEARCH_KEYS
+          prev->packedUntilDateTime = extended::packDateTuple(tt);
+        #endif
         }
 
         // 2) Calculate the current startDateTime by shifting the
@@ -1091,6 +1575,9 @@ class ExtendedZoneProcessorTemplate: public ZoneProcessor {
             + t->offsetSeconds + t->deltaSeconds);
         t->startDateTime = {tt.year, tt.month, tt.day, seconds, tt.suffix};
         extended::normalizeDateTuple(&t->startDateTime);
+      #if ACE_TIME_TRANSITION_SEARCH_KEYS
+        t->packedStartDateTime = extended::packDateTuple(t->startDateTime);
+      #endif
 
         // 3) The epochSecond of the 'transitionTime' is determined by the
         // UTC offset of the *previous* Transition. However, the
@@ -1102,11 +1589,27 @@ class ExtendedZoneProcessorTemplate: public ZoneProcessor {
         // 'transitionTimeU' which should still be a valid field, because it
         // hasn't been clobbered by 'untilDateTime' yet. Not sure if this saves
         // any CPU time though, since we still need to mutiply by 900.
+        //
+        // The calculation is done in 64-bits, because findByUnixSeconds64()
+        // generates Transitions for years which are out of range of the
+        // 32-bit startEpochSeconds.
         const extended::DateTuple& st = t->startDateTime;
-        const acetime_t offsetSeconds =
+        const int32_t offsetSeconds =
             st.seconds - (t->offsetSeconds + t->deltaSeconds);
         LocalDate ld = LocalDate::forComponents(st.year, st.month, st.day);
-        t->startEpochSeconds = ld.toEpochSeconds() + offsetSeconds;
+        int64_t epochSeconds64 = (int64_t) 86400 * ld.toEpochDays()
+            + offsetSeconds;
+        if (epochSeconds64 < LocalDate::kMinEpochSeconds) {
+          t->startEpochSeconds = LocalDate::kMinEpochSeconds;
+        } else if (epochSeconds64 > LocalDate::kMaxEpochSeconds) {
+          t->startEpochSeconds = LocalDate::kMaxEpochSeconds;
+        } else {
+          t->startEpochSeconds = (acetime_t) epochSeconds64;
+        }
+      #if ACE_TIME_TRANSITION_SEARCH_KEYS
+        t->startUnixSeconds = epochSeconds64
+            + Epoch::secondsToCurrentEpochFromUnixEpoch64();
+      #endif
 
         prev = t;
         isAfterFirst = true;
@@ -1124,6 +1627,9 @@ class ExtendedZoneProcessorTemplate: public ZoneProcessor {
           &untilTimeS,
           &untilTimeU);
       prev->untilDateTime = untilTimeW;
+    #if ACE_TIME_TRANSITION_SEARCH_KEYS
+      prev->packedUntilDateTime = extended::packDateTuple(untilTimeW);
+    #endif
     }
 
     /**
@@ -1152,13 +1658,150 @@ class ExtendedZoneProcessorTemplate: public ZoneProcessor {
     }
 
   private:
+    /** Return the year slot at index `i`, where 0 is the built-in slot. */
+    YearSlot* yearSlotAt(uint8_t i) const {
+      return (i == 0) ? &mYearSlot : &mExtraYearSlots[i - 1];
+    }
+
+    /**
+     * Remember the interval of epochSeconds which maps to the Transition at
+     * `index` of the active pool with no overlap, so that findByEpochSeconds()
+     * can return the same result without a search. The interval excludes the
+     * overlap shadows of the adjacent Transitions, and is restricted to the
+     * current year whose Transitions are known to be accurate.
+     */
+    void setValidInterval(uint8_t index) const {
+      const Transition* const* begin = getActiveTransitionsBegin();
+      const Transition* const* end = getActiveTransitionsEnd();
+      const Transition* curr = begin[index];
+      const Transition* prev = (index > 0) ? begin[index - 1] : nullptr;
+      const Transition* next = (begin + index + 1 < end)
+          ? begin[index + 1] : nullptr;
+
+      acetime_t startSeconds = mYearStartSeconds;
+      acetime_t untilSeconds = mYearUntilSeconds;
+      if (prev) {
+        acetime_t shiftSeconds = extended::subtractDateTuple(
+            curr->startDateTime, prev->untilDateTime);
+        acetime_t seconds = curr->startEpochSeconds
+            + (shiftSeconds < 0 ? -shiftSeconds : 0);
+        if (seconds > startSeconds) startSeconds = seconds;
+      }
+      if (next) {
+        acetime_t shiftSeconds = extended::subtractDateTuple(
+            next->startDateTime, curr->untilDateTime);
+        acetime_t seconds = next->startEpochSeconds
+            + (shiftSeconds < 0 ? shiftSeconds : 0);
+        if (seconds < untilSeconds) untilSeconds = seconds;
+      }
+
+      mValidStartSeconds = startSeconds;
+      mValidUntilSeconds = untilSeconds;
+      mValidEpochYear = mEpochYear;
+      mValidStdOffsetSeconds = curr->offsetSeconds;
+      mValidDstOffsetSeconds = curr->deltaSeconds;
+      memcpy(mValidAbbrev, curr->abbrev, kAbbrevSize);
+    }
+
+    /** Create the FindResult of the interval set by setValidInterval(). */
+    FindResult createValidFindResult() const {
+      FindResult result;
+      result.type = FindResult::kTypeExact;
+      result.stdOffsetSeconds = mValidStdOffsetSeconds;
+      result.dstOffsetSeconds = mValidDstOffsetSeconds;
+      result.reqStdOffsetSeconds = mValidStdOffsetSeconds;
+      result.reqDstOffsetSeconds = mValidDstOffsetSeconds;
+      result.abbrev = mValidAbbrev;
+      return result;
+    }
+
+    /** Invalidate all year slots, e.g. when the zone changes. */
+    void clearYearSlots() {
+      clearYearBounds();
+      mValidStartSeconds = 0;
+      mValidUntilSeconds = 0;
+      for (uint8_t i = 0; i < getNumYearSlots(); i++) {
+        YearSlot* slot = yearSlotAt(i);
+        slot->year = LocalDate::kInvalidYear;
+        slot->numMatches = 0;
+      }
+      mCurrentYearSlot = &mYearSlot;
+      mChangeStartYear = LocalDate::kInvalidYear;
+    }
+
+    /** Return the slot which holds the given year, or nullptr. */
+    YearSlot* findYearSlot(int16_t year, int16_t epochYear) const {
+      // Check the most recently used slot first, it is the common case.
+      if (mCurrentYearSlot->year == year
+          && mCurrentYearSlot->epochYear == epochYear) {
+        return mCurrentYearSlot;
+      }
+      for (uint8_t i = 0; i < getNumYearSlots(); i++) {
+        YearSlot* slot = yearSlotAt(i);
+        if (slot->year == year && slot->epochYear == epochYear) return slot;
+      }
+      return nullptr;
+    }
+
+    /**
+     * Return an empty or stale slot if one exists, otherwise the least
+     * recently used slot.
+     */
+    YearSlot* findYearSlotToEvict(int16_t epochYear) const {
+      YearSlot* lruSlot = &mYearSlot;
+      uint16_t maxAge = 0;
+      for (uint8_t i = 0; i < getNumYearSlots(); i++) {
+        YearSlot* slot = yearSlotAt(i);
+        if (slot->year == LocalDate::kInvalidYear
+            || slot->epochYear != epochYear) {
+          return slot;
+        }
+        // Unsigned subtraction handles the wrap around of mYearSlotClock.
+        uint16_t age = mYearSlotClock - slot->lastUsed;
+        if (age >= maxAge) {
+          maxAge = age;
+          lruSlot = slot;
+        }
+      }
+      return lruSlot;
+    }
+
+    /** Make the given slot the current one, and update its LRU timestamp. */
+    void useYearSlot(YearSlot* slot) const {
+      slot->lastUsed = ++mYearSlotClock;
+      mCurrentYearSlot = slot;
+      mYear = slot->year;
+      mEpochYear = slot->epochYear;
+      setYearBounds();
+    }
+
     const typename D::ZoneInfoStore* mZoneInfoStore; // nullable
     typename D::ZoneInfoBroker mZoneInfoBroker;
 
-    // NOTE: Maybe move mNumMatches and mMatches into a MatchStorage object.
-    mutable uint8_t mNumMatches = 0; // actual number of matches
-    mutable MatchingEra mMatches[kMaxMatches];
-    mutable TransitionStorage mTransitionStorage;
+    mutable YearSlot mYearSlot; // built-in year slot
+    YearSlot* mExtraYearSlots = nullptr; // optional, supplied by subclass
+    uint8_t mNumExtraYearSlots = 0;
+    mutable YearSlot* mCurrentYearSlot = &mYearSlot; // most recently used
+    mutable uint16_t mYearSlotClock = 0; // LRU timestamp
+    // Transition where the last findByEpochSecondsBatch() stopped.
+    mutable uint8_t mBatchIndex = 0;
+    // Years which can contain a change, see calcChangeYears(). Computed on
+    // first use, kInvalidYear until then.
+    mutable int16_t mChangeStartYear = LocalDate::kInvalidYear;
+    mutable int16_t mChangeEndYear = LocalDate::kInvalidYear;
+
+    // Interval [mValidStartSeconds, mValidUntilSeconds) of the most recent
+    // exact match of findByEpochSeconds(), empty if the two are equal.
+    mutable acetime_t mValidStartSeconds = 0;
+    mutable acetime_t mValidUntilSeconds = 0;
+    mutable int32_t mValidStdOffsetSeconds = 0;
+    mutable int32_t mValidDstOffsetSeconds = 0;
+    mutable int16_t mValidEpochYear = LocalDate::kInvalidYear;
+    mutable char mValidAbbrev[kAbbrevSize];
+
+  #if ACE_TIME_ZONE_STATS
+    mutable ZoneProcessorStats mStats;
+  #endif
 };
 
 /**
@@ -1183,6 +1826,36 @@ class ExtendedZoneProcessor :
     extended::Info::ZoneInfoStore mZoneInfoStore;
 };
 
+/**
+ * An ExtendedZoneProcessor which caches the transitions of up to NUM_YEARS
+ * different years, instead of only the most recent year. This is useful when
+ * the requested times alternate between a small number of years, for example
+ * when processing timestamps which straddle Dec 31. The least recently used
+ * year is evicted when the cache is full. The cost is about 500 bytes of
+ * additional RAM per extra year on a 32-bit processor.
+ *
+ * Enable ACE_TIME_ZONE_STATS and compare the `yearCacheHits` and `rebuilds`
+ * of getStats() to determine the size of the year window needed by the
+ * application.
+ *
+ * @tparam NUM_YEARS number of years cached, must be at least 2
+ */
+template <uint8_t NUM_YEARS>
+class ExtendedZoneProcessorMultiYear : public ExtendedZoneProcessor {
+  static_assert(NUM_YEARS >= 2, "NUM_YEARS must be >= 2");
+
+  public:
+    explicit ExtendedZoneProcessorMultiYear(
+        const extended::Info::ZoneInfo* zoneInfo = nullptr)
+      : ExtendedZoneProcessor(zoneInfo)
+    {
+      setExtraYearSlots(mExtraYearSlots, NUM_YEARS - 1);
+    }
+
+  private:
+    YearSlot mExtraYearSlots[NUM_YEARS - 1];
+};
+
 } // namespace ace_time
 
 #endif
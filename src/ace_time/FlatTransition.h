@@ -0,0 +1,388 @@
+/*
+ * MIT License
+ * Copyright (c) 2026 Brian T. Park
+ */
+
+#ifndef ACE_TIME_FLAT_TRANSITION_H
+#define ACE_TIME_FLAT_TRANSITION_H
+
+#include <stdint.h> // uint8_t, uint16_t
+#include <string.h> // strncmp(), memcpy(), memset()
+#include "common/common.h" // acetime_t, kAbbrevSize
+#include "LocalDate.h"
+#include "LocalDateTime.h"
+#include "ZoneProcessor.h" // FindResult, ZoneTransition
+
+namespace ace_time {
+namespace flat {
+
+/**
+ * A single entry in the flattened transition table of a zone. The entry is
+ * valid from startEpochSeconds until the startEpochSeconds of the next entry.
+ */
+struct FlatTransition {
+  /** The epochSeconds when this transition starts. */
+  acetime_t startEpochSeconds;
+
+  /** STD offset in seconds. */
+  int32_t stdOffsetSeconds;
+
+  /** DST offset in seconds. */
+  int32_t dstOffsetSeconds;
+
+  /** Index into the abbreviation table of the zone. */
+  uint8_t abbrevIndex;
+};
+
+/**
+ * A read-only view of the flattened transitions of a single zone, sorted by
+ * startEpochSeconds, and its abbreviations. The lookups are binary searches
+ * over the transitions. Used by FlatZoneProcessorTemplate, which owns the
+ * arrays of a single zone, and by PrecomputedZoneTable, which stores the
+ * arrays of all zones in a single buffer.
+ */
+struct FlatTable {
+  /** Returned by findIndexForSeconds() if there is no matching entry. */
+  static const uint16_t kInvalidIndex = 0xFFFF;
+
+  /** Upper bound of the absolute value of the total UTC offset. */
+  static const int32_t kMaxOffsetSeconds = 24 * 60 * 60;
+
+  /** The transitions, sorted by startEpochSeconds. */
+  const FlatTransition* transitions;
+
+  /** The abbreviations referenced by FlatTransition::abbrevIndex. */
+  const char (*abbrevs)[kAbbrevSize];
+
+  /** The epochSeconds where the last transition ends. */
+  acetime_t untilEpochSeconds;
+
+  /** Number of transitions. */
+  uint16_t numTransitions;
+
+  /**
+   * Return the index of the last transition whose startEpochSeconds is less
+   * than or equal to epochSeconds, or kInvalidIndex if epochSeconds is
+   * before the first transition.
+   */
+  uint16_t findIndexForSeconds(acetime_t epochSeconds) const {
+    uint16_t lo = 0;
+    uint16_t hi = numTransitions;
+    while (lo < hi) {
+      uint16_t mid = lo + (hi - lo) / 2;
+      if (transitions[mid].startEpochSeconds <= epochSeconds) {
+        lo = mid + 1;
+      } else {
+        hi = mid;
+      }
+    }
+    return lo - 1; // wraps to kInvalidIndex if lo == 0
+  }
+
+  /** Return the epochSeconds where transition i ends. */
+  acetime_t untilEpochSecondsAt(uint16_t i) const {
+    return (i + 1 < numTransitions)
+        ? transitions[i + 1].startEpochSeconds
+        : untilEpochSeconds;
+  }
+
+  /** Return the abbreviation of the given transition. */
+  const char* abbrevOf(const FlatTransition& t) const {
+    return abbrevs[t.abbrevIndex];
+  }
+
+  /**
+   * Find the transition of the local date time. The fold parameter is
+   * handled the same way as ExtendedZoneProcessor::findByLocalDateTime().
+   */
+  FindResult findByLocalDateTime(const LocalDateTime& ldt) const {
+    FindResult result;
+
+    // Treat the ldt as if it were UTC to get the "local" seconds.
+    acetime_t localSeconds = ldt.toEpochSeconds();
+    if (localSeconds == LocalDate::kInvalidEpochSeconds) return result;
+
+    // UTC offsets are less than a day, so only the transitions which start
+    // within a day of localSeconds need to be examined.
+    acetime_t searchSeconds = (localSeconds < INT32_MIN + kMaxOffsetSeconds)
+        ? INT32_MIN
+        : localSeconds - kMaxOffsetSeconds;
+    uint16_t i = findIndexForSeconds(searchSeconds);
+    if (i == kInvalidIndex) i = 0;
+
+    // Find the transitions whose local interval contains the localSeconds.
+    const FlatTransition* prev = nullptr;
+    const FlatTransition* curr = nullptr;
+    const FlatTransition* matches[2] = {nullptr, nullptr};
+    uint8_t num = 0;
+    for (; i < numTransitions; i++) {
+      const FlatTransition* t = &transitions[i];
+      int32_t offsetSeconds = t->stdOffsetSeconds + t->dstOffsetSeconds;
+      acetime_t localStart = t->startEpochSeconds + offsetSeconds;
+      acetime_t localUntil = untilEpochSecondsAt(i) + offsetSeconds;
+      if (localSeconds < localStart) {
+        curr = t;
+        break;
+      }
+      if (localSeconds < localUntil) {
+        if (num < 2) matches[num] = t;
+        num++;
+      } else {
+        prev = t;
+      }
+    }
+
+    const FlatTransition* transition;
+    if (num == 1) {
+      transition = matches[0];
+      result.type = FindResult::kTypeExact;
+      result.reqStdOffsetSeconds = transition->stdOffsetSeconds;
+      result.reqDstOffsetSeconds = transition->dstOffsetSeconds;
+    } else if (num == 2) {
+      transition = (ldt.fold() == 0) ? matches[0] : matches[1];
+      result.type = FindResult::kTypeOverlap;
+      result.reqStdOffsetSeconds = transition->stdOffsetSeconds;
+      result.reqDstOffsetSeconds = transition->dstOffsetSeconds;
+      result.fold = ldt.fold();
+    } else if (prev == nullptr || curr == nullptr) {
+      // ldt is outside the year range of the table
+      return result;
+    } else {
+      // Gap, see ExtendedZoneProcessorTemplate::findByLocalDateTime().
+      result.type = FindResult::kTypeGap;
+      const FlatTransition* req = (ldt.fold() == 0) ? prev : curr;
+      transition = (ldt.fold() == 0) ? curr : prev;
+      result.reqStdOffsetSeconds = req->stdOffsetSeconds;
+      result.reqDstOffsetSeconds = req->dstOffsetSeconds;
+    }
+
+    result.stdOffsetSeconds = transition->stdOffsetSeconds;
+    result.dstOffsetSeconds = transition->dstOffsetSeconds;
+    result.abbrev = abbrevOf(*transition);
+    return result;
+  }
+
+  /**
+   * Find the transition at the epochSeconds. The fold parameter is
+   * calculated the same way as ExtendedZoneProcessor::findByEpochSeconds().
+   */
+  FindResult findByEpochSeconds(acetime_t epochSeconds) const {
+    FindResult result;
+    if (epochSeconds >= untilEpochSeconds) return result;
+
+    uint16_t i = findIndexForSeconds(epochSeconds);
+    if (i == kInvalidIndex) return result;
+
+    const FlatTransition* curr = &transitions[i];
+    int32_t currOffset = curr->stdOffsetSeconds + curr->dstOffsetSeconds;
+    result.type = FindResult::kTypeExact;
+
+    // Check if within the overlap shadow of the previous transition.
+    if (i > 0) {
+      const FlatTransition* prev = &transitions[i - 1];
+      int32_t shiftSeconds = currOffset
+          - (prev->stdOffsetSeconds + prev->dstOffsetSeconds);
+      if (shiftSeconds < 0
+          && secondsBetween(curr->startEpochSeconds, epochSeconds)
+              < (uint32_t) -shiftSeconds) {
+        result.type = FindResult::kTypeOverlap;
+        result.fold = 1;
+      }
+    }
+
+    // Check if within the overlap shadow of the next transition.
+    if (result.type == FindResult::kTypeExact && i + 1 < numTransitions) {
+      const FlatTransition* next = &transitions[i + 1];
+      int32_t shiftSeconds = (next->stdOffsetSeconds + next->dstOffsetSeconds)
+          - currOffset;
+      if (shiftSeconds < 0
+          && secondsBetween(epochSeconds, next->startEpochSeconds)
+              <= (uint32_t) -shiftSeconds) {
+        result.type = FindResult::kTypeOverlap;
+      }
+    }
+
+    result.stdOffsetSeconds = curr->stdOffsetSeconds;
+    result.dstOffsetSeconds = curr->dstOffsetSeconds;
+    result.reqStdOffsetSeconds = curr->stdOffsetSeconds;
+    result.reqDstOffsetSeconds = curr->dstOffsetSeconds;
+    result.abbrev = abbrevOf(*curr);
+    return result;
+  }
+
+  /**
+   * Find the first transition after epochSeconds. The first entry is the
+   * start of the table, not a transition, so it is never returned.
+   */
+  ZoneTransition findNextTransition(acetime_t epochSeconds) const {
+    uint16_t i = findIndexForSeconds(epochSeconds);
+    uint16_t next = (i == kInvalidIndex) ? 1 : i + 1;
+    if (next >= numTransitions) return ZoneTransition();
+    return createZoneTransition(next);
+  }
+
+  /** Find the last transition at or before epochSeconds. */
+  ZoneTransition findPrevTransition(acetime_t epochSeconds) const {
+    if (epochSeconds >= untilEpochSeconds) return ZoneTransition();
+
+    uint16_t i = findIndexForSeconds(epochSeconds);
+    if (i == kInvalidIndex || i == 0) return ZoneTransition();
+    return createZoneTransition(i);
+  }
+
+  /** Create the ZoneTransition into entry i (i > 0) of the table. */
+  ZoneTransition createZoneTransition(uint16_t i) const {
+    const FlatTransition* prev = &transitions[i - 1];
+    const FlatTransition* curr = &transitions[i];
+    ZoneTransition transition;
+    transition.unixSeconds = curr->startEpochSeconds
+        + Epoch::secondsToCurrentEpochFromUnixEpoch64();
+    transition.epochSeconds = curr->startEpochSeconds;
+    transition.stdOffsetSecondsBefore = prev->stdOffsetSeconds;
+    transition.dstOffsetSecondsBefore = prev->dstOffsetSeconds;
+    transition.stdOffsetSecondsAfter = curr->stdOffsetSeconds;
+    transition.dstOffsetSecondsAfter = curr->dstOffsetSeconds;
+    memcpy(transition.abbrevBefore, abbrevOf(*prev), kAbbrevSize);
+    memcpy(transition.abbrevAfter, abbrevOf(*curr), kAbbrevSize);
+    return transition;
+  }
+
+  /**
+   * Return the number of seconds from `from` until `to` (to >= from), which
+   * can exceed INT32_MAX when the two are far apart.
+   */
+  static uint32_t secondsBetween(acetime_t from, acetime_t to) {
+    return (uint32_t) to - (uint32_t) from;
+  }
+};
+
+/**
+ * Appends transitions to the arrays of a FlatTable under construction,
+ * merging each transition into the previous one if the offsets and the
+ * abbreviation are unchanged. The caller owns the arrays, and must provide
+ * room for maxTransitions and maxAbbrevs entries.
+ */
+struct FlatTableBuilder {
+  /** The transitions of the zone. */
+  FlatTransition* transitions;
+
+  /** The abbreviations of the zone. */
+  char (*abbrevs)[kAbbrevSize];
+
+  /** Number of transitions added so far. */
+  uint16_t numTransitions;
+
+  /** Capacity of the transitions array. */
+  uint16_t maxTransitions;
+
+  /** Number of unique abbreviations added so far. */
+  uint8_t numAbbrevs;
+
+  /** Capacity of the abbrevs array. */
+  uint8_t maxAbbrevs;
+
+  /**
+   * Append a transition, merging it into the previous entry if the offsets
+   * and abbreviation are unchanged. Returns false if the arrays are full.
+   */
+  bool addTransition(
+      acetime_t startEpochSeconds,
+      int32_t stdOffsetSeconds,
+      int32_t dstOffsetSeconds,
+      const char* abbrev) {
+
+    uint8_t abbrevIndex = findAbbrev(abbrev);
+    if (abbrevIndex == numAbbrevs) {
+      if (numAbbrevs >= maxAbbrevs) return false;
+      // Bounded copy, always NUL terminated. The unused bytes are cleared so
+      // that a table saved to a file is reproducible.
+      char* dest = abbrevs[numAbbrevs];
+      memset(dest, 0, kAbbrevSize);
+      for (uint8_t n = 0; n < kAbbrevSize - 1 && abbrev[n] != '\0'; n++) {
+        dest[n] = abbrev[n];
+      }
+      numAbbrevs++;
+    }
+
+    if (numTransitions > 0) {
+      const FlatTransition& last = transitions[numTransitions - 1];
+      if (last.stdOffsetSeconds == stdOffsetSeconds
+          && last.dstOffsetSeconds == dstOffsetSeconds
+          && last.abbrevIndex == abbrevIndex) {
+        return true;
+      }
+    }
+
+    if (numTransitions >= maxTransitions) return false;
+    FlatTransition& t = transitions[numTransitions];
+    memset(&t, 0, sizeof(t)); // clear the padding
+    t.startEpochSeconds = startEpochSeconds;
+    t.stdOffsetSeconds = stdOffsetSeconds;
+    t.dstOffsetSeconds = dstOffsetSeconds;
+    t.abbrevIndex = abbrevIndex;
+    numTransitions++;
+    return true;
+  }
+
+  /** Return the index of abbrev, or numAbbrevs if not found. */
+  uint8_t findAbbrev(const char* abbrev) const {
+    uint8_t i = 0;
+    for (; i < numAbbrevs; i++) {
+      if (strncmp(abbrevs[i], abbrev, kAbbrevSize - 1) == 0) break;
+    }
+    return i;
+  }
+};
+
+/**
+ * Calculate the transitions of the zone of the zoneProcessor over the years
+ * [startYear, untilYear), and append them to the builder. Each
+ * ZP::initForYear() returns the transitions over a 14-month window, so
+ * consecutive windows overlap. Only the transitions which are later than the
+ * previous one are kept, and the builder merges those which change nothing.
+ *
+ * Returns the epochSeconds where the transitions end: untilEpochSeconds, or
+ * the start of the first transition which did not fit into the builder.
+ *
+ * @tparam ZP ExtendedZoneProcessor or CompleteZoneProcessor
+ * @tparam B FlatTableBuilder, or a class which provides the same
+ *    addTransition() method
+ */
+template <typename ZP, typename B>
+acetime_t addTransitionsForYears(
+    const ZP& zoneProcessor,
+    int16_t startYear,
+    int16_t untilYear,
+    acetime_t untilEpochSeconds,
+    B& builder) {
+
+  bool hasLast = false;
+  acetime_t lastStartEpochSeconds = 0;
+  for (int16_t year = startYear; year < untilYear; year++) {
+    if (! zoneProcessor.initForYear(year)) break;
+
+    const typename ZP::Transition* const* end =
+        zoneProcessor.getActiveTransitionsEnd();
+    for (const typename ZP::Transition* const* iter =
+          zoneProcessor.getActiveTransitionsBegin();
+        iter != end;
+        ++iter) {
+      const typename ZP::Transition* t = *iter;
+      if (t->startEpochSeconds >= untilEpochSeconds) break;
+      if (hasLast && t->startEpochSeconds <= lastStartEpochSeconds) continue;
+      if (! builder.addTransition(t->startEpochSeconds, t->offsetSeconds,
+          t->deltaSeconds, t->abbrev)) {
+        // Builder full, truncate the year range.
+        return t->startEpochSeconds;
+      }
+      hasLast = true;
+      lastStartEpochSeconds = t->startEpochSeconds;
+    }
+  }
+  return untilEpochSeconds;
+}
+
+} // namespace flat
+} // namespace ace_time
+
+#endif
@@ -0,0 +1,323 @@
+/*
+ * MIT License
+ * Copyright (c) 2026 Brian T. Park
+ */
+
+#ifndef ACE_TIME_FLAT_ZONE_PROCESSOR_H
+#define ACE_TIME_FLAT_ZONE_PROCESSOR_H
+
+#include <stdint.h> // uintptr_t
+#include "common/common.h" // kAbbrevSize
+#include "common/logging.h"
+#include "Epoch.h"
+#include "LocalDate.h"
+#include "LocalDateTime.h"
+#include "ZoneProcessor.h"
+#include "ExtendedZoneProcessor.h"
+#include "CompleteZoneProcessor.h"
+#include "FlatTransition.h"
+
+#ifndef ACE_TIME_FLAT_ZONE_PROCESSOR_DEBUG
+#define ACE_TIME_FLAT_ZONE_PROCESSOR_DEBUG 0
+#endif
+
+class FlatZoneProcessorTest_initTransitions;
+class FlatZoneProcessorTest_findByEpochSeconds;
+class FlatZoneProcessorTest_findNextTransition;
+
+class Print;
+
+namespace ace_time {
+
+/**
+ * A ZoneProcessor which runs the ExtendedZoneProcessor (or
+ * CompleteZoneProcessor) once over a range of years, then stores the
+ * resulting transitions as a single sorted array of FlatTransition entries.
+ * The findByEpochSeconds() method becomes a binary search over that array,
+ * with no per-year recalculation of the transitions. This trades RAM for
+ * speed, so it is intended for machines with plenty of memory (e.g. ESP32 or
+ * Linux), not for 8-bit processors.
+ *
+ * The table is calculated lazily on the first lookup after the zone is
+ * changed through setZoneKey(), or after the current epoch year is changed.
+ * By default, the year range is [Epoch::epochValidYearLower(),
+ * Epoch::epochValidYearUpper()). Requests outside of the year range return
+ * FindResult::kTypeNotFound.
+ *
+ * If the zone has more transitions (or abbreviations) than can fit into the
+ * table, the table ends at the first transition which does not fit, and the
+ * lookups after that return FindResult::kTypeNotFound. The isTruncated()
+ * method reports this, and getUntilEpochSeconds() returns where the table
+ * actually ends.
+ *
+ * The lookup methods do not modify the object once the table has been
+ * calculated. So the table acts as an immutable snapshot which can be shared
+ * by multiple threads without locking, if initTransitions() is called
+ * (successfully) before the object is published to the other threads, and
+ * neither setZoneKey() with a different zone nor Epoch::currentEpochYear(year)
+ * is called afterwards. Otherwise, not thread-safe.
+ *
+ * @tparam ZP ExtendedZoneProcessor or CompleteZoneProcessor used to
+ *    calculate the transitions
+ * @tparam SIZE max number of FlatTransition entries
+ * @tparam NUM_ABBREVS max number of unique abbreviations
+ */
+template <typename ZP, uint16_t SIZE, uint8_t NUM_ABBREVS>
+class FlatZoneProcessorTemplate: public ZoneProcessor {
+  public:
+    typedef flat::FlatTransition FlatTransition;
+
+    bool isLink() const override {
+      return mZoneProcessor.isLink();
+    }
+
+    uint32_t getZoneId() const override {
+      return mZoneProcessor.getZoneId();
+    }
+
+    FindResult findByLocalDateTime(const LocalDateTime& ldt) const override {
+      if (! initTransitions()) return FindResult();
+      return flatTable().findByLocalDateTime(ldt);
+    }
+
+    /**
+     * @copydoc ZoneProcessor::findByEpochSeconds(acetime_t)
+     *
+     * This is a binary search over the flattened transition table. The fold
+     * parameter is calculated the same way as ExtendedZoneProcessor.
+     */
+    FindResult findByEpochSeconds(acetime_t epochSeconds) const override {
+      if (! initTransitions()) return FindResult();
+      return flatTable().findByEpochSeconds(epochSeconds);
+    }
+
+    /**
+     * @copydoc ZoneProcessor::findNextTransition()
+     *
+     * The transition table already merges the transitions which change
+     * nothing, so this is a binary search over the table. Transitions outside
+     * of the year range of the table are not found.
+     */
+    ZoneTransition findNextTransition(acetime_t epochSeconds) const override {
+      if (! initTransitions()) return ZoneTransition();
+      return flatTable().findNextTransition(epochSeconds);
+    }
+
+    /**
+     * @copydoc ZoneProcessor::findPrevTransition()
+     *
+     * This is a binary search over the transition table. See
+     * findNextTransition().
+     */
+    ZoneTransition findPrevTransition(acetime_t epochSeconds) const override {
+      if (! initTransitions()) return ZoneTransition();
+      return flatTable().findPrevTransition(epochSeconds);
+    }
+
+    void printNameTo(Print& printer) const override {
+      mZoneProcessor.printNameTo(printer);
+    }
+
+    void printShortNameTo(Print& printer) const override {
+      mZoneProcessor.printShortNameTo(printer);
+    }
+
+    void printTargetNameTo(Print& printer) const override {
+      mZoneProcessor.printTargetNameTo(printer);
+    }
+
+    void setZoneKey(uintptr_t zoneKey) override {
+      if (mZoneProcessor.equalsZoneKey(zoneKey)) return;
+
+      mZoneProcessor.setZoneKey(zoneKey);
+      mYear = LocalDate::kInvalidYear;
+      mNumTransitions = 0;
+      mNumAbbrevs = 0;
+      mIsTruncated = false;
+    }
+
+    bool equalsZoneKey(uintptr_t zoneKey) const override {
+      return mZoneProcessor.equalsZoneKey(zoneKey);
+    }
+
+    /** Return the number of entries in the transition table. */
+    uint16_t getNumTransitions() const {
+      initTransitions();
+      return mNumTransitions;
+    }
+
+    /** Return the number of unique abbreviations in the transition table. */
+    uint8_t getNumAbbrevs() const {
+      initTransitions();
+      return mNumAbbrevs;
+    }
+
+    /**
+     * Return true if the transition table filled up before the end of the
+     * year range, so that it ends early at getUntilEpochSeconds().
+     */
+    bool isTruncated() const {
+      initTransitions();
+      return mIsTruncated;
+    }
+
+    /**
+     * Return the epochSeconds (exclusive) where the transition table ends.
+     * This is the start of the until year, or the start of the first
+     * transition which did not fit if isTruncated() is true.
+     */
+    acetime_t getUntilEpochSeconds() const {
+      initTransitions();
+      return mUntilEpochSeconds;
+    }
+
+    /**
+     * Calculate the transition table over the year range if the zone or the
+     * current epoch year has changed. Returns true if the table contains at
+     * least one transition. Exposed for debugging.
+     */
+    bool initTransitions() const {
+      // Clamp the year range to the years where epochSeconds is valid.
+      int16_t startYear = Epoch::epochValidYearLower();
+      if (mStartYear != LocalDate::kInvalidYear && mStartYear > startYear) {
+        startYear = mStartYear;
+      }
+      int16_t untilYear = Epoch::epochValidYearUpper();
+      if (mUntilYear != LocalDate::kInvalidYear && mUntilYear < untilYear) {
+        untilYear = mUntilYear;
+      }
+
+      if (isFilled(startYear)) return mNumTransitions > 0;
+      mYear = startYear;
+      mEpochYear = Epoch::currentEpochYear();
+      mNumTransitions = 0;
+      mNumAbbrevs = 0;
+      mIsTruncated = false;
+      mUntilEpochSeconds = 0;
+      if (startYear >= untilYear) return false;
+      acetime_t untilEpochSeconds =
+          LocalDate::forComponents(untilYear, 1, 1).toEpochSeconds();
+
+      if (ACE_TIME_FLAT_ZONE_PROCESSOR_DEBUG) {
+        logging::printf("initTransitions(): [%d, %d)\n", startYear, untilYear);
+      }
+
+      // If the table is full, the year range is truncated.
+      flat::FlatTableBuilder builder = {
+          mTransitions, mAbbrevs, 0, SIZE, 0, NUM_ABBREVS};
+      mUntilEpochSeconds = flat::addTransitionsForYears(
+          mZoneProcessor, startYear, untilYear, untilEpochSeconds, builder);
+      mNumTransitions = builder.numTransitions;
+      mNumAbbrevs = builder.numAbbrevs;
+      mIsTruncated = mUntilEpochSeconds < untilEpochSeconds;
+
+      return mNumTransitions > 0;
+    }
+
+  protected:
+    /**
+     * Constructor.
+     *
+     * @param type indentifier for the specific subclass of ZoneProcessor
+     * @param zoneKey an opaque Zone primary key (e.g. const ZoneInfo*)
+     * @param startYear start year of the table, or LocalDate::kInvalidYear to
+     *    use Epoch::epochValidYearLower()
+     * @param untilYear until year (exclusive) of the table, or
+     *    LocalDate::kInvalidYear to use Epoch::epochValidYearUpper()
+     */
+    explicit FlatZoneProcessorTemplate(
+        uint8_t type,
+        uintptr_t zoneKey,
+        int16_t startYear,
+        int16_t untilYear
+    ) :
+        ZoneProcessor(type),
+        mStartYear(startYear),
+        mUntilYear(untilYear)
+    {
+      setZoneKey(zoneKey);
+    }
+
+  private:
+    friend class ::FlatZoneProcessorTest_initTransitions;
+    friend class ::FlatZoneProcessorTest_findByEpochSeconds;
+    friend class ::FlatZoneProcessorTest_findNextTransition;
+
+    // Disable copy constructor and assignment operator.
+    FlatZoneProcessorTemplate(const FlatZoneProcessorTemplate&) = delete;
+    FlatZoneProcessorTemplate& operator=(const FlatZoneProcessorTemplate&) =
+        delete;
+
+    bool equals(const ZoneProcessor& other) const override {
+      return mZoneProcessor
+          == ((const FlatZoneProcessorTemplate&) other).mZoneProcessor;
+    }
+
+    /** Return the view of the transition table used by the lookups. */
+    flat::FlatTable flatTable() const {
+      return flat::FlatTable{
+          mTransitions, mAbbrevs, mUntilEpochSeconds, mNumTransitions};
+    }
+
+  private:
+    ZP mZoneProcessor;
+    int16_t const mStartYear;
+    int16_t const mUntilYear;
+
+    mutable acetime_t mUntilEpochSeconds = 0;
+    mutable uint16_t mNumTransitions = 0;
+    mutable uint8_t mNumAbbrevs = 0;
+    mutable bool mIsTruncated = false;
+    mutable FlatTransition mTransitions[SIZE];
+    mutable char mAbbrevs[NUM_ABBREVS][kAbbrevSize];
+};
+
+/**
+ * A FlatZoneProcessorTemplate which uses the ExtendedZoneProcessor to read the
+ * 'zonedbx' database. The table is large enough for all zones in the database
+ * over the default 100-year range of the current epoch. (The current maximum
+ * is 263 transitions and 5 abbreviations.)
+ */
+class FlatZoneProcessor: public FlatZoneProcessorTemplate<
+    ExtendedZoneProcessor,
+    300 /*SIZE*/,
+    8 /*NUM_ABBREVS*/> {
+
+  public:
+    /** Unique TimeZone type identifier for FlatZoneProcessor. */
+    static const uint8_t kTypeFlat = 6;
+
+    explicit FlatZoneProcessor(
+        const extended::Info::ZoneInfo* zoneInfo = nullptr,
+        int16_t startYear = LocalDate::kInvalidYear,
+        int16_t untilYear = LocalDate::kInvalidYear)
+      : FlatZoneProcessorTemplate(
+          kTypeFlat, (uintptr_t) zoneInfo, startYear, untilYear)
+    {}
+};
+
+/**
+ * A FlatZoneProcessorTemplate which uses the CompleteZoneProcessor to read the
+ * 'zonedbc' database.
+ */
+class FlatCompleteZoneProcessor: public FlatZoneProcessorTemplate<
+    CompleteZoneProcessor,
+    300 /*SIZE*/,
+    8 /*NUM_ABBREVS*/> {
+
+  public:
+    /** Unique TimeZone type identifier for FlatCompleteZoneProcessor. */
+    static const uint8_t kTypeFlatComplete = 7;
+
+    explicit FlatCompleteZoneProcessor(
+        const complete::Info::ZoneInfo* zoneInfo = nullptr,
+        int16_t startYear = LocalDate::kInvalidYear,
+        int16_t untilYear = LocalDate::kInvalidYear)
+      : FlatZoneProcessorTemplate(
+          kTypeFlatComplete, (uintptr_t) zoneInfo, startYear, untilYear)
+    {}
+};
+
+} // namespace ace_time
+
+#endif
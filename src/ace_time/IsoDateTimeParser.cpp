@@ -0,0 +1,253 @@
+/*
+ * MIT License
+ * Copyright (c) 2026 Brian T. Park
+ */
+
+#include <string.h> // memcpy(), memchr()
+#include "LocalDate.h"
+#include "TimeOffset.h"
+#include "IsoDateTimeParser.h"
+
+namespace ace_time {
+
+// Layout of the date and time. 'd' is a digit, anything else is a separator.
+static const char kLayout[] = "dddd-dd-ddTdd:dd:dd";
+static const uint8_t kLayoutLength = sizeof(kLayout) - 1;
+
+// Each 8-byte word is described by the mask of its digit bytes, the mask of
+// its separator bytes, and the expected separators. The bytes are numbered in
+// memory order, byte 0 being the least significant after load().
+static const uint64_t kOnes = 0x0101010101010101ULL;
+static const uint64_t kHighs = 0x8080808080808080ULL;
+
+// Bytes [0,8): "yyyy-mm-"
+static const uint64_t kDigitsA = 0x00ffff00ffffffffULL;
+static const uint64_t kSeparatorsA = 0xff0000ff00000000ULL;
+static const uint64_t kExpectedA = 0x2d00002d00000000ULL;
+
+// Bytes [8,16): "ddThh:mm", only "dd" is checked, the 'T' is checked
+// separately because it has alternatives, and "hh:mm" is in word C.
+static const uint64_t kDigitsB = 0x000000000000ffffULL;
+
+// Bytes [11,19): "hh:mm:ss"
+static const uint64_t kDigitsC = 0xffff00ffff00ffffULL;
+static const uint64_t kSeparatorsC = 0x0000ff0000ff0000ULL;
+static const uint64_t kExpectedC = 0x00003a00003a0000ULL;
+
+/** Load 8 bytes with byte 0 in the least significant position. */
+static inline uint64_t load(const char* s) {
+  uint64_t x;
+  memcpy(&x, s, 8);
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+  x = __builtin_bswap64(x);
+#endif
+  return x;
+}
+
+/**
+ * Return the byte at the given index of the word.
+ */
+static inline uint8_t byteAt(uint64_t x, uint8_t index) {
+  return (uint8_t) (x >> (8 * index));
+}
+
+/**
+ * Validate the word 'x' which starts at position 'start'. Return kStatusOk,
+ * or set 'position' to the first invalid byte and return its status.
+ */
+static uint8_t checkWord(uint64_t x, uint64_t digits, uint64_t separators,
+    uint64_t expected, size_t start, size_t& position) {
+
+  // The high bit of each byte which is not in ['0', '9'] is set. There is no
+  // borrow across bytes, because each byte is at least 0x80 before the
+  // subtraction.
+  uint64_t x7 = x | kHighs;
+  uint64_t badDigits = (x | ~(x7 - 0x30 * kOnes) | (x7 - 0x3a * kOnes))
+      & kHighs & digits;
+  uint64_t badSeparators = (x ^ expected) & separators;
+  if ((badDigits | badSeparators) == 0) return IsoDateTimeParser::kStatusOk;
+
+  // The least significant bad byte comes first in the string.
+  uint8_t digitIndex = badDigits ? __builtin_ctzll(badDigits) / 8 : 8;
+  uint8_t separatorIndex = badSeparators
+      ? __builtin_ctzll(badSeparators) / 8 : 8;
+  if (digitIndex < separatorIndex) {
+    position = start + digitIndex;
+    return IsoDateTimeParser::kStatusBadDigit;
+  } else {
+    position = start + separatorIndex;
+    return IsoDateTimeParser::kStatusBadSeparator;
+  }
+}
+
+/**
+ * Convert the digits of a validated word into 2-digit numbers. Byte 'i' of the
+ * result is the number formed by the digits at bytes 'i' and 'i+1'. Each byte
+ * is at most 99, so there is no carry across bytes.
+ */
+static inline uint64_t pairs(uint64_t x, uint64_t digits) {
+  uint64_t v = (x & digits) - (0x30 * kOnes & digits);
+  return v * 10 + (v >> 8);
+}
+
+static inline bool isDigit(char c) {
+  return c >= '0' && c <= '9';
+}
+
+static inline bool isDateTimeSeparator(char c) {
+  return c == 'T' || c == 't' || c == ' ';
+}
+
+uint8_t IsoDateTimeParser::parse(const char* s, size_t len) {
+  if (len < kLayoutLength) {
+    // Find the first bad character before reporting a short string.
+    for (size_t i = 0; i < len; i++) {
+      char expected = kLayout[i];
+      if (expected == 'd') {
+        if (! isDigit(s[i])) return error(kStatusBadDigit, i);
+      } else if (expected == 'T') {
+        if (! isDateTimeSeparator(s[i])) return error(kStatusBadSeparator, i);
+      } else if (s[i] != expected) {
+        return error(kStatusBadSeparator, i);
+      }
+    }
+    return error(kStatusTooShort, len);
+  }
+
+  // Validate the date and time.
+  size_t position;
+  uint64_t a = load(s);
+  uint64_t b = load(s + 8);
+  uint64_t c = load(s + 11);
+  uint8_t status = checkWord(a, kDigitsA, kSeparatorsA, kExpectedA, 0,
+      position);
+  if (status == kStatusOk) {
+    status = checkWord(b, kDigitsB, 0, 0, 8, position);
+  }
+  if (status == kStatusOk && ! isDateTimeSeparator(s[10])) {
+    status = kStatusBadSeparator;
+    position = 10;
+  }
+  if (status == kStatusOk) {
+    status = checkWord(c, kDigitsC, kSeparatorsC, kExpectedC, 11, position);
+  }
+  if (status != kStatusOk) return error(status, position);
+
+  // Convert the digits.
+  uint64_t pa = pairs(a, kDigitsA);
+  uint64_t pb = pairs(b, kDigitsB);
+  uint64_t pc = pairs(c, kDigitsC);
+  int16_t year = byteAt(pa, 0) * 100 + byteAt(pa, 2);
+  uint8_t month = byteAt(pa, 5);
+  uint8_t day = byteAt(pb, 0);
+  uint8_t hour = byteAt(pc, 0);
+  uint8_t minute = byteAt(pc, 3);
+  uint8_t second = byteAt(pc, 6);
+
+  if (month < 1 || month > 12) return error(kStatusOutOfRange, 5);
+  if (day < 1 || day > LocalDate::daysInMonth(year, month)) {
+    return error(kStatusOutOfRange, 8);
+  }
+  if (hour > 23) return error(kStatusOutOfRange, 11);
+  if (minute > 59) return error(kStatusOutOfRange, 14);
+  if (second > 59) return error(kStatusOutOfRange, 17);
+
+  // Fractional seconds, keeping the first 9 digits.
+  size_t i = kLayoutLength;
+  uint32_t nanos = 0;
+  if (i < len && (s[i] == '.' || s[i] == ',')) {
+    if (! mAllowFraction) return error(kStatusBadOffset, i);
+    i++;
+    if (i >= len) return error(kStatusTooShort, i);
+    if (! isDigit(s[i])) return error(kStatusBadDigit, i);
+    uint8_t numDigits = 0;
+    for (; i < len && isDigit(s[i]); i++) {
+      if (numDigits < 9) {
+        nanos = nanos * 10 + (s[i] - '0');
+        numDigits++;
+      }
+    }
+    for (; numDigits < 9; numDigits++) {
+      nanos *= 10;
+    }
+  }
+
+  int32_t offsetSeconds;
+  status = parseOffset(s, len, i, offsetSeconds);
+  if (status != kStatusOk) return status;
+
+  mDateTime = OffsetDateTime::forComponents(year, month, day,
+      hour, minute, second, TimeOffset::forSeconds(offsetSeconds));
+  mNanos = nanos;
+  mPosition = i;
+  mStatus = kStatusOk;
+  return kStatusOk;
+}
+
+uint8_t IsoDateTimeParser::parseOffset(const char* s, size_t len, size_t& i,
+    int32_t& offsetSeconds) {
+  if (i >= len) return error(kStatusTooShort, i);
+
+  char sign = s[i];
+  if (sign == 'Z' || sign == 'z') {
+    offsetSeconds = 0;
+    i++;
+    return kStatusOk;
+  }
+  if (sign != '+' && sign != '-') return error(kStatusBadOffset, i);
+  size_t start = i;
+  i++;
+
+  // "hh:mm", followed by an optional ":ss"
+  uint8_t fields[3] = {0, 0, 0};
+  for (uint8_t f = 0; f < 3; f++) {
+    if (f > 0) {
+      if (f == 2 && (i >= len || s[i] != ':')) break;
+      if (i >= len) return error(kStatusTooShort, i);
+      if (s[i] != ':') return error(kStatusBadSeparator, i);
+      i++;
+    }
+    for (uint8_t d = 0; d < 2; d++, i++) {
+      if (i >= len) return error(kStatusTooShort, i);
+      if (! isDigit(s[i])) return error(kStatusBadDigit, i);
+      fields[f] = fields[f] * 10 + (s[i] - '0');
+    }
+    if (fields[f] > ((f == 0) ? 23 : 59)) {
+      return error(kStatusOutOfRange, i - 2);
+    }
+  }
+
+  offsetSeconds = (fields[0] * int32_t(60) + fields[1]) * 60 + fields[2];
+  if (s[start] == '-') offsetSeconds = -offsetSeconds;
+  return kStatusOk;
+}
+
+size_t IsoDateTimeParser::parseLines(const char* s, size_t len,
+    OffsetDateTime* dateTimes, size_t maxLines,
+    uint32_t* nanos, uint8_t* statuses, bool endOfInput) {
+
+  size_t numLines = 0;
+  size_t pos = 0;
+  while (numLines < maxLines && pos < len) {
+    const char* line = s + pos;
+    const char* eol = (const char*) memchr(line, '\n', len - pos);
+    if (! eol && ! endOfInput) break;
+    size_t lineLength = eol ? (size_t) (eol - line) : len - pos;
+    pos += lineLength + (eol ? 1 : 0);
+    if (lineLength > 0 && line[lineLength - 1] == '\r') lineLength--;
+
+    uint8_t status = parse(line, lineLength);
+    if (status == kStatusOk && mPosition != lineLength) {
+      status = error(kStatusTrailing, mPosition);
+    }
+    dateTimes[numLines] = mDateTime;
+    if (nanos) nanos[numLines] = mNanos;
+    if (statuses) statuses[numLines] = status;
+    numLines++;
+  }
+
+  mPosition = pos;
+  return numLines;
+}
+
+}
@@ -0,0 +1,155 @@
+/*
+ * MIT License
+ * Copyright (c) 2026 Brian T. Park
+ */
+
+#ifndef ACE_TIME_ISO_DATE_TIME_PARSER_H
+#define ACE_TIME_ISO_DATE_TIME_PARSER_H
+
+#include <stdint.h>
+#include <stddef.h> // size_t
+#include "OffsetDateTime.h"
+
+namespace ace_time {
+
+/**
+ * A strict parser of ISO 8601 (RFC 3339) date time strings with the fixed
+ * layout "yyyy-mm-ddThh:mm:ss" followed by "Z", "+hh:mm", or "-hh:mm". The
+ * "T" may also be a "t" or a space, and the UTC offset may have a seconds
+ * field ("+hh:mm:ss") as written by OffsetDateTime::formatTo(). If enabled in
+ * the constructor, the seconds may be followed by a fraction (".123"), whose
+ * first 9 digits are returned by nanos().
+ *
+ * Unlike OffsetDateTime::forDateString(), every separator is checked and every
+ * field is range checked, and the location of the first error is reported by
+ * position(). The 19 characters of the date and time are loaded as 8-byte
+ * words, and their 14 digits are validated and converted in parallel within
+ * each word (SWAR), instead of one character at a time.
+ *
+ * Example:
+ *
+ * @code
+ * IsoDateTimeParser parser;
+ * if (parser.parse(s, len) == IsoDateTimeParser::kStatusOk) {
+ *   OffsetDateTime odt = parser.dateTime();
+ *   ...
+ * }
+ * @endcode
+ */
+class IsoDateTimeParser {
+  public:
+    /** The string was parsed successfully. */
+    static const uint8_t kStatusOk = 0;
+
+    /** The string ended before the end of the date time. */
+    static const uint8_t kStatusTooShort = 1;
+
+    /** A digit was expected. */
+    static const uint8_t kStatusBadDigit = 2;
+
+    /** A '-', 'T', or ':' separator was expected. */
+    static const uint8_t kStatusBadSeparator = 3;
+
+    /** A 'Z', '+', or '-' was expected, or a fraction is not allowed. */
+    static const uint8_t kStatusBadOffset = 4;
+
+    /** A field (e.g. the month, or the day of month) is out of range. */
+    static const uint8_t kStatusOutOfRange = 5;
+
+    /** parseLines() found unexpected characters after the date time. */
+    static const uint8_t kStatusTrailing = 6;
+
+    /**
+     * Constructor.
+     * @param allowFraction accept fractional seconds after the seconds field
+     */
+    explicit IsoDateTimeParser(bool allowFraction = false) :
+        mDateTime(OffsetDateTime::forError()),
+        mAllowFraction(allowFraction)
+    {}
+
+    /**
+     * Parse a single date time string at the beginning of 's', reading at
+     * most 'len' characters. The string does not need to be NUL terminated.
+     * Characters after the date time are not examined.
+     *
+     * @return status code, also available from status()
+     */
+    uint8_t parse(const char* s, size_t len);
+
+    /**
+     * Parse newline-delimited date time strings, one per line, into the
+     * 'dateTimes' array. A line may end with "\r\n". A line which fails to
+     * parse, including one with unexpected characters after the date time,
+     * produces an OffsetDateTime::forError(). Parsing stops after 'maxLines'
+     * lines or at the end of the input, and position() returns the number of
+     * characters consumed, so that the remainder can be parsed by the next
+     * call.
+     *
+     * If the input is read in chunks, a chunk can end in the middle of a line.
+     * Set 'endOfInput' to false for every chunk except the last one. Parsing
+     * then stops before a final line without a '\n', and position() points
+     * to the start of that line, so that it can be parsed again once the rest
+     * of it has been read.
+     *
+     * @param s input buffer, not necessarily NUL terminated
+     * @param len size of the input
+     * @param dateTimes output array of size maxLines
+     * @param maxLines maximum number of lines to parse
+     * @param nanos optional output array of fractional seconds
+     * @param statuses optional output array of status codes
+     * @param endOfInput true if the input ends at 'len', so that a final line
+     *    without a '\n' is complete
+     * @return number of lines parsed
+     */
+    size_t parseLines(const char* s, size_t len,
+        OffsetDateTime* dateTimes, size_t maxLines,
+        uint32_t* nanos = nullptr, uint8_t* statuses = nullptr,
+        bool endOfInput = true);
+
+    /** Return the status of the last parse(). */
+    uint8_t status() const { return mStatus; }
+
+    /**
+     * Return the number of characters consumed by the last parse() if
+     * successful, or the position of the offending character if not. After
+     * parseLines(), return the number of characters consumed.
+     */
+    size_t position() const { return mPosition; }
+
+    /**
+     * Return the date time of the last parse(), or OffsetDateTime::forError()
+     * if it failed.
+     */
+    const OffsetDateTime& dateTime() const { return mDateTime; }
+
+    /** Return the fractional seconds of the last parse(), in nanoseconds. */
+    uint32_t nanos() const { return mNanos; }
+
+  private:
+    /** Record an error at the given position and return its status. */
+    uint8_t error(uint8_t status, size_t position) {
+      mStatus = status;
+      mPosition = position;
+      mDateTime = OffsetDateTime::forError();
+      mNanos = 0;
+      return status;
+    }
+
+    /**
+     * Parse "Z" or "+hh:mm[:ss]" starting at position 'i' of 's', and advance
+     * 'i' past it.
+     */
+    uint8_t parseOffset(const char* s, size_t len, size_t& i,
+        int32_t& offsetSeconds);
+
+    OffsetDateTime mDateTime;
+    uint32_t mNanos = 0;
+    size_t mPosition = 0;
+    uint8_t mStatus = kStatusTooShort;
+    bool mAllowFraction;
+};
+
+}
+
+#endif
@@ -6,6 +6,7 @@
 #include <Arduino.h>
 #include <AceCommon.h> // printPad2To()
 #include "common/DateStrings.h" // DateStrings
+#include "common/DateFormat.h" // formatDate()
 #include "LocalDate.h"
 
 namespace ace_time {
@@ -75,4 +76,15 @@ void LocalDate::printTo(Print& printer) const {
   printer.print(ds.dayOfWeekLongString(dayOfWeek()));
 }
 
+size_t LocalDate::formatTo(char* buf, size_t len) const {
+  if (len < kFormatBufferSize || isError() || mYear > 9999) {
+    if (len > 0) buf[0] = '\0';
+    return 0;
+  }
+
+  char* p = internal::formatDate(buf, mYear, mMonth, mDay);
+  *p = '\0';
+  return p - buf;
+}
+
 }
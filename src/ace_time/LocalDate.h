@@ -7,6 +7,7 @@
 #define ACE_TIME_LOCAL_DATE_H
 
 #include <stdint.h>
+#include <stddef.h> // size_t
 #include <string.h> // strlen()
 #include "Epoch.h"
 #include "common/common.h"
@@ -122,6 +123,9 @@ class LocalDate {
     /** Sunday ISO 8601 number. */
     static const uint8_t kSunday = 7;
 
+    /** Size of the buffer needed by formatTo(), "yyyy-mm-dd" plus NUL. */
+    static const uint8_t kFormatBufferSize = 11;
+
   // Utility functions
   public:
     /** True if year is a leap year. */
@@ -164,6 +168,15 @@ class LocalDate {
      * @param epochDays number of days since the current epoch
      */
     static LocalDate forEpochDays(int32_t epochDays) {
+      return forEpochDays(epochDays, Epoch::currentContext());
+    }
+
+    /**
+     * Factory method using the number of days since the epoch given by the
+     * explicit `context`, instead of the current epoch.
+     */
+    static LocalDate forEpochDays(int32_t epochDays,
+        const EpochContext& context) {
       int16_t year;
       uint8_t month;
       uint8_t day;
@@ -173,7 +186,7 @@ class LocalDate {
         day = 0;
       } else {
         // shift relative to Epoch::kInternalEpochYear
-        epochDays += Epoch::daysToCurrentEpochFromInternalEpoch();
+        epochDays += context.daysToEpochFromInternalEpoch();
         ACE_TIME_EPOCH_CONVERTER::fromEpochDays(epochDays, year, month, day);
       }
       return forComponents(year, month, day);
@@ -203,6 +216,15 @@ class LocalDate {
      * @param epochSeconds number of seconds since the current epoch
      */
     static LocalDate forEpochSeconds(acetime_t epochSeconds) {
+      return forEpochSeconds(epochSeconds, Epoch::currentContext());
+    }
+
+    /**
+     * Factory method using the number of seconds since the epoch given by
+     * the explicit `context`, instead of the current epoch.
+     */
+    static LocalDate forEpochSeconds(acetime_t epochSeconds,
+        const EpochContext& context) {
       if (epochSeconds == kInvalidEpochSeconds) {
         return forError();
       }
@@ -211,7 +233,7 @@ class LocalDate {
       int32_t days = (epochSeconds < 0)
           ? (epochSeconds + 1) / 86400 - 1
           : epochSeconds / 86400;
-      return forEpochDays(days);
+      return forEpochDays(days, context);
     }
 
     /**
@@ -350,9 +372,17 @@ class LocalDate {
      * true.
      */
     int32_t toEpochDays() const {
+      return toEpochDays(Epoch::currentContext());
+    }
+
+    /**
+     * Return the number of days since the epoch given by the explicit
+     * `context`, instead of the current epoch.
+     */
+    int32_t toEpochDays(const EpochContext& context) const {
       if (isError()) return kInvalidEpochDays;
       int32_t days = ACE_TIME_EPOCH_CONVERTER::toEpochDays(mYear, mMonth, mDay)
-          - Epoch::daysToCurrentEpochFromInternalEpoch();
+          - context.daysToEpochFromInternalEpoch();
       return days;
     }
 
@@ -369,8 +399,16 @@ class LocalDate {
      * out of range.
      */
     acetime_t toEpochSeconds() const {
+      return toEpochSeconds(Epoch::currentContext());
+    }
+
+    /**
+     * Return the number of seconds since the epoch given by the explicit
+     * `context`, instead of the current epoch.
+     */
+    acetime_t toEpochSeconds(const EpochContext& context) const {
       if (isError()) return kInvalidEpochSeconds;
-      return (int32_t) 86400 * toEpochDays();
+      return (int32_t) 86400 * toEpochDays(context);
     }
 
     /**
@@ -421,6 +459,15 @@ class LocalDate {
      */
     void printTo(Print& printer) const;
 
+    /**
+     * Write the date in ISO 8601 format "yyyy-mm-dd" into 'buf', terminated
+     * by a NUL. Unlike printTo(), the day of week is not included. The buffer
+     * must have a size of at least kFormatBufferSize. Return the number of
+     * characters written, excluding the NUL, or 0 if the buffer is too small,
+     * the date is an error, or the year is greater than 9999.
+     */
+    size_t formatTo(char* buf, size_t len) const;
+
     // Use default copy constructor and assignment operator.
     LocalDate(const LocalDate&) = default;
     LocalDate& operator=(const LocalDate&) = default;
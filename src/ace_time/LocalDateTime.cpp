@@ -7,6 +7,7 @@
 #include <Arduino.h> // strncpy_P()
 #include <AceCommon.h>
 #include "common/DateStrings.h"
+#include "common/DateFormat.h" // formatDate(), formatTime()
 #include "LocalDateTime.h"
 
 using ace_common::printPad2To;
@@ -37,6 +38,21 @@ void LocalDateTime::printTo(Print& printer) const {
   printPad2To(printer, mLocalTime.second(), '0');
 }
 
+size_t LocalDateTime::formatTo(char* buf, size_t len) const {
+  if (len < kFormatBufferSize || isError() || mLocalDate.year() > 9999) {
+    if (len > 0) buf[0] = '\0';
+    return 0;
+  }
+
+  char* p = internal::formatDate(buf,
+      mLocalDate.year(), mLocalDate.month(), mLocalDate.day());
+  *p++ = 'T';
+  p = internal::formatTime(p,
+      mLocalTime.hour(), mLocalTime.minute(), mLocalTime.second());
+  *p = '\0';
+  return p - buf;
+}
+
 LocalDateTime LocalDateTime::forDateString(const char* dateString) {
   if (strlen(dateString) < kDateTimeStringLength) {
     return LocalDateTime::forError();
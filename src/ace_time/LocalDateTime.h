@@ -29,6 +29,11 @@ namespace ace_time {
  */
 class LocalDateTime {
   public:
+    /**
+     * Size of the buffer needed by formatTo(), "yyyy-mm-ddThh:mm:ss" plus
+     * NUL.
+     */
+    static const uint8_t kFormatBufferSize = 20;
 
     /**
      * Factory method using separated date and time components.
@@ -62,6 +67,16 @@ class LocalDateTime {
      */
     static LocalDateTime forEpochSeconds(
         acetime_t epochSeconds, uint8_t fold = 0) {
+      return forEpochSeconds(epochSeconds, Epoch::currentContext(), fold);
+    }
+
+    /**
+     * Factory method using the number of seconds since the epoch given by the
+     * explicit `context`, instead of the current epoch.
+     */
+    static LocalDateTime forEpochSeconds(
+        acetime_t epochSeconds, const EpochContext& context,
+        uint8_t fold = 0) {
       if (epochSeconds == LocalDate::kInvalidEpochSeconds) {
         return forError();
       }
@@ -72,10 +87,13 @@ class LocalDateTime {
           : epochSeconds / 86400;
 
       // Avoid % operator, because it's slow on an 8-bit process and because
-      // epochSeconds could be negative.
-      int32_t seconds = epochSeconds - 86400 * days;
+      // epochSeconds could be negative. The product overflows int32_t on the
+      // day of kMinEpochSeconds, so use unsigned arithmetic which wraps
+      // around to the correct remainder.
+      int32_t seconds = (uint32_t) epochSeconds
+          - (uint32_t) 86400 * (uint32_t) days;
 
-      LocalDate ld = LocalDate::forEpochDays(days);
+      LocalDate ld = LocalDate::forEpochDays(days, context);
       LocalTime lt = LocalTime::forSeconds(seconds, fold);
       return LocalDateTime(ld, lt);
     }
@@ -228,9 +246,39 @@ class LocalDateTime {
      * epochSeconds is out of range.
      */
     acetime_t toEpochSeconds() const {
+      return toEpochSeconds(Epoch::currentContext());
+    }
+
+    /**
+     * Return the number of seconds since the epoch given by the explicit
+     * `context`, instead of the current epoch.
+     */
+    acetime_t toEpochSeconds(const EpochContext& context) const {
       if (isError()) return LocalDate::kInvalidEpochSeconds;
-      int32_t days = mLocalDate.toEpochDays();
+      int32_t days = mLocalDate.toEpochDays(context);
       int32_t seconds = mLocalTime.toSeconds();
+
+      // The valid range starts part way into kMinDays and ends part way into
+      // kMaxDays. Only those 2 days need a check of the seconds.
+      const int32_t kMinDays = LocalDate::kMinEpochSeconds / 86400 - 1;
+      const int32_t kMaxDays = LocalDate::kMaxEpochSeconds / 86400;
+      const int32_t kMinSeconds = LocalDate::kMinEpochSeconds
+          - (int32_t) 86400 * (kMinDays + 1) + 86400;
+      const int32_t kMaxSeconds = LocalDate::kMaxEpochSeconds
+          - (int32_t) 86400 * kMaxDays;
+      if (days <= kMinDays) {
+        if (days < kMinDays || seconds < kMinSeconds) {
+          return LocalDate::kInvalidEpochSeconds;
+        }
+        // 86400 * kMinDays overflows int32_t, so count back from the start of
+        // the next day.
+        return (int32_t) 86400 * (kMinDays + 1) + (seconds - 86400);
+      }
+      if (days >= kMaxDays) {
+        if (days > kMaxDays || seconds > kMaxSeconds) {
+          return LocalDate::kInvalidEpochSeconds;
+        }
+      }
       return (int32_t) 86400 * days + seconds;
     }
 
@@ -270,6 +318,15 @@ class LocalDateTime {
      */
     void printTo(Print& printer) const;
 
+    /**
+     * Write the date and time in ISO 8601 format "yyyy-mm-ddThh:mm:ss" into
+     * 'buf', terminated by a NUL, without going through the Print interface.
+     * The buffer must have a size of at least kFormatBufferSize. Return the
+     * number of characters written, excluding the NUL, or 0 if the buffer is
+     * too small, the date time is an error, or the year is greater than 9999.
+     */
+    size_t formatTo(char* buf, size_t len) const;
+
     // Use default copy constructor and assignment operator.
     LocalDateTime(const LocalDateTime&) = default;
     LocalDateTime& operator=(const LocalDateTime&) = default;
@@ -5,6 +5,7 @@
 
 #include <string.h> // strlen()
 #include <AceCommon.h>
+#include "common/DateFormat.h" // formatTime()
 #include "LocalTime.h"
 
 using ace_common::printPad2To;
@@ -25,6 +26,17 @@ void LocalTime::printTo(Print& printer) const {
   printPad2To(printer, mSecond, '0');
 }
 
+size_t LocalTime::formatTo(char* buf, size_t len) const {
+  if (len < kFormatBufferSize || isError()) {
+    if (len > 0) buf[0] = '\0';
+    return 0;
+  }
+
+  char* p = internal::formatTime(buf, mHour, mMinute, mSecond);
+  *p = '\0';
+  return p - buf;
+}
+
 LocalTime LocalTime::forTimeString(const char* timeString) {
   if (strlen(timeString) < kTimeStringLength) {
     return forError();
@@ -7,6 +7,7 @@
 #define ACE_TIME_LOCAL_TIME_H
 
 #include <stdint.h>
+#include <stddef.h> // size_t
 #include "common/common.h"
 
 class Print;
@@ -29,6 +30,9 @@ class LocalTime {
     /** An invalid seconds marker that indicates isError() true. */
     static const int32_t kInvalidSeconds = INT32_MIN;
 
+    /** Size of the buffer needed by formatTo(), "hh:mm:ss" plus NUL. */
+    static const uint8_t kFormatBufferSize = 9;
+
     /**
      * Factory method using separated date, time, and time zone fields. The
      * dayOfWeek will be lazily evaluated. No data validation is performed on
@@ -176,6 +180,14 @@ class LocalTime {
      */
     void printTo(Print& printer) const;
 
+    /**
+     * Write the time in ISO 8601 format "hh:mm:ss" into 'buf', terminated by
+     * a NUL. The buffer must have a size of at least kFormatBufferSize. Return
+     * the number of characters written, excluding the NUL, or 0 if the buffer
+     * is too small or the time is an error.
+     */
+    size_t formatTo(char* buf, size_t len) const;
+
     // Use default copy constructor and assignment operator.
     LocalTime(const LocalTime&) = default;
     LocalTime& operator=(const LocalTime&) = default;
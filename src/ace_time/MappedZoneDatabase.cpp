@@ -0,0 +1,163 @@
+/*
+ * MIT License
+ * Copyright (c) 2026 Brian T. Park
+ */
+
+#include <string.h> // memcmp(), memchr()
+#include "MappedZoneDatabase.h"
+
+namespace ace_time {
+
+const char MappedZoneDatabase::kMagic[8] = "AceTzDb";
+
+uint8_t MappedZoneDatabase::validate(const void* data, size_t size) {
+  if (((uintptr_t) data & 0x3) != 0) return kStatusBadAlignment;
+  if (size < sizeof(Header)) return kStatusBadSize;
+
+  const Header* header = (const Header*) data;
+  if (memcmp(header->magic, kMagic, sizeof(kMagic)) != 0
+      || header->formatVersion != Header::kFormatVersion
+      || header->byteOrderMark != Header::kByteOrderMark
+      || header->headerSize != sizeof(Header)) {
+    return kStatusBadHeader;
+  }
+
+  // Every offset of every record is checked once, so that the brokers can
+  // follow the offsets without any checks. The numeric fields (offsets,
+  // years, months, times) are trusted.
+  uint32_t fileSize = header->fileSize;
+  if (fileSize > size) return kStatusBadSize;
+
+  const ZoneContext* context = (const ZoneContext*) findRecord(
+      data, fileSize, header->zoneContext, sizeof(ZoneContext));
+  if (! context || ! isValidString(data, fileSize, context->tzVersion)) {
+    return kStatusBadSize;
+  }
+  const int32_t* letters = (const int32_t*) findRecord(
+      data, fileSize, context->letters,
+      context->numLetters * sizeof(int32_t));
+  if (context->numLetters > 0 && ! letters) return kStatusBadSize;
+  for (uint8_t i = 0; i < context->numLetters; i++) {
+    if (! isValidString(data, fileSize, letters[i])) return kStatusBadSize;
+  }
+
+  const int32_t* registry = (const int32_t*) findRecord(
+      data, fileSize, header->registry, header->numZones * sizeof(int32_t));
+  if (header->numZones > 0 && ! registry) return kStatusBadSize;
+  for (uint16_t i = 0; i < header->numZones; i++) {
+    const ZoneInfo* info = (const ZoneInfo*) findRecord(
+        data, fileSize, registry[i], sizeof(ZoneInfo));
+    if (! info || ! isValidZoneInfo(data, fileSize, context, info, false)) {
+      return kStatusBadSize;
+    }
+  }
+
+  return kStatusOk;
+}
+
+bool MappedZoneDatabase::isValidZoneInfo(
+    const void* data,
+    uint32_t fileSize,
+    const ZoneContext* context,
+    const ZoneInfo* info,
+    bool isTarget) {
+
+  // All zones share the ZoneContext of the Header, whose numLetters bounds
+  // the letterIndex of the rules.
+  if (! isValidString(data, fileSize, info->name)
+      || findRecord(data, fileSize, info->zoneContext, sizeof(ZoneContext))
+          != context) {
+    return false;
+  }
+
+  const ZoneEra* eras = (const ZoneEra*) findRecord(
+      data, fileSize, info->eras, info->numEras * sizeof(ZoneEra));
+  if (info->numEras == 0 || ! eras) return false;
+  for (uint8_t e = 0; e < info->numEras; e++) {
+    const ZoneEra& era = eras[e];
+    if (! isValidString(data, fileSize, era.format)) return false;
+    if (era.zonePolicy == 0) continue;
+
+    const ZonePolicy* policy = (const ZonePolicy*) findRecord(
+        data, fileSize, era.zonePolicy, sizeof(ZonePolicy));
+    if (! policy) return false;
+    const ZoneRule* rules = (const ZoneRule*) findRecord(
+        data, fileSize, policy->rules, policy->numRules * sizeof(ZoneRule));
+    if (! rules) return false;
+    for (uint8_t r = 0; r < policy->numRules; r++) {
+      if (rules[r].letterIndex >= context->numLetters) return false;
+    }
+  }
+
+  // The target of a Link must be a Zone, not another Link.
+  if (info->targetInfo == 0) return true;
+  if (isTarget) return false;
+  const ZoneInfo* target = (const ZoneInfo*) findRecord(
+      data, fileSize, info->targetInfo, sizeof(ZoneInfo));
+  return target && isValidZoneInfo(data, fileSize, context, target, true);
+}
+
+const void* MappedZoneDatabase::findRecord(
+    const void* data, uint32_t fileSize, const int32_t& offset, size_t size) {
+  if (offset == 0) return nullptr;
+  int64_t pos = ((const char*) &offset - (const char*) data)
+      + (int64_t) offset;
+  if (pos < (int64_t) sizeof(Header)
+      || (pos & 0x3) != 0
+      || (uint64_t) pos + size > fileSize) {
+    return nullptr;
+  }
+  return (const char*) data + pos;
+}
+
+bool MappedZoneDatabase::isValidString(
+    const void* data, uint32_t fileSize, const int32_t& offset) {
+  if (offset == 0) return false;
+  int64_t pos = ((const char*) &offset - (const char*) data)
+      + (int64_t) offset;
+  if (pos < (int64_t) sizeof(Header) || pos >= (int64_t) fileSize) {
+    return false;
+  }
+  return memchr((const char*) data + pos, '\0', fileSize - pos) != nullptr;
+}
+
+uint8_t MappedZoneDatabase::initFromBuffer(const void* data, size_t size) {
+  close();
+  mStatus = validate(data, size);
+  if (mStatus == kStatusOk) {
+    mData = data;
+    mSize = size;
+  }
+  return mStatus;
+}
+
+#if ACE_TIME_HAS_MMAP
+
+uint8_t MappedZoneDatabase::openFile(const char* path) {
+  close();
+
+  if (! mMappedFile.open(path)) {
+    mStatus = kStatusOpenError;
+    return mStatus;
+  }
+
+  mStatus = validate(mMappedFile.data(), mMappedFile.size());
+  if (mStatus == kStatusOk) {
+    mData = mMappedFile.data();
+    mSize = mMappedFile.size();
+  } else {
+    mMappedFile.close();
+  }
+  return mStatus;
+}
+
+#endif
+
+void MappedZoneDatabase::close() {
+  mMappedFile.close();
+  mData = nullptr;
+  mSize = 0;
+  mStatus = kStatusNotLoaded;
+}
+
+}
@@ -0,0 +1,187 @@
+/*
+ * MIT License
+ * Copyright (c) 2026 Brian T. Park
+ */
+
+#ifndef ACE_TIME_MAPPED_ZONE_DATABASE_H
+#define ACE_TIME_MAPPED_ZONE_DATABASE_H
+
+#include <stdint.h>
+#include <stddef.h> // size_t
+#include "../zoneinfo/compat.h" // ACE_TIME_HAS_MMAP
+#include "../zoneinfo/infos.h"
+#include "common/MappedFile.h"
+
+namespace ace_time {
+
+/**
+ * A zone database which is loaded at runtime from a binary file in the format
+ * defined by ZoneInfoMapped.h, instead of being compiled into the program like
+ * the 'zonedbc' database. The records are used in place without any parsing,
+ * so loading the file costs an mmap() and a single pass over the records to
+ * validate them. A new version of the TZ Database can be installed by
+ * replacing the file, without rebuilding the program.
+ *
+ * The file is expected to be generated by MappedZoneDatabaseWriter. When it is
+ * loaded, every offset of the Header, ZoneContext, ZoneInfo, ZoneEra,
+ * ZonePolicy and ZoneRule records is checked to point inside the file, every
+ * string to be NUL-terminated within the file, and every letterIndex to be
+ * within the letters of the ZoneContext. The numeric fields (UTC offsets,
+ * years, months and times) are trusted.
+ *
+ * The zoneRegistrySize() and zoneRegistry() are passed into a
+ * MappedZoneManager (or a mapped::ZoneRegistrar), in the same way as the
+ * kZoneAndLinkRegistrySize and kZoneAndLinkRegistry of the 'zonedbc' database:
+ *
+ * @code
+ * MappedZoneDatabase database;
+ * database.openFile("zonedbc.bin");
+ * MappedZoneProcessorHashedCache<4> cache;
+ * MappedZoneManager manager(
+ *     database.zoneRegistrySize(), database.zoneRegistry(), cache);
+ * @endcode
+ *
+ * The database must outlive the ZoneManager and every TimeZone created from
+ * it. When the file is replaced using rename(), an open database continues to
+ * see the old version of the file until it is closed and opened again.
+ */
+class MappedZoneDatabase {
+  public:
+    /** The "AceTzDb" magic string at the start of the file. */
+    static const char kMagic[8];
+
+    /** The database is valid. */
+    static const uint8_t kStatusOk = 0;
+
+    /** No file or buffer has been loaded, or close() was called. */
+    static const uint8_t kStatusNotLoaded = 1;
+
+    /** The file could not be opened or mapped. */
+    static const uint8_t kStatusOpenError = 2;
+
+    /** The buffer is not aligned on a 4-byte boundary. */
+    static const uint8_t kStatusBadAlignment = 3;
+
+    /** The magic string, format version, or byte order does not match. */
+    static const uint8_t kStatusBadHeader = 4;
+
+    /**
+     * The size of the file, or an offset of a record or a string, does not
+     * fit in the buffer, or a rule refers to a letter which does not exist.
+     */
+    static const uint8_t kStatusBadSize = 5;
+
+    /** Constructor. The database is not valid until it is loaded. */
+    MappedZoneDatabase() = default;
+
+    /** Destructor, which unmaps the file opened by openFile(). */
+    ~MappedZoneDatabase() { close(); }
+
+    /**
+     * Use the database stored in the given buffer of `size` bytes, which
+     * must be aligned on a 4-byte boundary and must outlive this object.
+     * Returns kStatusOk if the Header and the records are valid.
+     */
+    uint8_t initFromBuffer(const void* data, size_t size);
+
+  #if ACE_TIME_HAS_MMAP
+    /**
+     * Map the database file at `path` into memory as read-only. Returns
+     * kStatusOk if the file was mapped and its records are valid.
+     */
+    uint8_t openFile(const char* path);
+  #endif
+
+    /** Unmap the file (if any), and invalidate the database. */
+    void close();
+
+    /** Return the status of the last initFromBuffer() or openFile(). */
+    uint8_t status() const { return mStatus; }
+
+    /** Return true if the database was loaded successfully. */
+    bool isValid() const { return mStatus == kStatusOk; }
+
+    /** Return the number of ZoneInfo entries (Zones and Links). */
+    uint16_t zoneRegistrySize() const {
+      return isValid() ? header()->numZones : 0;
+    }
+
+    /**
+     * Return the zone registry, for use by the mapped::ZoneRegistrar or
+     * MappedZoneManager. See mapped::Info::ZoneRegistryBroker.
+     */
+    const mapped::Info::ZoneInfo* const* zoneRegistry() const {
+      return isValid()
+          ? (const mapped::Info::ZoneInfo* const*)
+              mapped::Info::resolve<int32_t>(header()->registry)
+          : nullptr;
+    }
+
+    /** Return the ZoneContext of the database, or nullptr if not valid. */
+    const mapped::Info::ZoneContext* zoneContext() const {
+      return isValid()
+          ? mapped::Info::resolve<mapped::Info::ZoneContext>(
+              header()->zoneContext)
+          : nullptr;
+    }
+
+  private:
+    // disable copy constructor and assignment operator
+    MappedZoneDatabase(const MappedZoneDatabase&) = delete;
+    MappedZoneDatabase& operator=(const MappedZoneDatabase&) = delete;
+
+    const mapped::Info::Header* header() const {
+      return (const mapped::Info::Header*) mData;
+    }
+
+    using Header = mapped::Info::Header;
+    using ZoneContext = mapped::Info::ZoneContext;
+    using ZoneInfo = mapped::Info::ZoneInfo;
+    using ZoneEra = mapped::Info::ZoneEra;
+    using ZonePolicy = mapped::Info::ZonePolicy;
+    using ZoneRule = mapped::Info::ZoneRule;
+
+    /**
+     * Validate the Header of the buffer of the given size, and every offset
+     * reachable from it.
+     */
+    static uint8_t validate(const void* data, size_t size);
+
+    /**
+     * Return true if the name, eras, policies, rules and FORMAT strings of
+     * the ZoneInfo are within the file, and its rules refer to the letters of
+     * the context. A Link also validates its target, which must be a Zone.
+     */
+    static bool isValidZoneInfo(
+        const void* data,
+        uint32_t fileSize,
+        const ZoneContext* context,
+        const ZoneInfo* info,
+        bool isTarget);
+
+    /**
+     * Return the record of `size` bytes at the self-relative `offset`, or
+     * nullptr if the offset is 0, or if the record is not aligned on a 4-byte
+     * boundary or does not fit between the Header and fileSize.
+     */
+    static const void* findRecord(
+        const void* data, uint32_t fileSize, const int32_t& offset,
+        size_t size);
+
+    /**
+     * Return true if the self-relative `offset` points to a NUL-terminated
+     * string within the file.
+     */
+    static bool isValidString(
+        const void* data, uint32_t fileSize, const int32_t& offset);
+
+  private:
+    const void* mData = nullptr;
+    size_t mSize = 0;
+    internal::MappedFile mMappedFile; // the file mapped by openFile()
+    uint8_t mStatus = kStatusNotLoaded;
+};
+
+}
+
+#endif
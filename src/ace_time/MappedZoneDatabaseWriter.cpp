@@ -0,0 +1,366 @@
+/*
+ * MIT License
+ * Copyright (c) 2026 Brian T. Park
+ */
+
+#include <string.h> // memcpy(), memset()
+#include "MappedZoneDatabase.h" // kMagic
+#include "MappedZoneDatabaseWriter.h"
+
+namespace ace_time {
+
+using Header = mapped::Info::Header;
+using MappedContext = mapped::Info::ZoneContext;
+using MappedInfo = mapped::Info::ZoneInfo;
+using MappedEra = mapped::Info::ZoneEra;
+using MappedPolicy = mapped::Info::ZonePolicy;
+using MappedRule = mapped::Info::ZoneRule;
+
+/** Floor of n/15, for the 15-second time codes of negative offsets. */
+static int32_t floorDiv15(int32_t n) {
+  return (n >= 0) ? n / 15 : -((-n + 14) / 15);
+}
+
+size_t MappedZoneDatabaseWriter::writeTo(
+    uint8_t* buffer, size_t bufferSize) const {
+  if (mZoneRegistrySize == 0) return 0;
+
+  // Measure the variable length sections without writing anything.
+  Layout layout;
+  memset(&layout, 0, sizeof(layout));
+  Cursors sizes;
+  writeRecords(nullptr, layout, sizes);
+
+  const complete::Info::ZoneRegistryBroker registry(mZoneRegistry);
+  complete::Info::ZoneContextBroker context =
+      complete::Info::ZoneInfoBroker(registry.zoneInfo(0)).zoneContext();
+
+  uint32_t pos = sizeof(Header);
+  layout.zoneContext = pos;
+  pos += sizeof(MappedContext);
+  layout.letters = pos;
+  pos += context.numLetters() * sizeof(int32_t);
+  layout.registry = pos;
+  pos += mZoneRegistrySize * sizeof(int32_t);
+  layout.infos = pos;
+  pos += mZoneRegistrySize * sizeof(MappedInfo);
+  layout.eras = pos;
+  pos += sizes.era;
+  layout.policies = pos;
+  pos += sizes.policy;
+  layout.rules = pos;
+  pos += sizes.rule;
+  layout.strings = pos;
+  pos += sizes.string;
+  layout.fileSize = (pos + 3) & ~(uint32_t) 3;
+
+  if (buffer == nullptr || bufferSize < layout.fileSize) {
+    return layout.fileSize;
+  }
+
+  memset(buffer, 0, layout.fileSize);
+  Header header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, MappedZoneDatabase::kMagic, sizeof(header.magic));
+  header.formatVersion = Header::kFormatVersion;
+  header.headerSize = sizeof(Header);
+  header.byteOrderMark = Header::kByteOrderMark;
+  header.fileSize = layout.fileSize;
+  header.numZones = mZoneRegistrySize;
+  memcpy(buffer, &header, sizeof(header));
+  writeOffset(buffer, offsetof(Header, zoneContext), layout.zoneContext);
+  writeOffset(buffer, offsetof(Header, registry), layout.registry);
+
+  Cursors cursors;
+  writeRecords(buffer, layout, cursors);
+  return layout.fileSize;
+}
+
+void MappedZoneDatabaseWriter::writeRecords(
+    uint8_t* buffer, const Layout& layout, Cursors& cursors) const {
+  const complete::Info::ZoneRegistryBroker registry(mZoneRegistry);
+  complete::Info::ZoneContextBroker context =
+      complete::Info::ZoneInfoBroker(registry.zoneInfo(0)).zoneContext();
+  cursors.era = layout.eras;
+  cursors.policy = layout.policies;
+  cursors.rule = layout.rules;
+  cursors.string = layout.strings;
+
+  // ZoneContext, and the tzVersion and letters at the start of the strings.
+  if (buffer) {
+    MappedContext c;
+    memset(&c, 0, sizeof(c));
+    c.startYear = context.startYear();
+    c.untilYear = context.untilYear();
+    c.startYearAccurate = context.startYearAccurate();
+    c.untilYearAccurate = context.untilYearAccurate();
+    c.baseYear = context.baseYear();
+    c.maxTransitions = context.maxTransitions();
+    c.numLetters = context.numLetters();
+    memcpy(buffer + layout.zoneContext, &c, sizeof(c));
+    writeOffset(buffer, layout.zoneContext + offsetof(MappedContext, tzVersion),
+        cursors.string);
+    writeOffset(buffer, layout.zoneContext + offsetof(MappedContext, letters),
+        layout.letters);
+  }
+  cursors.string += copyString(
+      buffer ? buffer + cursors.string : nullptr,
+      (const char*) context.tzVersion());
+  for (uint8_t l = 0; l < context.numLetters(); l++) {
+    if (buffer) {
+      writeOffset(buffer, layout.letters + l * sizeof(int32_t),
+          cursors.string);
+    }
+    cursors.string += copyString(
+        buffer ? buffer + cursors.string : nullptr,
+        (const char*) context.letter(l));
+  }
+
+  // Registry and ZoneInfo records, and the names. The eras of each owner
+  // zone are assigned in registry order.
+  for (uint16_t i = 0; i < mZoneRegistrySize; i++) {
+    complete::Info::ZoneInfoBroker info(registry.zoneInfo(i));
+    uint32_t infoPos = layout.infos + i * sizeof(MappedInfo);
+    uint16_t owner = findErasOwner(i);
+    if (buffer) {
+      writeOffset(buffer, layout.registry + i * sizeof(int32_t), infoPos);
+
+      MappedInfo record;
+      memset(&record, 0, sizeof(record));
+      record.zoneId = info.zoneId();
+      record.numEras = info.numEras();
+      memcpy(buffer + infoPos, &record, sizeof(record));
+      writeOffset(buffer, infoPos + offsetof(MappedInfo, name),
+          cursors.string);
+      writeOffset(buffer, infoPos + offsetof(MappedInfo, zoneContext),
+          layout.zoneContext);
+      uint32_t eras = (owner == i)
+          ? cursors.era
+          : readOffset(buffer, layout.infos + owner * sizeof(MappedInfo)
+              + offsetof(MappedInfo, eras));
+      writeOffset(buffer, infoPos + offsetof(MappedInfo, eras), eras);
+      if (info.isLink()) {
+        uint16_t target = findIndexForId(info.targetInfo().zoneId());
+        if (target != mZoneRegistrySize) {
+          writeOffset(buffer, infoPos + offsetof(MappedInfo, targetInfo),
+              layout.infos + target * sizeof(MappedInfo));
+        }
+      }
+    }
+    cursors.string += copyName(
+        buffer ? buffer + cursors.string : nullptr, info);
+    if (owner == i) cursors.era += info.numEras() * sizeof(MappedEra);
+  }
+
+  // ZoneEra records, which write the ZonePolicy, ZoneRule and FORMAT strings
+  // the first time they are referenced.
+  for (uint16_t i = 0; i < mZoneRegistrySize; i++) {
+    if (findErasOwner(i) == i) writeEras(buffer, layout, i, cursors);
+  }
+}
+
+void MappedZoneDatabaseWriter::writeEras(uint8_t* buffer,
+    const Layout& layout, uint16_t i, Cursors& cursors) const {
+  const complete::Info::ZoneRegistryBroker registry(mZoneRegistry);
+  complete::Info::ZoneInfoBroker info(registry.zoneInfo(i));
+  complete::Info::ZoneContextBroker context = info.zoneContext();
+
+  for (uint8_t e = 0; e < info.numEras(); e++) {
+    complete::Info::ZoneEraBroker era = info.era(e);
+    uint32_t eraPos = buffer ? eraPosition(buffer, layout, i, e) : 0;
+    if (buffer) {
+      MappedEra record;
+      memset(&record, 0, sizeof(record));
+      int32_t offsetSeconds = era.offsetSeconds();
+      record.offsetCode = (int16_t) floorDiv15(offsetSeconds);
+      record.offsetRemainder =
+          (uint8_t) (offsetSeconds - 15 * record.offsetCode);
+      record.deltaMinutes = (int8_t) (era.deltaSeconds() / 60);
+      record.untilYear = era.untilYear();
+      record.untilMonth = era.untilMonth();
+      record.untilDay = era.untilDay();
+      uint32_t untilSeconds = era.untilTimeSeconds();
+      record.untilTimeCode = (uint16_t) (untilSeconds / 15);
+      record.untilTimeModifier =
+          (uint8_t) (era.untilTimeSuffix() | (untilSeconds % 15));
+      memcpy(buffer + eraPos, &record, sizeof(record));
+    }
+
+    uint16_t firstZone;
+    uint8_t firstEra;
+
+    // ZonePolicy and its ZoneRules
+    complete::Info::ZonePolicyBroker policy = era.zonePolicy();
+    if (! policy.isNull()) {
+      findFirstEra(i, e, false /*byFormat*/, firstZone, firstEra);
+      uint32_t field = eraPos + offsetof(MappedEra, zonePolicy);
+      if (firstZone == i && firstEra == e) {
+        if (buffer) {
+          writeOffset(buffer, field, cursors.policy);
+          MappedPolicy p;
+          memset(&p, 0, sizeof(p));
+          p.numRules = policy.numRules();
+          memcpy(buffer + cursors.policy, &p, sizeof(p));
+          writeOffset(buffer, cursors.policy + offsetof(MappedPolicy, rules),
+              cursors.rule);
+        }
+        cursors.policy += sizeof(MappedPolicy);
+
+        for (uint8_t r = 0; r < policy.numRules(); r++) {
+          if (buffer) {
+            complete::Info::ZoneRuleBroker rule = policy.rule(r);
+            MappedRule record;
+            memset(&record, 0, sizeof(record));
+            record.fromYear = rule.fromYear();
+            record.toYear = rule.toYear();
+            record.inMonth = rule.inMonth();
+            record.onDayOfWeek = rule.onDayOfWeek();
+            record.onDayOfMonth = rule.onDayOfMonth();
+            uint32_t atSeconds = rule.atTimeSeconds();
+            record.atTimeCode = (uint16_t) (atSeconds / 15);
+            record.atTimeModifier =
+                (uint8_t) (rule.atTimeSuffix() | (atSeconds % 15));
+            record.deltaMinutes = (int8_t) (rule.deltaSeconds() / 60);
+            record.letterIndex = findLetterIndex(context, rule.letter());
+            memcpy(buffer + cursors.rule, &record, sizeof(record));
+          }
+          cursors.rule += sizeof(MappedRule);
+        }
+      } else if (buffer) {
+        writeOffset(buffer, field, readOffset(buffer,
+            eraPosition(buffer, layout, firstZone, firstEra)
+                + offsetof(MappedEra, zonePolicy)));
+      }
+    }
+
+    // FORMAT string
+    findFirstEra(i, e, true /*byFormat*/, firstZone, firstEra);
+    uint32_t field = eraPos + offsetof(MappedEra, format);
+    if (firstZone == i && firstEra == e) {
+      if (buffer) writeOffset(buffer, field, cursors.string);
+      cursors.string += copyString(
+          buffer ? buffer + cursors.string : nullptr, era.format());
+    } else if (buffer) {
+      writeOffset(buffer, field, readOffset(buffer,
+          eraPosition(buffer, layout, firstZone, firstEra)
+              + offsetof(MappedEra, format)));
+    }
+  }
+}
+
+uint16_t MappedZoneDatabaseWriter::findErasOwner(uint16_t i) const {
+  const complete::Info::ZoneRegistryBroker registry(mZoneRegistry);
+  complete::Info::ZoneInfoBroker info(registry.zoneInfo(i));
+  for (uint16_t j = 0; j < i; j++) {
+    complete::Info::ZoneInfoBroker other(registry.zoneInfo(j));
+    if (other.numEras() == info.numEras()
+        && other.era(0).equals(info.era(0))) {
+      return j;
+    }
+  }
+  return i;
+}
+
+void MappedZoneDatabaseWriter::findFirstEra(uint16_t i, uint8_t e,
+    bool byFormat, uint16_t& firstZone, uint8_t& firstEra) const {
+  const complete::Info::ZoneRegistryBroker registry(mZoneRegistry);
+  complete::Info::ZoneEraBroker target =
+      complete::Info::ZoneInfoBroker(registry.zoneInfo(i)).era(e);
+  const char* format = target.format();
+  complete::Info::ZonePolicyBroker policy = target.zonePolicy();
+
+  for (uint16_t z = 0; z <= i; z++) {
+    complete::Info::ZoneInfoBroker info(registry.zoneInfo(z));
+    uint8_t numEras = (z == i) ? e : info.numEras();
+    for (uint8_t f = 0; f < numEras; f++) {
+      complete::Info::ZoneEraBroker era = info.era(f);
+      bool match = byFormat
+          ? era.format() == format
+          : era.zonePolicy().equals(policy);
+      if (match) {
+        firstZone = z;
+        firstEra = f;
+        return;
+      }
+    }
+  }
+  firstZone = i;
+  firstEra = e;
+}
+
+uint32_t MappedZoneDatabaseWriter::eraPosition(const uint8_t* buffer,
+    const Layout& layout, uint16_t i, uint8_t e) {
+  uint32_t eras = readOffset(buffer,
+      layout.infos + i * sizeof(MappedInfo) + offsetof(MappedInfo, eras));
+  return eras + e * sizeof(MappedEra);
+}
+
+uint16_t MappedZoneDatabaseWriter::findIndexForId(uint32_t zoneId) const {
+  const complete::Info::ZoneRegistryBroker registry(mZoneRegistry);
+  for (uint16_t i = 0; i < mZoneRegistrySize; i++) {
+    if (complete::Info::ZoneInfoBroker(registry.zoneInfo(i)).zoneId()
+        == zoneId) {
+      return i;
+    }
+  }
+  return mZoneRegistrySize;
+}
+
+uint8_t MappedZoneDatabaseWriter::findLetterIndex(
+    const complete::Info::ZoneContextBroker& context,
+    const __FlashStringHelper* letter) {
+  for (uint8_t l = 0; l < context.numLetters(); l++) {
+    if (context.letter(l) == letter) return l;
+  }
+  return 0;
+}
+
+uint32_t MappedZoneDatabaseWriter::copyString(uint8_t* buffer, const char* s) {
+  uint32_t n = 0;
+  char c;
+  do {
+    c = (char) pgm_read_byte(s + n);
+    if (buffer) buffer[n] = (uint8_t) c;
+    n++;
+  } while (c != '\0');
+  return n;
+}
+
+uint32_t MappedZoneDatabaseWriter::copyName(uint8_t* buffer,
+    const complete::Info::ZoneInfoBroker& zoneInfo) {
+  complete::Info::ZoneContextBroker context = zoneInfo.zoneContext();
+  const char* name = (const char*) zoneInfo.name();
+  const char* const* fragments = (const char* const*) context.fragments();
+  uint8_t numFragments = context.numFragments();
+
+  uint32_t n = 0;
+  for (const char* p = name; ; p++) {
+    uint8_t c = pgm_read_byte(p);
+    if (c == 0) break;
+    if (c < 0x20 && c < numFragments) {
+      // Expand the KString keyword reference.
+      const char* fragment = (const char*) pgm_read_ptr(fragments + c);
+      n += copyString(buffer ? buffer + n : nullptr, fragment) - 1;
+    } else {
+      if (buffer) buffer[n] = c;
+      n++;
+    }
+  }
+  if (buffer) buffer[n] = '\0';
+  return n + 1;
+}
+
+void MappedZoneDatabaseWriter::writeOffset(
+    uint8_t* buffer, uint32_t pos, uint32_t target) {
+  int32_t offset = (int32_t) (target - pos);
+  memcpy(buffer + pos, &offset, sizeof(offset));
+}
+
+uint32_t MappedZoneDatabaseWriter::readOffset(
+    const uint8_t* buffer, uint32_t pos) {
+  int32_t offset;
+  memcpy(&offset, buffer + pos, sizeof(offset));
+  return pos + offset;
+}
+
+}
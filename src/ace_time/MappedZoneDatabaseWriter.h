@@ -0,0 +1,145 @@
+/*
+ * MIT License
+ * Copyright (c) 2026 Brian T. Park
+ */
+
+#ifndef ACE_TIME_MAPPED_ZONE_DATABASE_WRITER_H
+#define ACE_TIME_MAPPED_ZONE_DATABASE_WRITER_H
+
+#include <stdint.h>
+#include <stddef.h> // size_t
+#include "../zoneinfo/infos.h"
+
+namespace ace_time {
+
+/**
+ * Serializes a registry of complete::Info::ZoneInfo records (e.g. the
+ * zonedbc::kZoneAndLinkRegistry) into the binary format defined by
+ * ZoneInfoMapped.h, which can be saved to a file and loaded at runtime by
+ * MappedZoneDatabase.
+ *
+ * The ZoneEra arrays shared between a Link and its Zone, the ZonePolicy
+ * records shared by multiple ZoneEras, and the FORMAT strings are written
+ * only once. The zone names are expanded from their KString compression. The
+ * registry must be sorted by zoneId, like the registries in 'zonedbc', for
+ * the binary search of the ZoneRegistrar.
+ *
+ * This is intended to be run once on a host machine (e.g. through
+ * EpoxyDuino). It does not allocate memory, so some of the deduplication
+ * uses O(N^2) searches.
+ */
+class MappedZoneDatabaseWriter {
+  public:
+    /**
+     * Constructor.
+     *
+     * @param zoneRegistrySize number of ZoneInfo entries in zoneRegistry
+     * @param zoneRegistry an array of ZoneInfo entries, sorted by zoneId
+     */
+    MappedZoneDatabaseWriter(
+        uint16_t zoneRegistrySize,
+        const complete::Info::ZoneInfo* const* zoneRegistry
+    ) :
+        mZoneRegistrySize(zoneRegistrySize),
+        mZoneRegistry(zoneRegistry)
+    {}
+
+    /**
+     * Write the database into the buffer, which should be aligned on a 4-byte
+     * boundary. Returns the size of the database in bytes. If the buffer is
+     * nullptr or smaller than that size, nothing is written, so the required
+     * size can be obtained by calling writeTo(nullptr, 0). Returns 0 if
+     * the registry is empty.
+     */
+    size_t writeTo(uint8_t* buffer, size_t bufferSize) const;
+
+  private:
+    /** Offsets of the sections of the file, from the start of the file. */
+    struct Layout {
+      uint32_t zoneContext;
+      uint32_t letters;
+      uint32_t registry;
+      uint32_t infos;
+      uint32_t eras;
+      uint32_t policies;
+      uint32_t rules;
+      uint32_t strings;
+      uint32_t fileSize;
+    };
+
+    /** Cursors for the records of variable length sections. */
+    struct Cursors {
+      uint32_t era;
+      uint32_t policy;
+      uint32_t rule;
+      uint32_t string;
+    };
+
+    /**
+     * Write the records of every section after the Header into buffer, using
+     * the section offsets of layout, and return the final position of each
+     * section in `cursors`. If buffer is nullptr, nothing is written, and
+     * the layout of zeros yields the size of the variable length sections.
+     */
+    void writeRecords(uint8_t* buffer, const Layout& layout,
+        Cursors& cursors) const;
+
+    /** Write the ZoneEra records of zone i, which owns its eras. */
+    void writeEras(uint8_t* buffer, const Layout& layout, uint16_t i,
+        Cursors& cursors) const;
+
+    /**
+     * Return the index of an earlier zone which uses the same ZoneEra array
+     * as zone i, or i if the eras of zone i are not shared with an earlier
+     * zone.
+     */
+    uint16_t findErasOwner(uint16_t i) const;
+
+    /**
+     * Find the first era (in registry order) which uses the same ZonePolicy
+     * as era e of zone i, or the same FORMAT string if `byFormat` is true.
+     * The first era always belongs to a zone which owns its eras.
+     */
+    void findFirstEra(uint16_t i, uint8_t e, bool byFormat,
+        uint16_t& firstZone, uint8_t& firstEra) const;
+
+    /** Return the position of era e of zone i written into buffer. */
+    static uint32_t eraPosition(const uint8_t* buffer, const Layout& layout,
+        uint16_t i, uint8_t e);
+
+    /** Return the registry index of the zone with the given zoneId. */
+    uint16_t findIndexForId(uint32_t zoneId) const;
+
+    /** Return the index of the letter in the ZoneContext. */
+    static uint8_t findLetterIndex(
+        const complete::Info::ZoneContextBroker& context,
+        const __FlashStringHelper* letter);
+
+    /**
+     * Copy the c-string in flash memory into buffer (if not nullptr).
+     * Returns the number of bytes, including the NUL terminator.
+     */
+    static uint32_t copyString(uint8_t* buffer, const char* s);
+
+    /**
+     * Copy the name of the zone into buffer (if not nullptr), expanding the
+     * KString fragments. Returns the number of bytes, including the NUL
+     * terminator.
+     */
+    static uint32_t copyName(uint8_t* buffer,
+        const complete::Info::ZoneInfoBroker& zoneInfo);
+
+    /** Write the self-relative offset of target into the field at pos. */
+    static void writeOffset(uint8_t* buffer, uint32_t pos, uint32_t target);
+
+    /** Return the target of the self-relative offset field at pos. */
+    static uint32_t readOffset(const uint8_t* buffer, uint32_t pos);
+
+  private:
+    uint16_t const mZoneRegistrySize;
+    const complete::Info::ZoneInfo* const* const mZoneRegistry;
+};
+
+}
+
+#endif
@@ -0,0 +1,42 @@
+/*
+ * MIT License
+ * Copyright (c) 2026 Brian T. Park
+ */
+
+#ifndef ACE_TIME_MAPPED_ZONE_PROCESSOR_H
+#define ACE_TIME_MAPPED_ZONE_PROCESSOR_H
+
+#include <stdint.h> // uintptr_t
+#include "ExtendedZoneProcessor.h"
+
+namespace ace_time {
+
+/**
+ * A specific implementation of ExtendedZoneProcessorTemplate that uses the
+ * mapped::ZoneXxxBrokers classes which read the ZoneInfo records directly
+ * from a binary zone database file loaded by MappedZoneDatabase, instead of
+ * from a 'zonedbc' database compiled into the program.
+ *
+ * The zoneKey is the address of the ZoneInfo record inside the loaded file,
+ * so the MappedZoneDatabase must outlive every TimeZone created from it.
+ */
+class MappedZoneProcessor: public
+  ExtendedZoneProcessorTemplate<mapped::Info> {
+
+  public:
+    /** Unique TimeZone type identifier for MappedZoneProcessor. */
+    static const uint8_t kTypeMapped = 10;
+
+    explicit MappedZoneProcessor(
+        const mapped::Info::ZoneInfo* zoneInfo = nullptr)
+      : ExtendedZoneProcessorTemplate<mapped::Info>(
+          kTypeMapped, &mZoneInfoStore, (uintptr_t) zoneInfo)
+    {}
+
+  private:
+    mapped::Info::ZoneInfoStore mZoneInfoStore;
+};
+
+}
+
+#endif
@@ -8,6 +8,7 @@
 #include "LocalDateTime.h"
 #include "OffsetDateTime.h"
 #include "TimeOffset.h"
+#include "common/DateFormat.h" // formatDate(), formatTime(), formatOffset()
 
 namespace ace_time {
 
@@ -24,6 +25,25 @@ void OffsetDateTime::printTo(Print& printer) const {
   mTimeOffset.printTo(printer);
 }
 
+size_t OffsetDateTime::formatTo(char* buf, size_t len) const {
+  // "yyyy-mm-ddThh:mm:ss" plus "+hh:mm" or "+hh:mm:ss", plus NUL
+  int32_t offsetSeconds = mTimeOffset.toSeconds();
+  size_t size = (offsetSeconds % 60 == 0) ? 26 : 29;
+  if (len < size || isError() || year() > 9999
+      || offsetSeconds < -internal::kMaxFormatOffsetSeconds
+      || offsetSeconds > internal::kMaxFormatOffsetSeconds) {
+    if (len > 0) buf[0] = '\0';
+    return 0;
+  }
+
+  char* p = internal::formatDate(buf, year(), month(), day());
+  *p++ = 'T';
+  p = internal::formatTime(p, hour(), minute(), second());
+  p = internal::formatOffset(p, offsetSeconds);
+  *p = '\0';
+  return p - buf;
+}
+
 OffsetDateTime OffsetDateTime::forDateString(const char* dateString) {
   if (strlen(dateString) < kDateStringLength) {
     return forError();
@@ -36,6 +36,11 @@ namespace ace_time {
  */
 class OffsetDateTime {
   public:
+    /**
+     * Size of the largest buffer needed by formatTo(),
+     * "yyyy-mm-ddThh:mm:ss+hh:mm:ss" plus NUL.
+     */
+    static const uint8_t kFormatBufferSize = 29;
 
     /** Factory method from LocalDateTime and TimeOffset. */
     static OffsetDateTime forLocalDateTimeAndOffset(
@@ -78,10 +83,21 @@ class OffsetDateTime {
      */
     static OffsetDateTime forEpochSeconds(acetime_t epochSeconds,
           TimeOffset timeOffset, uint8_t fold = 0) {
+      return forEpochSeconds(epochSeconds, timeOffset,
+          Epoch::currentContext(), fold);
+    }
+
+    /**
+     * Factory method using the number of seconds since the epoch given by the
+     * explicit `context`, instead of the current epoch.
+     */
+    static OffsetDateTime forEpochSeconds(acetime_t epochSeconds,
+          TimeOffset timeOffset, const EpochContext& context,
+          uint8_t fold = 0) {
       if (epochSeconds != LocalDate::kInvalidEpochSeconds) {
         epochSeconds += timeOffset.toSeconds();
       }
-      auto ldt = LocalDateTime::forEpochSeconds(epochSeconds, fold);
+      auto ldt = LocalDateTime::forEpochSeconds(epochSeconds, context, fold);
       return OffsetDateTime(ldt, timeOffset);
     }
 
@@ -257,8 +273,16 @@ class OffsetDateTime {
      * `Epoch::currentEpochYear()`.
      */
     acetime_t toEpochSeconds() const {
+      return toEpochSeconds(Epoch::currentContext());
+    }
+
+    /**
+     * Return the number of seconds since the epoch given by the explicit
+     * `context`, instead of the current epoch.
+     */
+    acetime_t toEpochSeconds(const EpochContext& context) const {
       if (isError()) return LocalDate::kInvalidEpochSeconds;
-      acetime_t epochSeconds = mLocalDateTime.toEpochSeconds();
+      acetime_t epochSeconds = mLocalDateTime.toEpochSeconds(context);
       if (epochSeconds == LocalDate::kInvalidEpochSeconds) {
         return epochSeconds;
       }
@@ -308,6 +332,17 @@ class OffsetDateTime {
      */
     void printTo(Print& printer) const;
 
+    /**
+     * Write the date time in ISO 8601 (and RFC 3339) format
+     * "yyyy-mm-ddThh:mm:ss+hh:mm" into 'buf', terminated by a NUL. The UTC
+     * offset is written as "+hh:mm:ss" if its seconds is not 0, like
+     * TimeOffset::printTo(). A buffer of size kFormatBufferSize is always
+     * large enough. Return the number of characters written, excluding the
+     * NUL, or 0 if the buffer is too small, the date time is an error, the
+     * year is greater than 9999, or the UTC offset is 100 hours or more.
+     */
+    size_t formatTo(char* buf, size_t len) const;
+
     // Use default copy constructor and assignment operator.
     OffsetDateTime(const OffsetDateTime&) = default;
     OffsetDateTime& operator=(const OffsetDateTime&) = default;
@@ -0,0 +1,196 @@
+/*
+ * MIT License
+ * Copyright (c) 2026 Brian T. Park
+ */
+
+#include "LocalDate.h"
+#include "PosixTimeZone.h"
+
+namespace ace_time {
+
+bool PosixTimeZone::parse(const char* s, size_t len) {
+  mIsValid = false;
+  mHasDst = false;
+  mDstAbbrev[0] = '\0';
+  const char* p = s;
+  const char* end = s + len;
+
+  // STD abbreviation and offset. The POSIX offset is positive west of UTC.
+  int32_t offset;
+  if (!parseAbbrev(p, end, mStdAbbrev)) return false;
+  if (!parseOffset(p, end, 24, offset)) return false;
+  mStdOffsetSeconds = -offset;
+  mDstOffsetSeconds = mStdOffsetSeconds;
+  if (p == end) {
+    mIsValid = true;
+    return true;
+  }
+
+  // DST abbreviation, and optional offset which defaults to 1 hour ahead.
+  if (!parseAbbrev(p, end, mDstAbbrev)) return false;
+  if (p != end && *p != ',') {
+    if (!parseOffset(p, end, 24, offset)) return false;
+    mDstOffsetSeconds = -offset;
+  } else {
+    mDstOffsetSeconds = mStdOffsetSeconds + 3600;
+  }
+
+  // Start and end rules, with the US rules as the default.
+  if (p == end) {
+    mStartRule = {kRuleMonth, 3, 2, 0, 0, 7200};
+    mEndRule = {kRuleMonth, 11, 1, 0, 0, 7200};
+  } else {
+    if (*p++ != ',') return false;
+    if (!parseRule(p, end, mStartRule)) return false;
+    if (p == end || *p++ != ',') return false;
+    if (!parseRule(p, end, mEndRule)) return false;
+    if (p != end) return false;
+  }
+
+  mHasDst = true;
+  mIsValid = true;
+  return true;
+}
+
+void PosixTimeZone::findForUnixSeconds(
+    int64_t unixSeconds, LocalTimeType& type) const {
+  type.stdOffsetSeconds = mStdOffsetSeconds;
+  if (mHasDst) {
+    // The rules are evaluated in the year of the local standard time. The
+    // start time is expressed in STD, the end time is expressed in DST.
+    int16_t year = LocalDate::forUnixSeconds64(
+        unixSeconds + mStdOffsetSeconds).year();
+    int64_t start = ruleToUnixSeconds(mStartRule, year) - mStdOffsetSeconds;
+    int64_t end = ruleToUnixSeconds(mEndRule, year) - mDstOffsetSeconds;
+    bool isDst = (start < end)
+        ? (start <= unixSeconds && unixSeconds < end) // northern hemisphere
+        : !(end <= unixSeconds && unixSeconds < start); // southern hemisphere
+    if (isDst) {
+      type.utcOffsetSeconds = mDstOffsetSeconds;
+      type.abbrev = mDstAbbrev;
+      return;
+    }
+  }
+  type.utcOffsetSeconds = mStdOffsetSeconds;
+  type.abbrev = mStdAbbrev;
+}
+
+int64_t PosixTimeZone::ruleToUnixSeconds(const Rule& rule, int16_t year) {
+  int32_t days;
+  if (rule.kind == kRuleMonth) {
+    LocalDate first = LocalDate::forComponents(year, rule.month, 1);
+    uint8_t firstDayOfWeek = first.dayOfWeek() % 7; // ISO 7 (Sunday) -> 0
+    uint8_t day = 1 + (rule.dayOfWeek + 7 - firstDayOfWeek) % 7
+        + (rule.week - 1) * 7;
+    uint8_t daysInMonth = LocalDate::daysInMonth(year, rule.month);
+    while (day > daysInMonth) day -= 7;
+    days = first.toUnixDays() + day - 1;
+  } else {
+    days = LocalDate::forComponents(year, 1, 1).toUnixDays() + rule.day;
+    if (rule.kind == kRuleJulian) {
+      days--;
+      if (rule.day >= 60 && LocalDate::isLeapYear(year)) days++;
+    }
+  }
+  return (int64_t) 86400 * days + rule.timeSeconds;
+}
+
+bool PosixTimeZone::parseAbbrev(
+    const char*& p, const char* end, char* abbrev) {
+  const char* begin;
+  const char* stop;
+  if (p != end && *p == '<') {
+    begin = ++p;
+    while (p != end && *p != '>') p++;
+    if (p == end) return false;
+    stop = p++;
+  } else {
+    begin = p;
+    while (p != end
+        && ((*p >= 'A' && *p <= 'Z') || (*p >= 'a' && *p <= 'z'))) {
+      p++;
+    }
+    stop = p;
+  }
+  if (stop == begin) return false;
+
+  // Truncate to the size of the abbreviations of the zonedb databases.
+  uint8_t i = 0;
+  for (; begin != stop && i < kAbbrevSize - 1; begin++, i++) {
+    abbrev[i] = *begin;
+  }
+  abbrev[i] = '\0';
+  return true;
+}
+
+bool PosixTimeZone::parseOffset(const char*& p, const char* end,
+    int32_t maxHours, int32_t& seconds) {
+  bool negative = false;
+  if (p != end && (*p == '+' || *p == '-')) {
+    negative = (*p == '-');
+    p++;
+  }
+  int32_t hours;
+  int32_t minutes = 0;
+  int32_t secs = 0;
+  if (!parseNumber(p, end, maxHours, hours)) return false;
+  if (p != end && *p == ':') {
+    p++;
+    if (!parseNumber(p, end, 59, minutes)) return false;
+    if (p != end && *p == ':') {
+      p++;
+      if (!parseNumber(p, end, 59, secs)) return false;
+    }
+  }
+  seconds = hours * 3600 + minutes * 60 + secs;
+  if (negative) seconds = -seconds;
+  return true;
+}
+
+bool PosixTimeZone::parseRule(const char*& p, const char* end, Rule& rule) {
+  int32_t value;
+  if (p == end) return false;
+  if (*p == 'M') {
+    p++;
+    rule.kind = kRuleMonth;
+    if (!parseNumber(p, end, 12, value) || value < 1) return false;
+    rule.month = value;
+    if (p == end || *p++ != '.') return false;
+    if (!parseNumber(p, end, 5, value) || value < 1) return false;
+    rule.week = value;
+    if (p == end || *p++ != '.') return false;
+    if (!parseNumber(p, end, 6, value)) return false;
+    rule.dayOfWeek = value;
+    rule.day = 0;
+  } else if (*p == 'J') {
+    p++;
+    rule.kind = kRuleJulian;
+    if (!parseNumber(p, end, 365, value) || value < 1) return false;
+    rule.day = value;
+  } else {
+    rule.kind = kRuleDay;
+    if (!parseNumber(p, end, 365, value)) return false;
+    rule.day = value;
+  }
+
+  rule.timeSeconds = 7200;
+  if (p != end && *p == '/') {
+    p++;
+    if (!parseOffset(p, end, 167, rule.timeSeconds)) return false;
+  }
+  return true;
+}
+
+bool PosixTimeZone::parseNumber(const char*& p, const char* end,
+    int32_t maxValue, int32_t& value) {
+  const char* begin = p;
+  value = 0;
+  while (p != end && *p >= '0' && *p <= '9') {
+    value = value * 10 + (*p - '0');
+    if (value > maxValue) return false;
+    p++;
+  }
+  return p != begin;
+}
+
+}
@@ -0,0 +1,108 @@
+/*
+ * MIT License
+ * Copyright (c) 2026 Brian T. Park
+ */
+
+#ifndef ACE_TIME_POSIX_TIME_ZONE_H
+#define ACE_TIME_POSIX_TIME_ZONE_H
+
+#include <stdint.h>
+#include <stddef.h> // size_t
+#include "common/common.h" // kAbbrevSize
+
+namespace ace_time {
+
+/**
+ * A time zone rule in the format of the POSIX TZ environment variable (e.g.
+ * "PST8PDT,M3.2.0,M11.1.0"), which is stored in the footer of TZif files
+ * (RFC 8536) to describe the local time after the last transition of the
+ * file. It supports the extensions of TZif version 3: quoted abbreviations
+ * (e.g. "<+0330>") and transition times from -167 to 167 hours.
+ *
+ * If the DST part is present without a rule, the US rule "M3.2.0,M11.1.0" is
+ * assumed, as in most implementations of POSIX.
+ */
+class PosixTimeZone {
+  public:
+    /** Local time type returned by findForUnixSeconds(). */
+    struct LocalTimeType {
+      /** Total UTC offset (STD + DST) in seconds. */
+      int32_t utcOffsetSeconds;
+
+      /** STD offset in seconds. */
+      int32_t stdOffsetSeconds;
+
+      /** Abbreviation, owned by the PosixTimeZone. */
+      const char* abbrev;
+    };
+
+    /** Constructor. The object is not valid until parse() succeeds. */
+    PosixTimeZone() = default;
+
+    /**
+     * Parse the TZ string of `len` characters, which does not need to be
+     * NUL-terminated. Returns false if the string is invalid or empty, and
+     * the object is marked as not valid.
+     */
+    bool parse(const char* s, size_t len);
+
+    /** Return true if the last parse() succeeded. */
+    bool isValid() const { return mIsValid; }
+
+    /** Return true if the zone observes DST. */
+    bool hasDst() const { return mHasDst; }
+
+    /** Return the STD offset in seconds, positive east of UTC. */
+    int32_t stdOffsetSeconds() const { return mStdOffsetSeconds; }
+
+    /** Return the UTC offset during DST in seconds, positive east of UTC. */
+    int32_t dstOffsetSeconds() const { return mDstOffsetSeconds; }
+
+    /** Return the abbreviation during STD. */
+    const char* stdAbbrev() const { return mStdAbbrev; }
+
+    /** Return the abbreviation during DST. */
+    const char* dstAbbrev() const { return mDstAbbrev; }
+
+    /** Find the local time type at the given seconds from the Unix epoch. */
+    void findForUnixSeconds(int64_t unixSeconds, LocalTimeType& type) const;
+
+  private:
+    static const uint8_t kRuleJulian = 0; // Jn, 1-365, skips Feb 29
+    static const uint8_t kRuleDay = 1; // n, 0-365, counts Feb 29
+    static const uint8_t kRuleMonth = 2; // Mm.w.d
+
+    /** A DST start or end rule. */
+    struct Rule {
+      uint8_t kind;
+      uint8_t month; // 1-12
+      uint8_t week; // 1-5, 5 is the last week
+      uint8_t dayOfWeek; // 0-6, 0 is Sunday
+      int16_t day; // day of year for kRuleJulian and kRuleDay
+      int32_t timeSeconds; // local time of transition, -167h to 167h
+    };
+
+    /** Return the seconds from the Unix epoch of the rule in the year. */
+    static int64_t ruleToUnixSeconds(const Rule& rule, int16_t year);
+
+    static bool parseAbbrev(const char*& p, const char* end, char* abbrev);
+    static bool parseOffset(const char*& p, const char* end,
+        int32_t maxHours, int32_t& seconds);
+    static bool parseRule(const char*& p, const char* end, Rule& rule);
+    static bool parseNumber(const char*& p, const char* end,
+        int32_t maxValue, int32_t& value);
+
+  private:
+    Rule mStartRule;
+    Rule mEndRule;
+    int32_t mStdOffsetSeconds = 0;
+    int32_t mDstOffsetSeconds = 0;
+    char mStdAbbrev[kAbbrevSize] = {0};
+    char mDstAbbrev[kAbbrevSize] = {0};
+    bool mHasDst = false;
+    bool mIsValid = false;
+};
+
+}
+
+#endif
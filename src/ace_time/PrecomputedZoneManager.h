@@ -0,0 +1,606 @@
+/*
+ * MIT License
+ * Copyright (c) 2026 Brian T. Park
+ */
+
+#ifndef ACE_TIME_PRECOMPUTED_ZONE_MANAGER_H
+#define ACE_TIME_PRECOMPUTED_ZONE_MANAGER_H
+
+#include <stdint.h>
+#include <stddef.h> // size_t
+#include <stdlib.h> // malloc(), realloc(), free()
+#include <string.h> // memcpy()
+#include "../zoneinfo/compat.h" // ACE_TIME_HAS_THREADS
+#include "../zoneinfo/infos.h"
+#include "common/common.h" // kAbbrevSize
+#include "Epoch.h"
+#include "LocalDate.h"
+#include "TimeOffset.h"
+#include "ZoneRegistrar.h"
+#include "ZoneIdIndex.h"
+#include "TimeZoneData.h"
+#include "TimeZone.h"
+#include "Zone.h"
+#include "ZoneManager.h"
+#include "PrecomputedZoneTable.h"
+#include "PrecomputedZoneProcessor.h"
+
+#if ACE_TIME_HAS_THREADS
+  #include <atomic>
+  #include <thread>
+#endif
+
+namespace ace_time {
+
+/**
+ * A ZoneManager which expands every zone of a registry over a range of years
+ * when the application starts, and stores the transitions of all zones in a
+ * single PrecomputedZoneTable. Every zone has its own
+ * PrecomputedZoneProcessor bound to its slice of the table, so a lookup is a
+ * binary search over the transitions of the zone, with no ZoneProcessorCache,
+ * no eviction, and no recalculation of the transitions. It provides the same
+ * factory methods as the ZoneManagerTemplate.
+ *
+ * The table is created by build(), which spreads the zones across threads if
+ * ACE_TIME_HAS_THREADS is enabled, or loaded from the data() of a table
+ * previously built by the same program through initFromBuffer() or
+ * openFile(). The table and the PrecomputedZoneProcessors are allocated on
+ * the heap, so this is intended for Linux, MacOS or the ESP32, not for 8-bit
+ * processors. A Link shares the transitions of its Zone.
+ *
+ * @code
+ * PrecomputedZoneManager manager(
+ *     zonedbc::kZoneAndLinkRegistrySize, zonedbc::kZoneAndLinkRegistry);
+ * manager.build(2000, 2100);
+ * TimeZone tz = manager.createForZoneName("America/Los_Angeles");
+ * @endcode
+ *
+ * The TimeZones can be shared by multiple threads once build() (or the
+ * loading of the table) has returned. They are invalidated by the next call
+ * to build(), initFromBuffer() or openFile(), and by the destruction of the
+ * manager.
+ *
+ * @tparam D container class of the zoneinfo files and brokers
+ * @tparam ZP zone processor used to calculate the transitions
+ * @tparam Z zone wrapper class, ExtendedZone or CompleteZone
+ * @tparam PP PrecomputedZoneProcessorTemplate subclass bound to each zone
+ */
+template <typename D, typename ZP, typename Z, typename PP>
+class PrecomputedZoneManagerTemplate : public ZoneManager {
+  public:
+    /**
+     * Constructor. The TimeZones are errors until the table is built or
+     * loaded.
+     *
+     * @param zoneRegistrySize number of ZoneInfo entries in zoneRegistry
+     * @param zoneRegistry an array of ZoneInfo entries
+     * @param zoneIdIndex optional perfect hash index of the zoneRegistry
+     *    (see ZoneIdIndexTemplate)
+     */
+    PrecomputedZoneManagerTemplate(
+        uint16_t zoneRegistrySize,
+        const typename D::ZoneInfo* const* zoneRegistry,
+        const ZoneIdIndexBase* zoneIdIndex = nullptr
+    ):
+        mZoneRegistrar(zoneRegistrySize, zoneRegistry, zoneIdIndex)
+    {}
+
+    /** Destructor, which releases the table and the ZoneProcessors. */
+    ~PrecomputedZoneManagerTemplate() {
+      delete[] mZoneProcessors;
+    }
+
+    /**
+     * Calculate the transitions of every zone of the registry over the years
+     * [startYear, untilYear). The zones are distributed across numThreads
+     * threads, or across all cores if numThreads is 0. Returns kStatusOk,
+     * kStatusNoMemory if the table could not be allocated, or
+     * kStatusBadYearRange if the range is empty or extends outside of
+     * [Epoch::epochValidYearLower(), Epoch::epochValidYearUpper()], where the
+     * epochSeconds of the current epoch year are valid. The range is not
+     * clamped, so table().startYear() and table().untilYear() are always the
+     * requested years.
+     *
+     * If a zone has more than 255 abbreviations or 65535 transitions, its
+     * year range is silently shortened, like the FlatZoneProcessor.
+     */
+    uint8_t build(int16_t startYear, int16_t untilYear, uint8_t numThreads = 0);
+
+    /**
+     * Use the table stored in the given buffer (e.g. the data() of the
+     * table() of a previous build()), which must be aligned on a 4-byte
+     * boundary and must outlive this object. Returns kStatusOk if the table
+     * is valid and was built from the same zone registry.
+     */
+    uint8_t initFromBuffer(const void* data, size_t size) {
+      mTable.initFromBuffer(data, size);
+      return bindZoneProcessors();
+    }
+
+  #if ACE_TIME_HAS_MMAP
+    /**
+     * Map the table file at `path` into memory as read-only. Returns
+     * kStatusOk if the table is valid and was built from the same zone
+     * registry.
+     */
+    uint8_t openFile(const char* path) {
+      mTable.openFile(path);
+      return bindZoneProcessors();
+    }
+  #endif
+
+    /** Return the status of the last build() or loading of the table. */
+    uint8_t status() const { return mStatus; }
+
+    /**
+     * Return the table, whose data() can be saved to a file, and whose size()
+     * is the memory used by the transitions of all zones.
+     */
+    const PrecomputedZoneTable& table() const { return mTable; }
+
+    /**
+     * Create a TimeZone for the given zone name (e.g. "America/Los_Angeles").
+     */
+    TimeZone createForZoneName(const char* name) {
+      return createForZoneIndex(mZoneRegistrar.findIndexForName(name));
+    }
+
+    /** Create a TimeZone for the given 32-bit zoneId. */
+    TimeZone createForZoneId(uint32_t id) {
+      return createForZoneIndex(mZoneRegistrar.findIndexForId(id));
+    }
+
+    /**
+     * Create a TimeZone for the given index in the ZoneInfo registry that was
+     * used to create this ZoneManager.
+     */
+    TimeZone createForZoneIndex(uint16_t index) {
+      if (! mTable.isValid() || index >= mZoneRegistrar.zoneRegistrySize()) {
+        return TimeZone::forError();
+      }
+      const typename D::ZoneInfo* zoneInfo =
+          mZoneRegistrar.getZoneInfoForIndex(index);
+      return TimeZone::forZoneKey(
+          (uintptr_t) zoneInfo, &mZoneProcessors[index]);
+    }
+
+    /**
+     * Create a TimeZone from the TimeZoneData created by
+     * TimeZone::toTimeZoneData().
+     */
+    TimeZone createForTimeZoneData(const TimeZoneData& d) {
+      switch (d.type) {
+        case TimeZoneData::kTypeError:
+          return TimeZone::forError();
+        case TimeZoneData::kTypeManual:
+          return TimeZone::forTimeOffset(
+              TimeOffset::forMinutes(d.stdOffsetMinutes),
+              TimeOffset::forMinutes(d.dstOffsetMinutes));
+        case TimeZoneData::kTypeZoneId:
+          return createForZoneId(d.zoneId);
+        default:
+          return TimeZone();
+      }
+    }
+
+    /**
+     * Create a TimeZone from an explicit ZoneInfo reference, which must be in
+     * the registry of this ZoneManager.
+     */
+    TimeZone createForZoneInfo(const typename D::ZoneInfo* zoneInfo) {
+      if (! zoneInfo) return TimeZone::forError();
+      return createForZoneId(typename D::ZoneInfoBroker(zoneInfo).zoneId());
+    }
+
+    /**
+     * Find the registry index for the given time zone name. Returns
+     * kInvalidIndex if not found.
+     */
+    uint16_t indexForZoneName(const char* name) const {
+      return mZoneRegistrar.findIndexForName(name);
+    }
+
+    /**
+     * Find the registry index for the given time zone id. Returns
+     * kInvalidIndex if not found.
+     */
+    uint16_t indexForZoneId(uint32_t id) const {
+      return mZoneRegistrar.findIndexForId(id);
+    }
+
+    /** Return the number of elements in the Zone and Fat Link registry. */
+    uint16_t zoneRegistrySize() const {
+      return mZoneRegistrar.zoneRegistrySize();
+    }
+
+    /** Return the Zone wrapper object for the given index. */
+    Z getZoneForIndex(uint16_t index) const {
+      return Z(mZoneRegistrar.getZoneInfoForIndex(index));
+    }
+
+  private:
+    using FlatTransition = flat::FlatTransition;
+    using ZoneEntry = precomputed::ZoneEntry;
+
+    /** The transitions of a zone calculated by a Worker. */
+    struct ZoneResult {
+      /** Index of the first transition in the buffer of the Worker. */
+      uint32_t transitionIndex;
+      /** Index of the first abbreviation in the buffer of the Worker. */
+      uint32_t abbrevIndex;
+      acetime_t untilEpochSeconds;
+      uint16_t numTransitions;
+      uint8_t numAbbrevs;
+      uint8_t worker;
+      /** Index of the target Zone of a Link, or kInvalidIndex. */
+      uint16_t targetIndex;
+    };
+
+    /** The state of a single thread of build(). */
+    struct Worker {
+      ZP zoneProcessor;
+      FlatTransition* transitions = nullptr;
+      uint32_t numTransitions = 0;
+      uint32_t transitionCapacity = 0;
+      char (*abbrevs)[kAbbrevSize] = nullptr;
+      uint32_t numAbbrevs = 0;
+      uint32_t abbrevCapacity = 0;
+      bool isOutOfMemory = false;
+
+      ~Worker() {
+        free(transitions);
+        free(abbrevs);
+      }
+    };
+
+    /** The parameters of build() shared by the Workers. */
+    struct BuildContext {
+      ZoneResult* results;
+      Worker* workers;
+      int16_t startYear;
+      int16_t untilYear;
+      int16_t epochYear;
+      acetime_t untilEpochSeconds;
+    #if ACE_TIME_HAS_THREADS
+      std::atomic<uint32_t> nextZoneIndex{0};
+    #else
+      uint32_t nextZoneIndex = 0;
+    #endif
+    };
+
+    // disable copy constructor and assignment operator
+    PrecomputedZoneManagerTemplate(const PrecomputedZoneManagerTemplate&) =
+        delete;
+    PrecomputedZoneManagerTemplate& operator=(
+        const PrecomputedZoneManagerTemplate&) = delete;
+
+    /**
+     * Calculate the zones handed out by the BuildContext until none are left.
+     * Runs on each thread of build().
+     */
+    void runWorker(BuildContext* context, uint8_t workerIndex) const {
+      // The epoch year may be thread-local (ACE_TIME_EPOCH_THREAD_LOCAL).
+      if (Epoch::currentEpochYear() != context->epochYear) {
+        Epoch::currentEpochYear(context->epochYear);
+      }
+
+      Worker& worker = context->workers[workerIndex];
+      uint16_t numZones = mZoneRegistrar.zoneRegistrySize();
+      while (! worker.isOutOfMemory) {
+      #if ACE_TIME_HAS_THREADS
+        uint32_t i = context->nextZoneIndex.fetch_add(
+            1, std::memory_order_relaxed);
+      #else
+        uint32_t i = context->nextZoneIndex++;
+      #endif
+        if (i >= numZones) break;
+
+        ZoneResult& result = context->results[i];
+        if (result.targetIndex != kInvalidIndex) continue;
+        result.worker = workerIndex;
+        calcZone(*context, worker, (uint16_t) i, result);
+      }
+    }
+
+    /** Calculate the transitions of zone i into the buffers of the worker. */
+    void calcZone(
+        const BuildContext& context,
+        Worker& worker,
+        uint16_t i,
+        ZoneResult& result) const {
+
+      result.transitionIndex = worker.numTransitions;
+      result.abbrevIndex = worker.numAbbrevs;
+      result.numTransitions = 0;
+      result.numAbbrevs = 0;
+      result.untilEpochSeconds = context.untilEpochSeconds;
+
+      ZP& zoneProcessor = worker.zoneProcessor;
+      zoneProcessor.setZoneKey(
+          (uintptr_t) mZoneRegistrar.getZoneInfoForIndex(i));
+      ZoneAppender appender = {worker, result};
+      result.untilEpochSeconds = flat::addTransitionsForYears(
+          zoneProcessor, context.startYear, context.untilYear,
+          context.untilEpochSeconds, appender);
+    }
+
+    /**
+     * Appends the transitions of a single zone to the growable buffers of a
+     * Worker, through a flat::FlatTableBuilder over the slice of the zone.
+     */
+    struct ZoneAppender {
+      Worker& worker;
+      ZoneResult& result;
+
+      /**
+       * Append a transition, merging it into the previous one if the offsets
+       * and abbreviation are unchanged. Returns false if the zone is full, or
+       * if the memory is exhausted.
+       */
+      bool addTransition(
+          acetime_t startEpochSeconds,
+          int32_t stdOffsetSeconds,
+          int32_t dstOffsetSeconds,
+          const char* abbrev) {
+
+        if (! reserve(worker.transitions, worker.transitionCapacity,
+                worker.numTransitions + 1)
+            || ! reserve(worker.abbrevs, worker.abbrevCapacity,
+                worker.numAbbrevs + 1)) {
+          worker.isOutOfMemory = true;
+          return false;
+        }
+
+        flat::FlatTableBuilder builder = {
+          &worker.transitions[result.transitionIndex],
+          &worker.abbrevs[result.abbrevIndex],
+          result.numTransitions,
+          (uint16_t) ((result.numTransitions < UINT16_MAX)
+              ? result.numTransitions + 1 : UINT16_MAX),
+          result.numAbbrevs,
+          (uint8_t) ((result.numAbbrevs < UINT8_MAX)
+              ? result.numAbbrevs + 1 : UINT8_MAX),
+        };
+        if (! builder.addTransition(startEpochSeconds, stdOffsetSeconds,
+            dstOffsetSeconds, abbrev)) {
+          return false;
+        }
+        worker.numTransitions += builder.numTransitions
+            - result.numTransitions;
+        worker.numAbbrevs += builder.numAbbrevs - result.numAbbrevs;
+        result.numTransitions = builder.numTransitions;
+        result.numAbbrevs = builder.numAbbrevs;
+        return true;
+      }
+    };
+
+    /**
+     * Grow the array to hold at least `size` elements, doubling its capacity.
+     * Returns false if the memory could not be allocated.
+     */
+    template <typename T>
+    static bool reserve(T*& array, uint32_t& capacity, uint32_t size) {
+      if (size <= capacity) return true;
+      uint32_t newCapacity = (capacity < 64) ? 64 : capacity * 2;
+      T* newArray = (T*) realloc(array, newCapacity * sizeof(T));
+      if (! newArray) return false;
+      array = newArray;
+      capacity = newCapacity;
+      return true;
+    }
+
+    /**
+     * Copy the transitions calculated by the workers into the table, in the
+     * order of the registry.
+     */
+    uint8_t assembleTable(const BuildContext& context, uint8_t numWorkers);
+
+    /**
+     * Verify that the table matches the zone registry, then bind a
+     * ZoneProcessor to each zone of the table.
+     */
+    uint8_t bindZoneProcessors();
+
+  private:
+    const ZoneRegistrarTemplate<D> mZoneRegistrar;
+    PrecomputedZoneTable mTable;
+    PP* mZoneProcessors = nullptr;
+    uint8_t mStatus = PrecomputedZoneTable::kStatusNotLoaded;
+};
+
+template <typename D, typename ZP, typename Z, typename PP>
+uint8_t PrecomputedZoneManagerTemplate<D, ZP, Z, PP>::build(
+    int16_t startYear, int16_t untilYear, uint8_t numThreads) {
+
+  mTable.close();
+  uint16_t numZones = mZoneRegistrar.zoneRegistrySize();
+
+  // The transitions are stored as epochSeconds, which are valid only within
+  // the years around the current epoch year.
+  if (startYear >= untilYear
+      || startYear < Epoch::epochValidYearLower()
+      || untilYear > Epoch::epochValidYearUpper()) {
+    mStatus = PrecomputedZoneTable::kStatusBadYearRange;
+    return mStatus;
+  }
+
+  BuildContext context;
+  context.epochYear = Epoch::currentEpochYear();
+  context.startYear = startYear;
+  context.untilYear = untilYear;
+  context.untilEpochSeconds =
+      LocalDate::forComponents(context.untilYear, 1, 1).toEpochSeconds();
+
+  // A Link whose Zone is in the registry shares the transitions of the Zone,
+  // so only the Zones are calculated.
+  context.results = (ZoneResult*) malloc(
+      (numZones ? numZones : 1) * sizeof(ZoneResult));
+  if (! context.results) {
+    mStatus = PrecomputedZoneTable::kStatusNoMemory;
+    return mStatus;
+  }
+  for (uint16_t i = 0; i < numZones; i++) {
+    typename D::ZoneInfoBroker zoneInfo(mZoneRegistrar.getZoneInfoForIndex(i));
+    typename D::ZoneInfoBroker targetInfo = zoneInfo.targetInfo();
+    uint16_t targetIndex = targetInfo.isNull()
+        ? kInvalidIndex
+        : mZoneRegistrar.findIndexForId(targetInfo.zoneId());
+    if (targetIndex != kInvalidIndex
+        && ! typename D::ZoneInfoBroker(
+            mZoneRegistrar.getZoneInfoForIndex(targetIndex))
+                .targetInfo().isNull()) {
+      targetIndex = kInvalidIndex; // not expected, but avoid chains of Links
+    }
+    context.results[i].targetIndex = targetIndex;
+    context.results[i].numTransitions = 0;
+    context.results[i].numAbbrevs = 0;
+  }
+
+  // Every zone is picked up by the next available worker, because the number
+  // of transitions varies a lot between zones.
+  uint8_t numWorkers = 1;
+#if ACE_TIME_HAS_THREADS
+  if (numThreads == 0) {
+    unsigned cores = std::thread::hardware_concurrency();
+    numThreads = (cores == 0) ? 1 : (cores > UINT8_MAX ? UINT8_MAX : cores);
+  }
+  numWorkers = (numThreads > numZones) ? numZones : numThreads;
+  if (numWorkers == 0) numWorkers = 1;
+#else
+  (void) numThreads;
+#endif
+  context.workers = new Worker[numWorkers];
+
+#if ACE_TIME_HAS_THREADS
+  std::thread* threads = new std::thread[numWorkers - 1];
+  for (uint8_t w = 1; w < numWorkers; w++) {
+    threads[w - 1] = std::thread(
+        &PrecomputedZoneManagerTemplate::runWorker, this, &context, w);
+  }
+  runWorker(&context, 0);
+  for (uint8_t w = 1; w < numWorkers; w++) {
+    threads[w - 1].join();
+  }
+  delete[] threads;
+#else
+  runWorker(&context, 0);
+#endif
+
+  uint8_t status = assembleTable(context, numWorkers);
+  delete[] context.workers;
+  free(context.results);
+  if (status != PrecomputedZoneTable::kStatusOk) {
+    mTable.close();
+    mStatus = status;
+    return mStatus;
+  }
+  mTable.setValid();
+  return bindZoneProcessors();
+}
+
+template <typename D, typename ZP, typename Z, typename PP>
+uint8_t PrecomputedZoneManagerTemplate<D, ZP, Z, PP>::assembleTable(
+    const BuildContext& context, uint8_t numWorkers) {
+
+  uint32_t numTransitions = 0;
+  uint32_t numAbbrevs = 0;
+  for (uint8_t w = 0; w < numWorkers; w++) {
+    const Worker& worker = context.workers[w];
+    if (worker.isOutOfMemory) return PrecomputedZoneTable::kStatusNoMemory;
+    numTransitions += worker.numTransitions;
+    numAbbrevs += worker.numAbbrevs;
+  }
+
+  uint16_t numZones = mZoneRegistrar.zoneRegistrySize();
+  uint8_t status = mTable.allocate(numZones, numTransitions, numAbbrevs,
+      context.startYear, context.untilYear, context.epochYear);
+  if (status != PrecomputedZoneTable::kStatusOk) return status;
+
+  ZoneEntry* entries = (ZoneEntry*) mTable.zoneEntries();
+  FlatTransition* transitions = (FlatTransition*) mTable.transitions();
+  char (*abbrevs)[kAbbrevSize] = (char (*)[kAbbrevSize]) mTable.abbrevs();
+  uint32_t transitionIndex = 0;
+  uint32_t abbrevIndex = 0;
+  for (uint16_t i = 0; i < numZones; i++) {
+    const ZoneResult& result = context.results[i];
+    ZoneEntry& entry = entries[i];
+    entry.zoneId = typename D::ZoneInfoBroker(
+        mZoneRegistrar.getZoneInfoForIndex(i)).zoneId();
+    if (result.targetIndex != kInvalidIndex) continue;
+
+    const Worker& worker = context.workers[result.worker];
+    memcpy(&transitions[transitionIndex],
+        &worker.transitions[result.transitionIndex],
+        result.numTransitions * sizeof(FlatTransition));
+    memcpy(&abbrevs[abbrevIndex],
+        &worker.abbrevs[result.abbrevIndex],
+        result.numAbbrevs * kAbbrevSize);
+    entry.transitionIndex = transitionIndex;
+    entry.abbrevIndex = abbrevIndex;
+    entry.untilEpochSeconds = result.untilEpochSeconds;
+    entry.numTransitions = result.numTransitions;
+    entry.numAbbrevs = result.numAbbrevs;
+    transitionIndex += result.numTransitions;
+    abbrevIndex += result.numAbbrevs;
+  }
+
+  // Point each Link to the records of its Zone.
+  for (uint16_t i = 0; i < numZones; i++) {
+    uint16_t targetIndex = context.results[i].targetIndex;
+    if (targetIndex == kInvalidIndex) continue;
+    uint32_t zoneId = entries[i].zoneId;
+    entries[i] = entries[targetIndex];
+    entries[i].zoneId = zoneId;
+  }
+
+  return PrecomputedZoneTable::kStatusOk;
+}
+
+template <typename D, typename ZP, typename Z, typename PP>
+uint8_t PrecomputedZoneManagerTemplate<D, ZP, Z, PP>::bindZoneProcessors() {
+  mStatus = mTable.status();
+  if (mStatus != PrecomputedZoneTable::kStatusOk) return mStatus;
+
+  uint16_t numZones = mZoneRegistrar.zoneRegistrySize();
+  bool matches = (mTable.numZones() == numZones);
+  for (uint16_t i = 0; matches && i < numZones; i++) {
+    matches = mTable.zoneEntry(i).zoneId == typename D::ZoneInfoBroker(
+        mZoneRegistrar.getZoneInfoForIndex(i)).zoneId();
+  }
+  if (! matches) {
+    mTable.close();
+    mStatus = PrecomputedZoneTable::kStatusRegistryMismatch;
+    return mStatus;
+  }
+
+  if (! mZoneProcessors) mZoneProcessors = new PP[numZones ? numZones : 1];
+  for (uint16_t i = 0; i < numZones; i++) {
+    mZoneProcessors[i].bind(
+        &mTable, i, mZoneRegistrar.getZoneInfoForIndex(i));
+  }
+  return mStatus;
+}
+
+/**
+ * A PrecomputedZoneManagerTemplate which expands the complete::Info::ZoneInfo
+ * records of the 'zonedbc' database using the CompleteZoneProcessor.
+ */
+using PrecomputedZoneManager = PrecomputedZoneManagerTemplate<
+    complete::Info,
+    CompleteZoneProcessor,
+    CompleteZone,
+    PrecomputedZoneProcessor>;
+
+/**
+ * A PrecomputedZoneManagerTemplate which expands the extended::Info::ZoneInfo
+ * records of the 'zonedbx' database using the ExtendedZoneProcessor.
+ */
+using PrecomputedExtendedZoneManager = PrecomputedZoneManagerTemplate<
+    extended::Info,
+    ExtendedZoneProcessor,
+    ExtendedZone,
+    PrecomputedExtendedZoneProcessor>;
+
+}
+
+#endif
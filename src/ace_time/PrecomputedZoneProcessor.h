@@ -0,0 +1,171 @@
+/*
+ * MIT License
+ * Copyright (c) 2026 Brian T. Park
+ */
+
+#ifndef ACE_TIME_PRECOMPUTED_ZONE_PROCESSOR_H
+#define ACE_TIME_PRECOMPUTED_ZONE_PROCESSOR_H
+
+#include <stdint.h> // uintptr_t
+#include "../zoneinfo/infos.h"
+#include "ZoneProcessor.h"
+#include "PrecomputedZoneTable.h"
+
+class Print;
+
+namespace ace_time {
+
+/**
+ * A ZoneProcessor which reads the transitions of a single zone from a
+ * PrecomputedZoneTable. It is created and bound to its zone by the
+ * PrecomputedZoneManager, which owns one instance per zone of the registry,
+ * so no ZoneProcessorCache is needed. The object holds no mutable state, so
+ * the TimeZone can be shared by multiple threads.
+ *
+ * The zoneKey is the `const ZoneInfo*` of the zone. Since the processor is
+ * bound to the position of the zone in the table, setZoneKey() cannot move it
+ * to another zone, so a different zoneKey is ignored.
+ *
+ * @tparam D container class of the zoneinfo files and brokers
+ */
+template <typename D>
+class PrecomputedZoneProcessorTemplate: public ZoneProcessor {
+  public:
+    bool isLink() const override {
+      return mZoneInfo
+          && ! typename D::ZoneInfoBroker(mZoneInfo).targetInfo().isNull();
+    }
+
+    uint32_t getZoneId() const override {
+      return mZoneInfo ? typename D::ZoneInfoBroker(mZoneInfo).zoneId() : 0;
+    }
+
+    FindResult findByLocalDateTime(const LocalDateTime& ldt) const override {
+      if (! mTable) return FindResult();
+      return mTable->findByLocalDateTime(mZoneIndex, ldt);
+    }
+
+    /**
+     * @copydoc ZoneProcessor::findByEpochSeconds(acetime_t)
+     *
+     * This is a binary search over the transitions of the zone in the
+     * PrecomputedZoneTable.
+     */
+    FindResult findByEpochSeconds(acetime_t epochSeconds) const override {
+      if (! mTable) return FindResult();
+      return mTable->findByEpochSeconds(mZoneIndex, epochSeconds);
+    }
+
+    ZoneTransition findNextTransition(acetime_t epochSeconds) const override {
+      if (! mTable) return ZoneTransition();
+      return mTable->findNextTransition(mZoneIndex, epochSeconds);
+    }
+
+    ZoneTransition findPrevTransition(acetime_t epochSeconds) const override {
+      if (! mTable) return ZoneTransition();
+      return mTable->findPrevTransition(mZoneIndex, epochSeconds);
+    }
+
+    void printNameTo(Print& printer) const override {
+      if (mZoneInfo) {
+        typename D::ZoneInfoBroker(mZoneInfo).printNameTo(printer);
+      }
+    }
+
+    void printShortNameTo(Print& printer) const override {
+      if (mZoneInfo) {
+        typename D::ZoneInfoBroker(mZoneInfo).printShortNameTo(printer);
+      }
+    }
+
+    void printTargetNameTo(Print& printer) const override {
+      if (isLink()) {
+        typename D::ZoneInfoBroker(mZoneInfo).targetInfo()
+            .printNameTo(printer);
+      }
+    }
+
+    /** The zone is fixed by bind(), so this does nothing. */
+    void setZoneKey(uintptr_t /*zoneKey*/) override {}
+
+    bool equalsZoneKey(uintptr_t zoneKey) const override {
+      return mZoneInfo == (const typename D::ZoneInfo*) zoneKey;
+    }
+
+    /**
+     * Bind this processor to the zone at zoneIndex of the table, whose
+     * ZoneInfo is zoneInfo. Called by the PrecomputedZoneManager.
+     */
+    void bind(
+        const PrecomputedZoneTable* table,
+        uint16_t zoneIndex,
+        const typename D::ZoneInfo* zoneInfo) {
+      mTable = table;
+      mZoneIndex = zoneIndex;
+      mZoneInfo = zoneInfo;
+    }
+
+  protected:
+    /**
+     * Constructor.
+     *
+     * @param type indentifier for the specific subclass of ZoneProcessor
+     */
+    explicit PrecomputedZoneProcessorTemplate(uint8_t type) :
+        ZoneProcessor(type)
+    {}
+
+  private:
+    // Disable copy constructor and assignment operator.
+    PrecomputedZoneProcessorTemplate(const PrecomputedZoneProcessorTemplate&)
+        = delete;
+    PrecomputedZoneProcessorTemplate& operator=(
+        const PrecomputedZoneProcessorTemplate&) = delete;
+
+    bool equals(const ZoneProcessor& other) const override {
+      const PrecomputedZoneProcessorTemplate& that =
+          (const PrecomputedZoneProcessorTemplate&) other;
+      return mTable == that.mTable && mZoneIndex == that.mZoneIndex;
+    }
+
+  private:
+    const PrecomputedZoneTable* mTable = nullptr;
+    const typename D::ZoneInfo* mZoneInfo = nullptr;
+    uint16_t mZoneIndex = 0;
+};
+
+/**
+ * A PrecomputedZoneProcessorTemplate for the zones of the 'zonedbc'
+ * database, used by the PrecomputedZoneManager.
+ */
+class PrecomputedZoneProcessor:
+    public PrecomputedZoneProcessorTemplate<complete::Info> {
+
+  public:
+    /** Unique TimeZone type identifier for PrecomputedZoneProcessor. */
+    static const uint8_t kTypePrecomputed = 12;
+
+    PrecomputedZoneProcessor() :
+        PrecomputedZoneProcessorTemplate(kTypePrecomputed)
+    {}
+};
+
+/**
+ * A PrecomputedZoneProcessorTemplate for the zones of the 'zonedbx'
+ * database, used by the PrecomputedExtendedZoneManager.
+ */
+class PrecomputedExtendedZoneProcessor:
+    public PrecomputedZoneProcessorTemplate<extended::Info> {
+
+  public:
+    /** Unique TimeZone type identifier for PrecomputedExtendedZoneProcessor. */
+    static const uint8_t kTypePrecomputedExtended = 13;
+
+    PrecomputedExtendedZoneProcessor() :
+        PrecomputedZoneProcessorTemplate(kTypePrecomputedExtended)
+    {}
+};
+
+}
+
+#endif
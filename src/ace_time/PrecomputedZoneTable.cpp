@@ -0,0 +1,181 @@
+/*
+ * MIT License
+ * Copyright (c) 2026 Brian T. Park
+ */
+
+#include <stdlib.h> // malloc(), free()
+#include <string.h> // memcmp(), memcpy(), memset()
+#include "Epoch.h"
+#include "PrecomputedZoneTable.h"
+
+namespace ace_time {
+
+const char PrecomputedZoneTable::kMagic[8] = "AceTzPc";
+
+uint8_t PrecomputedZoneTable::validate(const void* data, size_t size) {
+  if (((uintptr_t) data & 0x3) != 0) return kStatusBadAlignment;
+  if (size < sizeof(Header)) return kStatusBadSize;
+
+  const Header* header = (const Header*) data;
+  if (memcmp(header->magic, kMagic, sizeof(kMagic)) != 0
+      || header->formatVersion != Header::kFormatVersion
+      || header->byteOrderMark != Header::kByteOrderMark
+      || header->headerSize != sizeof(Header)) {
+    return kStatusBadHeader;
+  }
+
+  if (header->tableSize > size
+      || header->tableSize != calcTableSize(
+          header->numZones, header->numTransitions, header->numAbbrevs)) {
+    return kStatusBadSize;
+  }
+
+  // The index must not point outside of the table. The transitions of each
+  // zone must be sorted, since the lookups are binary searches, and must
+  // refer to the abbreviations of the zone. The offsets and the contents of
+  // the abbreviations are trusted.
+  const ZoneEntry* entries = (const ZoneEntry*) (header + 1);
+  const FlatTransition* transitions =
+      (const FlatTransition*) (entries + header->numZones);
+  for (uint16_t i = 0; i < header->numZones; i++) {
+    const ZoneEntry& entry = entries[i];
+    if (entry.transitionIndex > header->numTransitions
+        || entry.numTransitions
+            > header->numTransitions - entry.transitionIndex
+        || entry.abbrevIndex > header->numAbbrevs
+        || entry.numAbbrevs > header->numAbbrevs - entry.abbrevIndex) {
+      return kStatusBadSize;
+    }
+
+    const FlatTransition* t = &transitions[entry.transitionIndex];
+    for (uint16_t j = 0; j < entry.numTransitions; j++) {
+      if (t[j].abbrevIndex >= entry.numAbbrevs
+          || (j > 0 && t[j].startEpochSeconds <= t[j - 1].startEpochSeconds)
+          || t[j].startEpochSeconds >= entry.untilEpochSeconds) {
+        return kStatusBadSize;
+      }
+    }
+  }
+
+  return kStatusOk;
+}
+
+uint8_t PrecomputedZoneTable::initFromBuffer(const void* data, size_t size) {
+  close();
+  mStatus = validate(data, size);
+  if (mStatus == kStatusOk) {
+    mData = data;
+    mSize = header()->tableSize;
+  }
+  return mStatus;
+}
+
+#if ACE_TIME_HAS_MMAP
+
+uint8_t PrecomputedZoneTable::openFile(const char* path) {
+  close();
+
+  if (! mMappedFile.open(path)) {
+    mStatus = kStatusOpenError;
+    return mStatus;
+  }
+
+  mStatus = validate(mMappedFile.data(), mMappedFile.size());
+  if (mStatus == kStatusOk) {
+    mData = mMappedFile.data();
+    mSize = header()->tableSize;
+  } else {
+    mMappedFile.close();
+  }
+  return mStatus;
+}
+
+#endif
+
+uint8_t PrecomputedZoneTable::allocate(
+    uint16_t numZones,
+    uint32_t numTransitions,
+    uint32_t numAbbrevs,
+    int16_t startYear,
+    int16_t untilYear,
+    int16_t epochYear) {
+
+  close();
+  size_t size = calcTableSize(numZones, numTransitions, numAbbrevs);
+  // malloc() returns memory aligned for any type, so the records are aligned.
+  mAllocatedData = malloc(size);
+  if (! mAllocatedData) {
+    mStatus = kStatusNoMemory;
+    return mStatus;
+  }
+  memset(mAllocatedData, 0, size);
+
+  Header* header = (Header*) mAllocatedData;
+  memcpy(header->magic, kMagic, sizeof(kMagic));
+  header->formatVersion = Header::kFormatVersion;
+  header->byteOrderMark = Header::kByteOrderMark;
+  header->headerSize = sizeof(Header);
+  header->numZones = numZones;
+  header->startYear = startYear;
+  header->untilYear = untilYear;
+  header->epochYear = epochYear;
+  header->numTransitions = numTransitions;
+  header->numAbbrevs = numAbbrevs;
+  header->tableSize = (uint32_t) size;
+
+  mData = mAllocatedData;
+  mSize = size;
+  return kStatusOk; // mStatus remains kStatusNotLoaded until setValid()
+}
+
+void PrecomputedZoneTable::close() {
+  mMappedFile.close();
+  free(mAllocatedData);
+  mAllocatedData = nullptr;
+  mData = nullptr;
+  mSize = 0;
+  mStatus = kStatusNotLoaded;
+}
+
+//---------------------------------------------------------------------------
+
+const precomputed::ZoneEntry* PrecomputedZoneTable::findZoneEntry(
+    uint16_t zoneIndex) const {
+  if (! isValid()
+      || zoneIndex >= header()->numZones
+      || header()->epochYear != Epoch::currentEpochYear()) {
+    return nullptr;
+  }
+  const ZoneEntry* entry = &zoneEntries()[zoneIndex];
+  return (entry->numTransitions > 0) ? entry : nullptr;
+}
+
+FindResult PrecomputedZoneTable::findByLocalDateTime(
+    uint16_t zoneIndex, const LocalDateTime& ldt) const {
+  const ZoneEntry* entry = findZoneEntry(zoneIndex);
+  if (! entry) return FindResult();
+  return flatTableOf(*entry).findByLocalDateTime(ldt);
+}
+
+FindResult PrecomputedZoneTable::findByEpochSeconds(
+    uint16_t zoneIndex, acetime_t epochSeconds) const {
+  const ZoneEntry* entry = findZoneEntry(zoneIndex);
+  if (! entry) return FindResult();
+  return flatTableOf(*entry).findByEpochSeconds(epochSeconds);
+}
+
+ZoneTransition PrecomputedZoneTable::findNextTransition(
+    uint16_t zoneIndex, acetime_t epochSeconds) const {
+  const ZoneEntry* entry = findZoneEntry(zoneIndex);
+  if (! entry) return ZoneTransition();
+  return flatTableOf(*entry).findNextTransition(epochSeconds);
+}
+
+ZoneTransition PrecomputedZoneTable::findPrevTransition(
+    uint16_t zoneIndex, acetime_t epochSeconds) const {
+  const ZoneEntry* entry = findZoneEntry(zoneIndex);
+  if (! entry) return ZoneTransition();
+  return flatTableOf(*entry).findPrevTransition(epochSeconds);
+}
+
+}
@@ -0,0 +1,342 @@
+/*
+ * MIT License
+ * Copyright (c) 2026 Brian T. Park
+ */
+
+#ifndef ACE_TIME_PRECOMPUTED_ZONE_TABLE_H
+#define ACE_TIME_PRECOMPUTED_ZONE_TABLE_H
+
+#include <stdint.h>
+#include <stddef.h> // size_t
+#include "../zoneinfo/compat.h" // ACE_TIME_HAS_MMAP
+#include "common/common.h" // acetime_t, kAbbrevSize
+#include "common/MappedFile.h"
+#include "LocalDate.h"
+#include "LocalDateTime.h"
+#include "ZoneProcessor.h"
+#include "FlatTransition.h" // flat::FlatTransition, flat::FlatTable
+
+class PrecomputedZoneManagerTest_build;
+
+namespace ace_time {
+
+template <typename D, typename ZP, typename Z, typename PP>
+class PrecomputedZoneManagerTemplate;
+
+namespace precomputed {
+
+/**
+ * The Header at the start of a PrecomputedZoneTable. It is followed by
+ * `numZones` ZoneEntry records, `numTransitions` flat::FlatTransition records,
+ * and `numAbbrevs` abbreviations of kAbbrevSize bytes each.
+ */
+struct Header {
+  /** Expected value of formatVersion. */
+  static const uint16_t kFormatVersion = 1;
+
+  /** Written as 0xFEFF, so that a table of the wrong byte order is rejected. */
+  static const uint16_t kByteOrderMark = 0xFEFF;
+
+  /** The PrecomputedZoneTable::kMagic string. */
+  char magic[8];
+
+  /** Version of the format of the table. */
+  uint16_t formatVersion;
+
+  /** Always kByteOrderMark in the byte order of the host. */
+  uint16_t byteOrderMark;
+
+  /** Size of this Header, which also checks the padding of the compiler. */
+  uint16_t headerSize;
+
+  /** Number of ZoneEntry records, which must match the zone registry. */
+  uint16_t numZones;
+
+  /** First year of the transitions. */
+  int16_t startYear;
+
+  /** Until year (exclusive) of the transitions. */
+  int16_t untilYear;
+
+  /** The Epoch::currentEpochYear() of the startEpochSeconds fields. */
+  int16_t epochYear;
+
+  /** Unused, set to 0. */
+  uint16_t reserved;
+
+  /** Number of flat::FlatTransition records. */
+  uint32_t numTransitions;
+
+  /** Number of abbreviations. */
+  uint32_t numAbbrevs;
+
+  /** Size of the whole table in bytes, including this Header. */
+  uint32_t tableSize;
+};
+
+/**
+ * The transitions of a single zone of the registry, at the same index as the
+ * zone in the registry. A Link shares the records of its target Zone.
+ */
+struct ZoneEntry {
+  /** The zoneId of the zone, used to check the registry. */
+  uint32_t zoneId;
+
+  /** Index of the first transition of the zone. */
+  uint32_t transitionIndex;
+
+  /**
+   * Index of the first abbreviation of the zone. The abbrevIndex of each
+   * flat::FlatTransition is relative to this index.
+   */
+  uint32_t abbrevIndex;
+
+  /** The epochSeconds where the last transition ends. */
+  acetime_t untilEpochSeconds;
+
+  /** Number of transitions. */
+  uint16_t numTransitions;
+
+  /** Number of unique abbreviations. */
+  uint8_t numAbbrevs;
+
+  /** Unused, set to 0. */
+  uint8_t reserved;
+};
+
+}
+
+/**
+ * The flattened transitions of every zone of a registry over a range of
+ * years, stored in a single contiguous buffer: a Header, an index of one
+ * ZoneEntry per zone, the flat::FlatTransition records of all zones, and their
+ * abbreviations. A lookup is a binary search over the transitions of one
+ * zone, like the FlatZoneProcessor, without any cache of ZoneProcessors.
+ *
+ * The table is created by PrecomputedZoneManager::build(), or loaded from a
+ * buffer (or a file) which holds the data() of a table built previously on a
+ * machine with the same byte order and struct layout. The transitions are
+ * stored in epochSeconds of the epochYear of the Header, so the lookups
+ * return FindResult::kTypeNotFound if Epoch::currentEpochYear() is changed
+ * afterwards. The table must then be built again.
+ *
+ * The table is immutable once loaded, so the lookups can be made by multiple
+ * threads without locking.
+ */
+class PrecomputedZoneTable {
+  public:
+    /** The "AceTzPc" magic string at the start of the table. */
+    static const char kMagic[8];
+
+    /** The table is valid. */
+    static const uint8_t kStatusOk = 0;
+
+    /** No table has been built or loaded, or close() was called. */
+    static const uint8_t kStatusNotLoaded = 1;
+
+    /** The file could not be opened or mapped. */
+    static const uint8_t kStatusOpenError = 2;
+
+    /** The buffer is not aligned on a 4-byte boundary. */
+    static const uint8_t kStatusBadAlignment = 3;
+
+    /** The magic string, format version, or byte order does not match. */
+    static const uint8_t kStatusBadHeader = 4;
+
+    /**
+     * The size or the indexes of the table do not fit in the buffer, or the
+     * transitions of a zone are not sorted or refer to an abbreviation
+     * outside of the zone.
+     */
+    static const uint8_t kStatusBadSize = 5;
+
+    /** The memory for the table could not be allocated. */
+    static const uint8_t kStatusNoMemory = 6;
+
+    /** The zones of the table do not match the zone registry. */
+    static const uint8_t kStatusRegistryMismatch = 7;
+
+    /**
+     * The year range passed to PrecomputedZoneManager::build() is empty, or
+     * outside of Epoch::epochValidYearLower() and
+     * Epoch::epochValidYearUpper().
+     */
+    static const uint8_t kStatusBadYearRange = 8;
+
+    /**
+     * Return the size in bytes of a table with the given number of records.
+     * Useful for estimating the memory of a year range.
+     */
+    static size_t calcTableSize(
+        uint16_t numZones, uint32_t numTransitions, uint32_t numAbbrevs) {
+      return sizeof(precomputed::Header)
+          + numZones * sizeof(precomputed::ZoneEntry)
+          + numTransitions * sizeof(flat::FlatTransition)
+          + numAbbrevs * kAbbrevSize;
+    }
+
+    /** Constructor. The table is not valid until it is built or loaded. */
+    PrecomputedZoneTable() = default;
+
+    /** Destructor, which releases the buffer of the table. */
+    ~PrecomputedZoneTable() { close(); }
+
+    /**
+     * Use the table stored in the given buffer of `size` bytes, which must be
+     * aligned on a 4-byte boundary and must outlive this object. Returns
+     * kStatusOk if the Header, the ZoneEntry records and the transitions are
+     * consistent. The offsets and abbreviation strings are trusted.
+     */
+    uint8_t initFromBuffer(const void* data, size_t size);
+
+  #if ACE_TIME_HAS_MMAP
+    /**
+     * Map the table file at `path` into memory as read-only. Returns
+     * kStatusOk if the file was mapped and is valid.
+     */
+    uint8_t openFile(const char* path);
+  #endif
+
+    /** Release or unmap the buffer (if any), and invalidate the table. */
+    void close();
+
+    /** Return the status of the last build, initFromBuffer() or openFile(). */
+    uint8_t status() const { return mStatus; }
+
+    /** Return true if the table was built or loaded successfully. */
+    bool isValid() const { return mStatus == kStatusOk; }
+
+    /**
+     * Return the buffer of the table, which can be saved to a file and loaded
+     * later through initFromBuffer() or openFile().
+     */
+    const void* data() const { return mData; }
+
+    /** Return the size of the table in bytes. */
+    size_t size() const { return mSize; }
+
+    /** Return the number of zones. */
+    uint16_t numZones() const { return isValid() ? header()->numZones : 0; }
+
+    /** Return the first year of the transitions. */
+    int16_t startYear() const {
+      return isValid() ? header()->startYear : LocalDate::kInvalidYear;
+    }
+
+    /** Return the until year (exclusive) of the transitions. */
+    int16_t untilYear() const {
+      return isValid() ? header()->untilYear : LocalDate::kInvalidYear;
+    }
+
+    /** Return the epoch year of the transitions. */
+    int16_t epochYear() const {
+      return isValid() ? header()->epochYear : LocalDate::kInvalidYear;
+    }
+
+    /** Return the total number of transitions of all zones. */
+    uint32_t numTransitions() const {
+      return isValid() ? header()->numTransitions : 0;
+    }
+
+    /** Return the total number of abbreviations of all zones. */
+    uint32_t numAbbrevs() const {
+      return isValid() ? header()->numAbbrevs : 0;
+    }
+
+    /** Return the ZoneEntry at the given index of the registry. */
+    const precomputed::ZoneEntry& zoneEntry(uint16_t zoneIndex) const {
+      return zoneEntries()[zoneIndex];
+    }
+
+    /** Find the FindResult of the zone at the local date time. */
+    FindResult findByLocalDateTime(
+        uint16_t zoneIndex, const LocalDateTime& ldt) const;
+
+    /** Find the FindResult of the zone at the epochSeconds. */
+    FindResult findByEpochSeconds(
+        uint16_t zoneIndex, acetime_t epochSeconds) const;
+
+    /** Find the first transition of the zone after epochSeconds. */
+    ZoneTransition findNextTransition(
+        uint16_t zoneIndex, acetime_t epochSeconds) const;
+
+    /** Find the last transition of the zone at or before epochSeconds. */
+    ZoneTransition findPrevTransition(
+        uint16_t zoneIndex, acetime_t epochSeconds) const;
+
+  private:
+    template <typename D, typename ZP, typename Z, typename PP>
+    friend class PrecomputedZoneManagerTemplate;
+    friend class ::PrecomputedZoneManagerTest_build;
+
+    using FlatTransition = flat::FlatTransition;
+    using ZoneEntry = precomputed::ZoneEntry;
+    using Header = precomputed::Header;
+
+    // disable copy constructor and assignment operator
+    PrecomputedZoneTable(const PrecomputedZoneTable&) = delete;
+    PrecomputedZoneTable& operator=(const PrecomputedZoneTable&) = delete;
+
+    /**
+     * Allocate and initialize the Header of a table with the given number of
+     * records, to be filled by the PrecomputedZoneManager. The table becomes
+     * valid when the manager calls setValid().
+     */
+    uint8_t allocate(
+        uint16_t numZones,
+        uint32_t numTransitions,
+        uint32_t numAbbrevs,
+        int16_t startYear,
+        int16_t untilYear,
+        int16_t epochYear);
+
+    /** Mark the table filled by the PrecomputedZoneManager as valid. */
+    void setValid() { mStatus = kStatusOk; }
+
+    /**
+     * Validate the Header, the ZoneEntry records, and the ordering and
+     * abbrevIndex of the transitions of the buffer.
+     */
+    static uint8_t validate(const void* data, size_t size);
+
+    const Header* header() const { return (const Header*) mData; }
+
+    const ZoneEntry* zoneEntries() const {
+      return (const ZoneEntry*) (header() + 1);
+    }
+
+    const FlatTransition* transitions() const {
+      return (const FlatTransition*) (zoneEntries() + header()->numZones);
+    }
+
+    const char (*abbrevs() const)[kAbbrevSize] {
+      return (const char (*)[kAbbrevSize])
+          (transitions() + header()->numTransitions);
+    }
+
+    /**
+     * Return the ZoneEntry at zoneIndex, or nullptr if the table is invalid,
+     * or if its epoch year is not the current epoch year.
+     */
+    const ZoneEntry* findZoneEntry(uint16_t zoneIndex) const;
+
+    /** Return the flattened transitions and abbreviations of the entry. */
+    flat::FlatTable flatTableOf(const ZoneEntry& entry) const {
+      return flat::FlatTable{
+          &transitions()[entry.transitionIndex],
+          &abbrevs()[entry.abbrevIndex],
+          entry.untilEpochSeconds,
+          entry.numTransitions};
+    }
+
+  private:
+    const void* mData = nullptr;
+    size_t mSize = 0;
+    void* mAllocatedData = nullptr; // non-null if allocated by allocate()
+    internal::MappedFile mMappedFile; // the file mapped by openFile()
+    uint8_t mStatus = kStatusNotLoaded;
+};
+
+}
+
+#endif
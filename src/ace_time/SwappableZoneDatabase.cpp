@@ -0,0 +1,85 @@
+/*
+ * MIT License
+ * Copyright (c) 2026 Brian T. Park
+ */
+
+#include "SwappableZoneDatabase.h"
+
+#if ACE_TIME_HAS_ATOMIC
+
+namespace ace_time {
+
+using internal::ZoneDatabaseVersion;
+
+ZoneDatabaseSnapshot SwappableZoneDatabaseBase::acquire() {
+  while (true) {
+    ZoneDatabaseVersion* version = mCurrent.load();
+    if (! version) return ZoneDatabaseSnapshot();
+
+    // The writer does not reuse a version with readers, but it may have
+    // reused this one before the increment, so check that it is still current.
+    version->numReaders.fetch_add(1);
+    if (mCurrent.load() == version) return ZoneDatabaseSnapshot(version);
+    version->numReaders.fetch_sub(1);
+  }
+}
+
+uint8_t SwappableZoneDatabaseBase::publishBuffer(
+    const void* data, size_t size) {
+  ZoneDatabaseVersion* version = findFreeVersion();
+  if (! version) return kStatusBusy;
+
+  uint8_t status = version->database.initFromBuffer(data, size);
+  if (status == MappedZoneDatabase::kStatusOk) publish(version);
+  return status;
+}
+
+#if ACE_TIME_HAS_MMAP
+
+uint8_t SwappableZoneDatabaseBase::publishFile(const char* path) {
+  ZoneDatabaseVersion* version = findFreeVersion();
+  if (! version) return kStatusBusy;
+
+  uint8_t status = version->database.openFile(path);
+  if (status == MappedZoneDatabase::kStatusOk) publish(version);
+  return status;
+}
+
+#endif
+
+uint8_t SwappableZoneDatabaseBase::reclaim() {
+  ZoneDatabaseVersion* current = mCurrent.load();
+  uint8_t numClosed = 0;
+  for (uint8_t i = 0; i < mNumVersions; i++) {
+    ZoneDatabaseVersion* version = &mVersions[i];
+    if (version != current
+        && version->numReaders.load() == 0
+        && version->database.isValid()) {
+      version->database.close();
+      numClosed++;
+    }
+  }
+  return numClosed;
+}
+
+ZoneDatabaseVersion* SwappableZoneDatabaseBase::findFreeVersion() const {
+  ZoneDatabaseVersion* current = mCurrent.load();
+  ZoneDatabaseVersion* oldest = nullptr;
+  for (uint8_t i = 0; i < mNumVersions; i++) {
+    ZoneDatabaseVersion* version = &mVersions[i];
+    if (version == current || version->numReaders.load() != 0) continue;
+    if (! oldest || version->generation < oldest->generation) {
+      oldest = version;
+    }
+  }
+  return oldest;
+}
+
+void SwappableZoneDatabaseBase::publish(ZoneDatabaseVersion* version) {
+  version->generation = ++mGeneration;
+  mCurrent.store(version);
+}
+
+}
+
+#endif
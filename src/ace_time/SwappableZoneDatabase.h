@@ -0,0 +1,360 @@
+/*
+ * MIT License
+ * Copyright (c) 2026 Brian T. Park
+ */
+
+#ifndef ACE_TIME_SWAPPABLE_ZONE_DATABASE_H
+#define ACE_TIME_SWAPPABLE_ZONE_DATABASE_H
+
+#include <stdint.h>
+#include <stddef.h> // size_t
+#include "../zoneinfo/compat.h" // ACE_TIME_HAS_MMAP, ACE_TIME_HAS_ATOMIC
+#include "../zoneinfo/infos.h"
+#include "MappedZoneDatabase.h"
+#include "MappedZoneProcessor.h"
+#include "ZoneProcessorCache.h"
+#include "ZoneRegistrar.h"
+#include "ZoneManager.h"
+#include "TimeZoneData.h"
+#include "TimeZone.h"
+
+#if ACE_TIME_HAS_ATOMIC
+
+#include <atomic>
+
+namespace ace_time {
+
+namespace internal {
+
+/**
+ * One version of the zone database held by a SwappableZoneDatabase, with the
+ * number of ZoneDatabaseSnapshots which are reading it.
+ */
+struct ZoneDatabaseVersion {
+  MappedZoneDatabase database;
+  std::atomic<uint32_t> numReaders{0};
+  uint32_t generation = 0;
+};
+
+}
+
+/**
+ * A handle to the version of the zone database which was current when it
+ * was acquired from a SwappableZoneDatabase. The version is not reclaimed
+ * while the handle exists, so the TimeZones created through it keep
+ * resolving against the same version, even after a newer version is
+ * published. The handle can be moved but not copied. It is released by its
+ * destructor or by release().
+ */
+class ZoneDatabaseSnapshot {
+  public:
+    /** Create an empty snapshot, which is not valid. */
+    ZoneDatabaseSnapshot() = default;
+
+    /** Destructor, which releases the version. */
+    ~ZoneDatabaseSnapshot() { release(); }
+
+    /** Move constructor. */
+    ZoneDatabaseSnapshot(ZoneDatabaseSnapshot&& other) :
+        mVersion(other.mVersion) {
+      other.mVersion = nullptr;
+    }
+
+    /** Move assignment operator, which releases the current version. */
+    ZoneDatabaseSnapshot& operator=(ZoneDatabaseSnapshot&& other) {
+      if (this != &other) {
+        release();
+        mVersion = other.mVersion;
+        other.mVersion = nullptr;
+      }
+      return *this;
+    }
+
+    /** Return true if the snapshot refers to a version of the database. */
+    bool isValid() const { return mVersion != nullptr; }
+
+    /**
+     * Return the generation of the version, which increases by 1 for every
+     * version published by the SwappableZoneDatabase. Returns 0 if not valid.
+     */
+    uint32_t generation() const {
+      return mVersion ? mVersion->generation : 0;
+    }
+
+    /** Return the number of ZoneInfo entries (Zones and Links). */
+    uint16_t zoneRegistrySize() const {
+      return mVersion ? mVersion->database.zoneRegistrySize() : 0;
+    }
+
+    /** Return the zone registry of the version, or nullptr. */
+    const mapped::Info::ZoneInfo* const* zoneRegistry() const {
+      return mVersion ? mVersion->database.zoneRegistry() : nullptr;
+    }
+
+    /** Return the MappedZoneDatabase of the version, or nullptr. */
+    const MappedZoneDatabase* database() const {
+      return mVersion ? &mVersion->database : nullptr;
+    }
+
+    /** Release the version, and make the snapshot not valid. */
+    void release() {
+      if (mVersion) {
+        mVersion->numReaders.fetch_sub(1);
+        mVersion = nullptr;
+      }
+    }
+
+  private:
+    friend class SwappableZoneDatabaseBase;
+
+    explicit ZoneDatabaseSnapshot(internal::ZoneDatabaseVersion* version) :
+        mVersion(version)
+    {}
+
+    // disable copy constructor and assignment operator
+    ZoneDatabaseSnapshot(const ZoneDatabaseSnapshot&) = delete;
+    ZoneDatabaseSnapshot& operator=(const ZoneDatabaseSnapshot&) = delete;
+
+  private:
+    internal::ZoneDatabaseVersion* mVersion = nullptr;
+};
+
+/**
+ * Base class of SwappableZoneDatabase which holds the implementation,
+ * independent of the NUM_VERSIONS template parameter.
+ */
+class SwappableZoneDatabaseBase {
+  public:
+    /**
+     * Returned by publishBuffer() or publishFile() if every version other than
+     * the current one is still held by a ZoneDatabaseSnapshot. The value is
+     * distinct from the MappedZoneDatabase::kStatusXxx codes.
+     */
+    static const uint8_t kStatusBusy = 16;
+
+    /**
+     * Acquire the current version of the database. This is lock-free and
+     * never blocks on a concurrent publishBuffer() or publishFile(). Returns
+     * a snapshot which is not valid if nothing has been published.
+     */
+    ZoneDatabaseSnapshot acquire();
+
+    /**
+     * Load the database in the buffer into a free version, then make it the
+     * current version. The snapshots acquired earlier continue to use their
+     * own versions. Returns MappedZoneDatabase::kStatusOk on success, the
+     * error of MappedZoneDatabase::initFromBuffer(), or kStatusBusy.
+     *
+     * Only one thread may call the publishXxx() and reclaim() methods at a
+     * time.
+     */
+    uint8_t publishBuffer(const void* data, size_t size);
+
+  #if ACE_TIME_HAS_MMAP
+    /**
+     * Same as publishBuffer(), using MappedZoneDatabase::openFile() to map
+     * the file at `path`.
+     */
+    uint8_t publishFile(const char* path);
+  #endif
+
+    /**
+     * Unmap the versions which are neither current nor held by a snapshot,
+     * instead of waiting for the next publishXxx() to reuse them. Returns the
+     * number of versions closed.
+     */
+    uint8_t reclaim();
+
+    /** Return the generation of the current version, 0 if none. */
+    uint32_t generation() const {
+      internal::ZoneDatabaseVersion* current = mCurrent.load();
+      return current ? current->generation : 0;
+    }
+
+  protected:
+    /**
+     * Constructor.
+     *
+     * @param versions an array of `numVersions` versions
+     * @param numVersions number of versions, at least 2
+     */
+    SwappableZoneDatabaseBase(
+        internal::ZoneDatabaseVersion* versions,
+        uint8_t numVersions
+    ) :
+        mVersions(versions),
+        mNumVersions(numVersions)
+    {}
+
+  private:
+    // disable copy constructor and assignment operator
+    SwappableZoneDatabaseBase(const SwappableZoneDatabaseBase&) = delete;
+    SwappableZoneDatabaseBase& operator=(const SwappableZoneDatabaseBase&)
+        = delete;
+
+    /**
+     * Return a version which is not current and has no readers, or nullptr.
+     * A reader which still sees the version as current after incrementing
+     * its numReaders is counted, and a reader which does not will not read
+     * it, so the version can be reloaded safely.
+     */
+    internal::ZoneDatabaseVersion* findFreeVersion() const;
+
+    /** Make the loaded version the current version. */
+    void publish(internal::ZoneDatabaseVersion* version);
+
+  private:
+    internal::ZoneDatabaseVersion* const mVersions;
+    uint8_t const mNumVersions;
+    std::atomic<internal::ZoneDatabaseVersion*> mCurrent{nullptr};
+    uint32_t mGeneration = 0;
+};
+
+/**
+ * A MappedZoneDatabase which can be replaced by a new version of the TZ
+ * Database while other threads are using it, without a lock, in the style of
+ * Read-Copy-Update (RCU). Readers acquire() a ZoneDatabaseSnapshot, which
+ * costs two atomic loads and an atomic increment, and the writer publishes a
+ * new version with publishFile() or publishBuffer(). A version is reclaimed
+ * only after it is no longer current and every snapshot of it is released.
+ *
+ * NUM_VERSIONS is the maximum number of versions which can be loaded at the
+ * same time: the current version, plus the older versions still held by
+ * snapshots. If none of the older versions is free, publishing fails with
+ * kStatusBusy, so long-lived snapshots should be avoided.
+ *
+ * @tparam NUM_VERSIONS number of versions, at least 2
+ */
+template <uint8_t NUM_VERSIONS>
+class SwappableZoneDatabase : public SwappableZoneDatabaseBase {
+  public:
+    SwappableZoneDatabase() :
+        SwappableZoneDatabaseBase(mVersionArray, NUM_VERSIONS)
+    {}
+
+  private:
+    static_assert(NUM_VERSIONS >= 2, "NUM_VERSIONS must be >= 2");
+
+    internal::ZoneDatabaseVersion mVersionArray[NUM_VERSIONS];
+};
+
+/**
+ * A ZoneManager which creates TimeZones from the ZoneDatabaseSnapshots of a
+ * SwappableZoneDatabase, using its own MappedZoneProcessorHashedCache. Like
+ * the other ZoneManagers, it is not thread-safe, so each thread should have
+ * its own instance, while sharing the SwappableZoneDatabase.
+ *
+ * @code
+ * SwappableZoneDatabase<3> database; // shared by all threads
+ * ...
+ * thread_local SwappableZoneManager<8> manager(database);
+ * ZoneDatabaseSnapshot snapshot = manager.acquire();
+ * TimeZone tz = manager.createForZoneName(snapshot, "America/Los_Angeles");
+ * ...use tz until the snapshot is released...
+ * @endcode
+ *
+ * When a TimeZone is created from the snapshot of a newer generation, the
+ * cache is cleared, so the ZoneProcessors of the older generations are
+ * invalidated lazily, on the first use of the new generation by each
+ * manager. The TimeZones of the older generations remain valid while their
+ * snapshots are held, because a TimeZone rebinds its ZoneProcessor to its
+ * own zoneKey on each use.
+ *
+ * @tparam CACHE_SIZE number of ZoneProcessors in the cache
+ */
+template <uint16_t CACHE_SIZE>
+class SwappableZoneManager : public ZoneManager {
+  public:
+    /** Constructor. */
+    explicit SwappableZoneManager(SwappableZoneDatabaseBase& database) :
+        mDatabase(database)
+    {}
+
+    /** Acquire the current version of the database. */
+    ZoneDatabaseSnapshot acquire() { return mDatabase.acquire(); }
+
+    /**
+     * Create a TimeZone for the given zone name (e.g. "America/Los_Angeles")
+     * from the snapshot, which must be held while the TimeZone is used.
+     */
+    TimeZone createForZoneName(
+        const ZoneDatabaseSnapshot& snapshot, const char* name) {
+      return createForZoneInfo(snapshot,
+          registrar(snapshot).getZoneInfoForName(name));
+    }
+
+    /** Create a TimeZone for the given 32-bit zoneId from the snapshot. */
+    TimeZone createForZoneId(
+        const ZoneDatabaseSnapshot& snapshot, uint32_t id) {
+      return createForZoneInfo(snapshot,
+          registrar(snapshot).getZoneInfoForId(id));
+    }
+
+    /** Create a TimeZone for the given registry index from the snapshot. */
+    TimeZone createForZoneIndex(
+        const ZoneDatabaseSnapshot& snapshot, uint16_t index) {
+      return createForZoneInfo(snapshot,
+          registrar(snapshot).getZoneInfoForIndex(index));
+    }
+
+    /**
+     * Create a TimeZone from the TimeZoneData created by
+     * TimeZone::toTimeZoneData(), using the snapshot for a zoneId.
+     */
+    TimeZone createForTimeZoneData(
+        const ZoneDatabaseSnapshot& snapshot, const TimeZoneData& d) {
+      switch (d.type) {
+        case TimeZoneData::kTypeError:
+          return TimeZone::forError();
+        case TimeZoneData::kTypeManual:
+          return TimeZone::forTimeOffset(
+              TimeOffset::forMinutes(d.stdOffsetMinutes),
+              TimeOffset::forMinutes(d.dstOffsetMinutes));
+        case TimeZoneData::kTypeZoneId:
+          return createForZoneId(snapshot, d.zoneId);
+        default:
+          return TimeZone();
+      }
+    }
+
+    /** Return the newest generation used by this manager. */
+    uint32_t generation() const { return mGeneration; }
+
+  private:
+    // disable copy constructor and assignment operator
+    SwappableZoneManager(const SwappableZoneManager&) = delete;
+    SwappableZoneManager& operator=(const SwappableZoneManager&) = delete;
+
+    static mapped::ZoneRegistrar registrar(
+        const ZoneDatabaseSnapshot& snapshot) {
+      return mapped::ZoneRegistrar(
+          snapshot.zoneRegistrySize(), snapshot.zoneRegistry());
+    }
+
+    TimeZone createForZoneInfo(
+        const ZoneDatabaseSnapshot& snapshot,
+        const mapped::Info::ZoneInfo* zoneInfo) {
+      if (! zoneInfo) return TimeZone::forError();
+
+      // A newer version can be mapped at the address of an older one which
+      // has been reclaimed, so a cached zoneKey may refer to different data.
+      if (snapshot.generation() > mGeneration) {
+        mZoneProcessorCache.clear();
+        mGeneration = snapshot.generation();
+      }
+      MappedZoneProcessor* processor =
+          mZoneProcessorCache.getZoneProcessor((uintptr_t) zoneInfo);
+      return TimeZone::forZoneInfo(zoneInfo, processor);
+    }
+
+  private:
+    SwappableZoneDatabaseBase& mDatabase;
+    MappedZoneProcessorHashedCache<CACHE_SIZE> mZoneProcessorCache;
+    uint32_t mGeneration = 0;
+};
+
+}
+
+#endif
+
+#endif
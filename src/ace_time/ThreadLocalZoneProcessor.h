@@ -0,0 +1,202 @@
+/*
+ * MIT License
+ * Copyright (c) 2026 Brian T. Park
+ */
+
+#ifndef ACE_TIME_THREAD_LOCAL_ZONE_PROCESSOR_H
+#define ACE_TIME_THREAD_LOCAL_ZONE_PROCESSOR_H
+
+#include <stdint.h> // uintptr_t
+#include "ZoneProcessor.h"
+#include "ExtendedZoneProcessor.h"
+#include "CompleteZoneProcessor.h"
+#include "ZoneProcessorCache.h"
+
+/**
+ * Set to 1 if the toolchain supports `thread_local` storage. Enabled by default
+ * only on platforms with real threads (Linux/MacOS through EpoxyDuino, and the
+ * ESP32 using FreeRTOS), because the AVR toolchain does not support TLS.
+ */
+#ifndef ACE_TIME_HAS_THREAD_LOCAL
+  #if defined(EPOXY_DUINO) || defined(ESP32)
+    #define ACE_TIME_HAS_THREAD_LOCAL 1
+  #else
+    #define ACE_TIME_HAS_THREAD_LOCAL 0
+  #endif
+#endif
+
+#if ACE_TIME_HAS_THREAD_LOCAL
+
+class Print;
+
+namespace ace_time {
+
+/**
+ * A ZoneProcessor which can be shared by a TimeZone across multiple threads.
+ * It holds only the zoneKey. Each lookup is forwarded to a ZoneProcessor of
+ * type ZP taken from a `thread_local` hash-indexed cache of CACHE_SIZE
+ * ZoneProcessors, so the mutable transition cache of each ZP is never touched
+ * by more than one thread, without using a lock. All instances of the same
+ * template share the cache of the calling thread. (The throughput with
+ * multiple threads can be measured with examples/MultiThreadBenchmark.)
+ *
+ * The setZoneKey() method must not be called with a different zoneKey while
+ * other threads are using the object, so each zone needs its own instance,
+ * bound to its zone before it is shared (e.g. using TimeZone::forZoneInfo()).
+ * The TimeZone calls setZoneKey() with its own zoneKey on every lookup, which
+ * does not write anything if the zoneKey is unchanged. For the same reason,
+ * there is no ZoneManager for this class: the ZoneProcessorCache of a
+ * ZoneManager rebinds its processors to other zones.
+ *
+ * The per-thread cache is created on the first lookup from each thread, and
+ * contains CACHE_SIZE ZoneProcessors of type ZP, so CACHE_SIZE should be about
+ * the number of zones that each thread uses concurrently.
+ *
+ * @tparam ZP ExtendedZoneProcessor or CompleteZoneProcessor
+ * @tparam CACHE_SIZE number of ZoneProcessors in the cache of each thread
+ */
+template <typename ZP, uint16_t CACHE_SIZE>
+class ThreadLocalZoneProcessorTemplate: public ZoneProcessor {
+  public:
+    bool isLink() const override {
+      return getLocalZoneProcessor()->isLink();
+    }
+
+    uint32_t getZoneId() const override {
+      return getLocalZoneProcessor()->getZoneId();
+    }
+
+    FindResult findByLocalDateTime(const LocalDateTime& ldt) const override {
+      return getLocalZoneProcessor()->findByLocalDateTime(ldt);
+    }
+
+    FindResult findByEpochSeconds(acetime_t epochSeconds) const override {
+      return getLocalZoneProcessor()->findByEpochSeconds(epochSeconds);
+    }
+
+    FindResult findByUnixSeconds64(int64_t unixSeconds) const override {
+      return getLocalZoneProcessor()->findByUnixSeconds64(unixSeconds);
+    }
+
+    void findByEpochSecondsBatch(
+        const acetime_t* epochSeconds,
+        FindResult* results,
+        size_t num) const override {
+      getLocalZoneProcessor()->findByEpochSecondsBatch(
+          epochSeconds, results, num);
+    }
+
+    ZoneTransition findNextTransition(acetime_t epochSeconds) const override {
+      return getLocalZoneProcessor()->findNextTransition(epochSeconds);
+    }
+
+    ZoneTransition findPrevTransition(acetime_t epochSeconds) const override {
+      return getLocalZoneProcessor()->findPrevTransition(epochSeconds);
+    }
+
+    uint8_t findTransitionsForYear(
+        int16_t year,
+        int64_t afterUnixSeconds,
+        ZoneTransition* transitions,
+        uint8_t size) const override {
+      return getLocalZoneProcessor()->findTransitionsForYear(
+          year, afterUnixSeconds, transitions, size);
+    }
+
+    void printNameTo(Print& printer) const override {
+      getLocalZoneProcessor()->printNameTo(printer);
+    }
+
+    void printShortNameTo(Print& printer) const override {
+      getLocalZoneProcessor()->printShortNameTo(printer);
+    }
+
+    void printTargetNameTo(Print& printer) const override {
+      getLocalZoneProcessor()->printTargetNameTo(printer);
+    }
+
+    void setZoneKey(uintptr_t zoneKey) override {
+      // Avoid writing to a shared object when the zoneKey is unchanged.
+      if (mZoneKey != zoneKey) mZoneKey = zoneKey;
+    }
+
+    bool equalsZoneKey(uintptr_t zoneKey) const override {
+      return mZoneKey == zoneKey;
+    }
+
+    /** Return the ZoneProcessor of the calling thread for the zoneKey. */
+    ZP* getLocalZoneProcessor() const {
+      static thread_local HashedZoneProcessorCacheTemplate<ZP, CACHE_SIZE>
+          sCache;
+      return sCache.getZoneProcessor(mZoneKey);
+    }
+
+  protected:
+    /**
+     * Constructor.
+     *
+     * @param type indentifier for the specific subclass of ZoneProcessor
+     * @param zoneKey an opaque Zone primary key (e.g. const ZoneInfo*)
+     */
+    explicit ThreadLocalZoneProcessorTemplate(uint8_t type, uintptr_t zoneKey):
+        ZoneProcessor(type),
+        mZoneKey(zoneKey)
+    {}
+
+  private:
+    bool equals(const ZoneProcessor& other) const override {
+      return mZoneKey
+          == ((const ThreadLocalZoneProcessorTemplate&) other).mZoneKey;
+    }
+
+  private:
+    uintptr_t mZoneKey;
+};
+
+/**
+ * A ThreadLocalZoneProcessorTemplate which uses ExtendedZoneProcessor to read
+ * the 'zonedbx' database.
+ *
+ * @tparam CACHE_SIZE number of ZoneProcessors in the cache of each thread
+ */
+template <uint16_t CACHE_SIZE>
+class ThreadLocalExtendedZoneProcessor: public
+    ThreadLocalZoneProcessorTemplate<ExtendedZoneProcessor, CACHE_SIZE> {
+
+  public:
+    /** Unique TimeZone type identifier for ThreadLocalExtendedZoneProcessor. */
+    static const uint8_t kTypeThreadLocalExtended = 8;
+
+    explicit ThreadLocalExtendedZoneProcessor(
+        const extended::Info::ZoneInfo* zoneInfo = nullptr)
+      : ThreadLocalZoneProcessorTemplate<ExtendedZoneProcessor, CACHE_SIZE>(
+          kTypeThreadLocalExtended, (uintptr_t) zoneInfo)
+    {}
+};
+
+/**
+ * A ThreadLocalZoneProcessorTemplate which uses CompleteZoneProcessor to read
+ * the 'zonedbc' database.
+ *
+ * @tparam CACHE_SIZE number of ZoneProcessors in the cache of each thread
+ */
+template <uint16_t CACHE_SIZE>
+class ThreadLocalCompleteZoneProcessor: public
+    ThreadLocalZoneProcessorTemplate<CompleteZoneProcessor, CACHE_SIZE> {
+
+  public:
+    /** Unique TimeZone type identifier for ThreadLocalCompleteZoneProcessor. */
+    static const uint8_t kTypeThreadLocalComplete = 9;
+
+    explicit ThreadLocalCompleteZoneProcessor(
+        const complete::Info::ZoneInfo* zoneInfo = nullptr)
+      : ThreadLocalZoneProcessorTemplate<CompleteZoneProcessor, CACHE_SIZE>(
+          kTypeThreadLocalComplete, (uintptr_t) zoneInfo)
+    {}
+};
+
+} // namespace ace_time
+
+#endif // ACE_TIME_HAS_THREAD_LOCAL
+
+#endif
@@ -6,6 +6,7 @@
 #include <string.h> // strlen()
 #include <AceCommon.h>
 #include "common/DateStrings.h"
+#include "common/DateFormat.h" // formatOffset()
 #include "TimeOffset.h"
 
 using ace_common::printPad2To;
@@ -35,6 +36,21 @@ void TimeOffset::printTo(Print& printer) const {
   }
 }
 
+size_t TimeOffset::formatTo(char* buf, size_t len) const {
+  // "+hh:mm" or "+hh:mm:ss", plus NUL
+  size_t size = (mSeconds % 60 == 0) ? 7 : 10;
+  if (len < size || isError()
+      || mSeconds < -internal::kMaxFormatOffsetSeconds
+      || mSeconds > internal::kMaxFormatOffsetSeconds) {
+    if (len > 0) buf[0] = '\0';
+    return 0;
+  }
+
+  char* p = internal::formatOffset(buf, mSeconds);
+  *p = '\0';
+  return p - buf;
+}
+
 TimeOffset TimeOffset::forOffsetString(const char* offsetString) {
   // Verify length of ISO 8601 string, either 6 ("-hh:mm") or 9 ("-hh:mm:ss").
   uint8_t len = strlen(offsetString);
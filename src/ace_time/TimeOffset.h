@@ -7,6 +7,7 @@
 #define ACE_TIME_TIME_OFFSET_H
 
 #include <stdint.h>
+#include <stddef.h> // size_t
 
 class Print;
 
@@ -55,6 +56,9 @@ void increment15Minutes(TimeOffset& offset);
  */
 class TimeOffset {
   public:
+    /** Size of the largest buffer needed by formatTo(), "+hh:mm:ss" plus NUL. */
+    static const uint8_t kFormatBufferSize = 10;
+
     /**
      * Create TimeOffset with the corresponding hour offset. For example,
      * -08:00 is 'forHours(-8)'.
@@ -174,6 +178,14 @@ class TimeOffset {
      */
     void printTo(Print& printer) const;
 
+    /**
+     * Write the same string as printTo() into 'buf', terminated by a NUL. A
+     * buffer of size kFormatBufferSize is always large enough. Return the
+     * number of characters written, excluding the NUL, or 0 if the buffer is
+     * too small, the offset is an error, or the offset is 100 hours or more.
+     */
+    size_t formatTo(char* buf, size_t len) const;
+
     // Use default copy constructor and assignment operator.
     TimeOffset(const TimeOffset&) = default;
     TimeOffset& operator=(const TimeOffset&) = default;
@@ -12,6 +12,10 @@
 #include "BasicZoneProcessor.h"
 #include "ExtendedZoneProcessor.h"
 #include "CompleteZoneProcessor.h"
+#include "FlatZoneProcessor.h"
+#include "MappedZoneProcessor.h"
+#include "TzifZoneProcessor.h"
+#include "ThreadLocalZoneProcessor.h"
 #include "TimeZoneData.h"
 #include "ZonedExtra.h"
 
@@ -220,6 +224,139 @@ class TimeZone {
       );
     }
 
+    /**
+     * Convenience factory method to create from a zoneInfo and an associated
+     * FlatZoneProcessor. The ZoneInfo previously associated with the
+     * given zoneProcessor is overridden.
+     *
+     * The TimeZone is valid only over the year range of the transition table
+     * of the zoneProcessor. If the zone has more transitions than fit into the
+     * table, the range ends early, see
+     * FlatZoneProcessorTemplate::isTruncated(). Outside of the range, the
+     * conversions return an error.
+     *
+     * @param zoneInfo an extended::Info::ZoneInfo that identifies the zone
+     * @param zoneProcessor a pointer to a ZoneProcessor, cannot be nullptr
+     */
+    static TimeZone forZoneInfo(
+        const extended::Info::ZoneInfo* zoneInfo,
+        FlatZoneProcessor* zoneProcessor
+    ) {
+      return TimeZone(
+          zoneProcessor->getType(),
+          (uintptr_t) zoneInfo,
+          zoneProcessor
+      );
+    }
+
+    /**
+     * Convenience factory method to create from a zoneInfo and an associated
+     * FlatCompleteZoneProcessor. The ZoneInfo previously associated with the
+     * given zoneProcessor is overridden.
+     *
+     * The TimeZone has the same limited year range as the FlatZoneProcessor
+     * overload above.
+     *
+     * @param zoneInfo a complete::Info::ZoneInfo that identifies the zone
+     * @param zoneProcessor a pointer to a ZoneProcessor, cannot be nullptr
+     */
+    static TimeZone forZoneInfo(
+        const complete::Info::ZoneInfo* zoneInfo,
+        FlatCompleteZoneProcessor* zoneProcessor
+    ) {
+      return TimeZone(
+          zoneProcessor->getType(),
+          (uintptr_t) zoneInfo,
+          zoneProcessor
+      );
+    }
+
+    /**
+     * Convenience factory method to create from a zoneInfo of a
+     * MappedZoneDatabase and an associated MappedZoneProcessor. The ZoneInfo
+     * previously associated with the given zoneProcessor is overridden.
+     *
+     * @param zoneInfo a mapped::Info::ZoneInfo that identifies the zone
+     * @param zoneProcessor a pointer to a ZoneProcessor, cannot be nullptr
+     */
+    static TimeZone forZoneInfo(
+        const mapped::Info::ZoneInfo* zoneInfo,
+        MappedZoneProcessor* zoneProcessor
+    ) {
+      return TimeZone(
+          zoneProcessor->getType(),
+          (uintptr_t) zoneInfo,
+          zoneProcessor
+      );
+    }
+
+    /**
+     * Convenience factory method to create from a TzifZoneInfo loaded from a
+     * TZif file and an associated TzifZoneProcessor. The zoneProcessor is
+     * bound to the zoneInfo immediately, so that the resulting TimeZone can be
+     * shared by multiple threads.
+     *
+     * @param zoneInfo a TzifZoneInfo that identifies the zone
+     * @param zoneProcessor a pointer to a ZoneProcessor, cannot be nullptr
+     */
+    static TimeZone forZoneInfo(
+        const TzifZoneInfo* zoneInfo,
+        TzifZoneProcessor* zoneProcessor
+    ) {
+      zoneProcessor->setZoneKey((uintptr_t) zoneInfo);
+      return TimeZone(
+          zoneProcessor->getType(),
+          (uintptr_t) zoneInfo,
+          zoneProcessor
+      );
+    }
+
+#if ACE_TIME_HAS_THREAD_LOCAL
+    /**
+     * Convenience factory method to create from a zoneInfo and an associated
+     * ThreadLocalExtendedZoneProcessor. The zoneProcessor is bound to the
+     * zoneInfo immediately, so that the resulting TimeZone can be shared by
+     * multiple threads. Each zone needs its own zoneProcessor.
+     *
+     * @param zoneInfo an extended::Info::ZoneInfo that identifies the zone
+     * @param zoneProcessor a pointer to a ZoneProcessor, cannot be nullptr
+     */
+    template <uint16_t CACHE_SIZE>
+    static TimeZone forZoneInfo(
+        const extended::Info::ZoneInfo* zoneInfo,
+        ThreadLocalExtendedZoneProcessor<CACHE_SIZE>* zoneProcessor
+    ) {
+      zoneProcessor->setZoneKey((uintptr_t) zoneInfo);
+      return TimeZone(
+          zoneProcessor->getType(),
+          (uintptr_t) zoneInfo,
+          zoneProcessor
+      );
+    }
+
+    /**
+     * Convenience factory method to create from a zoneInfo and an associated
+     * ThreadLocalCompleteZoneProcessor. The zoneProcessor is bound to the
+     * zoneInfo immediately, so that the resulting TimeZone can be shared by
+     * multiple threads. Each zone needs its own zoneProcessor.
+     *
+     * @param zoneInfo a complete::Info::ZoneInfo that identifies the zone
+     * @param zoneProcessor a pointer to a ZoneProcessor, cannot be nullptr
+     */
+    template <uint16_t CACHE_SIZE>
+    static TimeZone forZoneInfo(
+        const complete::Info::ZoneInfo* zoneInfo,
+        ThreadLocalCompleteZoneProcessor<CACHE_SIZE>* zoneProcessor
+    ) {
+      zoneProcessor->setZoneKey((uintptr_t) zoneInfo);
+      return TimeZone(
+          zoneProcessor->getType(),
+          (uintptr_t) zoneInfo,
+          zoneProcessor
+      );
+    }
+#endif
+
     /**
      * Factory method to create from a generic zoneKey and a generic
      * zoneProcessor. The 'type' of the TimeZone is extracted from
@@ -445,20 +582,139 @@ class TimeZone {
         default: {
           FindResult result =
               getBoundZoneProcessor()->findByEpochSeconds(epochSeconds);
-          if (result.type == FindResult::kTypeNotFound) {
-            break;
-          }
+          odt = createOffsetDateTime(epochSeconds, result);
+          break;
+        }
+      }
+      return odt;
+    }
 
+    /**
+     * Return the best estimate of the OffsetDateTime at the given 64-bit
+     * number of seconds from the Unix epoch. Used by
+     * ZonedDateTime::forUnixSeconds64(). The calculation is performed in
+     * 64-bits by ZoneProcessor::findByUnixSeconds64(), so it is valid for any
+     * year in [1, 9999] if the ZoneProcessor supports it (e.g.
+     * ExtendedZoneProcessor, CompleteZoneProcessor, TzifZoneProcessor).
+     * Otherwise, unixSeconds must be within the range of the
+     * Epoch::currentEpochYear().
+     */
+    OffsetDateTime getOffsetDateTimeForUnixSeconds64(int64_t unixSeconds)
+        const {
+      OffsetDateTime odt = OffsetDateTime::forError();
+      switch (mType) {
+        case kTypeError:
+        case kTypeReserved:
+          break;
+
+        case kTypeManual:
+          odt = OffsetDateTime::forUnixSeconds64(
+              unixSeconds,
+              TimeOffset::forMinutes(mStdOffsetMinutes + mDstOffsetMinutes));
+          break;
+
+        default: {
+          FindResult result =
+              getBoundZoneProcessor()->findByUnixSeconds64(unixSeconds);
+          if (result.type == FindResult::kTypeNotFound) break;
           TimeOffset offset = TimeOffset::forSeconds(
               result.reqStdOffsetSeconds + result.reqDstOffsetSeconds);
-          odt = OffsetDateTime::forEpochSeconds(
-              epochSeconds, offset, result.fold);
+          odt = OffsetDateTime::forUnixSeconds64(
+              unixSeconds, offset, result.fold);
           break;
         }
       }
       return odt;
     }
 
+    /**
+     * Batch version of getOffsetDateTime(acetime_t) which converts the `num`
+     * elements of the `epochSeconds` array into the `odts` array. The
+     * ZoneProcessor is bound and dispatched once per chunk of elements
+     * instead of once per element, and the ZoneProcessor can reuse its
+     * transitions across consecutive elements, and across chunks (see
+     * ZoneProcessor::findByEpochSecondsBatch()).
+     */
+    void getOffsetDateTimeBatch(
+        const acetime_t* epochSeconds,
+        OffsetDateTime* odts,
+        size_t num) const {
+      switch (mType) {
+        case kTypeError:
+        case kTypeReserved:
+          for (size_t i = 0; i < num; i++) {
+            odts[i] = OffsetDateTime::forError();
+          }
+          break;
+
+        case kTypeManual: {
+          TimeOffset offset = TimeOffset::forMinutes(
+              mStdOffsetMinutes + mDstOffsetMinutes);
+          for (size_t i = 0; i < num; i++) {
+            odts[i] = OffsetDateTime::forEpochSeconds(epochSeconds[i], offset);
+          }
+          break;
+        }
+
+        default: {
+          // Process in chunks to keep the FindResult buffer on the stack small.
+          FindResult results[kBatchChunkSize];
+          const ZoneProcessor* processor = getBoundZoneProcessor();
+          for (size_t i = 0; i < num; i += kBatchChunkSize) {
+            size_t n = (num - i < kBatchChunkSize) ? num - i : kBatchChunkSize;
+            processor->findByEpochSecondsBatch(epochSeconds + i, results, n);
+            for (size_t j = 0; j < n; j++) {
+              odts[i + j] = createOffsetDateTime(
+                  epochSeconds[i + j], results[j]);
+            }
+          }
+          break;
+        }
+      }
+    }
+
+    /**
+     * Return the next transition strictly after epochSeconds, where the UTC
+     * offset or the abbreviation of the time zone changes, crossing year
+     * boundaries as needed. The UTC offset returned by getOffsetDateTime() is
+     * valid until ZoneTransition::epochSeconds, so a caller can cache it and
+     * skip further lookups until then. Returns an error (isError() is true)
+     * for a kTypeManual time zone which never changes, or if there is no
+     * transition before Epoch::epochValidYearUpper().
+     *
+     * Supported by the Extended, Complete, Flat, and ThreadLocal processors
+     * (and their subclasses). Other processors return an error.
+     */
+    ZoneTransition nextTransition(acetime_t epochSeconds) const {
+      switch (mType) {
+        case kTypeError:
+        case kTypeReserved:
+        case kTypeManual:
+          return ZoneTransition();
+
+        default:
+          return getBoundZoneProcessor()->findNextTransition(epochSeconds);
+      }
+    }
+
+    /**
+     * Return the latest transition at or before epochSeconds, which defines
+     * the UTC offset at epochSeconds. Returns an error if there is no
+     * transition on or after Epoch::epochValidYearLower(). See
+     * nextTransition().
+     */
+    ZoneTransition prevTransition(acetime_t epochSeconds) const {
+      switch (mType) {
+        case kTypeError:
+        case kTypeReserved:
+        case kTypeManual:
+          return ZoneTransition();
+
+        default:
+          return getBoundZoneProcessor()->findPrevTransition(epochSeconds);
+      }
+    }
+
     /** Return true if UTC (+00:00+00:00). */
     bool isUtc() const {
       if (mType != kTypeManual) return false;
@@ -549,6 +805,21 @@ class TimeZone {
   private:
     friend bool operator==(const TimeZone& a, const TimeZone& b);
 
+    /** Number of FindResult processed at a time by getOffsetDateTimeBatch(). */
+    static const uint8_t kBatchChunkSize = 8;
+
+    /** Convert the FindResult at the given epochSeconds to OffsetDateTime. */
+    static OffsetDateTime createOffsetDateTime(
+        acetime_t epochSeconds, const FindResult& result) {
+      if (result.type == FindResult::kTypeNotFound) {
+        return OffsetDateTime::forError();
+      }
+      TimeOffset offset = TimeOffset::forSeconds(
+          result.reqStdOffsetSeconds + result.reqDstOffsetSeconds);
+      return OffsetDateTime::forEpochSeconds(
+          epochSeconds, offset, result.fold);
+    }
+
     /**
      * Constructor for a kTypeManual TimeZone.
      *
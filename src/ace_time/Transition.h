@@ -28,6 +28,23 @@ class Print;
 #define ACE_TIME_EXTENDED_ZONE_PROCESSOR_DEBUG 0
 #endif
 
+/**
+ * Set to 1 to store precomputed search keys in each Transition, which makes
+ * the lookups of the ExtendedZoneProcessor and CompleteZoneProcessor faster at
+ * the cost of RAM: the startDateTime and untilDateTime packed into 64-bit
+ * integers (16 bytes per Transition). Enabled by default only on platforms
+ * with plenty of RAM (Linux/MacOS through EpoxyDuino, and the ESP32). Other
+ * microcontrollers keep the smaller layout, whose lookups compare the
+ * DateTuples directly.
+ */
+#ifndef ACE_TIME_TRANSITION_SEARCH_KEYS
+  #if defined(EPOXY_DUINO) || defined(ESP32)
+    #define ACE_TIME_TRANSITION_SEARCH_KEYS 1
+  #else
+    #define ACE_TIME_TRANSITION_SEARCH_KEYS 0
+  #endif
+#endif
+
 namespace ace_time {
 namespace extended {
 
@@ -170,7 +187,14 @@ struct TransitionTemplate {
   DateTuple originalTransitionTime;
 #endif
 
-  /** The calculated transition time of the given rule. */
+  /**
+   * The calculated transition time of the given rule. Clamped to
+   * [LocalDate::kMinEpochSeconds, LocalDate::kMaxEpochSeconds] if the
+   * transition is out of range of the 32-bit epochSeconds, which happens for
+   * the years calculated by the 64-bit functions (e.g.
+   * ExtendedZoneProcessor::findByUnixSeconds64()). Use startUnixSeconds64()
+   * for those years.
+   */
   acetime_t startEpochSeconds;
 
   /** The standard time offset seconds, not the total offset. */
@@ -203,10 +227,54 @@ struct TransitionTemplate {
     CompareStatus compareStatus;
   };
 
+#if ACE_TIME_TRANSITION_SEARCH_KEYS
+  /**
+   * The startDateTime packed by packDateTuple(), so that
+   * TransitionStorageTemplate::findTransitionForDateTime() compares integers
+   * instead of DateTuples. Valid after
+   * ExtendedZoneProcessor::generateStartUntilTimes() is called.
+   */
+  int64_t packedStartDateTime;
+
+  /** The untilDateTime packed by packDateTuple(). */
+  int64_t packedUntilDateTime;
+
+  /**
+   * The start time as the 64-bit number of seconds from the Unix epoch,
+   * returned by startUnixSeconds64(). Valid after
+   * ExtendedZoneProcessor::generateStartUntilTimes() is called.
+   */
+  int64_t startUnixSeconds;
+#endif
+
   const char* format() const {
     return match->era.format();
   }
 
+  /**
+   * Return the 64-bit equivalent of startEpochSeconds, the number of seconds
+   * from the Unix epoch, which is valid for any year. Valid after
+   * ExtendedZoneProcessor::generateStartUntilTimes() is called, using the
+   * same Epoch::currentEpochYear().
+   *
+   * If ACE_TIME_TRANSITION_SEARCH_KEYS is enabled, this returns the value
+   * saved by generateStartUntilTimes(). Otherwise, it is derived from
+   * startEpochSeconds, and calculated from startDateTime only if
+   * startEpochSeconds was clamped.
+   */
+  int64_t startUnixSeconds64() const {
+  #if ACE_TIME_TRANSITION_SEARCH_KEYS
+    return startUnixSeconds;
+  #else
+    if (startEpochSeconds > LocalDate::kMinEpochSeconds
+        && startEpochSeconds < LocalDate::kMaxEpochSeconds) {
+      return startEpochSeconds + Epoch::secondsToCurrentEpochFromUnixEpoch64();
+    }
+    return dateTupleToUnixSeconds64(startDateTime)
+        - (offsetSeconds + deltaSeconds);
+  #endif
+  }
+
   /** Used only for debugging. */
   void log() const {
     logging::printf("Transition(");
@@ -270,7 +338,7 @@ struct TransitionTemplate {
 
 /**
  * Tuple of a matching Transition and its 'fold'. Used by
- * findTransitionForSeconds() which is guaranteed to return only a single
+ * findTransitionForSecondsFrom() which is guaranteed to return only a single
  * Transition if found. Usually `fold=0`. But if the epochSeconds maps to a
  * LocalDateTime which occurs a second time during a "fall back", then `fold` is
  * set to 1.
@@ -386,6 +454,9 @@ class TransitionStorageTemplate {
       mIndexPrior = 0;
       mIndexCandidates = 0;
       mIndexFree = 0;
+    #if ACE_TIME_TRANSITION_SEARCH_KEYS
+      mNumSearchTransitions = 0;
+    #endif
     }
 
     /** Return the current prior transition. */
@@ -550,6 +621,68 @@ class TransitionStorageTemplate {
       return mTransitions[iActive - 1];
     }
 
+    /**
+     * Copy the lookup-critical data of the Active pool into the dense search
+     * arrays used by findTransitionForSecondsFrom(), after the startEpochSeconds,
+     * startDateTime and untilDateTime of every active Transition have been
+     * calculated. The Transitions themselves are spread across mPool in the
+     * order in which they were allocated, so scanning their startEpochSeconds
+     * through mTransitions touches a different cache line for each one. The
+     * search arrays keep the startEpochSeconds contiguous, along with the
+     * shift of the UTC offset at each Transition, which would otherwise be
+     * recalculated from the DateTuples on every lookup. This must be called
+     * again after the Active pool is rebuilt, since init() empties the search
+     * arrays.
+     *
+     * The search arrays exist only if ACE_TIME_TRANSITION_SEARCH_KEYS is
+     * enabled. Otherwise, this does nothing, and the lookups read the
+     * Transitions directly.
+     */
+    void compactActivePool() {
+    #if ACE_TIME_TRANSITION_SEARCH_KEYS
+      mNumSearchTransitions = mIndexFree;
+      for (uint8_t i = 0; i < mIndexFree; i++) {
+        const Transition* curr = mTransitions[i];
+        mStartEpochSeconds[i] = curr->startEpochSeconds;
+        // Can be 0 in some cases where the zone changed from DST of one zone
+        // to the STD into another zone, causing the overall UTC offset to
+        // remain unchanged.
+        mShiftSeconds[i] = (i == 0) ? 0 : subtractDateTuple(
+            curr->startDateTime, mTransitions[i - 1]->untilDateTime);
+      }
+    #endif
+    }
+
+    /**
+     * Same as findTransitionForSecondsFrom(), but using the 64-bit number of
+     * seconds from the Unix epoch. The start time of each Transition is the
+     * 64-bit TransitionTemplate::startUnixSeconds64() instead of the 32-bit
+     * startEpochSeconds, so the result is valid for any year supported by the
+     * TransitionStorage, independent of the Epoch::currentEpochYear().
+     */
+    TransitionForSeconds findTransitionForUnixSeconds64(int64_t unixSeconds)
+        const {
+      uint8_t i = 0;
+      int64_t currStart = 0;
+      int64_t nextStart = 0;
+      for (; i < numSearchTransitions(); i++) {
+        nextStart = mTransitions[i]->startUnixSeconds64();
+        if (nextStart > unixSeconds) break;
+        currStart = nextStart;
+      }
+
+      if (i == 0) {
+        return TransitionForSeconds{nullptr, 0, 0};
+      }
+      uint8_t fold;
+      uint8_t num;
+      calcFoldAndOverlap(&fold, &num, i - 1,
+          (acetime_t) (unixSeconds - currStart),
+          (i < numSearchTransitions())
+              ? (acetime_t) (nextStart - unixSeconds) : 0);
+      return TransitionForSeconds{mTransitions[i - 1], fold, num};
+    }
+
     /**
      * Return the Transition matching the given epochSeconds. Return nullptr if
      * no matching Transition found. If a zone does not have any transition
@@ -558,112 +691,92 @@ class TransitionStorageTemplate {
      * be the year 1872 (because the year is stored as an int8_t). Therefore,
      * this method should never return a nullptr for a well-formed ZoneInfo
      * file.
+     *
+     * The scan starts at the transition given by `*index`, then `*index` is
+     * updated to the position of the matching transition. This allows a
+     * merge-style walk through a sorted array of epochSeconds. If epochSeconds
+     * is earlier than the starting transition, the scan restarts at the
+     * beginning, so unsorted input still returns the correct result. A single
+     * lookup passes an `*index` of 0.
+     *
+     * If ACE_TIME_TRANSITION_SEARCH_KEYS is enabled, the search scans the
+     * dense array of startEpochSeconds filled by compactActivePool(), and
+     * reads only the matching Transition.
      */
-    TransitionForSeconds findTransitionForSeconds(acetime_t epochSeconds)
-        const {
-      if (ACE_TIME_EXTENDED_ZONE_PROCESSOR_DEBUG) {
-        logging::printf(
-            "findTransitionForSeconds(): mIndexFree: %d\n", mIndexFree);
+    TransitionForSeconds findTransitionForSecondsFrom(
+        acetime_t epochSeconds, uint8_t* index) const {
+      uint8_t i = *index;
+      if (i >= numSearchTransitions() || startSecondsAt(i) > epochSeconds) {
+        i = 0;
       }
-
-      const Transition* prev = nullptr;
-      const Transition* curr = nullptr;
-      const Transition* next = nullptr;
-      for (uint8_t i = 0; i < mIndexFree; i++) {
-        next = mTransitions[i];
-        if (next->startEpochSeconds > epochSeconds) break;
-        prev = curr;
-        curr = next;
-        next = nullptr;
+      if (i >= numSearchTransitions() || startSecondsAt(i) > epochSeconds) {
+        *index = 0;
+        return TransitionForSeconds{nullptr, 0, 0};
+      }
+      while (i + 1 < numSearchTransitions()
+          && startSecondsAt(i + 1) <= epochSeconds) {
+        i++;
       }
+      *index = i;
 
       uint8_t fold;
       uint8_t num;
-      calcFoldAndOverlap(&fold, &num, prev, curr, next, epochSeconds);
-      //fprintf(stderr, "prev=%p;curr=%p;next=%p;fold=%d;num=%d\n",
-      //  prev, curr, next, fold, num);
-      return TransitionForSeconds{curr, fold, num};
+      calcFoldAndOverlap(&fold, &num, i,
+          epochSeconds - startSecondsAt(i),
+          (i + 1 < numSearchTransitions())
+              ? startSecondsAt(i + 1) - epochSeconds : 0);
+      return TransitionForSeconds{mTransitions[i], fold, num};
     }
 
     /**
-     * Calculate the fold and num parameters of TransitionForSecond.
+     * Calculate the fold and num parameters of TransitionForSecond, for the
+     * active transition at index i, given the number of seconds from the start
+     * of that transition (secondsFromCurr), and the number of seconds to the
+     * start of the next transition (secondsToNext, ignored if there is no next
+     * transition). Both differences are bounded by the
+     * 14-month window of the TransitionStorage, so the 64-bit
+     * findTransitionForUnixSeconds64() can share this calculation.
      *
      * The `num` parameter is the number of transitions which can shadow a given
-     * epochSeconds. It is 0 if `curr` is NULL, which means that epochSeconds
-     * cannot be mapped to any transition. It is 1 if the epochSeconds in the
-     * `curr` transition is unique and does not overlap with the `prev` or
-     * `next` transition. It is 2 if the epochSeconds in the `curr` transition
-     * maps to a LocalDateTime that overlaps with either the `prev` or `next`
-     * transition. (In theory, I suppose it could overlap with both, but it is
-     * improbable that any timezone in the TZDB will ever let that happen.)
+     * epochSeconds. It is 1 if the epochSeconds in the `curr` transition is
+     * unique and does not overlap with the `prev` or `next` transition. It is
+     * 2 if the epochSeconds in the `curr` transition maps to a LocalDateTime
+     * that overlaps with either the `prev` or `next` transition. (In theory, I
+     * suppose it could overlap with both, but it is improbable that any
+     * timezone in the TZDB will ever let that happen.)
      *
      * The `fold` parameter specifies whether the `curr` transition is the first
      * instance (0) or the second instance (1). It is relevant only if `num` is
-     * 2. If `num` is 0 or 1, `fold` will always be 0. If `num` is 2, then
-     * `fold` indicates whether `curr` is the earlier (0) or later (1)
-     * transition of the overlap. This `fold` parameter will be copied into the
-     * corresponding `fold` parameter in LocalDateTime.
+     * 2. If `num` is 1, `fold` will always be 0. If `num` is 2, then `fold`
+     * indicates whether `curr` is the earlier (0) or later (1) transition of
+     * the overlap. This `fold` parameter will be copied into the corresponding
+     * `fold` parameter in LocalDateTime.
      */
-    static void calcFoldAndOverlap(
+    void calcFoldAndOverlap(
         uint8_t* fold,
         uint8_t* num,
-        const Transition* prev,
-        const Transition* curr,
-        const Transition* next,
-        acetime_t epochSeconds) {
-
-      if (curr == nullptr) {
-        *fold = 0;
-        *num = 0;
-        return;
-      }
-
-      // Check if within forward overlap shadow from prev
-      bool isOverlap;
-      if (prev == nullptr) {
-        isOverlap = false;
-      } else {
-        // Extract the shift from prev transition. Can be 0 in some cases where
-        // the zone changed from DST of one zone to the STD into another zone,
-        // causing the overall UTC offset to remain unchanged.
-        acetime_t shiftSeconds = subtractDateTuple(
-            curr->startDateTime, prev->untilDateTime);
-        if (shiftSeconds >= 0) {
-          // spring forward, or unchanged
-          isOverlap = false;
-        } else {
-          // Check if within the forward overlap shadow from prev
-          isOverlap = epochSeconds - curr->startEpochSeconds < -shiftSeconds;
-        }
-      }
-      if (isOverlap) {
+        uint8_t i,
+        acetime_t secondsFromCurr,
+        acetime_t secondsToNext) const {
+
+      // Check if within the forward overlap shadow from prev. A shift >= 0
+      // is a spring forward, or unchanged.
+      acetime_t shiftSeconds = shiftSecondsAt(i);
+      if (i > 0 && shiftSeconds < 0 && secondsFromCurr < -shiftSeconds) {
         *fold = 1; // epochSeconds selects the second match
         *num = 2;
         return;
       }
 
-      // Check if within backward overlap shawdow from next
-      if (next == nullptr) {
-        isOverlap = false;
-      } else {
-        // Extract the shift to next transition. Can be 0 in some cases where
-        // the zone changed from DST of one zone to the STD into another zone,
-        // causing the overall UTC offset to remain unchanged.
-        acetime_t shiftSeconds = subtractDateTuple(
-            next->startDateTime, curr->untilDateTime);
-        if (shiftSeconds >= 0) {
-          // spring forward, or unchanged
-          isOverlap = false;
-        } else {
-          // Check if within the backward overlap shadow from next
-          isOverlap = next->startEpochSeconds - epochSeconds <= -shiftSeconds;
+      // Check if within the backward overlap shadow from next
+      if (i + 1 < numSearchTransitions()) {
+        shiftSeconds = shiftSecondsAt(i + 1);
+        if (shiftSeconds < 0 && secondsToNext <= -shiftSeconds) {
+          *fold = 0; // epochSeconds selects the first match
+          *num = 2;
+          return;
         }
       }
-      if (isOverlap) {
-        *fold = 0; // epochSeconds selects the first match
-        *num = 2;
-        return;
-      }
 
       // Normal single match, no overlap.
       *fold = 0;
@@ -674,7 +787,64 @@ class TransitionStorageTemplate {
      * Return the candidate Transitions matching the given dateTime. The
      * search may return 0, 1 or 2 Transitions, depending on whether the
      * dateTime falls in a gap or overlap.
+     *
+     * If ACE_TIME_TRANSITION_SEARCH_KEYS is enabled, the Transitions are
+     * sorted by their packedStartDateTime, so a binary search finds the last
+     * Transition which starts at or before the dateTime. The dateTime is an
+     * exact match if it is before the packedUntilDateTime of that Transition,
+     * and an overlap if it is also before the packedUntilDateTime of the
+     * previous Transition (i.e. inside a "fall back"). Otherwise, the
+     * dateTime is in the gap before the next Transition (i.e. inside a
+     * "spring forward").
+     *
+     * If ACE_TIME_TRANSITION_SEARCH_KEYS is disabled, the DateTuples of
+     * adjacent pairs of Transitions are compared in a linear scan.
      */
+  #if ACE_TIME_TRANSITION_SEARCH_KEYS
+    TransitionForDateTime findTransitionForDateTime(
+        const LocalDateTime& ldt) const {
+      int64_t localDate = packDateTuple(
+          ldt.year(),
+          ldt.month(),
+          ldt.day(),
+          (ldt.hour() * int32_t(60) + ldt.minute()) * 60 + ldt.second());
+
+      // Find the number of Transitions whose start is <= localDate.
+      uint8_t lo = 0;
+      uint8_t hi = mIndexFree;
+      while (lo < hi) {
+        uint8_t mid = (lo + hi) / 2;
+        if (mTransitions[mid]->packedStartDateTime <= localDate) {
+          lo = mid + 1;
+        } else {
+          hi = mid;
+        }
+      }
+
+      // Before the first Transition (should not happen).
+      if (lo == 0) {
+        const Transition* first = (mIndexFree > 0) ? mTransitions[0] : nullptr;
+        return TransitionForDateTime{nullptr, first, 0};
+      }
+
+      const Transition* curr = mTransitions[lo - 1];
+      if (localDate < curr->packedUntilDateTime) {
+        // Check the previous Transition to detect an overlap.
+        if (lo >= 2) {
+          const Transition* prev = mTransitions[lo - 2];
+          if (localDate < prev->packedUntilDateTime) {
+            return TransitionForDateTime{prev, curr, 2};
+          }
+        }
+        return TransitionForDateTime{curr, curr, 1};
+      }
+
+      // In the gap before the next Transition, or after the last Transition
+      // (should not happen).
+      const Transition* next = (lo < mIndexFree) ? mTransitions[lo] : nullptr;
+      return TransitionForDateTime{curr, next, 0};
+    }
+  #else
     TransitionForDateTime findTransitionForDateTime(
         const LocalDateTime& ldt) const {
       // Convert LocalDateTime to DateTuple.
@@ -729,6 +899,7 @@ class TransitionStorageTemplate {
       // This should get optimized by RVO.
       return TransitionForDateTime{prev, curr, num};
     }
+  #endif
 
     /** Verify that the indexes are valid. Used only for debugging. */
     void log() const {
@@ -783,6 +954,37 @@ class TransitionStorageTemplate {
       return mTransitions[i];
     }
 
+    /** Return the number of active Transitions searched by the lookups. */
+    uint8_t numSearchTransitions() const {
+    #if ACE_TIME_TRANSITION_SEARCH_KEYS
+      return mNumSearchTransitions;
+    #else
+      return mIndexFree;
+    #endif
+    }
+
+    /** Return the startEpochSeconds of the active Transition at index i. */
+    acetime_t startSecondsAt(uint8_t i) const {
+    #if ACE_TIME_TRANSITION_SEARCH_KEYS
+      return mStartEpochSeconds[i];
+    #else
+      return mTransitions[i]->startEpochSeconds;
+    #endif
+    }
+
+    /**
+     * Return the shift of the UTC offset at the active Transition at index i.
+     * See mShiftSeconds.
+     */
+    acetime_t shiftSecondsAt(uint8_t i) const {
+    #if ACE_TIME_TRANSITION_SEARCH_KEYS
+      return mShiftSeconds[i];
+    #else
+      return (i == 0) ? 0 : subtractDateTuple(
+          mTransitions[i]->startDateTime, mTransitions[i - 1]->untilDateTime);
+    #endif
+    }
+
     Transition mPool[SIZE];
     Transition* mTransitions[SIZE];
     uint8_t mIndexPrior;
@@ -791,6 +993,24 @@ class TransitionStorageTemplate {
 
     /** Number of allocated transitions. */
     uint8_t mAllocSize = 0;
+
+  #if ACE_TIME_TRANSITION_SEARCH_KEYS
+    /**
+     * Number of active Transitions copied into the search arrays by
+     * compactActivePool().
+     */
+    uint8_t mNumSearchTransitions = 0;
+
+    /** The startEpochSeconds of the active Transitions, in order. */
+    acetime_t mStartEpochSeconds[SIZE];
+
+    /**
+     * The shift of the UTC offset at each active Transition, i.e. its
+     * startDateTime minus the untilDateTime of the previous Transition. A
+     * negative shift is a "fall back" which creates an overlap.
+     */
+    acetime_t mShiftSeconds[SIZE];
+  #endif
 };
 
 } // namespace extended
@@ -0,0 +1,188 @@
+/*
+ * MIT License
+ * Copyright (c) 2026 Brian T. Park
+ */
+
+#include <string.h> // memcmp(), strlen(), memcpy()
+#include <AceCommon.h> // hashDjb2()
+#include "TzifZoneInfo.h"
+
+namespace ace_time {
+
+uint8_t TzifZoneInfo::parse(
+    const char* name, const uint8_t* data, size_t size) {
+  size_t nameLength = strlen(name);
+  if (nameLength == 0 || nameLength >= kMaxNameSize) return kStatusBadName;
+
+  // The version 1 header and data block, which are skipped.
+  if (size < kHeaderSize) return kStatusBadSize;
+  if (memcmp(data, "TZif", 4) != 0) return kStatusBadHeader;
+  if (data[4] < '2') return kStatusBadHeader;
+  uint64_t v1Size = (uint64_t) readUint32(data + 32) * 5 // timecnt
+      + (uint64_t) readUint32(data + 36) * kTimeTypeSize // typecnt
+      + readUint32(data + 40) // charcnt
+      + (uint64_t) readUint32(data + 28) * 8 // leapcnt
+      + readUint32(data + 24) // isstdcnt
+      + readUint32(data + 20); // isutcnt
+  if (v1Size > size - kHeaderSize) return kStatusBadSize;
+
+  // The version 2+ header, followed by the 64-bit data block.
+  const uint8_t* header = data + kHeaderSize + v1Size;
+  const uint8_t* end = data + size;
+  if ((size_t) (end - header) < kHeaderSize) return kStatusBadSize;
+  if (memcmp(header, "TZif", 4) != 0) return kStatusBadHeader;
+  uint32_t isutcnt = readUint32(header + 20);
+  uint32_t isstdcnt = readUint32(header + 24);
+  uint32_t leapcnt = readUint32(header + 28);
+  uint32_t timecnt = readUint32(header + 32);
+  uint32_t typecnt = readUint32(header + 36);
+  uint32_t charcnt = readUint32(header + 40);
+  if (leapcnt != 0) return kStatusUnsupported;
+  if (typecnt == 0 || typecnt > 256 || charcnt == 0
+      || (isutcnt != 0 && isutcnt != typecnt)
+      || (isstdcnt != 0 && isstdcnt != typecnt)) {
+    return kStatusBadData;
+  }
+  uint64_t v2Size = (uint64_t) timecnt * 9
+      + (uint64_t) typecnt * kTimeTypeSize
+      + charcnt + isstdcnt + isutcnt;
+  const uint8_t* block = header + kHeaderSize;
+  if (v2Size > (uint64_t) (end - block)) return kStatusBadSize;
+
+  const uint8_t* times = block;
+  const uint8_t* typeIndexes = times + (size_t) timecnt * 8;
+  const uint8_t* timeTypes = typeIndexes + timecnt;
+  const char* abbrevs = (const char*) (timeTypes + typecnt * kTimeTypeSize);
+
+  // Validate the records once, so that the lookups need no checks.
+  for (uint32_t i = 0; i < timecnt; i++) {
+    if (typeIndexes[i] >= typecnt) return kStatusBadData;
+    if (i > 0 && readInt64(times + 8 * i) <= readInt64(times + 8 * (i - 1))) {
+      return kStatusBadData;
+    }
+  }
+  for (uint32_t i = 0; i < typecnt; i++) {
+    const uint8_t* timeType = timeTypes + i * kTimeTypeSize;
+    if (timeType[4] > 1 || timeType[5] >= charcnt) return kStatusBadData;
+  }
+  if (abbrevs[charcnt - 1] != '\0') return kStatusBadData;
+
+  // The footer is a POSIX TZ string between two newlines, possibly empty.
+  const char* footer = (const char*) (block + v2Size);
+  const char* footerEnd = (const char*) end;
+  if (footer == footerEnd || *footer != '\n') return kStatusBadSize;
+  footer++;
+  const char* newline = footer;
+  while (newline != footerEnd && *newline != '\n') newline++;
+  if (newline == footerEnd) return kStatusBadSize;
+  if (newline != footer && !mFooter.parse(footer, newline - footer)) {
+    return kStatusBadData;
+  }
+
+  mTransitionTimes = times;
+  mTypeIndexes = typeIndexes;
+  mTimeTypes = timeTypes;
+  mAbbrevs = abbrevs;
+  mNumTransitions = timecnt;
+  memcpy(mName, name, nameLength + 1);
+  mZoneId = ace_common::hashDjb2(mName);
+  return kStatusOk;
+}
+
+uint8_t TzifZoneInfo::initFromBuffer(
+    const char* name, const void* data, size_t size) {
+  close();
+  uint8_t status = parse(name, (const uint8_t*) data, size);
+  if (status != kStatusOk) close();
+  mStatus = status;
+  return mStatus;
+}
+
+#if ACE_TIME_HAS_MMAP
+
+uint8_t TzifZoneInfo::openFile(const char* name, const char* path) {
+  close();
+
+  if (! mMappedFile.open(path)) {
+    mStatus = kStatusOpenError;
+    return mStatus;
+  }
+
+  uint8_t status = parse(name, (const uint8_t*) mMappedFile.data(),
+      mMappedFile.size());
+  if (status != kStatusOk) close();
+  mStatus = status;
+  return mStatus;
+}
+
+#endif
+
+void TzifZoneInfo::close() {
+  mMappedFile.close();
+  mTransitionTimes = nullptr;
+  mTypeIndexes = nullptr;
+  mTimeTypes = nullptr;
+  mAbbrevs = nullptr;
+  mNumTransitions = 0;
+  mZoneId = 0;
+  mFooter = PosixTimeZone();
+  mName[0] = '\0';
+  mStatus = kStatusNotLoaded;
+}
+
+void TzifZoneInfo::findForUnixSeconds(
+    int64_t unixSeconds, LocalTimeType& type) const {
+  // The footer applies after the last transition.
+  if (mFooter.isValid()
+      && (mNumTransitions == 0
+          || unixSeconds > transitionTime(mNumTransitions - 1))) {
+    mFooter.findForUnixSeconds(unixSeconds, type);
+    return;
+  }
+
+  // Find the last transition at or before unixSeconds.
+  uint32_t low = 0;
+  uint32_t high = mNumTransitions;
+  while (low < high) {
+    uint32_t mid = low + (high - low) / 2;
+    if (transitionTime(mid) <= unixSeconds) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+  findForTransition((int32_t) low - 1, type);
+}
+
+void TzifZoneInfo::findForTransition(int32_t i, LocalTimeType& type) const {
+  uint8_t typeIndex = typeIndexAt(i);
+  const uint8_t* timeType = mTimeTypes + kTimeTypeSize * typeIndex;
+  type.utcOffsetSeconds = (int32_t) readUint32(timeType);
+  type.abbrev = mAbbrevs + timeType[5];
+  if (! isDst(typeIndex)) {
+    type.stdOffsetSeconds = type.utcOffsetSeconds;
+    return;
+  }
+
+  // TZif does not record the STD offset of a DST type, so use the UTC offset
+  // of the nearest STD type.
+  for (int32_t j = i - 1; j >= -1; j--) {
+    uint8_t index = typeIndexAt(j);
+    if (! isDst(index)) {
+      type.stdOffsetSeconds =
+          (int32_t) readUint32(mTimeTypes + kTimeTypeSize * index);
+      return;
+    }
+  }
+  for (int32_t j = i + 1; j < (int32_t) mNumTransitions; j++) {
+    uint8_t index = typeIndexAt(j);
+    if (! isDst(index)) {
+      type.stdOffsetSeconds =
+          (int32_t) readUint32(mTimeTypes + kTimeTypeSize * index);
+      return;
+    }
+  }
+  type.stdOffsetSeconds = type.utcOffsetSeconds - 3600;
+}
+
+}
@@ -0,0 +1,179 @@
+/*
+ * MIT License
+ * Copyright (c) 2026 Brian T. Park
+ */
+
+#ifndef ACE_TIME_TZIF_ZONE_INFO_H
+#define ACE_TIME_TZIF_ZONE_INFO_H
+
+#include <stdint.h>
+#include <stddef.h> // size_t
+#include "../zoneinfo/compat.h" // ACE_TIME_HAS_MMAP
+#include "common/MappedFile.h"
+#include "PosixTimeZone.h"
+
+namespace ace_time {
+
+/**
+ * A single zone read from a TZif file (RFC 8536), such as the files installed
+ * in /usr/share/zoneinfo by most Unix systems. Only version 2 and later files
+ * are supported, because only their 64-bit data block is read. The data block
+ * is used in place without copying: the transition times are decoded from the
+ * big-endian bytes on each probe of the binary search. Times after the last
+ * transition are calculated from the POSIX TZ string in the footer.
+ *
+ * Files with leap second records (e.g. the "right/" zones) are rejected,
+ * because AceTime ignores leap seconds.
+ *
+ * The object is immutable after initFromBuffer() or openFile(), so it can be
+ * read by multiple threads concurrently. It is not copyable, because a
+ * TzifZoneProcessor refers to it by its address.
+ */
+class TzifZoneInfo {
+  public:
+    /** Maximum size of the zone name, including the NUL terminator. */
+    static const uint8_t kMaxNameSize = 48;
+
+    /** The zone is valid. */
+    static const uint8_t kStatusOk = 0;
+
+    /** No file or buffer has been loaded, or close() was called. */
+    static const uint8_t kStatusNotLoaded = 1;
+
+    /** The file could not be opened or mapped. */
+    static const uint8_t kStatusOpenError = 2;
+
+    /** The magic string is not "TZif", or the version is earlier than 2. */
+    static const uint8_t kStatusBadHeader = 3;
+
+    /** The data blocks or the footer do not fit in the buffer. */
+    static const uint8_t kStatusBadSize = 4;
+
+    /** The transitions, time types, or footer are invalid. */
+    static const uint8_t kStatusBadData = 5;
+
+    /** The zone name is empty or longer than kMaxNameSize - 1. */
+    static const uint8_t kStatusBadName = 6;
+
+    /** The file contains leap second records. */
+    static const uint8_t kStatusUnsupported = 7;
+
+    /** Local time type returned by findForUnixSeconds(). */
+    using LocalTimeType = PosixTimeZone::LocalTimeType;
+
+    /** Constructor. The zone is not valid until it is loaded. */
+    TzifZoneInfo() = default;
+
+    /** Destructor, which unmaps the file opened by openFile(). */
+    ~TzifZoneInfo() { close(); }
+
+    /**
+     * Use the TZif data of `size` bytes in the given buffer, which must
+     * outlive this object, for the zone of the given name (e.g.
+     * "America/Los_Angeles"). Returns kStatusOk if the data is valid.
+     */
+    uint8_t initFromBuffer(const char* name, const void* data, size_t size);
+
+  #if ACE_TIME_HAS_MMAP
+    /**
+     * Map the TZif file at `path` into memory as read-only, for the zone of
+     * the given name. Returns kStatusOk if the file was mapped and is valid.
+     */
+    uint8_t openFile(const char* name, const char* path);
+  #endif
+
+    /** Unmap the file (if any), and invalidate the zone. */
+    void close();
+
+    /** Return the status of the last initFromBuffer() or openFile(). */
+    uint8_t status() const { return mStatus; }
+
+    /** Return true if the zone was loaded successfully. */
+    bool isValid() const { return mStatus == kStatusOk; }
+
+    /** Return the name of the zone, or "" if not valid. */
+    const char* name() const { return mName; }
+
+    /**
+     * Return the zoneId, the djb2 hash of the name, which is identical to the
+     * zoneId of the same zone in the zonedb databases.
+     */
+    uint32_t zoneId() const { return mZoneId; }
+
+    /** Return the number of transitions in the transition table. */
+    uint32_t numTransitions() const { return mNumTransitions; }
+
+    /** Return the seconds from the Unix epoch of transition i. */
+    int64_t transitionTime(uint32_t i) const {
+      return readInt64(mTransitionTimes + 8 * i);
+    }
+
+    /** Return the POSIX TZ string in the footer, which may be invalid. */
+    const PosixTimeZone& footer() const { return mFooter; }
+
+    /**
+     * Find the local time type at the given seconds from the Unix epoch,
+     * using a binary search of the transitions, or the footer after the last
+     * transition.
+     */
+    void findForUnixSeconds(int64_t unixSeconds, LocalTimeType& type) const;
+
+  private:
+    // disable copy constructor and assignment operator
+    TzifZoneInfo(const TzifZoneInfo&) = delete;
+    TzifZoneInfo& operator=(const TzifZoneInfo&) = delete;
+
+    /** Size of the header of each data block. */
+    static const uint8_t kHeaderSize = 44;
+
+    /** Size of each ttinfo record. */
+    static const uint8_t kTimeTypeSize = 6;
+
+    static int64_t readInt64(const uint8_t* p) {
+      return (int64_t) (((uint64_t) readUint32(p) << 32) | readUint32(p + 4));
+    }
+
+    static uint32_t readUint32(const uint8_t* p) {
+      return ((uint32_t) p[0] << 24) | ((uint32_t) p[1] << 16)
+          | ((uint32_t) p[2] << 8) | p[3];
+    }
+
+    /**
+     * Validate the buffer and set the pointers to the sections of the 64-bit
+     * data block. Returns the status.
+     */
+    uint8_t parse(const char* name, const uint8_t* data, size_t size);
+
+    /** Return the time type of transition i, or type 0 if i is -1. */
+    uint8_t typeIndexAt(int32_t i) const {
+      return (i < 0) ? 0 : mTypeIndexes[i];
+    }
+
+    /** Return true if the time type is DST. */
+    bool isDst(uint8_t typeIndex) const {
+      return mTimeTypes[kTimeTypeSize * typeIndex + 4] != 0;
+    }
+
+    /**
+     * Fill the local time type in effect after transition i, or before the
+     * first transition if i is -1. The STD offset of a DST type is the UTC
+     * offset of the nearest STD type, preferably an earlier one.
+     */
+    void findForTransition(int32_t i, LocalTimeType& type) const;
+
+  private:
+    const uint8_t* mTransitionTimes = nullptr; // int64 big-endian
+    const uint8_t* mTypeIndexes = nullptr;
+    const uint8_t* mTimeTypes = nullptr; // ttinfo records
+    const char* mAbbrevs = nullptr;
+    uint32_t mNumTransitions = 0;
+    uint32_t mZoneId = 0;
+    PosixTimeZone mFooter;
+    internal::MappedFile mMappedFile; // the file mapped by openFile()
+    char mName[kMaxNameSize] = {0};
+    uint8_t mStatus = kStatusNotLoaded;
+};
+
+}
+
+#endif
@@ -0,0 +1,96 @@
+/*
+ * MIT License
+ * Copyright (c) 2026 Brian T. Park
+ */
+
+#include <stdio.h> // snprintf()
+#include <string.h> // strcmp(), strstr()
+#include <AceCommon.h> // hashDjb2()
+#include "TzifZoneManager.h"
+
+namespace ace_time {
+
+const char TzifZoneManagerBase::kDefaultZoneInfoDir[] = "/usr/share/zoneinfo";
+
+TimeZone TzifZoneManagerBase::createForZoneName(const char* name) {
+  uint16_t index = indexForZoneName(name);
+  if (index != kInvalidIndex) return createForLoadedIndex(index);
+
+#if ACE_TIME_HAS_MMAP
+  if (mNumZones >= mSize || ! isSafeName(name)) return TimeZone::forError();
+  char path[kMaxPathSize];
+  int n = snprintf(path, sizeof(path), "%s/%s", mZoneInfoDir, name);
+  if (n < 0 || n >= (int) sizeof(path)) return TimeZone::forError();
+
+  mStatus = mZoneInfos[mNumZones].openFile(name, path);
+  if (mStatus != TzifZoneInfo::kStatusOk) return TimeZone::forError();
+  return createForLoadedIndex(mNumZones++);
+#else
+  return TimeZone::forError();
+#endif
+}
+
+TimeZone TzifZoneManagerBase::createForTzifData(
+    const char* name, const void* data, size_t size) {
+  uint16_t index = indexForZoneName(name);
+  if (index != kInvalidIndex) return createForLoadedIndex(index);
+  if (mNumZones >= mSize) return TimeZone::forError();
+
+  mStatus = mZoneInfos[mNumZones].initFromBuffer(name, data, size);
+  if (mStatus != TzifZoneInfo::kStatusOk) return TimeZone::forError();
+  return createForLoadedIndex(mNumZones++);
+}
+
+TimeZone TzifZoneManagerBase::createForZoneId(uint32_t id) {
+  uint16_t index = indexForZoneId(id);
+  if (index == kInvalidIndex) return TimeZone::forError();
+  return createForLoadedIndex(index);
+}
+
+TimeZone TzifZoneManagerBase::createForZoneIndex(uint16_t index) {
+  if (index >= mNumZones) return TimeZone::forError();
+  return createForLoadedIndex(index);
+}
+
+TimeZone TzifZoneManagerBase::createForTimeZoneData(const TimeZoneData& d) {
+  switch (d.type) {
+    case TimeZoneData::kTypeError:
+      return TimeZone::forError();
+    case TimeZoneData::kTypeManual:
+      return TimeZone::forTimeOffset(
+          TimeOffset::forMinutes(d.stdOffsetMinutes),
+          TimeOffset::forMinutes(d.dstOffsetMinutes));
+    case TimeZoneData::kTypeZoneId:
+      return createForZoneId(d.zoneId);
+    default:
+      return TimeZone();
+  }
+}
+
+uint16_t TzifZoneManagerBase::indexForZoneName(const char* name) const {
+  uint32_t id = ace_common::hashDjb2(name);
+  for (uint16_t i = 0; i < mNumZones; i++) {
+    if (mZoneInfos[i].zoneId() == id
+        && strcmp(mZoneInfos[i].name(), name) == 0) {
+      return i;
+    }
+  }
+  return kInvalidIndex;
+}
+
+uint16_t TzifZoneManagerBase::indexForZoneId(uint32_t id) const {
+  for (uint16_t i = 0; i < mNumZones; i++) {
+    if (mZoneInfos[i].zoneId() == id) return i;
+  }
+  return kInvalidIndex;
+}
+
+TimeZone TzifZoneManagerBase::createForLoadedIndex(uint16_t index) {
+  return TimeZone::forZoneInfo(&mZoneInfos[index], &mZoneProcessors[index]);
+}
+
+bool TzifZoneManagerBase::isSafeName(const char* name) {
+  return name[0] != '\0' && name[0] != '/' && strstr(name, "..") == nullptr;
+}
+
+}
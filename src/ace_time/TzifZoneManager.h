@@ -0,0 +1,160 @@
+/*
+ * MIT License
+ * Copyright (c) 2026 Brian T. Park
+ */
+
+#ifndef ACE_TIME_TZIF_ZONE_MANAGER_H
+#define ACE_TIME_TZIF_ZONE_MANAGER_H
+
+#include <stdint.h>
+#include <stddef.h> // size_t
+#include "../zoneinfo/compat.h" // ACE_TIME_HAS_MMAP
+#include "TzifZoneInfo.h"
+#include "TzifZoneProcessor.h"
+#include "TimeZoneData.h"
+#include "TimeZone.h"
+#include "ZoneManager.h"
+
+namespace ace_time {
+
+/**
+ * Base class of TzifZoneManager which holds the implementation, independent
+ * of the SIZE template parameter. It provides the same factory methods as the
+ * ZoneManagerTemplate, but the registry is populated at runtime from TZif
+ * files instead of a zonedb database.
+ */
+class TzifZoneManagerBase : public ZoneManager {
+  public:
+    /** The default directory of the TZif files on Linux and MacOS. */
+    static const char kDefaultZoneInfoDir[];
+
+    /** Maximum size of the path of a TZif file, including the NUL. */
+    static const uint16_t kMaxPathSize = 128;
+
+    /**
+     * Create a TimeZone for the given zone name (e.g. "America/Los_Angeles").
+     * If the zone is not yet loaded, its TZif file is mapped from the
+     * zoneInfoDir, if ACE_TIME_HAS_MMAP is enabled. Returns
+     * TimeZone::forError() if the zone cannot be loaded, or if all SIZE
+     * entries are used.
+     */
+    TimeZone createForZoneName(const char* name);
+
+    /** Create a TimeZone for the given 32-bit zoneId of a loaded zone. */
+    TimeZone createForZoneId(uint32_t id);
+
+    /** Create a TimeZone for the given index of a loaded zone. */
+    TimeZone createForZoneIndex(uint16_t index);
+
+    /**
+     * Create a TimeZone from the TimeZoneData created by
+     * TimeZone::toTimeZoneData(). A zoneId is found only if its zone is
+     * loaded.
+     */
+    TimeZone createForTimeZoneData(const TimeZoneData& d);
+
+    /**
+     * Load the zone of the given name from the TZif data in the buffer, which
+     * must outlive this object, and return its TimeZone. This is the only way
+     * to load zones on platforms without mmap(). If the zone is already
+     * loaded, the existing zone is returned.
+     */
+    TimeZone createForTzifData(
+        const char* name, const void* data, size_t size);
+
+    /** Return the index of the loaded zone, or kInvalidIndex. */
+    uint16_t indexForZoneName(const char* name) const;
+
+    /** Return the index of the loaded zone, or kInvalidIndex. */
+    uint16_t indexForZoneId(uint32_t id) const;
+
+    /** Return the number of loaded zones. */
+    uint16_t zoneRegistrySize() const { return mNumZones; }
+
+    /** Return the status of the last attempt to load a zone. */
+    uint8_t status() const { return mStatus; }
+
+  protected:
+    /**
+     * Constructor.
+     *
+     * @param zoneInfos an array of `size` TzifZoneInfo entries
+     * @param zoneProcessors an array of `size` TzifZoneProcessor entries
+     * @param size number of entries in the arrays
+     * @param zoneInfoDir directory of the TZif files
+     */
+    TzifZoneManagerBase(
+        TzifZoneInfo* zoneInfos,
+        TzifZoneProcessor* zoneProcessors,
+        uint16_t size,
+        const char* zoneInfoDir
+    ) :
+        mZoneInfos(zoneInfos),
+        mZoneProcessors(zoneProcessors),
+        mZoneInfoDir(zoneInfoDir),
+        mSize(size)
+    {}
+
+  private:
+    // disable copy constructor and assignment operator
+    TzifZoneManagerBase(const TzifZoneManagerBase&) = delete;
+    TzifZoneManagerBase& operator=(const TzifZoneManagerBase&) = delete;
+
+    /** Return the TimeZone of the loaded zone at index. */
+    TimeZone createForLoadedIndex(uint16_t index);
+
+    /** Return true if the name is a relative path without "..". */
+    static bool isSafeName(const char* name);
+
+  private:
+    TzifZoneInfo* const mZoneInfos;
+    TzifZoneProcessor* const mZoneProcessors;
+    const char* const mZoneInfoDir;
+    uint16_t const mSize;
+    uint16_t mNumZones = 0;
+    uint8_t mStatus = TzifZoneInfo::kStatusNotLoaded;
+};
+
+/**
+ * A ZoneManager which creates TimeZones from TZif files (RFC 8536), such as
+ * the files in /usr/share/zoneinfo maintained by the operating system, so
+ * that updates of the TZ Database are picked up without rebuilding the
+ * program. Up to SIZE zones are loaded on demand by createForZoneName(), and
+ * remain loaded until this object is destroyed. Each zone has its own
+ * TzifZoneProcessor, so no ZoneProcessorCache is needed, and the TimeZones
+ * can be shared by multiple threads.
+ *
+ * @code
+ * TzifZoneManager<4> manager;
+ * TimeZone tz = manager.createForZoneName("America/Los_Angeles");
+ * @endcode
+ *
+ * A TZif file describes a single Zone, with its Links resolved, so
+ * TimeZone::isLink() is always false.
+ *
+ * @tparam SIZE maximum number of zones which can be loaded
+ */
+template <uint16_t SIZE>
+class TzifZoneManager : public TzifZoneManagerBase {
+  public:
+    /**
+     * Constructor.
+     *
+     * @param zoneInfoDir directory of the TZif files, which must outlive
+     *    this object
+     */
+    explicit TzifZoneManager(
+        const char* zoneInfoDir = TzifZoneManagerBase::kDefaultZoneInfoDir
+    ) :
+        TzifZoneManagerBase(mZoneInfoArray, mZoneProcessorArray, SIZE,
+            zoneInfoDir)
+    {}
+
+  private:
+    TzifZoneInfo mZoneInfoArray[SIZE];
+    TzifZoneProcessor mZoneProcessorArray[SIZE];
+};
+
+}
+
+#endif
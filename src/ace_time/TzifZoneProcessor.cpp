@@ -0,0 +1,103 @@
+/*
+ * MIT License
+ * Copyright (c) 2026 Brian T. Park
+ */
+
+#include "Epoch.h"
+#include "LocalDate.h"
+#include "LocalDateTime.h"
+#include "TzifZoneProcessor.h"
+
+namespace ace_time {
+
+void TzifZoneProcessor::resolveLocalSeconds(
+    int64_t localSeconds, LocalResolution& resolution) const {
+  // The UTC offsets are at most 26 hours apart, so the instants 1 day
+  // before and after localSeconds bracket the instant of localSeconds.
+  mZoneInfo->findForUnixSeconds(localSeconds - 86400, resolution.before);
+  mZoneInfo->findForUnixSeconds(localSeconds + 86400, resolution.after);
+
+  LocalTimeType check;
+  mZoneInfo->findForUnixSeconds(
+      localSeconds - resolution.before.utcOffsetSeconds, check);
+  resolution.beforeIsValid =
+      check.utcOffsetSeconds == resolution.before.utcOffsetSeconds;
+  mZoneInfo->findForUnixSeconds(
+      localSeconds - resolution.after.utcOffsetSeconds, check);
+  resolution.afterIsValid =
+      check.utcOffsetSeconds == resolution.after.utcOffsetSeconds;
+}
+
+FindResult TzifZoneProcessor::findByLocalDateTime(
+    const LocalDateTime& ldt) const {
+  FindResult result;
+  if (! mZoneInfo || ! mZoneInfo->isValid()) return result;
+  int64_t localSeconds = ldt.toUnixSeconds64();
+  if (localSeconds == LocalDate::kInvalidUnixSeconds64) return result;
+
+  LocalResolution resolution;
+  resolveLocalSeconds(localSeconds, resolution);
+  bool isTransition = resolution.before.utcOffsetSeconds
+      != resolution.after.utcOffsetSeconds;
+
+  if (isTransition
+      && resolution.beforeIsValid && resolution.afterIsValid) {
+    // Overlap: fold=0 selects the earlier transition.
+    result.type = FindResult::kTypeOverlap;
+    result.fold = ldt.fold();
+    setResult(result,
+        (ldt.fold() == 0) ? resolution.before : resolution.after);
+  } else if (isTransition
+      && ! resolution.beforeIsValid && ! resolution.afterIsValid) {
+    // Gap: the requested offset normalizes into the other transition.
+    result.type = FindResult::kTypeGap;
+    const LocalTimeType& req = (ldt.fold() == 0)
+        ? resolution.before : resolution.after;
+    setResult(result,
+        (ldt.fold() == 0) ? resolution.after : resolution.before);
+    result.reqStdOffsetSeconds = req.stdOffsetSeconds;
+    result.reqDstOffsetSeconds = req.utcOffsetSeconds - req.stdOffsetSeconds;
+  } else {
+    // Use the time type at the instant itself, which can differ from the
+    // bracketing types in its STD offset or abbreviation.
+    result.type = FindResult::kTypeExact;
+    int32_t utcOffsetSeconds = resolution.afterIsValid
+        ? resolution.after.utcOffsetSeconds
+        : resolution.before.utcOffsetSeconds;
+    LocalTimeType type;
+    mZoneInfo->findForUnixSeconds(localSeconds - utcOffsetSeconds, type);
+    setResult(result, type);
+  }
+  return result;
+}
+
+FindResult TzifZoneProcessor::findByEpochSeconds(acetime_t epochSeconds) const {
+  if (epochSeconds == LocalDate::kInvalidEpochSeconds) return FindResult();
+  return findByUnixSeconds64(
+      epochSeconds + Epoch::secondsToCurrentEpochFromUnixEpoch64());
+}
+
+FindResult TzifZoneProcessor::findByUnixSeconds64(int64_t unixSeconds) const {
+  FindResult result;
+  if (! mZoneInfo || ! mZoneInfo->isValid()) return result;
+  if (unixSeconds == LocalDate::kInvalidUnixSeconds64) return result;
+
+  LocalTimeType type;
+  mZoneInfo->findForUnixSeconds(unixSeconds, type);
+  setResult(result, type);
+
+  // Determine if the local time occurs twice, and which one this is.
+  LocalResolution resolution;
+  resolveLocalSeconds(unixSeconds + type.utcOffsetSeconds, resolution);
+  if (resolution.before.utcOffsetSeconds != resolution.after.utcOffsetSeconds
+      && resolution.beforeIsValid && resolution.afterIsValid) {
+    result.type = FindResult::kTypeOverlap;
+    result.fold =
+        (type.utcOffsetSeconds == resolution.before.utcOffsetSeconds) ? 0 : 1;
+  } else {
+    result.type = FindResult::kTypeExact;
+  }
+  return result;
+}
+
+}
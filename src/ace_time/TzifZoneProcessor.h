@@ -0,0 +1,132 @@
+/*
+ * MIT License
+ * Copyright (c) 2026 Brian T. Park
+ */
+
+#ifndef ACE_TIME_TZIF_ZONE_PROCESSOR_H
+#define ACE_TIME_TZIF_ZONE_PROCESSOR_H
+
+#include <stdint.h> // uintptr_t
+#include <AceCommon.h> // printReplaceCharTo()
+#include "../zoneinfo/BrokerCommon.h" // findShortName()
+#include "ZoneProcessor.h"
+#include "TzifZoneInfo.h"
+
+class Print;
+
+namespace ace_time {
+
+/**
+ * A ZoneProcessor which reads a zone from a TzifZoneInfo loaded from a TZif
+ * file (RFC 8536), instead of the zonedb databases compiled into the program.
+ * The TZif file already contains the transitions of the zone, so the lookups
+ * are binary searches over the transitions with no expansion of the zone
+ * rules, and the POSIX TZ string of the footer is evaluated directly for the
+ * years after the last transition.
+ *
+ * The zoneKey is the `const TzifZoneInfo*`. The object holds no other state,
+ * so a single instance bound to its zone (e.g. through
+ * TimeZone::forZoneInfo()) can be shared by multiple threads.
+ *
+ * The TZif format does not record the STD offset of a DST time type, so the
+ * STD offset is taken from the nearest STD time type. This matches the
+ * ExtendedZoneProcessor except for historical zones which changed their STD
+ * offset during DST.
+ */
+class TzifZoneProcessor: public ZoneProcessor {
+  public:
+    /** Unique TimeZone type identifier for TzifZoneProcessor. */
+    static const uint8_t kTypeTzif = 11;
+
+    /** Constructor. */
+    explicit TzifZoneProcessor(const TzifZoneInfo* zoneInfo = nullptr):
+        ZoneProcessor(kTypeTzif),
+        mZoneInfo(zoneInfo)
+    {}
+
+    /** TZif files are generated for Zones, with Links resolved. */
+    bool isLink() const override { return false; }
+
+    uint32_t getZoneId() const override {
+      return mZoneInfo ? mZoneInfo->zoneId() : 0;
+    }
+
+    FindResult findByLocalDateTime(const LocalDateTime& ldt) const override;
+
+    FindResult findByEpochSeconds(acetime_t epochSeconds) const override;
+
+    /**
+     * @copydoc ZoneProcessor::findByUnixSeconds64()
+     *
+     * The TZif transitions are stored as 64-bit Unix seconds, so this is the
+     * native search, and findByEpochSeconds() is implemented using it.
+     */
+    FindResult findByUnixSeconds64(int64_t unixSeconds) const override;
+
+    void printNameTo(Print& printer) const override {
+      if (mZoneInfo) printer.print(mZoneInfo->name());
+    }
+
+    void printShortNameTo(Print& printer) const override {
+      if (mZoneInfo) {
+        ace_common::printReplaceCharTo(
+            printer, zoneinfo::findShortName(mZoneInfo->name()), '_', ' ');
+      }
+    }
+
+    void printTargetNameTo(Print& /*printer*/) const override {}
+
+    void setZoneKey(uintptr_t zoneKey) override {
+      // Avoid writing to a shared object when the zoneKey is unchanged.
+      if (mZoneInfo != (const TzifZoneInfo*) zoneKey) {
+        mZoneInfo = (const TzifZoneInfo*) zoneKey;
+      }
+    }
+
+    bool equalsZoneKey(uintptr_t zoneKey) const override {
+      return mZoneInfo == (const TzifZoneInfo*) zoneKey;
+    }
+
+  private:
+    using LocalTimeType = TzifZoneInfo::LocalTimeType;
+
+    /** The candidates for a local time given in seconds from Unix epoch. */
+    struct LocalResolution {
+      /** Local time type in effect about 1 day before the local time. */
+      LocalTimeType before;
+      /** Local time type in effect about 1 day after the local time. */
+      LocalTimeType after;
+      /** True if the local time occurs using the 'before' UTC offset. */
+      bool beforeIsValid;
+      /** True if the local time occurs using the 'after' UTC offset. */
+      bool afterIsValid;
+    };
+
+    bool equals(const ZoneProcessor& other) const override {
+      return mZoneInfo == ((const TzifZoneProcessor&) other).mZoneInfo;
+    }
+
+    /**
+     * Find the UTC offsets before and after the transition nearest to the
+     * local seconds, and whether the local seconds occurs in each. Assumes
+     * that a zone has at most one transition within a day of any local time.
+     */
+    void resolveLocalSeconds(
+        int64_t localSeconds, LocalResolution& resolution) const;
+
+    /** Copy the local time type into the result. */
+    static void setResult(FindResult& result, const LocalTimeType& type) {
+      result.stdOffsetSeconds = type.stdOffsetSeconds;
+      result.dstOffsetSeconds = type.utcOffsetSeconds - type.stdOffsetSeconds;
+      result.reqStdOffsetSeconds = result.stdOffsetSeconds;
+      result.reqDstOffsetSeconds = result.dstOffsetSeconds;
+      result.abbrev = type.abbrev;
+    }
+
+  private:
+    const TzifZoneInfo* mZoneInfo;
+};
+
+}
+
+#endif
@@ -95,6 +95,7 @@ class ZoneTemplate {
 using BasicZone = ZoneTemplate<basic::Info>;
 using ExtendedZone = ZoneTemplate<extended::Info>;
 using CompleteZone = ZoneTemplate<complete::Info>;
+using MappedZone = ZoneTemplate<mapped::Info>;
 
 }
 
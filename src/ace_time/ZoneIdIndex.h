@@ -0,0 +1,253 @@
+/*
+ * MIT License
+ * Copyright (c) 2026 Brian T. Park
+ */
+
+#ifndef ACE_TIME_ZONE_ID_INDEX_H
+#define ACE_TIME_ZONE_ID_INDEX_H
+
+#include <stdint.h>
+#include "../zoneinfo/infos.h"
+
+namespace ace_time {
+
+/**
+ * A minimal perfect hash index from the zoneId to the position of the ZoneInfo
+ * in a zone registry, which replaces the binary search in
+ * ZoneRegistrarTemplate::findIndexForId() with a single probe.
+ *
+ * The index uses the "hash and displace" scheme. The zoneId is hashed into one
+ * of numBuckets buckets, each bucket stores a 16-bit seed, and the zoneId is
+ * hashed again with that seed into one of numSlots (== registry size) slots.
+ * Each slot stores the zoneId and its registry index, so that an unknown
+ * zoneId can be rejected without reading the ZoneInfo.
+ *
+ * This is the base class which contains the lookup code. The buffers are
+ * provided by ZoneIdIndexTemplate, which also builds the index.
+ */
+class ZoneIdIndexBase {
+  public:
+    /** Invalid index to indicate error or not found. */
+    static const uint16_t kInvalidIndex = 0xffff;
+
+    /** A slot of the hash table. */
+    struct Entry {
+      uint32_t zoneId;
+      uint16_t index;
+    };
+
+    /**
+     * Return true if the index was built successfully. Otherwise,
+     * findIndexForId() always returns kInvalidIndex.
+     */
+    bool isValid() const { return mNumSlots > 0; }
+
+    /** Return the number of slots, which is the size of the registry. */
+    uint16_t numSlots() const { return mNumSlots; }
+
+    /** Return the number of buckets. */
+    uint16_t numBuckets() const { return mNumBuckets; }
+
+    /**
+     * Find the registry index of the zoneId. Return kInvalidIndex if not
+     * found.
+     */
+    uint16_t findIndexForId(uint32_t zoneId) const {
+      if (mNumSlots == 0) return kInvalidIndex;
+      uint16_t seed = mSeeds[reduce(mix(zoneId), mNumBuckets)];
+      if (seed == 0) return kInvalidIndex;
+      const Entry& entry = mEntries[slotForSeed(zoneId, seed)];
+      return (entry.zoneId == zoneId) ? entry.index : kInvalidIndex;
+    }
+
+  protected:
+    /** Set on every seed of a bucket which contains at least one zoneId. */
+    static const uint16_t kSeedPlaced = 0x8000;
+
+    /** Max number of zoneIds in a single bucket. */
+    static const uint8_t kMaxBucketSize = 16;
+
+    ZoneIdIndexBase(Entry* entries, uint16_t* seeds) :
+        mEntries(entries),
+        mSeeds(seeds)
+    {}
+
+    // disable copy constructor and assignment operator
+    ZoneIdIndexBase(const ZoneIdIndexBase&) = delete;
+    ZoneIdIndexBase& operator=(const ZoneIdIndexBase&) = delete;
+
+    /** The finalizer of MurmurHash3, to spread the bits of the zoneId. */
+    static uint32_t mix(uint32_t h) {
+      h ^= h >> 16;
+      h *= 0x85ebca6bu;
+      h ^= h >> 13;
+      h *= 0xc2b2ae35u;
+      h ^= h >> 16;
+      return h;
+    }
+
+    /** Map the hash h into [0, n) without a division. */
+    static uint16_t reduce(uint32_t h, uint16_t n) {
+      return (uint16_t) (((h >> 16) * n) >> 16);
+    }
+
+    /** Return the slot of zoneId using the seed of its bucket. */
+    uint16_t slotForSeed(uint32_t zoneId, uint16_t seed) const {
+      return reduce(mix(zoneId ^ (seed * 0x9e3779b9u)), mNumSlots);
+    }
+
+    /**
+     * Build the index from the zoneIds returned by the getZoneId(i) lambda,
+     * for i in [0, size). The buckets are placed from the largest to the
+     * smallest, by searching for the first seed which maps every zoneId of
+     * the bucket into a free slot. Grouping the zoneIds by bucket uses a
+     * scan over the zoneIds for each bucket instead of a scratch buffer,
+     * which is O(N^2) but runs only once. Returns false if the zoneIds
+     * cannot be placed (e.g. duplicate zoneIds), leaving the index invalid.
+     */
+    template <typename F>
+    bool build(uint16_t size, uint16_t numBuckets, F&& getZoneId) {
+      mNumSlots = 0;
+      mNumBuckets = numBuckets;
+      if (size == 0 || numBuckets == 0) return false;
+
+      // Count the number of zoneIds in each bucket, using the seeds.
+      for (uint16_t b = 0; b < numBuckets; b++) mSeeds[b] = 0;
+      for (uint16_t i = 0; i < size; i++) {
+        mEntries[i].zoneId = 0;
+        mEntries[i].index = kInvalidIndex;
+      }
+      uint16_t maxBucketSize = 0;
+      for (uint16_t i = 0; i < size; i++) {
+        uint16_t b = reduce(mix(getZoneId(i)), numBuckets);
+        mSeeds[b]++;
+        if (mSeeds[b] > maxBucketSize) maxBucketSize = mSeeds[b];
+      }
+      if (maxBucketSize > kMaxBucketSize) return false;
+
+      // mNumSlots must be set for slotForSeed().
+      mNumSlots = size;
+      uint32_t zoneIds[kMaxBucketSize];
+      uint16_t indexes[kMaxBucketSize];
+      uint16_t slots[kMaxBucketSize];
+      for (uint16_t bucketSize = maxBucketSize; bucketSize > 0; bucketSize--) {
+        for (uint16_t b = 0; b < numBuckets; b++) {
+          if (mSeeds[b] != bucketSize) continue;
+
+          // Collect the zoneIds of bucket b.
+          uint8_t n = 0;
+          for (uint16_t i = 0; i < size && n < bucketSize; i++) {
+            uint32_t zoneId = getZoneId(i);
+            if (reduce(mix(zoneId), numBuckets) == b) {
+              zoneIds[n] = zoneId;
+              indexes[n] = i;
+              n++;
+            }
+          }
+
+          uint16_t seed = findSeed(zoneIds, n, slots);
+          if (seed == 0) {
+            mNumSlots = 0;
+            return false;
+          }
+          for (uint8_t k = 0; k < n; k++) {
+            mEntries[slots[k]].zoneId = zoneIds[k];
+            mEntries[slots[k]].index = indexes[k];
+          }
+          mSeeds[b] = seed;
+        }
+      }
+      return true;
+    }
+
+  private:
+    /**
+     * Return the first seed which maps the n zoneIds into distinct free slots,
+     * saved into `slots`. Return 0 if none is found.
+     */
+    uint16_t findSeed(const uint32_t* zoneIds, uint8_t n, uint16_t* slots)
+        const {
+      for (uint32_t seed = kSeedPlaced | 1; seed <= 0xffff; seed++) {
+        bool ok = true;
+        for (uint8_t k = 0; k < n && ok; k++) {
+          uint16_t slot = slotForSeed(zoneIds[k], (uint16_t) seed);
+          if (mEntries[slot].index != kInvalidIndex) ok = false;
+          for (uint8_t j = 0; j < k && ok; j++) {
+            if (slots[j] == slot) ok = false;
+          }
+          slots[k] = slot;
+        }
+        if (ok) return (uint16_t) seed;
+      }
+      return 0;
+    }
+
+  private:
+    Entry* const mEntries;
+    uint16_t* const mSeeds;
+    uint16_t mNumSlots = 0;
+    uint16_t mNumBuckets = 0;
+};
+
+/**
+ * A ZoneIdIndexBase which contains the buffers for a zone registry of up to
+ * SIZE entries, and builds the index in the constructor. It can then be passed
+ * to the ZoneRegistrarTemplate (or ZoneManagerTemplate) of the same registry.
+ * It uses about 8 bytes per registry entry, so it is intended for machines
+ * with plenty of RAM, not for 8-bit processors.
+ *
+ * If the registry is larger than SIZE, or the index cannot be built, isValid()
+ * returns false and the ZoneRegistrar falls back to its binary search.
+ *
+ * @tparam D container type of ZoneInfo database (e.g. basic::Info,
+ * extended::Info, complete::Info)
+ * @tparam SIZE max number of entries in the zone registry
+ */
+template <typename D, uint16_t SIZE>
+class ZoneIdIndexTemplate : public ZoneIdIndexBase {
+  public:
+    /**
+     * Constructor.
+     *
+     * @param zoneRegistrySize number of ZoneInfo entries in zoneRegistry
+     * @param zoneRegistry an array of ZoneInfo entries
+     */
+    ZoneIdIndexTemplate(
+        uint16_t zoneRegistrySize,
+        const typename D::ZoneInfo* const* zoneRegistry
+    ) :
+        ZoneIdIndexBase(mEntries, mSeeds)
+    {
+      if (zoneRegistrySize > SIZE) return;
+
+      const typename D::ZoneRegistryBroker registry(zoneRegistry);
+      build(zoneRegistrySize, (zoneRegistrySize + 1) / 2,
+          [&registry](uint16_t i) -> uint32_t {
+            return typename D::ZoneInfoBroker(registry.zoneInfo(i)).zoneId();
+          }
+      );
+    }
+
+  private:
+    Entry mEntries[SIZE];
+    uint16_t mSeeds[(SIZE + 1) / 2];
+};
+
+namespace basic {
+template <uint16_t SIZE>
+using ZoneIdIndex = ZoneIdIndexTemplate<basic::Info, SIZE>;
+}
+
+namespace extended {
+template <uint16_t SIZE>
+using ZoneIdIndex = ZoneIdIndexTemplate<extended::Info, SIZE>;
+}
+
+namespace complete {
+template <uint16_t SIZE>
+using ZoneIdIndex = ZoneIdIndexTemplate<complete::Info, SIZE>;
+}
+
+} // ace_time
+
+#endif
@@ -85,13 +85,17 @@ class ZoneManagerTemplate : public ZoneManager {
      *
      * @param zoneRegistrySize number of ZoneInfo entries in zoneRegistry
      * @param zoneRegistry an array of ZoneInfo entries
+     * @param zoneProcessorCache cache of ZoneProcessors
+     * @param zoneIdIndex optional perfect hash index of the zoneRegistry
+     *    (see ZoneIdIndexTemplate)
      */
     ZoneManagerTemplate(
         uint16_t zoneRegistrySize,
         const typename D::ZoneInfo* const* zoneRegistry,
-        ZoneProcessorCacheBaseTemplate<ZP>& zoneProcessorCache
+        ZoneProcessorCacheBaseTemplate<ZP>& zoneProcessorCache,
+        const ZoneIdIndexBase* zoneIdIndex = nullptr
     ):
-        mZoneRegistrar(zoneRegistrySize, zoneRegistry),
+        mZoneRegistrar(zoneRegistrySize, zoneRegistry, zoneIdIndex),
         mZoneProcessorCache(zoneProcessorCache)
     {}
 
@@ -197,11 +201,87 @@ class ZoneManagerTemplate : public ZoneManager {
       return Z(zoneInfo);
     }
 
+    /**
+     * Bind a ZoneProcessor of the ZoneProcessorCache to each of the `numNames`
+     * zone names, and calculate their transitions for each year in
+     * [startYear, untilYear) using up to `numThreads` threads (all cores if
+     * 0). Intended to be called at the startup of the application, before
+     * any TimeZone is created by this ZoneManager, so that the first
+     * createForZoneName() of each zone is fast. The warm up is rejected if
+     * the ZoneProcessorCache is already in use, and the zones which do not
+     * fit into the cache are skipped. See
+     * ZoneProcessorCacheBaseTemplate::warmUpZoneProcessors().
+     */
+    ZoneWarmUpResult warmUpZoneNames(
+        const char* const* names,
+        uint16_t numNames,
+        int16_t startYear,
+        int16_t untilYear,
+        uint8_t numThreads = 0) {
+      uint32_t startMicros = micros();
+      uint16_t numNotFound = 0;
+      uint16_t numSkipped = 0;
+      for (uint16_t i = 0; i < numNames; i++) {
+        if (mZoneProcessorCache.isInUse()) break;
+        const typename D::ZoneInfo* zoneInfo =
+            mZoneRegistrar.getZoneInfoForName(names[i]);
+        if (! zoneInfo) {
+          numNotFound++;
+        } else if (! mZoneProcessorCache.bindForWarmUp(
+            (uintptr_t) zoneInfo)) {
+          numSkipped++;
+        }
+      }
+      return finishWarmUp(startMicros, numNotFound, numSkipped,
+          startYear, untilYear, numThreads);
+    }
+
+    /** Same as warmUpZoneNames() for an array of `numIds` zoneIds. */
+    ZoneWarmUpResult warmUpZoneIds(
+        const uint32_t* ids,
+        uint16_t numIds,
+        int16_t startYear,
+        int16_t untilYear,
+        uint8_t numThreads = 0) {
+      uint32_t startMicros = micros();
+      uint16_t numNotFound = 0;
+      uint16_t numSkipped = 0;
+      for (uint16_t i = 0; i < numIds; i++) {
+        if (mZoneProcessorCache.isInUse()) break;
+        const typename D::ZoneInfo* zoneInfo =
+            mZoneRegistrar.getZoneInfoForId(ids[i]);
+        if (! zoneInfo) {
+          numNotFound++;
+        } else if (! mZoneProcessorCache.bindForWarmUp(
+            (uintptr_t) zoneInfo)) {
+          numSkipped++;
+        }
+      }
+      return finishWarmUp(startMicros, numNotFound, numSkipped,
+          startYear, untilYear, numThreads);
+    }
+
   private:
     // disable copy constructor and assignment operator
     ZoneManagerTemplate(const ZoneManagerTemplate&) = delete;
     ZoneManagerTemplate& operator=(const ZoneManagerTemplate&) = delete;
 
+    /** Calculate the transitions of the bound ZoneProcessors. */
+    ZoneWarmUpResult finishWarmUp(
+        uint32_t startMicros,
+        uint16_t numNotFound,
+        uint16_t numSkipped,
+        int16_t startYear,
+        int16_t untilYear,
+        uint8_t numThreads) {
+      ZoneWarmUpResult result = mZoneProcessorCache.warmUpZoneProcessors(
+          startYear, untilYear, numThreads);
+      result.numNotFound = numNotFound;
+      result.numSkipped = numSkipped;
+      result.elapsedMicros = micros() - startMicros;
+      return result;
+    }
+
   private:
     const ZoneRegistrarTemplate<D> mZoneRegistrar;
     ZoneProcessorCacheBaseTemplate<ZP>& mZoneProcessorCache;
@@ -228,6 +308,13 @@ using ExtendedZoneManager = ZoneManagerTemplate<
 using CompleteZoneManager = ZoneManagerTemplate<
     complete::Info, CompleteZoneProcessor, CompleteZone>;
 
+/**
+ * An implementation of the ZoneManager which uses the registry of
+ * mapped::Info::ZoneInfo records of a MappedZoneDatabase.
+ */
+using MappedZoneManager = ZoneManagerTemplate<
+    mapped::Info, MappedZoneProcessor, MappedZone>;
+
 }
 
 #endif
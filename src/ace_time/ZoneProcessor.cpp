@@ -10,6 +10,43 @@
 
 namespace ace_time {
 
+uint8_t ZoneProcessor::findTransitionsForYear(
+    int16_t year,
+    int64_t afterUnixSeconds,
+    ZoneTransition* transitions,
+    uint8_t size) const {
+  if (year < Epoch::epochValidYearLower()
+      || year >= Epoch::epochValidYearUpper()) {
+    return 0;
+  }
+  acetime_t startSeconds = Epoch::yearStartEpochSeconds(year);
+  acetime_t untilSeconds = Epoch::yearStartEpochSeconds(year + 1);
+  if (startSeconds == LocalDate::kInvalidEpochSeconds
+      || untilSeconds == LocalDate::kInvalidEpochSeconds) {
+    return 0;
+  }
+
+  // Search from the later of afterUnixSeconds and the start of the year.
+  int64_t unixOffset = Epoch::secondsToCurrentEpochFromUnixEpoch64();
+  acetime_t epochSeconds = startSeconds - 1;
+  if (afterUnixSeconds != LocalDate::kInvalidUnixSeconds64
+      && afterUnixSeconds > epochSeconds + unixOffset) {
+    if (afterUnixSeconds >= untilSeconds + unixOffset) return 0;
+    epochSeconds = (acetime_t) (afterUnixSeconds - unixOffset);
+  }
+
+  uint8_t numTransitions = 0;
+  while (numTransitions < size) {
+    ZoneTransition transition = findNextTransition(epochSeconds);
+    if (transition.isError() || transition.epochSeconds >= untilSeconds) {
+      break;
+    }
+    epochSeconds = transition.epochSeconds;
+    transitions[numTransitions++] = transition;
+  }
+  return numTransitions;
+}
+
 MonthDay calcStartDayOfMonth(int16_t year, uint8_t month,
     uint8_t onDayOfWeek, int8_t onDayOfMonth) {
   if (onDayOfWeek == 0) return {month, (uint8_t) onDayOfMonth};
@@ -6,6 +6,7 @@
 #ifndef ACE_TIME_ZONE_PROCESSOR_H
 #define ACE_TIME_ZONE_PROCESSOR_H
 
+#include <stddef.h> // size_t
 #include "common/common.h" // kAbbrevSize
 #include "OffsetDateTime.h"
 
@@ -14,6 +15,7 @@ class Print;
 namespace ace_time {
 
 class LocalDateTime;
+class ZoneTransitionRange;
 
 /**
  * Result of a search for transition at a specific epochSeconds or a specific
@@ -115,6 +117,55 @@ class FindResult {
     const char* abbrev = "";
 };
 
+/**
+ * A change of the UTC offset or abbreviation of a time zone, returned by
+ * ZoneProcessor::findNextTransition() and findPrevTransition(). The
+ * abbreviations are copied into this object, so unlike FindResult::abbrev,
+ * they remain valid after other timezone calculations are performed.
+ */
+class ZoneTransition {
+  public:
+    /** Return true if no transition was found. */
+    bool isError() const {
+      return unixSeconds == LocalDate::kInvalidUnixSeconds64;
+    }
+
+    /**
+     * Instant of the transition as the number of seconds from the Unix epoch,
+     * valid for all years. The 'after' offsets apply at and after this
+     * instant, the 'before' offsets apply before it. Set to
+     * LocalDate::kInvalidUnixSeconds64 if no transition was found.
+     */
+    int64_t unixSeconds = LocalDate::kInvalidUnixSeconds64;
+
+    /**
+     * Instant of the transition relative to the current epoch. Set to
+     * LocalDate::kInvalidEpochSeconds if no transition was found, or if the
+     * transition cannot be represented by the 32-bit epochSeconds (which can
+     * happen only for the transitions returned by
+     * ZoneProcessor::transitions()).
+     */
+    acetime_t epochSeconds = LocalDate::kInvalidEpochSeconds;
+
+    /** STD offset before the transition. */
+    int32_t stdOffsetSecondsBefore = 0;
+
+    /** DST offset before the transition. */
+    int32_t dstOffsetSecondsBefore = 0;
+
+    /** STD offset at and after the transition. */
+    int32_t stdOffsetSecondsAfter = 0;
+
+    /** DST offset at and after the transition. */
+    int32_t dstOffsetSecondsAfter = 0;
+
+    /** Abbreviation before the transition. */
+    char abbrevBefore[kAbbrevSize] = "";
+
+    /** Abbreviation at and after the transition. */
+    char abbrevAfter[kAbbrevSize] = "";
+};
+
 /**
  * Base interface for ZoneProcessor classes. There were 2 options for
  * implmenting the various concrete implementations of ZoneProcessors:
@@ -156,6 +207,113 @@ class ZoneProcessor {
     virtual FindResult findByEpochSeconds(
         acetime_t epochSeconds) const = 0;
 
+    /**
+     * Return the search results at the given 64-bit number of seconds from
+     * the Unix epoch (1970-01-01 00:00:00 UTC). Subclasses which can calculate
+     * their transitions in 64-bits override this to support any year in the
+     * range [1, 9999], independent of the Epoch::currentEpochYear(). The
+     * default implementation converts unixSeconds to the 32-bit epochSeconds
+     * and calls findByEpochSeconds(), returning kTypeNotFound if unixSeconds
+     * cannot be represented as epochSeconds.
+     */
+    virtual FindResult findByUnixSeconds64(int64_t unixSeconds) const {
+      if (unixSeconds == LocalDate::kInvalidUnixSeconds64) {
+        return FindResult();
+      }
+      int64_t epochSeconds64 = unixSeconds
+          - Epoch::secondsToCurrentEpochFromUnixEpoch64();
+      if (epochSeconds64 < LocalDate::kMinEpochSeconds
+          || epochSeconds64 > LocalDate::kMaxEpochSeconds) {
+        return FindResult();
+      }
+      return findByEpochSeconds((acetime_t) epochSeconds64);
+    }
+
+    /**
+     * Return the search results for each of the `num` elements of the
+     * `epochSeconds` array into the `results` array, which must be at least
+     * `num` elements long. This is equivalent to calling findByEpochSeconds()
+     * on each element, but subclasses can override this to reuse the
+     * transitions across consecutive elements. It is fastest when the
+     * epochSeconds are sorted, or at least grouped by year.
+     */
+    virtual void findByEpochSecondsBatch(
+        const acetime_t* epochSeconds,
+        FindResult* results,
+        size_t num) const {
+      for (size_t i = 0; i < num; i++) {
+        results[i] = findByEpochSeconds(epochSeconds[i]);
+      }
+    }
+
+    /**
+     * Return the earliest transition strictly after the given epochSeconds,
+     * at which the STD offset, DST offset, or abbreviation changes. The
+     * search crosses year boundaries as needed, but is limited to the years
+     * supported by the current epoch (see Epoch::epochValidYearLower() and
+     * Epoch::epochValidYearUpper()). The default implementation returns an
+     * error, for subclasses which do not support this search.
+     */
+    virtual ZoneTransition findNextTransition(
+        acetime_t /*epochSeconds*/) const {
+      return ZoneTransition();
+    }
+
+    /**
+     * Return the latest transition at or before the given epochSeconds, in
+     * other words, the transition which defines the UTC offset at
+     * epochSeconds. See findNextTransition().
+     */
+    virtual ZoneTransition findPrevTransition(
+        acetime_t /*epochSeconds*/) const {
+      return ZoneTransition();
+    }
+
+    /**
+     * Copy the transitions which occur in the given UTC year, strictly after
+     * afterUnixSeconds, into `transitions` in increasing order. Returns the
+     * number of transitions copied, at most `size`. If `size` transitions are
+     * returned, the year may contain more, which are found by calling again
+     * with the unixSeconds of the last one. Used by ZoneTransitionIterator.
+     *
+     * The default implementation calls findNextTransition(), so it supports
+     * only the years of the current epoch, and returns 0 for processors which
+     * do not support findNextTransition().
+     */
+    virtual uint8_t findTransitionsForYear(
+        int16_t year,
+        int64_t afterUnixSeconds,
+        ZoneTransition* transitions,
+        uint8_t size) const;
+
+    /**
+     * Return the transitions in the years [startYear, untilYear) in
+     * increasing order, for use in a range-based for loop:
+     *
+     * @code
+     * for (const ZoneTransition& t : zoneProcessor.transitions(1900, 2100)) {
+     *   ...
+     * }
+     * @endcode
+     *
+     * The transitions of each year are calculated once, by
+     * findTransitionsForYear(), and returned from a small buffer in the
+     * iterator before moving to the next year. This is not a single forward
+     * sweep: each year which can contain a change costs a full rebuild of its
+     * transitions, like initForYear(), and replaces the year cached by the
+     * ZoneProcessor. The years which cannot contain a change cost nothing.
+     * For example, [1900, 2100) of America/Los_Angeles takes about 100
+     * microseconds with the ExtendedZoneProcessor on a desktop computer.
+     *
+     * The ExtendedZoneProcessor and CompleteZoneProcessor support all years,
+     * using ZoneTransition::unixSeconds for the years outside of the current
+     * epoch. Other processors return only the transitions within
+     * Epoch::epochValidYearLower() and Epoch::epochValidYearUpper(). The
+     * range is empty for processors which do not support findNextTransition().
+     */
+    ZoneTransitionRange transitions(int16_t startYear, int16_t untilYear)
+        const;
+
     /**
      * Print a human-readable identifier (e.g. "America/Los_Angeles").
      *
@@ -230,6 +388,41 @@ class ZoneProcessor {
       return year == mYear && mEpochYear == Epoch::currentEpochYear();
     }
 
+    /**
+     * Check if the Transition cache is filled for the year containing the
+     * given epochSeconds, using the bounds saved by setYearBounds(). This
+     * avoids converting the epochSeconds into a year when the cache is hit.
+     */
+    bool isFilledForEpochSeconds(acetime_t epochSeconds) const {
+      return epochSeconds >= mYearStartSeconds
+          && epochSeconds < mYearUntilSeconds
+          && mEpochYear == Epoch::currentEpochYear();
+    }
+
+    /**
+     * Save the epochSeconds bounds of mYear for isFilledForEpochSeconds(),
+     * shifted by shiftSeconds (at most one day) for subclasses whose cached
+     * year does not start on Jan 1. The bounds are empty if mYear cannot be
+     * represented in the current epoch.
+     */
+    void setYearBounds(int32_t shiftSeconds = 0) const {
+      acetime_t startSeconds = Epoch::yearStartEpochSeconds(mYear);
+      acetime_t untilSeconds = Epoch::yearStartEpochSeconds(mYear + 1);
+      if (startSeconds == LocalDate::kInvalidEpochSeconds
+          || untilSeconds == LocalDate::kInvalidEpochSeconds) {
+        clearYearBounds();
+        return;
+      }
+      mYearStartSeconds = startSeconds + shiftSeconds;
+      mYearUntilSeconds = untilSeconds + shiftSeconds;
+    }
+
+    /** Clear the bounds saved by setYearBounds(). */
+    void clearYearBounds() const {
+      mYearStartSeconds = 0;
+      mYearUntilSeconds = 0;
+    }
+
     /** Return true if equal. */
     virtual bool equals(const ZoneProcessor& other) const = 0;
 
@@ -253,6 +446,13 @@ class ZoneProcessor {
      * cache. Set to LocalDate::kInvalidYear to indicate invalid cache.
      */
     mutable int16_t mEpochYear = LocalDate::kInvalidYear;
+
+    /**
+     * The [start, until) epochSeconds of mYear, empty if the two are equal.
+     * Set by setYearBounds().
+     */
+    mutable acetime_t mYearStartSeconds = 0;
+    mutable acetime_t mYearUntilSeconds = 0;
 };
 
 inline bool operator==(const ZoneProcessor& a, const ZoneProcessor& b) {
@@ -264,6 +464,128 @@ inline bool operator!=(const ZoneProcessor& a, const ZoneProcessor& b) {
   return ! (a == b);
 }
 
+/**
+ * Forward iterator over the transitions of a ZoneProcessor, returned by
+ * ZoneTransitionRange. The transitions of the current year are held in a
+ * buffer of kBufferSize elements, and the next year is requested only after
+ * the buffer is exhausted. The end iterator holds no transitions.
+ */
+class ZoneTransitionIterator {
+  public:
+    /**
+     * Number of transitions fetched by one call to
+     * ZoneProcessor::findTransitionsForYear(). Most years have at most 2
+     * transitions.
+     */
+    static const uint8_t kBufferSize = 4;
+
+    /** Create the end iterator. */
+    ZoneTransitionIterator() {}
+
+    /**
+     * Create an iterator pointing to the first transition in the years
+     * [startYear, untilYear).
+     */
+    ZoneTransitionIterator(
+        const ZoneProcessor* zoneProcessor,
+        int16_t startYear,
+        int16_t untilYear
+    ) :
+        mZoneProcessor(zoneProcessor),
+        mYear(startYear - 1),
+        mUntilYear(untilYear)
+    {
+      fill(LocalDate::kInvalidUnixSeconds64);
+    }
+
+    const ZoneTransition& operator*() const { return mTransitions[mIndex]; }
+
+    const ZoneTransition* operator->() const { return &mTransitions[mIndex]; }
+
+    ZoneTransitionIterator& operator++() {
+      mIndex++;
+      if (mIndex >= mNumTransitions) {
+        fill(mTransitions[mNumTransitions - 1].unixSeconds);
+      }
+      return *this;
+    }
+
+    bool operator==(const ZoneTransitionIterator& other) const {
+      return unixSeconds() == other.unixSeconds();
+    }
+
+    bool operator!=(const ZoneTransitionIterator& other) const {
+      return ! (*this == other);
+    }
+
+  private:
+    /** Return the unixSeconds of the current transition, or invalid at end. */
+    int64_t unixSeconds() const {
+      return (mIndex < mNumTransitions)
+          ? mTransitions[mIndex].unixSeconds
+          : LocalDate::kInvalidUnixSeconds64;
+    }
+
+    /**
+     * Fill the buffer with the transitions after afterUnixSeconds. The
+     * current year is asked again only if the previous call filled the
+     * buffer, otherwise the search moves on to the following years.
+     */
+    void fill(int64_t afterUnixSeconds) {
+      if (mNumTransitions < kBufferSize) mYear++;
+      mIndex = 0;
+      mNumTransitions = 0;
+      for (; mYear < mUntilYear; mYear++) {
+        mNumTransitions = mZoneProcessor->findTransitionsForYear(
+            mYear, afterUnixSeconds, mTransitions, kBufferSize);
+        if (mNumTransitions > 0) return;
+      }
+    }
+
+    const ZoneProcessor* mZoneProcessor = nullptr;
+    int16_t mYear = 0;
+    int16_t mUntilYear = 0;
+    uint8_t mIndex = 0;
+    uint8_t mNumTransitions = 0;
+    ZoneTransition mTransitions[kBufferSize];
+};
+
+/**
+ * The transitions of a ZoneProcessor over a range of years, returned by
+ * ZoneProcessor::transitions(). The ZoneProcessor must not be used for other
+ * zones while the range is iterated.
+ */
+class ZoneTransitionRange {
+  public:
+    ZoneTransitionRange(
+        const ZoneProcessor* zoneProcessor,
+        int16_t startYear,
+        int16_t untilYear
+    ) :
+        mZoneProcessor(zoneProcessor),
+        mStartYear(startYear),
+        mUntilYear(untilYear)
+    {}
+
+    ZoneTransitionIterator begin() const {
+      return ZoneTransitionIterator(mZoneProcessor, mStartYear, mUntilYear);
+    }
+
+    ZoneTransitionIterator end() const {
+      return ZoneTransitionIterator();
+    }
+
+  private:
+    const ZoneProcessor* mZoneProcessor;
+    int16_t mStartYear;
+    int16_t mUntilYear;
+};
+
+inline ZoneTransitionRange ZoneProcessor::transitions(
+    int16_t startYear, int16_t untilYear) const {
+  return ZoneTransitionRange(this, startYear, untilYear);
+}
+
 /** The result of calcStartDayOfMonth(). */
 struct MonthDay {
   uint8_t month;
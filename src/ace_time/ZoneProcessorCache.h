@@ -6,14 +6,86 @@
 #ifndef ACE_TIME_ZONE_PROCESSOR_CACHE_H
 #define ACE_TIME_ZONE_PROCESSOR_CACHE_H
 
+#include "../zoneinfo/compat.h" // ACE_TIME_HAS_THREADS
 #include "common/common.h"
+#include "LocalDateTime.h"
 #include "OffsetDateTime.h"
 #include "BasicZoneProcessor.h"
 #include "ExtendedZoneProcessor.h"
 #include "CompleteZoneProcessor.h"
+#include "MappedZoneProcessor.h"
+#include "ZoneStats.h" // micros()
+
+#if ACE_TIME_HAS_THREADS
+  #include <atomic>
+  #include <thread>
+#endif
 
 namespace ace_time {
 
+/**
+ * The result of ZoneProcessorCacheBaseTemplate::warmUp() and
+ * warmUpZoneProcessors(), and of the warmUpZoneNames() and warmUpZoneIds()
+ * methods of the ZoneManagerTemplate.
+ */
+struct ZoneWarmUpResult {
+  /**
+   * Set if nothing was done because the cache had already returned a
+   * ZoneProcessor through getZoneProcessor() or pinZoneProcessor(). See
+   * ZoneProcessorCacheBaseTemplate::warmUpZoneProcessors().
+   */
+  bool rejected;
+
+  /** Number of ZoneProcessors whose transitions were calculated. */
+  uint16_t numZones;
+
+  /** Number of zone names or zoneIds which were not found in the registry. */
+  uint16_t numNotFound;
+
+  /**
+   * Number of zones which were not bound, because every ZoneProcessor of the
+   * cache was already bound to another zone of the list.
+   */
+  uint16_t numSkipped;
+
+  /** Number of threads which calculated the transitions. */
+  uint8_t numThreads;
+
+  /** Duration of the warm up, measured using micros(). */
+  uint32_t elapsedMicros;
+};
+
+namespace internal {
+
+/**
+ * Bookkeeping for each ZoneProcessor in a hash-indexed cache. The zoneKey is
+ * stored here so that the hash index can be rebuilt around an evicted
+ * ZoneProcessor without asking the ZoneProcessor for its key.
+ */
+struct ZoneProcessorCacheEntry {
+  /** Set if the ZoneProcessor has been bound to zoneKey. */
+  static const uint8_t kFlagBound = 0x1;
+
+  /** Set on each access, cleared by the CLOCK eviction hand. */
+  static const uint8_t kFlagReferenced = 0x2;
+
+  /** Set if the ZoneProcessor must not be evicted. */
+  static const uint8_t kFlagPinned = 0x4;
+
+  uintptr_t zoneKey;
+  uint8_t flags;
+};
+
+/**
+ * Return the smallest power of 2 which is >= n. Used to size the open
+ * addressing hash table at compile time.
+ */
+constexpr uint16_t nextPowerOf2(uint16_t n, uint16_t p = 1) {
+  return (p >= n) ? p : nextPowerOf2(n, p * 2);
+}
+
+}
+
 /**
  * The template class of BasicZoneProcessorCacheBase or
  * ExtendedZoneProcessorCacheBase. The common implementation
@@ -21,20 +93,53 @@ namespace ace_time {
  * creates the caches inside the class itself, which will normally be created at
  * static initialization time. An alternative implementation would create the
  * cache on the heap.
+ *
+ * If the subclass provides the optional entries and hash slots (see
+ * HashedZoneProcessorCacheTemplate), the ZoneProcessor for a zoneKey is found
+ * using an open addressing hash table with linear probing, and the
+ * ZoneProcessor to reuse is selected using the CLOCK (second chance)
+ * algorithm which skips pinned ZoneProcessors. Otherwise, the cache uses a
+ * linear search and round-robin eviction, which is smaller and faster for a
+ * handful of ZoneProcessors.
  */
 template <typename ZP>
 class ZoneProcessorCacheBaseTemplate {
   public:
-    ZoneProcessorCacheBaseTemplate(ZP* zoneProcessors, uint8_t size) :
+    ZoneProcessorCacheBaseTemplate(ZP* zoneProcessors, uint16_t size) :
       mSize(size),
       mZoneProcessors(zoneProcessors)
     {}
 
+    /**
+     * Constructor for a hash-indexed cache. The `entries` and `hashSlots` are
+     * usually members of the subclass which are not constructed yet, so the
+     * subclass must call initHashIndex() in the body of its constructor.
+     *
+     * @param zoneProcessors array of `size` ZoneProcessors
+     * @param size number of ZoneProcessors
+     * @param entries array of `size` bookkeeping entries
+     * @param hashSlots array of `numHashSlots` hash slots
+     * @param numHashSlots number of hash slots, must be a power of 2 and
+     *    larger than `size`
+     */
+    ZoneProcessorCacheBaseTemplate(
+        ZP* zoneProcessors,
+        uint16_t size,
+        internal::ZoneProcessorCacheEntry* entries,
+        uint16_t* hashSlots,
+        uint16_t numHashSlots) :
+      mSize(size),
+      mZoneProcessors(zoneProcessors),
+      mEntries(entries),
+      mHashSlots(hashSlots),
+      mHashMask(numHashSlots - 1)
+    {}
+
     /** Return the size of the cache. */
-    uint8_t size() const { return mSize; }
+    uint16_t size() const { return mSize; }
 
     /** Get the ZoneProcessor at index i. */
-    ZP* getZoneProcessorAtIndex(uint8_t i) { return &mZoneProcessors[i]; }
+    ZP* getZoneProcessorAtIndex(uint16_t i) { return &mZoneProcessors[i]; }
 
     /**
      * Get ZoneProcessor from either a ZoneKey, basic::Info::ZoneInfo, an
@@ -45,23 +150,296 @@ class ZoneProcessorCacheBaseTemplate {
      *    uint16_t index into a database table of ZoneInfo records)
      */
     ZP* getZoneProcessor(uintptr_t zoneKey) {
+      mInUse = true;
+      return bindZoneProcessor(zoneKey);
+    }
+
+    /**
+     * Same as getZoneProcessor(), but also pin the ZoneProcessor so that it
+     * will not be evicted until unpinZoneProcessor() is called. Pinning is
+     * supported only by a hash-indexed cache; otherwise this is the same as
+     * getZoneProcessor(). If every ZoneProcessor is pinned, the cache must
+     * still return a ZoneProcessor for a new zoneKey, so a pinned
+     * ZoneProcessor will be reused.
+     */
+    ZP* pinZoneProcessor(uintptr_t zoneKey) {
+      if (! mHashSlots) return getZoneProcessor(zoneKey);
+
+      mInUse = true;
+      uint16_t index = getIndexUsingHash(zoneKey);
+      mEntries[index].flags |= internal::ZoneProcessorCacheEntry::kFlagPinned;
+      return &mZoneProcessors[index];
+    }
+
+    /** Allow the ZoneProcessor of the given zoneKey to be evicted again. */
+    void unpinZoneProcessor(uintptr_t zoneKey) {
+      if (! mHashSlots) return;
+
+      uint16_t slot = findSlotUsingHash(zoneKey);
+      if (mHashSlots[slot] == kEmptySlot) return;
+      mEntries[mHashSlots[slot] - 1].flags &=
+          ~internal::ZoneProcessorCacheEntry::kFlagPinned;
+    }
+
+    /**
+     * Unbind every ZoneProcessor, including the pinned ones, so that the next
+     * lookup of any zoneKey recalculates its transitions. This is needed when
+     * a zoneKey may refer to different data than before, for example when a
+     * zone database is replaced at the same address. A TimeZone which still
+     * refers to one of the ZoneProcessors rebinds it on its next use.
+     */
+    void clear() {
+      for (uint16_t i = 0; i < mSize; i++) {
+        mZoneProcessors[i].setZoneKey(0);
+      }
+      initHashIndex();
+      mCurrentIndex = 0;
+    }
+
+    /**
+     * Return true if the cache has returned a ZoneProcessor through
+     * getZoneProcessor() or pinZoneProcessor(). The warm up is rejected after
+     * that point.
+     */
+    bool isInUse() const { return mInUse; }
+
+    /**
+     * Bind a ZoneProcessor to zoneKey for a following warmUpZoneProcessors(),
+     * without marking the cache as in use. Used by warmUp(), and by the
+     * warmUpZoneNames() and warmUpZoneIds() methods of the
+     * ZoneManagerTemplate. A zone which is already bound is never evicted, so
+     * this returns false if every ZoneProcessor is bound to another zone, or
+     * if the cache is in use.
+     */
+    bool bindForWarmUp(uintptr_t zoneKey) {
+      if (mInUse) return false;
+      if (! isBound(zoneKey) && numBound() >= mSize) return false;
+      bindZoneProcessor(zoneKey);
+      return true;
+    }
+
+    /**
+     * Bind a ZoneProcessor to each of the `numKeys` zoneKeys, then call
+     * warmUpZoneProcessors() to calculate their transitions for each year in
+     * [startYear, untilYear). Intended to be called at the startup of the
+     * application, so that the first lookup of each zone does not pay for
+     * setZoneKey() and the calculation of its transitions. If there are more
+     * distinct zoneKeys than ZoneProcessors, only the first size() zones are
+     * bound, and the others are counted in ZoneWarmUpResult::numSkipped.
+     */
+    ZoneWarmUpResult warmUp(
+        const uintptr_t* zoneKeys,
+        uint16_t numKeys,
+        int16_t startYear,
+        int16_t untilYear,
+        uint8_t numThreads = 0) {
+      uint32_t startMicros = micros();
+      uint16_t numSkipped = 0;
+      if (! mInUse) {
+        for (uint16_t i = 0; i < numKeys; i++) {
+          if (! bindForWarmUp(zoneKeys[i])) numSkipped++;
+        }
+      }
+      ZoneWarmUpResult result = warmUpZoneProcessors(
+          startYear, untilYear, numThreads);
+      result.numSkipped = numSkipped;
+      result.elapsedMicros = micros() - startMicros;
+      return result;
+    }
+
+    /**
+     * Calculate the transitions of every ZoneProcessor which is bound to a
+     * zone, for each year in [startYear, untilYear). If ACE_TIME_HAS_THREADS
+     * is enabled, the ZoneProcessors are spread across `numThreads` threads,
+     * or across all cores if numThreads is 0.
+     *
+     * The worker threads modify the ZoneProcessors, so the warm up must
+     * happen before any of them is handed out to a TimeZone. It is rejected
+     * (ZoneWarmUpResult::rejected) once getZoneProcessor() or
+     * pinZoneProcessor() has been called. The cache itself must not be used
+     * by other threads until this method returns.
+     *
+     * A ZoneProcessor keeps only the transitions of its last
+     * getNumYearSlots() years (usually 1), so untilYear is clamped to
+     * startYear + getNumYearSlots().
+     */
+    ZoneWarmUpResult warmUpZoneProcessors(
+        int16_t startYear,
+        int16_t untilYear,
+        uint8_t numThreads = 0) {
+      uint32_t startMicros = micros();
+      ZoneWarmUpResult result;
+      result.rejected = mInUse;
+      result.numZones = 0;
+      result.numNotFound = 0;
+      result.numSkipped = 0;
+      result.numThreads = 0;
+      if (mInUse || mSize == 0) {
+        result.elapsedMicros = micros() - startMicros;
+        return result;
+      }
+
+      uint8_t numYearSlots = mZoneProcessors[0].getNumYearSlots();
+      if (untilYear - startYear > numYearSlots) {
+        untilYear = startYear + numYearSlots;
+      }
+      WarmUpContext context;
+      context.startYear = startYear;
+      context.untilYear = untilYear;
+      context.epochYear = Epoch::currentEpochYear();
+
+      for (uint16_t i = 0; i < mSize; i++) {
+        if (! mZoneProcessors[i].equalsZoneKey(0)) result.numZones++;
+      }
+
+      // Every ZoneProcessor is picked up by the next available thread,
+      // because the cost of the transitions varies between zones.
+      uint8_t numWorkers = 1;
+    #if ACE_TIME_HAS_THREADS
+      if (numThreads == 0) {
+        unsigned cores = std::thread::hardware_concurrency();
+        numThreads = (cores == 0)
+            ? 1 : (cores > UINT8_MAX ? UINT8_MAX : cores);
+      }
+      numWorkers = (numThreads > result.numZones)
+          ? result.numZones : numThreads;
+      if (numWorkers == 0) numWorkers = 1;
+
+      std::thread* threads = new std::thread[numWorkers - 1];
+      for (uint8_t w = 1; w < numWorkers; w++) {
+        threads[w - 1] = std::thread(
+            &ZoneProcessorCacheBaseTemplate::runWarmUpWorker, this, &context);
+      }
+      runWarmUpWorker(&context);
+      for (uint8_t w = 1; w < numWorkers; w++) {
+        threads[w - 1].join();
+      }
+      delete[] threads;
+    #else
+      (void) numThreads;
+      runWarmUpWorker(&context);
+    #endif
+
+      result.numThreads = numWorkers;
+      result.elapsedMicros = micros() - startMicros;
+      return result;
+    }
+
+  #if ACE_TIME_ZONE_STATS
+    /**
+     * Return the lookup statistics of the cache, which can be read without a
+     * lock. Available only if ACE_TIME_ZONE_STATS is enabled. The statistics
+     * of each ZoneProcessor are available through
+     * getZoneProcessorAtIndex(i)->getStats().
+     */
+    const ZoneProcessorCacheStats& getStats() const { return mStats; }
+
+    /** Reset the lookup statistics to 0. */
+    void resetStats() { mStats.reset(); }
+  #endif
+
+  private:
+    // disable copy constructor and assignment operator
+    ZoneProcessorCacheBaseTemplate(const ZoneProcessorCacheBaseTemplate&)
+        = delete;
+    ZoneProcessorCacheBaseTemplate& operator=(
+        const ZoneProcessorCacheBaseTemplate&) = delete;
+
+    /** Value of a hash slot which does not refer to a ZoneProcessor. */
+    static const uint16_t kEmptySlot = 0;
+
+    /** The parameters of warmUpZoneProcessors() shared by the threads. */
+    struct WarmUpContext {
+      int16_t startYear;
+      int16_t untilYear;
+      int16_t epochYear;
+    #if ACE_TIME_HAS_THREADS
+      std::atomic<uint16_t> nextIndex{0};
+    #else
+      uint16_t nextIndex = 0;
+    #endif
+    };
+
+    /**
+     * Calculate the transitions of the ZoneProcessors handed out by the
+     * WarmUpContext until none are left. Runs on each thread of
+     * warmUpZoneProcessors(). A lookup of a local date time in the middle of
+     * each year calculates the transitions of that year for every type of
+     * ZoneProcessor.
+     */
+    void runWarmUpWorker(WarmUpContext* context) {
+      // The epoch year may be thread-local (ACE_TIME_EPOCH_THREAD_LOCAL).
+      if (Epoch::currentEpochYear() != context->epochYear) {
+        Epoch::currentEpochYear(context->epochYear);
+      }
+
+      while (true) {
+      #if ACE_TIME_HAS_THREADS
+        uint16_t i = context->nextIndex.fetch_add(
+            1, std::memory_order_relaxed);
+      #else
+        uint16_t i = context->nextIndex++;
+      #endif
+        if (i >= mSize) break;
+
+        const ZP& zoneProcessor = mZoneProcessors[i];
+        if (zoneProcessor.equalsZoneKey(0)) continue;
+        for (int16_t year = context->startYear; year < context->untilYear;
+            year++) {
+          zoneProcessor.findByLocalDateTime(
+              LocalDateTime::forComponents(year, 7, 1, 0, 0, 0));
+        }
+      }
+    }
+
+    /**
+     * Return the ZoneProcessor bound to zoneKey, binding one if necessary,
+     * without marking the cache as in use.
+     */
+    ZP* bindZoneProcessor(uintptr_t zoneKey) {
+      if (mHashSlots) {
+        return &mZoneProcessors[getIndexUsingHash(zoneKey)];
+      }
+
       ZP* zoneProcessor = findUsingZoneKey(zoneKey);
-      if (zoneProcessor) return zoneProcessor;
+      if (zoneProcessor) {
+      #if ACE_TIME_ZONE_STATS
+        mStats.hits.increment();
+      #endif
+        return zoneProcessor;
+      }
 
       // Allocate the next ZoneProcessor in the cache using round-robin.
       zoneProcessor = &mZoneProcessors[mCurrentIndex];
       mCurrentIndex++;
       if (mCurrentIndex >= mSize) mCurrentIndex = 0;
+    #if ACE_TIME_ZONE_STATS
+      mStats.misses.increment();
+      if (! zoneProcessor->equalsZoneKey(0)) mStats.evictions.increment();
+    #endif
       zoneProcessor->setZoneKey(zoneKey);
       return zoneProcessor;
     }
 
-  private:
-    // disable copy constructor and assignment operator
-    ZoneProcessorCacheBaseTemplate(const ZoneProcessorCacheBaseTemplate&)
-        = delete;
-    ZoneProcessorCacheBaseTemplate& operator=(
-        const ZoneProcessorCacheBaseTemplate&) = delete;
+    /** Return true if a ZoneProcessor is bound to zoneKey. */
+    bool isBound(uintptr_t zoneKey) const {
+      if (mHashSlots) {
+        return mHashSlots[findSlotUsingHash(zoneKey)] != kEmptySlot;
+      }
+      for (uint16_t i = 0; i < mSize; i++) {
+        if (mZoneProcessors[i].equalsZoneKey(zoneKey)) return true;
+      }
+      return false;
+    }
+
+    /** Return the number of ZoneProcessors which are bound to a zone. */
+    uint16_t numBound() const {
+      uint16_t num = 0;
+      for (uint16_t i = 0; i < mSize; i++) {
+        if (! mZoneProcessors[i].equalsZoneKey(0)) num++;
+      }
+      return num;
+    }
 
     /**
      * Find an existing ZoneProcessor with the ZoneInfo given by zoneInfoKey.
@@ -72,7 +450,7 @@ class ZoneProcessorCacheBaseTemplate {
      *    uint16_t index into a database table of ZoneInfo records)
      */
     ZP* findUsingZoneKey(uintptr_t zoneKey) {
-      for (uint8_t i = 0; i < mSize; i++) {
+      for (uint16_t i = 0; i < mSize; i++) {
         ZP* zoneProcessor = &mZoneProcessors[i];
         if (zoneProcessor->equalsZoneKey(zoneKey)) {
           return zoneProcessor;
@@ -81,10 +459,152 @@ class ZoneProcessorCacheBaseTemplate {
       return nullptr;
     }
 
+    /** Return the home slot of zoneKey in the hash table. */
+    uint16_t hashZoneKey(uintptr_t zoneKey) const {
+      // Fold the upper half of a 64-bit pointer, then scramble with the
+      // Fibonacci multiplier because pointers have zero low bits.
+      uint32_t h = (uint32_t) zoneKey
+          ^ (uint32_t) ((zoneKey >> 16) >> 16);
+      h *= 0x9E3779B1u;
+      h ^= h >> 16;
+      return (uint16_t) h & mHashMask;
+    }
+
+    /**
+     * Return the hash slot which holds zoneKey, or the empty slot where it
+     * would be inserted.
+     */
+    uint16_t findSlotUsingHash(uintptr_t zoneKey) const {
+      using internal::ZoneProcessorCacheEntry;
+      uint16_t slot = hashZoneKey(zoneKey);
+      while (true) {
+        uint16_t value = mHashSlots[slot];
+        if (value == kEmptySlot) return slot;
+        if (mEntries[value - 1].zoneKey == zoneKey) return slot;
+        slot = (slot + 1) & mHashMask;
+      }
+    }
+
+    /**
+     * Return the index of the ZoneProcessor bound to zoneKey, evicting and
+     * rebinding another ZoneProcessor if necessary.
+     */
+    uint16_t getIndexUsingHash(uintptr_t zoneKey) {
+      using internal::ZoneProcessorCacheEntry;
+      uint16_t slot = findSlotUsingHash(zoneKey);
+      if (mHashSlots[slot] != kEmptySlot) {
+        uint16_t index = mHashSlots[slot] - 1;
+        mEntries[index].flags |= ZoneProcessorCacheEntry::kFlagReferenced;
+      #if ACE_TIME_ZONE_STATS
+        mStats.hits.increment();
+      #endif
+        return index;
+      }
+
+    #if ACE_TIME_ZONE_STATS
+      mStats.misses.increment();
+    #endif
+      uint16_t index = findIndexToEvict();
+      ZoneProcessorCacheEntry& entry = mEntries[index];
+      if (entry.flags & ZoneProcessorCacheEntry::kFlagBound) {
+      #if ACE_TIME_ZONE_STATS
+        mStats.evictions.increment();
+      #endif
+        removeFromHash(entry.zoneKey);
+        // Removal can shift the empty slot reserved for zoneKey.
+        slot = findSlotUsingHash(zoneKey);
+      }
+      entry.zoneKey = zoneKey;
+      entry.flags = ZoneProcessorCacheEntry::kFlagBound
+          | ZoneProcessorCacheEntry::kFlagReferenced;
+      mHashSlots[slot] = index + 1;
+      mZoneProcessors[index].setZoneKey(zoneKey);
+      return index;
+    }
+
+    /**
+     * Select the ZoneProcessor to reuse using the CLOCK algorithm. The
+     * mCurrentIndex is the clock hand. Unbound and unreferenced
+     * ZoneProcessors are taken immediately, referenced ones get a second
+     * chance, and pinned ones are skipped. After 2 full sweeps, every
+     * ZoneProcessor must be pinned, so the one under the hand is taken.
+     */
+    uint16_t findIndexToEvict() {
+      using internal::ZoneProcessorCacheEntry;
+      for (uint32_t n = 0; n < 2 * (uint32_t) mSize; n++) {
+        uint16_t index = advanceClockHand();
+        uint8_t& flags = mEntries[index].flags;
+        if (flags & ZoneProcessorCacheEntry::kFlagPinned) continue;
+        if (flags & ZoneProcessorCacheEntry::kFlagReferenced) {
+          flags &= ~ZoneProcessorCacheEntry::kFlagReferenced;
+          continue;
+        }
+        return index;
+      }
+      return advanceClockHand();
+    }
+
+    /** Return the current clock hand, and move it to the next index. */
+    uint16_t advanceClockHand() {
+      uint16_t index = mCurrentIndex;
+      mCurrentIndex++;
+      if (mCurrentIndex >= mSize) mCurrentIndex = 0;
+      return index;
+    }
+
+    /**
+     * Remove zoneKey from the hash table using backward shift deletion, which
+     * keeps the linear probe sequences intact without tombstones.
+     */
+    void removeFromHash(uintptr_t zoneKey) {
+      uint16_t hole = findSlotUsingHash(zoneKey);
+      mHashSlots[hole] = kEmptySlot;
+      uint16_t slot = hole;
+      while (true) {
+        slot = (slot + 1) & mHashMask;
+        uint16_t value = mHashSlots[slot];
+        if (value == kEmptySlot) return;
+
+        // Move the entry into the hole, unless its home slot lies cyclically
+        // within (hole, slot], in which case it must stay where it is.
+        uint16_t home = hashZoneKey(mEntries[value - 1].zoneKey);
+        bool stays = (hole <= slot)
+            ? (hole < home && home <= slot)
+            : (hole < home || home <= slot);
+        if (stays) continue;
+        mHashSlots[hole] = value;
+        mHashSlots[slot] = kEmptySlot;
+        hole = slot;
+      }
+    }
+
+  protected:
+    /** Empty the hash index, if any. */
+    void initHashIndex() {
+      if (! mHashSlots) return;
+      for (uint16_t i = 0; i < mSize; i++) {
+        mEntries[i].zoneKey = 0;
+        mEntries[i].flags = 0;
+      }
+      for (uint32_t i = 0; i <= mHashMask; i++) {
+        mHashSlots[i] = kEmptySlot;
+      }
+    }
+
   private:
-    uint8_t const mSize;
-    uint8_t mCurrentIndex = 0;
+    uint16_t const mSize;
+    uint16_t mCurrentIndex = 0;
     ZP* const mZoneProcessors;
+    bool mInUse = false; // set by getZoneProcessor() and pinZoneProcessor()
+
+    // Optional hash index, nullptr for the small linear caches.
+    internal::ZoneProcessorCacheEntry* const mEntries = nullptr;
+    uint16_t* const mHashSlots = nullptr;
+    uint16_t const mHashMask = 0;
+
+  #if ACE_TIME_ZONE_STATS
+    ZoneProcessorCacheStats mStats;
+  #endif
 };
 
 /**
@@ -188,6 +708,66 @@ class CompleteZoneProcessorCache: public CompleteZoneProcessorCacheBase {
     CompleteZoneProcessor mZoneProcessors[SIZE];
 };
 
+/**
+ * A hash-indexed ZoneProcessorCache for apps which keep many zones active at
+ * the same time, e.g. a server. Finding the ZoneProcessor of a zoneKey takes
+ * O(1) time instead of O(SIZE), eviction uses the CLOCK algorithm instead of
+ * round-robin, and frequently used zones can be pinned using
+ * pinZoneProcessor(). It can be passed to the ZoneManager in place of the
+ * smaller caches.
+ *
+ * @tparam ZP type of ZoneProcessor
+ * @tparam SIZE number of zone processors
+ */
+template <typename ZP, uint16_t SIZE>
+class HashedZoneProcessorCacheTemplate:
+    public ZoneProcessorCacheBaseTemplate<ZP> {
+  public:
+    HashedZoneProcessorCacheTemplate() :
+      ZoneProcessorCacheBaseTemplate<ZP>(
+          mZoneProcessors, SIZE, mEntries, mHashSlots, kNumHashSlots)
+    {
+      this->initHashIndex();
+    }
+
+  private:
+    static_assert(SIZE <= 0x4000, "SIZE must be <= 16384");
+
+    // disable copy constructor and assignment operator
+    HashedZoneProcessorCacheTemplate(const HashedZoneProcessorCacheTemplate&)
+        = delete;
+    HashedZoneProcessorCacheTemplate& operator=(
+        const HashedZoneProcessorCacheTemplate&) = delete;
+
+    /** Keep the load factor of the hash table <= 0.5. */
+    static const uint16_t kNumHashSlots = internal::nextPowerOf2(2 * SIZE);
+
+  private:
+    ZP mZoneProcessors[SIZE];
+    internal::ZoneProcessorCacheEntry mEntries[SIZE];
+    uint16_t mHashSlots[kNumHashSlots];
+};
+
+/** Hash-indexed cache of BasicZoneProcessor. */
+template <uint16_t SIZE>
+using BasicZoneProcessorHashedCache =
+    HashedZoneProcessorCacheTemplate<BasicZoneProcessor, SIZE>;
+
+/** Hash-indexed cache of ExtendedZoneProcessor. */
+template <uint16_t SIZE>
+using ExtendedZoneProcessorHashedCache =
+    HashedZoneProcessorCacheTemplate<ExtendedZoneProcessor, SIZE>;
+
+/** Hash-indexed cache of CompleteZoneProcessor. */
+template <uint16_t SIZE>
+using CompleteZoneProcessorHashedCache =
+    HashedZoneProcessorCacheTemplate<CompleteZoneProcessor, SIZE>;
+
+/** Hash-indexed cache of MappedZoneProcessor. */
+template <uint16_t SIZE>
+using MappedZoneProcessorHashedCache =
+    HashedZoneProcessorCacheTemplate<MappedZoneProcessor, SIZE>;
+
 }
 
 #endif
@@ -9,6 +9,8 @@
 #include <stdint.h>
 #include <AceCommon.h> // KString, binarySearchByKey(), isSortedByKey()
 #include "../zoneinfo/infos.h"
+#include "ZoneIdIndex.h"
+#include "ZoneStats.h"
 
 // AutoBenchmark.ino
 void runBasicRegistrarFindIndexForName();
@@ -48,14 +50,23 @@ class ZoneRegistrarTemplate {
     /** Invalid index to indicate error or not found. */
     static const uint16_t kInvalidIndex = 0xffff;
 
-    /** Constructor. */
+    /**
+     * Constructor.
+     *
+     * @param zoneRegistrySize number of ZoneInfo entries in zoneRegistry
+     * @param zoneRegistry an array of ZoneInfo entries
+     * @param zoneIdIndex optional perfect hash index of the same zoneRegistry,
+     *    used by findIndexForId() and findIndexForName() if it is valid
+     */
     ZoneRegistrarTemplate(
         uint16_t zoneRegistrySize,
-        const typename D::ZoneInfo* const* zoneRegistry
+        const typename D::ZoneInfo* const* zoneRegistry,
+        const ZoneIdIndexBase* zoneIdIndex = nullptr
     ):
         mZoneRegistrySize(zoneRegistrySize),
         mIsSorted(isSorted(zoneRegistry, zoneRegistrySize)),
-        mZoneRegistry(zoneRegistry)
+        mZoneRegistry(zoneRegistry),
+        mZoneIdIndex(zoneIdIndex)
     {}
 
     /** Return the number of zones and (fat) links. */
@@ -99,18 +110,37 @@ class ZoneRegistrarTemplate {
         zoneInfoBroker.zoneContext().fragments(),
         zoneInfoBroker.zoneContext().numFragments()
       );
-      return (kname.compareTo(name) == 0) ? index : kInvalidIndex;
+      if (kname.compareTo(name) == 0) return index;
+    #if ACE_TIME_ZONE_STATS
+      mStats.nameMismatches.increment();
+      mStats.notFound.increment();
+    #endif
+      return kInvalidIndex;
     }
 
     /** Find the index for zone id. Return kInvalidIndex if not found. */
     uint16_t findIndexForId(uint32_t zoneId) const {
-      if (mIsSorted && mZoneRegistrySize >= kBinarySearchThreshold) {
-        return binarySearchById(mZoneRegistry, mZoneRegistrySize, zoneId);
-      } else {
-        return linearSearchById(mZoneRegistry, mZoneRegistrySize, zoneId);
-      }
+    #if ACE_TIME_ZONE_STATS
+      mStats.lookups.increment();
+      uint16_t index = findIndexForIdUncounted(zoneId);
+      if (index == kInvalidIndex) mStats.notFound.increment();
+      return index;
+    #else
+      return findIndexForIdUncounted(zoneId);
+    #endif
     }
 
+  #if ACE_TIME_ZONE_STATS
+    /**
+     * Return the lookup statistics, which can be read without a lock.
+     * Available only if ACE_TIME_ZONE_STATS is enabled.
+     */
+    const ZoneRegistrarStats& getStats() const { return mStats; }
+
+    /** Reset the lookup statistics to 0. */
+    void resetStats() { mStats.reset(); }
+  #endif
+
   protected:
     friend void ::runBasicRegistrarFindIndexForName();
     friend void ::runBasicRegistrarFindIndexForIdBinary();
@@ -203,6 +233,18 @@ class ZoneRegistrarTemplate {
       );
     }
 
+    /** Find the index for zone id, without updating the statistics. */
+    uint16_t findIndexForIdUncounted(uint32_t zoneId) const {
+      if (mZoneIdIndex && mZoneIdIndex->isValid()) {
+        return mZoneIdIndex->findIndexForId(zoneId);
+      }
+      if (mIsSorted && mZoneRegistrySize >= kBinarySearchThreshold) {
+        return binarySearchById(mZoneRegistry, mZoneRegistrySize, zoneId);
+      } else {
+        return linearSearchById(mZoneRegistry, mZoneRegistrySize, zoneId);
+      }
+    }
+
     /** Exposed only for benchmarking purposes. */
     uint16_t findIndexForIdLinear(uint32_t zoneId) const {
       return linearSearchById(mZoneRegistry, mZoneRegistrySize, zoneId);
@@ -218,6 +260,11 @@ class ZoneRegistrarTemplate {
     uint16_t const mZoneRegistrySize;
     bool const mIsSorted;
     const typename D::ZoneInfo* const* const mZoneRegistry; // not nullable
+    const ZoneIdIndexBase* const mZoneIdIndex; // nullable
+
+  #if ACE_TIME_ZONE_STATS
+    mutable ZoneRegistrarStats mStats;
+  #endif
 };
 
 namespace basic {
@@ -232,6 +279,10 @@ namespace complete {
 using ZoneRegistrar = ZoneRegistrarTemplate<complete::Info>;
 }
 
+namespace mapped {
+using ZoneRegistrar = ZoneRegistrarTemplate<mapped::Info>;
+}
+
 } // ace_time
 
 #endif // ACE_TIME_ZONE_REGISTRAR_H
@@ -0,0 +1,341 @@
+/*
+ * MIT License
+ * Copyright (c) 2026 Brian T. Park
+ */
+
+#ifndef ACE_TIME_ZONE_STATS_H
+#define ACE_TIME_ZONE_STATS_H
+
+#include <stdint.h>
+#include <Arduino.h> // micros()
+#include "../zoneinfo/compat.h" // ACE_TIME_HAS_ATOMIC
+
+/**
+ * Set to 1 to collect the hot path statistics of the zone processors, the
+ * ZoneProcessorCache, and the ZoneRegistrar, available through their
+ * getStats() methods. Disabled by default, so that the counters cost nothing
+ * in flash, RAM, or CPU time unless they are requested. The macro must be
+ * defined before including <AceTime.h>, with the same value in every
+ * translation unit of the program.
+ */
+#ifndef ACE_TIME_ZONE_STATS
+  #define ACE_TIME_ZONE_STATS 0
+#endif
+
+#if ACE_TIME_HAS_ATOMIC
+  #include <atomic>
+#endif
+
+namespace ace_time {
+
+/**
+ * A 32-bit event counter which can be read by another thread without a lock,
+ * for example by a metrics exporter. If `std::atomic` is available
+ * (ACE_TIME_HAS_ATOMIC), each update is a relaxed atomic operation, so the
+ * counter never loses increments or returns a torn value, but it does not
+ * order the other memory operations of the writer. Otherwise, the counter is
+ * a volatile integer which is safe to read only on processors which load 32
+ * bits in a single instruction. The counter wraps around after 2^32 events.
+ */
+class StatsCounter {
+  public:
+    StatsCounter() = default;
+
+    /**
+     * Copy the current value of the other counter. Allows the instrumented
+     * classes (e.g. ZoneRegistrarTemplate) to remain copyable.
+     */
+    StatsCounter(const StatsCounter& other) :
+      mValue(other.value())
+    {}
+
+    StatsCounter& operator=(const StatsCounter& other) {
+      set(other.value());
+      return *this;
+    }
+
+    /** Return the current value. */
+    uint32_t value() const {
+    #if ACE_TIME_HAS_ATOMIC
+      return mValue.load(std::memory_order_relaxed);
+    #else
+      return mValue;
+    #endif
+    }
+
+    /** Increment the counter by 1. */
+    void increment() { add(1); }
+
+    /** Increment the counter by n. */
+    void add(uint32_t n) {
+    #if ACE_TIME_HAS_ATOMIC
+      mValue.fetch_add(n, std::memory_order_relaxed);
+    #else
+      mValue += n;
+    #endif
+    }
+
+    /**
+     * Set the counter to n if n is larger than the current value. Used for
+     * high water marks.
+     */
+    void recordMax(uint32_t n) {
+    #if ACE_TIME_HAS_ATOMIC
+      uint32_t current = mValue.load(std::memory_order_relaxed);
+      while (n > current && ! mValue.compare_exchange_weak(
+          current, n, std::memory_order_relaxed)) {}
+    #else
+      if (n > mValue) mValue = n;
+    #endif
+    }
+
+    /** Set the counter to 0. */
+    void reset() { set(0); }
+
+  private:
+    void set(uint32_t n) {
+    #if ACE_TIME_HAS_ATOMIC
+      mValue.store(n, std::memory_order_relaxed);
+    #else
+      mValue = n;
+    #endif
+    }
+
+  #if ACE_TIME_HAS_ATOMIC
+    std::atomic<uint32_t> mValue{0};
+  #else
+    volatile uint32_t mValue = 0;
+  #endif
+};
+
+/**
+ * A histogram of durations in microseconds, using buckets whose bounds are
+ * powers of 2. Bucket 0 counts the durations shorter than 1 micro, bucket i
+ * counts the durations in [2^(i-1), 2^i) micros, and the last bucket counts
+ * everything longer. The durations are measured with micros(), so their
+ * resolution is the resolution of micros() on the given board (e.g. 4 micros
+ * on a 16 MHz AVR).
+ */
+class StatsHistogram {
+  public:
+    /** Number of buckets, which covers durations up to about 16 millis. */
+    static const uint8_t kNumBuckets = 16;
+
+    /** A copy of the buckets of a StatsHistogram. */
+    struct Snapshot {
+      uint32_t buckets[kNumBuckets];
+    };
+
+    /**
+     * Return the exclusive upper bound of the durations in bucket i, in
+     * micros. The last bucket has no upper bound, so UINT32_MAX is returned.
+     */
+    static uint32_t bucketUpperMicros(uint8_t i) {
+      return (i + 1 >= kNumBuckets) ? UINT32_MAX : ((uint32_t) 1 << i);
+    }
+
+    /** Return the index of the bucket which counts the given duration. */
+    static uint8_t bucketIndex(uint32_t micros) {
+      uint8_t i = 0;
+      while (micros && i + 1 < kNumBuckets) {
+        micros >>= 1;
+        i++;
+      }
+      return i;
+    }
+
+    /** Count a duration. */
+    void record(uint32_t micros) {
+      mBuckets[bucketIndex(micros)].increment();
+    }
+
+    /** Return the number of durations counted by bucket i. */
+    uint32_t bucket(uint8_t i) const { return mBuckets[i].value(); }
+
+    /** Return the number of durations counted by all buckets. */
+    uint32_t count() const {
+      uint32_t count = 0;
+      for (uint8_t i = 0; i < kNumBuckets; i++) count += bucket(i);
+      return count;
+    }
+
+    /** Copy the buckets into the given snapshot. */
+    void snapshot(Snapshot& snapshot) const {
+      for (uint8_t i = 0; i < kNumBuckets; i++) {
+        snapshot.buckets[i] = bucket(i);
+      }
+    }
+
+    /** Set every bucket to 0. */
+    void reset() {
+      for (uint8_t i = 0; i < kNumBuckets; i++) mBuckets[i].reset();
+    }
+
+  private:
+    StatsCounter mBuckets[kNumBuckets];
+};
+
+/**
+ * Statistics of a BasicZoneProcessor or an ExtendedZoneProcessor (and its
+ * subclasses), collected if ACE_TIME_ZONE_STATS is enabled. Unlike the
+ * transition alloc size of the ExtendedZoneProcessor, the statistics are not
+ * cleared when the ZoneProcessor is bound to a different zone, so they
+ * describe the whole lifetime of the ZoneProcessor (or the time since the
+ * last reset()).
+ *
+ * Each counter can be read without a lock while the ZoneProcessor is used by
+ * another thread. A Snapshot copies the counters one by one, so it is not an
+ * atomic picture of all of them: a rebuild which happens during snapshot()
+ * may be counted by some fields and not by others.
+ */
+struct ZoneProcessorStats {
+  /** A copy of the counters, as plain integers. */
+  struct Snapshot {
+    uint32_t yearCacheHits;
+    uint32_t validIntervalHits;
+    uint32_t rebuilds;
+    uint32_t evictions;
+    uint32_t transitionsGenerated;
+    uint32_t transitionsHighWater;
+    StatsHistogram::Snapshot rebuildMicros;
+  };
+
+  /** Number of lookups which found the transitions of the year cached. */
+  StatsCounter yearCacheHits;
+
+  /**
+   * Number of findByEpochSeconds() calls which fell inside the interval of
+   * the transition matched by the previous call, and returned without a
+   * search. Counted only by the ExtendedZoneProcessor.
+   */
+  StatsCounter validIntervalHits;
+
+  /**
+   * Number of lookups which recalculated the transitions of a year (i.e.
+   * year cache misses).
+   */
+  StatsCounter rebuilds;
+
+  /** Number of rebuilds which replaced the transitions of another year. */
+  StatsCounter evictions;
+
+  /** Total number of transitions generated by the rebuilds. */
+  StatsCounter transitionsGenerated;
+
+  /**
+   * Largest number of transitions used by a single rebuild. For the
+   * ExtendedZoneProcessor, this is the largest TransitionStorage allocation
+   * size, including the candidate transitions which were discarded.
+   */
+  StatsCounter transitionsHighWater;
+
+  /** Histogram of the durations of the rebuilds. */
+  StatsHistogram rebuildMicros;
+
+  /** Copy the counters into the given snapshot. */
+  void snapshot(Snapshot& snapshot) const {
+    snapshot.yearCacheHits = yearCacheHits.value();
+    snapshot.validIntervalHits = validIntervalHits.value();
+    snapshot.rebuilds = rebuilds.value();
+    snapshot.evictions = evictions.value();
+    snapshot.transitionsGenerated = transitionsGenerated.value();
+    snapshot.transitionsHighWater = transitionsHighWater.value();
+    rebuildMicros.snapshot(snapshot.rebuildMicros);
+  }
+
+  /** Set every counter to 0. */
+  void reset() {
+    yearCacheHits.reset();
+    validIntervalHits.reset();
+    rebuilds.reset();
+    evictions.reset();
+    transitionsGenerated.reset();
+    transitionsHighWater.reset();
+    rebuildMicros.reset();
+  }
+};
+
+/**
+ * Statistics of a ZoneProcessorCache, collected if ACE_TIME_ZONE_STATS is
+ * enabled. See ZoneProcessorStats for the consistency of a Snapshot.
+ */
+struct ZoneProcessorCacheStats {
+  /** A copy of the counters, as plain integers. */
+  struct Snapshot {
+    uint32_t hits;
+    uint32_t misses;
+    uint32_t evictions;
+  };
+
+  /** Number of lookups which found a ZoneProcessor bound to the zoneKey. */
+  StatsCounter hits;
+
+  /** Number of lookups which had to bind a ZoneProcessor to the zoneKey. */
+  StatsCounter misses;
+
+  /**
+   * Number of misses which rebound a ZoneProcessor that was bound to another
+   * zoneKey.
+   */
+  StatsCounter evictions;
+
+  /** Copy the counters into the given snapshot. */
+  void snapshot(Snapshot& snapshot) const {
+    snapshot.hits = hits.value();
+    snapshot.misses = misses.value();
+    snapshot.evictions = evictions.value();
+  }
+
+  /** Set every counter to 0. */
+  void reset() {
+    hits.reset();
+    misses.reset();
+    evictions.reset();
+  }
+};
+
+/**
+ * Statistics of a ZoneRegistrar, collected if ACE_TIME_ZONE_STATS is enabled.
+ * See ZoneProcessorStats for the consistency of a Snapshot.
+ */
+struct ZoneRegistrarStats {
+  /** A copy of the counters, as plain integers. */
+  struct Snapshot {
+    uint32_t lookups;
+    uint32_t notFound;
+    uint32_t nameMismatches;
+  };
+
+  /**
+   * Number of lookups by zoneId, including the lookups by name which search
+   * for the zoneId of the name.
+   */
+  StatsCounter lookups;
+
+  /** Number of lookups by zoneId or name which did not find the zone. */
+  StatsCounter notFound;
+
+  /**
+   * Number of lookups by name which found the zoneId of the name, but a
+   * different name, because of a hash collision with an unknown name.
+   */
+  StatsCounter nameMismatches;
+
+  /** Copy the counters into the given snapshot. */
+  void snapshot(Snapshot& snapshot) const {
+    snapshot.lookups = lookups.value();
+    snapshot.notFound = notFound.value();
+    snapshot.nameMismatches = nameMismatches.value();
+  }
+
+  /** Set every counter to 0. */
+  void reset() {
+    lookups.reset();
+    notFound.reset();
+    nameMismatches.reset();
+  }
+};
+
+}
+
+#endif
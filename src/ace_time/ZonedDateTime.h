@@ -35,6 +35,10 @@ namespace ace_time {
  */
 class ZonedDateTime {
   public:
+    /** Size of the largest buffer needed by formatTo(). */
+    static const uint8_t kFormatBufferSize =
+        OffsetDateTime::kFormatBufferSize;
+
     /**
      * Factory method using separated date, time, and time zone fields.
      * This is intended mostly for testing purposes. Most production code
@@ -98,16 +102,39 @@ class ZonedDateTime {
       return ZonedDateTime(odt, timeZone);
     }
 
+    /**
+     * Batch version of forEpochSeconds() which converts the `num` elements of
+     * the `epochSeconds` array into the `zdts` array using the same
+     * `timeZone`. This is faster than calling forEpochSeconds() in a loop,
+     * especially if the `epochSeconds` are sorted, because the ZoneProcessor
+     * is able to reuse its transitions across elements. Invalid elements
+     * produce ZonedDateTime::forError().
+     */
+    static void forEpochSecondsBatch(
+        const acetime_t* epochSeconds,
+        ZonedDateTime* zdts,
+        size_t num,
+        const TimeZone& timeZone) {
+      OffsetDateTime odts[kBatchChunkSize];
+      for (size_t i = 0; i < num; i += kBatchChunkSize) {
+        size_t n = (num - i < kBatchChunkSize) ? num - i : kBatchChunkSize;
+        timeZone.getOffsetDateTimeBatch(epochSeconds + i, odts, n);
+        for (size_t j = 0; j < n; j++) {
+          zdts[i + j] = ZonedDateTime(odts[j], timeZone);
+        }
+      }
+    }
+
     /**
      * Factory method to create a ZonedDateTime using the 64-bit number of
      * seconds from Unix epoch.
      *
-     * Even though unixSeconds is 64-bit integer, the internal calculations of
-     * the DST time zone transitions are performed using a 32-bit integer.
-     * Therefore, the valid range of `unixSeconds` is approximately the same
-     * range as `ZonedDateTime::forEpochSeconds()` after translating it to the
-     * AceTime current epoch. In other words, unixSeconds should be roughly
-     * within +/- 60 years of the current epoch year given by
+     * The DST time zone transitions are calculated using 64-bit integers by
+     * TimeZone::getOffsetDateTimeForUnixSeconds64(), so `unixSeconds` can be
+     * in any year [1, 9999] if the ZoneProcessor of the TimeZone supports it
+     * (e.g. ExtendedZoneProcessor, CompleteZoneProcessor, TzifZoneProcessor).
+     * For other ZoneProcessors (e.g. BasicZoneProcessor), unixSeconds should
+     * be roughly within +/- 60 years of the current epoch year given by
      * `Epoch::currentEpochYear()`.
      *
      * Returns ZonedDateTime::forError() if unixSeconds is invalid.
@@ -118,14 +145,10 @@ class ZonedDateTime {
      */
     static ZonedDateTime forUnixSeconds64(
         int64_t unixSeconds, const TimeZone& timeZone) {
-      acetime_t epochSeconds;
-      if (unixSeconds == LocalDate::kInvalidUnixSeconds64) {
-        epochSeconds = LocalDate::kInvalidEpochSeconds;
-      } else {
-        epochSeconds = unixSeconds
-            - Epoch::secondsToCurrentEpochFromUnixEpoch64();
-      }
-      return forEpochSeconds(epochSeconds, timeZone);
+      OffsetDateTime odt = (unixSeconds == LocalDate::kInvalidUnixSeconds64)
+          ? OffsetDateTime::forError()
+          : timeZone.getOffsetDateTimeForUnixSeconds64(unixSeconds);
+      return ZonedDateTime(odt, timeZone);
     }
 
     /**
@@ -326,6 +349,17 @@ class ZonedDateTime {
      */
     void printTo(Print& printer) const;
 
+    /**
+     * Write the date time in ISO 8601 format "yyyy-mm-ddThh:mm:ss+hh:mm" into
+     * 'buf', using OffsetDateTime::formatTo(). Unlike printTo(), the "[zone]"
+     * suffix is not written, because the name of the zone can be retrieved
+     * only through the Print interface of the ZoneProcessor. Return the
+     * number of characters written, excluding the NUL, or 0 on error.
+     */
+    size_t formatTo(char* buf, size_t len) const {
+      return mOffsetDateTime.formatTo(buf, len);
+    }
+
     // Use default copy constructor and assignment operator.
     ZonedDateTime(const ZonedDateTime&) = default;
     ZonedDateTime& operator=(const ZonedDateTime&) = default;
@@ -336,6 +370,9 @@ class ZonedDateTime {
 
     friend bool operator==(const ZonedDateTime& a, const ZonedDateTime& b);
 
+    /** Number of elements processed at a time by forEpochSecondsBatch(). */
+    static const uint8_t kBatchChunkSize = 8;
+
     /** Constructor. From OffsetDateTime and TimeZone. */
     ZonedDateTime(const OffsetDateTime& offsetDateTime, const TimeZone& tz):
       mOffsetDateTime(offsetDateTime),
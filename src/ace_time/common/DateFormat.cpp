@@ -0,0 +1,74 @@
+/*
+ * MIT License
+ * Copyright (c) 2026 Brian T. Park
+ */
+
+#include "DateFormat.h"
+
+namespace ace_time {
+namespace internal {
+
+const char kTwoDigits[200] ACE_TIME_PROGMEM = {
+  '0','0', '0','1', '0','2', '0','3', '0','4',
+  '0','5', '0','6', '0','7', '0','8', '0','9',
+  '1','0', '1','1', '1','2', '1','3', '1','4',
+  '1','5', '1','6', '1','7', '1','8', '1','9',
+  '2','0', '2','1', '2','2', '2','3', '2','4',
+  '2','5', '2','6', '2','7', '2','8', '2','9',
+  '3','0', '3','1', '3','2', '3','3', '3','4',
+  '3','5', '3','6', '3','7', '3','8', '3','9',
+  '4','0', '4','1', '4','2', '4','3', '4','4',
+  '4','5', '4','6', '4','7', '4','8', '4','9',
+  '5','0', '5','1', '5','2', '5','3', '5','4',
+  '5','5', '5','6', '5','7', '5','8', '5','9',
+  '6','0', '6','1', '6','2', '6','3', '6','4',
+  '6','5', '6','6', '6','7', '6','8', '6','9',
+  '7','0', '7','1', '7','2', '7','3', '7','4',
+  '7','5', '7','6', '7','7', '7','8', '7','9',
+  '8','0', '8','1', '8','2', '8','3', '8','4',
+  '8','5', '8','6', '8','7', '8','8', '8','9',
+  '9','0', '9','1', '9','2', '9','3', '9','4',
+  '9','5', '9','6', '9','7', '9','8', '9','9',
+};
+
+char* formatDate(char* p, int16_t year, uint8_t month, uint8_t day) {
+  uint8_t century = (uint16_t) year / 100;
+  p = formatTwoDigits(p, century);
+  p = formatTwoDigits(p, (uint16_t) year - 100 * century);
+  *p++ = '-';
+  p = formatTwoDigits(p, month);
+  *p++ = '-';
+  return formatTwoDigits(p, day);
+}
+
+char* formatTime(char* p, uint8_t hour, uint8_t minute, uint8_t second) {
+  p = formatTwoDigits(p, hour);
+  *p++ = ':';
+  p = formatTwoDigits(p, minute);
+  *p++ = ':';
+  return formatTwoDigits(p, second);
+}
+
+char* formatOffset(char* p, int32_t offsetSeconds) {
+  uint32_t seconds;
+  if (offsetSeconds < 0) {
+    *p++ = '-';
+    seconds = -offsetSeconds;
+  } else {
+    *p++ = '+';
+    seconds = offsetSeconds;
+  }
+  uint8_t second = seconds % 60;
+  uint16_t minutes = seconds / 60;
+  p = formatTwoDigits(p, minutes / 60);
+  *p++ = ':';
+  p = formatTwoDigits(p, minutes % 60);
+  if (second != 0) {
+    *p++ = ':';
+    p = formatTwoDigits(p, second);
+  }
+  return p;
+}
+
+}
+}
@@ -0,0 +1,54 @@
+/*
+ * MIT License
+ * Copyright (c) 2026 Brian T. Park
+ *
+ * Low-level routines which write ISO 8601 fields into a char buffer, used by
+ * the formatTo() methods.
+ */
+
+#ifndef ACE_TIME_COMMON_DATE_FORMAT_H
+#define ACE_TIME_COMMON_DATE_FORMAT_H
+
+#include <stdint.h>
+#include "../../zoneinfo/compat.h" // ACE_TIME_PROGMEM, pgm_read_byte()
+
+namespace ace_time {
+namespace internal {
+
+/** The 2-digit strings "00" to "99" concatenated together. */
+extern const char kTwoDigits[200] ACE_TIME_PROGMEM;
+
+/**
+ * Write 'n' in [0,99] as 2 digits. Return the pointer after the digits. A
+ * larger 'n' is written as "99", instead of reading past the end of
+ * kTwoDigits.
+ */
+inline char* formatTwoDigits(char* p, uint8_t n) {
+  if (n > 99) n = 99;
+  const char* digits = &kTwoDigits[2 * n];
+  p[0] = pgm_read_byte(digits);
+  p[1] = pgm_read_byte(digits + 1);
+  return p + 2;
+}
+
+/** Write "yyyy-mm-dd" (10 characters). The year must be in [0,9999]. */
+char* formatDate(char* p, int16_t year, uint8_t month, uint8_t day);
+
+/** Write "hh:mm:ss" (8 characters). */
+char* formatTime(char* p, uint8_t hour, uint8_t minute, uint8_t second);
+
+/** Largest magnitude of the offsetSeconds which fits into "+/-hh:mm:ss". */
+const int32_t kMaxFormatOffsetSeconds = 99 * 3600 + 59 * 60 + 59;
+
+/**
+ * Write the UTC offset as "+/-hh:mm" (6 characters), or "+/-hh:mm:ss" (9
+ * characters) if the seconds is not 0, like TimeOffset::printTo(). The
+ * offsetSeconds must be in [-kMaxFormatOffsetSeconds,
+ * kMaxFormatOffsetSeconds].
+ */
+char* formatOffset(char* p, int32_t offsetSeconds);
+
+}
+}
+
+#endif
@@ -0,0 +1,51 @@
+/*
+ * MIT License
+ * Copyright (c) 2026 Brian T. Park
+ */
+
+#include "MappedFile.h"
+
+#if ACE_TIME_HAS_MMAP
+  #include <fcntl.h> // open()
+  #include <sys/mman.h> // mmap(), munmap()
+  #include <sys/stat.h> // fstat()
+  #include <unistd.h> // close()
+#endif
+
+namespace ace_time {
+namespace internal {
+
+#if ACE_TIME_HAS_MMAP
+
+bool MappedFile::open(const char* path) {
+  close();
+
+  int fd = ::open(path, O_RDONLY);
+  if (fd < 0) return false;
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+    ::close(fd);
+    return false;
+  }
+  size_t size = (size_t) st.st_size;
+  void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd); // the mapping remains valid after the fd is closed
+  if (data == MAP_FAILED) return false;
+
+  mData = data;
+  mSize = size;
+  return true;
+}
+
+#endif
+
+void MappedFile::close() {
+#if ACE_TIME_HAS_MMAP
+  if (mData) munmap(mData, mSize);
+#endif
+  mData = nullptr;
+  mSize = 0;
+}
+
+}
+}
@@ -0,0 +1,60 @@
+/*
+ * MIT License
+ * Copyright (c) 2026 Brian T. Park
+ *
+ * A read-only memory mapping of a whole file, shared by the classes which
+ * load their data from a file through openFile().
+ */
+
+#ifndef ACE_TIME_COMMON_MAPPED_FILE_H
+#define ACE_TIME_COMMON_MAPPED_FILE_H
+
+#include <stddef.h> // size_t
+#include "../../zoneinfo/compat.h" // ACE_TIME_HAS_MMAP
+
+namespace ace_time {
+namespace internal {
+
+/**
+ * Owns the read-only mmap() of a file. Used by MappedZoneDatabase,
+ * PrecomputedZoneTable and TzifZoneInfo, which validate the data() before
+ * using it. Without ACE_TIME_HAS_MMAP, nothing can be mapped and close() does
+ * nothing.
+ */
+class MappedFile {
+  public:
+    MappedFile() = default;
+
+    /** Destructor, which unmaps the file. */
+    ~MappedFile() { close(); }
+
+  #if ACE_TIME_HAS_MMAP
+    /**
+     * Map the file at `path`, unmapping the previous file (if any). Returns
+     * false if the file could not be opened, is empty, or could not be mapped.
+     */
+    bool open(const char* path);
+  #endif
+
+    /** Unmap the file (if any). */
+    void close();
+
+    /** Return the mapped file, or nullptr if no file is mapped. */
+    const void* data() const { return mData; }
+
+    /** Return the size of the mapped file in bytes. */
+    size_t size() const { return mSize; }
+
+  private:
+    // disable copy constructor and assignment operator
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    void* mData = nullptr;
+    size_t mSize = 0;
+};
+
+}
+}
+
+#endif
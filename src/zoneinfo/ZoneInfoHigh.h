@@ -540,6 +540,10 @@ class ZonePolicyBroker {
 
     bool isNull() const { return mZonePolicy == nullptr; }
 
+    bool equals(const ZonePolicyBroker& other) const {
+      return mZonePolicy == other.mZonePolicy;
+    }
+
     uint8_t numRules() const {
       return pgm_read_byte(&mZonePolicy->numRules);
     }
@@ -0,0 +1,588 @@
+/*
+ * MIT License
+ * Copyright (c) 2026 Brian T. Park
+ */
+
+#ifndef ACE_TIME_ZONE_INFO_MAPPED_H
+#define ACE_TIME_ZONE_INFO_MAPPED_H
+
+/**
+ * @file ZoneInfoMapped.h
+ *
+ * Data structures that encode the zoneinfo database in a binary file which is
+ * loaded at runtime (e.g. using mmap()) instead of being compiled into the
+ * program. The records have the same 1-second resolution as ZoneInfoHigh.h,
+ * so the file can hold everything in the 'zonedbc' database.
+ *
+ * The file is position-independent. Every pointer of ZoneInfoHigh is replaced
+ * by a 32-bit signed offset which is relative to the address of the offset
+ * field itself, with 0 representing nullptr. This allows the records to be
+ * read in place, without any parsing or relocation, from wherever the file
+ * is mapped into memory. The records are naturally aligned on 4-byte
+ * boundaries, and use the native byte order (little-endian on every
+ * supported platform) which is verified by the Header::byteOrderMark.
+ *
+ * The file is written by MappedZoneDatabaseWriter and loaded by
+ * MappedZoneDatabase. The brokers below read the records using normal memory
+ * reads, so the file must be in RAM or in memory-mapped storage. It cannot
+ * live in the PROGMEM of an AVR processor.
+ *
+ * The layout of the file is:
+ *
+ * @verbatim
+ * Header
+ * ZoneContext
+ * letters: int32_t[numLetters]
+ * registry: int32_t[numZones], sorted by zoneId
+ * ZoneInfo[numZones], in the same order as the registry
+ * ZoneEra[]
+ * ZonePolicy[]
+ * ZoneRule[]
+ * string pool: tzVersion, letters, names, formats
+ * @endverbatim
+ *
+ * Unlike ZoneInfoHigh, the zone names are stored without the KString
+ * fragment compression, so ZoneContextBroker::numFragments() is always 0.
+ */
+
+#include <stdint.h>
+#include <Arduino.h> // FPSTR()
+#include <AceCommon.h> // KString
+#include "compat.h"
+#include "BrokerCommon.h"
+
+class __FlashStringHelper;
+class Print;
+
+namespace ace_time {
+
+/**
+ * Wrapper class so that the entire collection can be referenced as a single
+ * template parameter.
+ */
+class ZoneInfoMapped {
+public:
+
+/**
+ * Return the pointer stored in the self-relative `offset` field, or nullptr
+ * if the offset is 0.
+ */
+template <typename T>
+static const T* resolve(const int32_t& offset) {
+  return (offset == 0)
+      ? nullptr
+      : (const T*) ((const char*) &offset + offset);
+}
+
+/**
+ * Header at the start of the file. All fields are validated by
+ * MappedZoneDatabase before any other record is read.
+ */
+struct Header {
+  /** Expected value of formatVersion. */
+  static const uint16_t kFormatVersion = 1;
+
+  /** Expected value of byteOrderMark, which detects a foreign byte order. */
+  static const uint32_t kByteOrderMark = 0x01020304;
+
+  /** Always "AceTzDb" followed by a NUL character (see kMagic). */
+  char magic[8];
+
+  /** Version of this file format. */
+  uint16_t formatVersion;
+
+  /** Size of this Header, in bytes. */
+  uint16_t headerSize;
+
+  /** Always kByteOrderMark, written in the native byte order. */
+  uint32_t byteOrderMark;
+
+  /** Size of the whole file, in bytes. */
+  uint32_t fileSize;
+
+  /** Number of ZoneInfo entries (Zones and Links) in the registry. */
+  uint16_t numZones;
+
+  /** Unused, always 0. */
+  uint16_t reserved;
+
+  /** Offset of the ZoneContext. */
+  int32_t zoneContext;
+
+  /** Offset of the registry, an array of numZones offsets of ZoneInfo. */
+  int32_t registry;
+};
+
+/**
+ * Metadata about the zone database. Same as ZoneInfoHigh::ZoneContext.
+ */
+struct ZoneContext {
+  /** Represents "-" in the UNTIL column, same as ZoneInfoHigh. */
+  static const int16_t kMaxUntilYear = 32767;
+
+  /** Represents "max" in the TO and FROM columns, same as ZoneInfoHigh. */
+  static const int16_t kMaxYear = kMaxUntilYear - 1;
+
+  /** Represents -Infinity, same as ZoneInfoHigh. */
+  static const int16_t kMinYear = -32767;
+
+  /** Represents 'w' or wall time. */
+  static const uint8_t kSuffixW = 0x00;
+
+  /** Represents 's' or standard time. */
+  static const uint8_t kSuffixS = 0x10;
+
+  /** Represents 'u' or UTC time. */
+  static const uint8_t kSuffixU = 0x20;
+
+  int16_t startYear;
+  int16_t untilYear;
+  int16_t startYearAccurate;
+  int16_t untilYearAccurate;
+  int16_t baseYear;
+  int16_t maxTransitions;
+
+  /** Number of entries in letters. */
+  uint8_t numLetters;
+
+  /** Unused, always 0. */
+  uint8_t reserved[3];
+
+  /** Offset of the TZ Database version string. */
+  int32_t tzVersion;
+
+  /** Offset of the array of numLetters offsets of the LETTER strings. */
+  int32_t letters;
+};
+
+/** A ZoneRule, same fields as ZoneInfoHigh::ZoneRule. */
+struct ZoneRule {
+  int16_t fromYear;
+  int16_t toYear;
+  uint8_t inMonth;
+  uint8_t onDayOfWeek;
+  int8_t onDayOfMonth;
+  uint8_t atTimeModifier;
+  uint16_t atTimeCode;
+  int8_t deltaMinutes;
+  uint8_t letterIndex;
+};
+
+/** A ZonePolicy, a collection of numRules ZoneRule records. */
+struct ZonePolicy {
+  /** Offset of the array of ZoneRule. */
+  int32_t rules;
+
+  uint8_t numRules;
+
+  /** Unused, always 0. */
+  uint8_t reserved[3];
+};
+
+/** A ZoneEra, same fields as ZoneInfoHigh::ZoneEra. */
+struct ZoneEra {
+  /** Offset of the ZonePolicy, 0 if the RULES column is '-' or 'hh:mm'. */
+  int32_t zonePolicy;
+
+  /** Offset of the FORMAT string. */
+  int32_t format;
+
+  int16_t offsetCode;
+  uint8_t offsetRemainder;
+  int8_t deltaMinutes;
+  int16_t untilYear;
+  uint8_t untilMonth;
+  uint8_t untilDay;
+  uint16_t untilTimeCode;
+  uint8_t untilTimeModifier;
+
+  /** Unused, always 0. */
+  uint8_t reserved;
+};
+
+/**
+ * A Zone or a Link. As in ZoneInfoHigh, a Link contains the eras of its
+ * target Zone.
+ */
+struct ZoneInfo {
+  /** Offset of the full, uncompressed name (e.g. "America/Los_Angeles"). */
+  int32_t name;
+
+  uint32_t zoneId;
+
+  /** Offset of the ZoneContext. */
+  int32_t zoneContext;
+
+  /** Offset of the array of numEras ZoneEra records. */
+  int32_t eras;
+
+  /** If Link, offset of the target ZoneInfo. If Zone, 0. */
+  int32_t targetInfo;
+
+  uint8_t numEras;
+
+  /** Unused, always 0. */
+  uint8_t reserved[3];
+};
+
+static_assert(sizeof(Header) == 32, "sizeof(Header)");
+static_assert(sizeof(ZoneContext) == 24, "sizeof(ZoneContext)");
+static_assert(sizeof(ZoneRule) == 12, "sizeof(ZoneRule)");
+static_assert(sizeof(ZonePolicy) == 8, "sizeof(ZonePolicy)");
+static_assert(sizeof(ZoneEra) == 20, "sizeof(ZoneEra)");
+static_assert(sizeof(ZoneInfo) == 24, "sizeof(ZoneInfo)");
+
+//-----------------------------------------------------------------------------
+// Brokers are wrappers around the above data objects so that outside code
+// can use the data objects with the same API as the ZoneInfoHigh brokers.
+//-----------------------------------------------------------------------------
+
+/** Convert the deltaMinutes of ZoneEra or ZoneRule to seconds. */
+static int32_t toDeltaSeconds(int8_t deltaMinutes) {
+  return int32_t(60) * deltaMinutes;
+}
+
+/** Convert (code, remainder) holding the STDOFF field into seconds. */
+static int32_t toOffsetSeconds(int16_t offsetCode, uint8_t offsetRemainder) {
+  return int32_t(15) * offsetCode + (int32_t) offsetRemainder;
+}
+
+/** Convert (code, modifier) holding the UNTIL or AT time into seconds. */
+static uint32_t timeCodeToSeconds(uint16_t code, uint8_t modifier) {
+  return code * (uint32_t) 15 + (modifier & 0x0f);
+}
+
+/** Extract the 'w', 's' 'u' suffix from the 'modifier' field. */
+static uint8_t toSuffix(uint8_t modifier) {
+  return modifier & 0xf0;
+}
+
+//-----------------------------------------------------------------------------
+
+/**
+ * Data broker for accessing a ZoneContext.
+ */
+class ZoneContextBroker {
+  public:
+    explicit ZoneContextBroker(const ZoneContext* zoneContext = nullptr)
+        : mZoneContext(zoneContext)
+    {}
+
+    // use the default copy constructor
+    ZoneContextBroker(const ZoneContextBroker&) = default;
+
+    // use the default assignment operator
+    ZoneContextBroker& operator=(const ZoneContextBroker&) = default;
+
+    bool isNull() const { return mZoneContext == nullptr; }
+
+    const ZoneContext* raw() const { return mZoneContext; }
+
+    int16_t startYear() const { return mZoneContext->startYear; }
+
+    int16_t untilYear() const { return mZoneContext->untilYear; }
+
+    int16_t startYearAccurate() const {
+      return mZoneContext->startYearAccurate;
+    }
+
+    int16_t untilYearAccurate() const {
+      return mZoneContext->untilYearAccurate;
+    }
+
+    int16_t baseYear() const { return mZoneContext->baseYear; }
+
+    int16_t maxTransitions() const { return mZoneContext->maxTransitions; }
+
+    const __FlashStringHelper* tzVersion() const {
+      return FPSTR(resolve<char>(mZoneContext->tzVersion));
+    }
+
+    /** The names are not compressed, so there are no fragments. */
+    uint8_t numFragments() const { return 0; }
+
+    /** The names are not compressed, so there are no fragments. */
+    const __FlashStringHelper* const* fragments() const { return nullptr; }
+
+    uint8_t numLetters() const { return mZoneContext->numLetters; }
+
+    const __FlashStringHelper* letter(uint8_t i) const {
+      const int32_t* letters = resolve<int32_t>(mZoneContext->letters);
+      return FPSTR(resolve<char>(letters[i]));
+    }
+
+  private:
+    const ZoneContext* mZoneContext;
+};
+
+//-----------------------------------------------------------------------------
+
+/**
+ * Data broker for accessing ZoneRule.
+ */
+class ZoneRuleBroker {
+  public:
+    explicit ZoneRuleBroker(
+        const ZoneContext* zoneContext = nullptr,
+        const ZoneRule* zoneRule = nullptr)
+        : mZoneContext(zoneContext)
+        , mZoneRule(zoneRule)
+    {}
+
+    // use the default copy constructor
+    ZoneRuleBroker(const ZoneRuleBroker&) = default;
+
+    // use the default assignment operator
+    ZoneRuleBroker& operator=(const ZoneRuleBroker&) = default;
+
+    bool isNull() const { return mZoneRule == nullptr; }
+
+    int16_t fromYear() const { return mZoneRule->fromYear; }
+
+    int16_t toYear() const { return mZoneRule->toYear; }
+
+    uint8_t inMonth() const { return mZoneRule->inMonth; }
+
+    uint8_t onDayOfWeek() const { return mZoneRule->onDayOfWeek; }
+
+    int8_t onDayOfMonth() const { return mZoneRule->onDayOfMonth; }
+
+    uint32_t atTimeSeconds() const {
+      return timeCodeToSeconds(
+          mZoneRule->atTimeCode, mZoneRule->atTimeModifier);
+    }
+
+    uint8_t atTimeSuffix() const {
+      return toSuffix(mZoneRule->atTimeModifier);
+    }
+
+    int32_t deltaSeconds() const {
+      return toDeltaSeconds(mZoneRule->deltaMinutes);
+    }
+
+    const __FlashStringHelper* letter() const {
+      return ZoneContextBroker(mZoneContext).letter(mZoneRule->letterIndex);
+    }
+
+  private:
+    const ZoneContext* mZoneContext;
+    const ZoneRule* mZoneRule;
+};
+
+/**
+ * Data broker for accessing ZonePolicy.
+ */
+class ZonePolicyBroker {
+  public:
+    explicit ZonePolicyBroker(
+        const ZoneContext* zoneContext,
+        const ZonePolicy* zonePolicy)
+        : mZoneContext(zoneContext)
+        , mZonePolicy(zonePolicy)
+    {}
+
+    // use default copy constructor
+    ZonePolicyBroker(const ZonePolicyBroker&) = default;
+
+    // use default assignment operator
+    ZonePolicyBroker& operator=(const ZonePolicyBroker&) = default;
+
+    bool isNull() const { return mZonePolicy == nullptr; }
+
+    uint8_t numRules() const { return mZonePolicy->numRules; }
+
+    const ZoneRuleBroker rule(uint8_t i) const {
+      const ZoneRule* rules = resolve<ZoneRule>(mZonePolicy->rules);
+      return ZoneRuleBroker(mZoneContext, &rules[i]);
+    }
+
+  private:
+    const ZoneContext* mZoneContext;
+    const ZonePolicy* mZonePolicy;
+};
+
+//-----------------------------------------------------------------------------
+
+/**
+ * Data broker for accessing ZoneEra.
+ */
+class ZoneEraBroker {
+  public:
+    explicit ZoneEraBroker(
+        const ZoneContext* zoneContext = nullptr,
+        const ZoneEra* zoneEra = nullptr)
+        : mZoneContext(zoneContext)
+        , mZoneEra(zoneEra)
+    {}
+
+    // use default copy constructor
+    ZoneEraBroker(const ZoneEraBroker&) = default;
+
+    // use default assignment operator
+    ZoneEraBroker& operator=(const ZoneEraBroker&) = default;
+
+    bool isNull() const { return mZoneEra == nullptr; }
+
+    bool equals(const ZoneEraBroker& other) const {
+      return mZoneEra == other.mZoneEra;
+    }
+
+    const ZonePolicyBroker zonePolicy() const {
+      return ZonePolicyBroker(
+          mZoneContext, resolve<ZonePolicy>(mZoneEra->zonePolicy));
+    }
+
+    int32_t offsetSeconds() const {
+      return toOffsetSeconds(
+          mZoneEra->offsetCode, mZoneEra->offsetRemainder);
+    }
+
+    int32_t deltaSeconds() const {
+      return toDeltaSeconds(mZoneEra->deltaMinutes);
+    }
+
+    const char* format() const {
+      return resolve<char>(mZoneEra->format);
+    }
+
+    int16_t untilYear() const { return mZoneEra->untilYear; }
+
+    uint8_t untilMonth() const { return mZoneEra->untilMonth; }
+
+    uint8_t untilDay() const { return mZoneEra->untilDay; }
+
+    uint32_t untilTimeSeconds() const {
+      return timeCodeToSeconds(
+          mZoneEra->untilTimeCode, mZoneEra->untilTimeModifier);
+    }
+
+    uint8_t untilTimeSuffix() const {
+      return toSuffix(mZoneEra->untilTimeModifier);
+    }
+
+  private:
+    const ZoneContext* mZoneContext;
+    const ZoneEra* mZoneEra;
+};
+
+/**
+ * Data broker for accessing ZoneInfo.
+ */
+class ZoneInfoBroker {
+  public:
+    explicit ZoneInfoBroker(const ZoneInfo* zoneInfo = nullptr):
+        mZoneInfo(zoneInfo) {}
+
+    // use default copy constructor
+    ZoneInfoBroker(const ZoneInfoBroker&) = default;
+
+    // use default assignment operator
+    ZoneInfoBroker& operator=(const ZoneInfoBroker&) = default;
+
+    /**
+     * @param zoneKey an opaque Zone primary key, the address of the ZoneInfo
+     *    record in the mapped file
+     */
+    bool equals(uintptr_t zoneKey) const {
+      return mZoneInfo == (const ZoneInfo*) zoneKey;
+    }
+
+    bool equals(const ZoneInfoBroker& zoneInfoBroker) const {
+      return mZoneInfo == zoneInfoBroker.mZoneInfo;
+    }
+
+    bool isNull() const { return mZoneInfo == nullptr; }
+
+    const ZoneContextBroker zoneContext() const {
+      return ZoneContextBroker(resolve<ZoneContext>(mZoneInfo->zoneContext));
+    }
+
+    const __FlashStringHelper* name() const {
+      return FPSTR(resolve<char>(mZoneInfo->name));
+    }
+
+    uint32_t zoneId() const { return mZoneInfo->zoneId; }
+
+    uint8_t numEras() const { return mZoneInfo->numEras; }
+
+    const ZoneEraBroker era(uint8_t i) const {
+      const ZoneEra* eras = resolve<ZoneEra>(mZoneInfo->eras);
+      return ZoneEraBroker(zoneContext().raw(), &eras[i]);
+    }
+
+    bool isLink() const { return mZoneInfo->targetInfo != 0; }
+
+    ZoneInfoBroker targetInfo() const {
+      return ZoneInfoBroker(resolve<ZoneInfo>(mZoneInfo->targetInfo));
+    }
+
+    /** Print a human-readable identifier (e.g. "America/Los_Angeles"). */
+    void printNameTo(Print& printer) const {
+      printer.print(name());
+    }
+
+    /**
+     * Print a short human-readable identifier (e.g. "Los Angeles").
+     * Any underscore in the short name is replaced with a space.
+     */
+    void printShortNameTo(Print& printer) const {
+      ace_common::printReplaceCharTo(
+          printer, zoneinfo::findShortName(name()), '_', ' ');
+    }
+
+  private:
+    const ZoneInfo* mZoneInfo;
+};
+
+//-----------------------------------------------------------------------------
+
+/**
+ * Data broker for accessing the registry of the mapped file. The registry is
+ * an array of self-relative int32_t offsets, not an array of pointers, but it
+ * is passed around as a `const ZoneInfo* const*` so that it can be used by
+ * the ZoneRegistrarTemplate and ZoneManagerTemplate.
+ * MappedZoneDatabase::zoneRegistry() returns the correct value.
+ */
+class ZoneRegistryBroker {
+  public:
+    ZoneRegistryBroker(const ZoneInfo* const* zoneRegistry):
+        mZoneRegistry((const int32_t*) zoneRegistry) {}
+
+    // use default copy constructor
+    ZoneRegistryBroker(const ZoneRegistryBroker&) = default;
+
+    // use default assignment operator
+    ZoneRegistryBroker& operator=(const ZoneRegistryBroker&) = default;
+
+    const ZoneInfo* zoneInfo(uint16_t i) const {
+      return resolve<ZoneInfo>(mZoneRegistry[i]);
+    }
+
+  private:
+    const int32_t* mZoneRegistry;
+};
+
+//-----------------------------------------------------------------------------
+
+/**
+ * A storage object that creates a ZoneInfoBroker from a key that identifies
+ * the ZoneInfo. Because the offsets in the file are self-relative, the zoneKey
+ * is simply the address of the ZoneInfo record in the mapped file, and the
+ * store does not need to know where the file was mapped.
+ */
+class ZoneInfoStore {
+  public:
+    /**
+     * @param zoneKey an opaque Zone primary key, the address of the ZoneInfo
+     *    record in the mapped file
+     */
+    ZoneInfoBroker createZoneInfoBroker(uintptr_t zoneKey) const {
+      return ZoneInfoBroker((const ZoneInfo*) zoneKey);
+    }
+};
+
+}; // ZoneInfoMapped
+
+} // ace_time
+
+#endif
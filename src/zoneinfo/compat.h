@@ -27,6 +27,48 @@
   #define ACE_TIME_PROGMEM
 #endif
 
+/**
+ * Set to 1 if the POSIX mmap() function is available to map zoneinfo files
+ * into memory (MappedZoneDatabase::openFile(), TzifZoneInfo::openFile()).
+ * Enabled by default only on Linux and MacOS through EpoxyDuino. Other
+ * platforms can still load the files into a RAM buffer.
+ */
+#ifndef ACE_TIME_HAS_MMAP
+  #if defined(EPOXY_DUINO) && (defined(__linux__) || defined(__APPLE__))
+    #define ACE_TIME_HAS_MMAP 1
+  #else
+    #define ACE_TIME_HAS_MMAP 0
+  #endif
+#endif
+
+/**
+ * Set to 1 if the toolchain supports `std::atomic`, which is required by the
+ * SwappableZoneDatabase, and used by the StatsCounter if available. Enabled
+ * by default only on platforms with real threads (Linux/MacOS through
+ * EpoxyDuino, and the ESP32 using FreeRTOS).
+ */
+#ifndef ACE_TIME_HAS_ATOMIC
+  #if defined(EPOXY_DUINO) || defined(ESP32)
+    #define ACE_TIME_HAS_ATOMIC 1
+  #else
+    #define ACE_TIME_HAS_ATOMIC 0
+  #endif
+#endif
+
+/**
+ * Set to 1 if the toolchain supports `std::thread`, which is used to spread
+ * the startup work of the PrecomputedZoneManager across the cores. Enabled by
+ * default on the same platforms as ACE_TIME_HAS_ATOMIC, which is also
+ * required. Otherwise, the work is done serially by the calling thread.
+ */
+#ifndef ACE_TIME_HAS_THREADS
+  #if ACE_TIME_HAS_ATOMIC
+    #define ACE_TIME_HAS_THREADS 1
+  #else
+    #define ACE_TIME_HAS_THREADS 0
+  #endif
+#endif
+
 // Some 3rd party Arduino cores does not define FPSTR(). And unfortunately, when
 // they do, sometimes it's wrong, so we sometimes have to clobber it below.
 #if ! defined(FPSTR)
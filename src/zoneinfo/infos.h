@@ -9,6 +9,7 @@
 #include "ZoneInfoLow.h"
 #include "ZoneInfoMid.h"
 #include "ZoneInfoHigh.h"
+#include "ZoneInfoMapped.h"
 
 namespace ace_time {
 
@@ -31,6 +32,12 @@ namespace complete {
 using Info = ZoneInfoHigh;
 }
 
+// Data structures for MappedZoneProcessor, read from a binary file which is
+// loaded at runtime by MappedZoneDatabase instead of being compiled in.
+namespace mapped {
+using Info = ZoneInfoMapped;
+}
+
 }
 
 #endif
@@ -145,58 +145,59 @@ test(BasicZoneProcessorTest, compareRulesBeforeYear) {
 
 test(BasicZoneProcessorTest, init_primitives) {
   BasicZoneProcessor zoneProcessor(&kZoneAmerica_Los_Angeles);
+  auto* slot = zoneProcessor.mCurrentYearSlot;
   zoneProcessor.mYear = 2001;
-  zoneProcessor.mNumTransitions = 0;
+  slot->numTransitions = 0;
 
   Info::ZoneEraBroker priorEra = zoneProcessor.addTransitionPriorToYear(
       2001);
-  assertEqual(1, zoneProcessor.mNumTransitions);
-  assertEqual(-8*60*60, zoneProcessor.mTransitions[0].era.offsetSeconds());
-  assertEqual("P%T", zoneProcessor.mTransitions[0].era.format());
-  assertEqual(-32767, zoneProcessor.mTransitions[0].rule.fromYear());
-  assertEqual(2006, zoneProcessor.mTransitions[0].rule.toYear());
-  assertEqual(10, zoneProcessor.mTransitions[0].rule.inMonth());
+  assertEqual(1, slot->numTransitions);
+  assertEqual(-8*60*60, slot->transitions[0].era.offsetSeconds());
+  assertEqual("P%T", slot->transitions[0].era.format());
+  assertEqual(-32767, slot->transitions[0].rule.fromYear());
+  assertEqual(2006, slot->transitions[0].rule.toYear());
+  assertEqual(10, slot->transitions[0].rule.inMonth());
 
   Info::ZoneEraBroker currentEra = zoneProcessor.addTransitionsForYear(
       2001, priorEra);
-  assertEqual(3, zoneProcessor.mNumTransitions);
+  assertEqual(3, slot->numTransitions);
 
-  assertEqual(-8*60*60, zoneProcessor.mTransitions[1].era.offsetSeconds());
-  assertEqual("P%T", zoneProcessor.mTransitions[1].era.format());
-  assertEqual(1987, zoneProcessor.mTransitions[1].rule.fromYear());
-  assertEqual(2006, zoneProcessor.mTransitions[1].rule.toYear());
-  assertEqual(4, zoneProcessor.mTransitions[1].rule.inMonth());
+  assertEqual(-8*60*60, slot->transitions[1].era.offsetSeconds());
+  assertEqual("P%T", slot->transitions[1].era.format());
+  assertEqual(1987, slot->transitions[1].rule.fromYear());
+  assertEqual(2006, slot->transitions[1].rule.toYear());
+  assertEqual(4, slot->transitions[1].rule.inMonth());
 
-  assertEqual(-8*60*60, zoneProcessor.mTransitions[2].era.offsetSeconds());
-  assertEqual("P%T", zoneProcessor.mTransitions[2].era.format());
-  assertEqual(-32767, zoneProcessor.mTransitions[2].rule.fromYear());
-  assertEqual(2006, zoneProcessor.mTransitions[2].rule.toYear());
-  assertEqual(10, zoneProcessor.mTransitions[2].rule.inMonth());
+  assertEqual(-8*60*60, slot->transitions[2].era.offsetSeconds());
+  assertEqual("P%T", slot->transitions[2].era.format());
+  assertEqual(-32767, slot->transitions[2].rule.fromYear());
+  assertEqual(2006, slot->transitions[2].rule.toYear());
+  assertEqual(10, slot->transitions[2].rule.inMonth());
 
   zoneProcessor.addTransitionAfterYear(2001, currentEra);
-  assertEqual(3, zoneProcessor.mNumTransitions);
+  assertEqual(3, slot->numTransitions);
 
   zoneProcessor.calcTransitions();
   // most recent prior is at [0]
   assertEqual(BasicZoneProcessor::kMinEpochSeconds,
-      zoneProcessor.mTransitions[0].startEpochSeconds);
-  assertEqual(-8*60, zoneProcessor.mTransitions[0].offsetMinutes);
+      slot->transitions[0].startEpochSeconds);
+  assertEqual(-8*60, slot->transitions[0].offsetMinutes);
 
   // t >= 2001-04-01 02:00 UTC-08:00 Sunday goes to PDT
-  assertEqual(-8*60, zoneProcessor.mTransitions[1].offsetMinutes);
-  assertEqual(1*60, zoneProcessor.mTransitions[1].deltaMinutes);
+  assertEqual(-8*60, slot->transitions[1].offsetMinutes);
+  assertEqual(1*60, slot->transitions[1].deltaMinutes);
   assertEqual(
       (acetime_t) (39434400 /*relative to 2000*/
           - Epoch::daysToCurrentEpochFromInternalEpoch() * 86400),
-      zoneProcessor.mTransitions[1].startEpochSeconds);
+      slot->transitions[1].startEpochSeconds);
 
   // t >= 2001-10-28 02:00 UTC-07:00 Sunday goes to PST
-  assertEqual(-8*60, zoneProcessor.mTransitions[2].offsetMinutes);
-  assertEqual(0*60, zoneProcessor.mTransitions[2].deltaMinutes);
+  assertEqual(-8*60, slot->transitions[2].offsetMinutes);
+  assertEqual(0*60, slot->transitions[2].deltaMinutes);
   assertEqual(
       (acetime_t) (57574800 /*relative to 2000*/
           - Epoch::daysToCurrentEpochFromInternalEpoch() * 86400),
-      zoneProcessor.mTransitions[2].startEpochSeconds);
+      slot->transitions[2].startEpochSeconds);
 }
 
 test(BasicZoneProcessorTest, initForLocalDate) {
@@ -205,50 +206,51 @@ test(BasicZoneProcessorTest, initForLocalDate) {
   BasicZoneProcessor zoneProcessor(&kZoneAmerica_Los_Angeles);
   LocalDate ld = LocalDate::forComponents(2018, 1, 2);
   bool ok = zoneProcessor.initForLocalDate(ld);
+  const auto* slot = zoneProcessor.mCurrentYearSlot;
 
   assertTrue(ok);
-  assertEqual(3, zoneProcessor.mNumTransitions);
+  assertEqual(3, slot->numTransitions);
 
-  assertEqual(-8*60*60, zoneProcessor.mTransitions[0].era.offsetSeconds());
-  assertEqual("P%T", zoneProcessor.mTransitions[0].era.format());
-  assertEqual(2007, zoneProcessor.mTransitions[0].rule.fromYear());
+  assertEqual(-8*60*60, slot->transitions[0].era.offsetSeconds());
+  assertEqual("P%T", slot->transitions[0].era.format());
+  assertEqual(2007, slot->transitions[0].rule.fromYear());
   assertEqual(Info::ZoneContext::kMaxYear,
-      zoneProcessor.mTransitions[0].rule.toYear());
-  assertEqual(11, zoneProcessor.mTransitions[0].rule.inMonth());
+      slot->transitions[0].rule.toYear());
+  assertEqual(11, slot->transitions[0].rule.inMonth());
 
-  assertEqual(-8*60*60, zoneProcessor.mTransitions[1].era.offsetSeconds());
-  assertEqual("P%T", zoneProcessor.mTransitions[1].era.format());
-  assertEqual(2007, zoneProcessor.mTransitions[1].rule.fromYear());
+  assertEqual(-8*60*60, slot->transitions[1].era.offsetSeconds());
+  assertEqual("P%T", slot->transitions[1].era.format());
+  assertEqual(2007, slot->transitions[1].rule.fromYear());
   assertEqual(Info::ZoneContext::kMaxYear,
-      zoneProcessor.mTransitions[1].rule.toYear());
-  assertEqual(3, zoneProcessor.mTransitions[1].rule.inMonth());
+      slot->transitions[1].rule.toYear());
+  assertEqual(3, slot->transitions[1].rule.inMonth());
 
-  assertEqual(-8*60*60, zoneProcessor.mTransitions[2].era.offsetSeconds());
-  assertEqual("P%T", zoneProcessor.mTransitions[2].era.format());
-  assertEqual(2007, zoneProcessor.mTransitions[2].rule.fromYear());
+  assertEqual(-8*60*60, slot->transitions[2].era.offsetSeconds());
+  assertEqual("P%T", slot->transitions[2].era.format());
+  assertEqual(2007, slot->transitions[2].rule.fromYear());
   assertEqual(Info::ZoneContext::kMaxYear,
-      zoneProcessor.mTransitions[2].rule.toYear());
-  assertEqual(11, zoneProcessor.mTransitions[2].rule.inMonth());
+      slot->transitions[2].rule.toYear());
+  assertEqual(11, slot->transitions[2].rule.inMonth());
 
   assertEqual((acetime_t) BasicZoneProcessor::kMinEpochSeconds,
-      zoneProcessor.mTransitions[0].startEpochSeconds);
-  assertEqual(-8*60, zoneProcessor.mTransitions[0].offsetMinutes);
+      slot->transitions[0].startEpochSeconds);
+  assertEqual(-8*60, slot->transitions[0].offsetMinutes);
 
   // t >= 2018-03-11 02:00 UTC-08:00 Sunday goes to PDT
-  assertEqual(-8*60, zoneProcessor.mTransitions[1].offsetMinutes);
-  assertEqual(1*60, zoneProcessor.mTransitions[1].deltaMinutes);
+  assertEqual(-8*60, slot->transitions[1].offsetMinutes);
+  assertEqual(1*60, slot->transitions[1].deltaMinutes);
   assertEqual(
       (acetime_t) (574077600 /*relative to 2000*/
           - Epoch::daysToCurrentEpochFromInternalEpoch() * 86400),
-      zoneProcessor.mTransitions[1].startEpochSeconds);
+      slot->transitions[1].startEpochSeconds);
 
   // t >= 2018-11-04 02:00 UTC-07:00 Sunday goes to PST
-  assertEqual(-8*60, zoneProcessor.mTransitions[2].offsetMinutes);
-  assertEqual(0*60, zoneProcessor.mTransitions[2].deltaMinutes);
+  assertEqual(-8*60, slot->transitions[2].offsetMinutes);
+  assertEqual(0*60, slot->transitions[2].deltaMinutes);
   assertEqual(
       (acetime_t) (594637200 /*relative to 2000*/
           - Epoch::daysToCurrentEpochFromInternalEpoch() * 86400),
-      zoneProcessor.mTransitions[2].startEpochSeconds);
+      slot->transitions[2].startEpochSeconds);
 }
 
 //---------------------------------------------------------------------------
@@ -271,6 +273,48 @@ test(BasicZoneProcessorTest, setZoneKey) {
   assertNotEqual(zoneProcessor.mYear, LocalDate::kInvalidYear);
 }
 
+test(BasicZoneProcessorTest, multiYear) {
+  BasicZoneProcessor singleYear(&kZoneAmerica_Los_Angeles);
+  BasicZoneProcessorMultiYear<2> multiYear(&kZoneAmerica_Los_Angeles);
+  assertEqual(1, singleYear.getNumYearSlots());
+  assertEqual(2, multiYear.getNumYearSlots());
+
+  // Alternate between 2 timestamps in different years. The cached year of
+  // the BasicZoneProcessor starts on Jan 2.
+  acetime_t before = OffsetDateTime::forComponents(2018, 12, 31, 23, 0, 0,
+      TimeOffset()).toEpochSeconds();
+  acetime_t after = OffsetDateTime::forComponents(2019, 1, 2, 1, 0, 0,
+      TimeOffset()).toEpochSeconds();
+  for (int i = 0; i < 3; i++) {
+    FindResult expected = singleYear.findByEpochSeconds(before);
+    FindResult result = multiYear.findByEpochSeconds(before);
+    assertEqual(result.type, expected.type);
+    assertEqual(result.stdOffsetSeconds, expected.stdOffsetSeconds);
+    assertEqual(result.dstOffsetSeconds, expected.dstOffsetSeconds);
+    assertEqual(result.abbrev, expected.abbrev);
+
+    expected = singleYear.findByEpochSeconds(after);
+    result = multiYear.findByEpochSeconds(after);
+    assertEqual(result.type, expected.type);
+    assertEqual(result.stdOffsetSeconds, expected.stdOffsetSeconds);
+    assertEqual(result.dstOffsetSeconds, expected.dstOffsetSeconds);
+    assertEqual(result.abbrev, expected.abbrev);
+  }
+
+  // A third year evicts the least recently used year, 2018.
+  LocalDateTime ldt = LocalDateTime::forComponents(2020, 6, 1, 0, 0, 0);
+  FindResult result = multiYear.findByLocalDateTime(ldt);
+  assertEqual(result.type, FindResult::kTypeExact);
+  assertEqual("PDT", result.abbrev);
+  result = multiYear.findByEpochSeconds(before);
+  assertEqual("PST", result.abbrev);
+
+  // Changing the zone invalidates all years.
+  multiYear.setZoneKey((uintptr_t) &kZoneAustralia_Darwin);
+  result = multiYear.findByEpochSeconds(after);
+  assertEqual("ACST", result.abbrev);
+}
+
 // https://www.timeanddate.com/time/zone/usa/los-angeles
 test(BasicZoneProcessorTest, printNameTo) {
   BasicZoneProcessor zoneProcessor(&kZoneAmerica_Los_Angeles);
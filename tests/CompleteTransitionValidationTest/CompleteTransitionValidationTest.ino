@@ -66,9 +66,9 @@ class CompleteTransitionValidation : public aunit::TestOnce {
         }
 
         CompleteZoneProcessor::Transition** start =
-            zoneProcessor.mTransitionStorage.getActivePoolBegin();
+            zoneProcessor.mCurrentYearSlot->transitionStorage.getActivePoolBegin();
         CompleteZoneProcessor::Transition** end =
-            zoneProcessor.mTransitionStorage.getActivePoolEnd();
+            zoneProcessor.mCurrentYearSlot->transitionStorage.getActivePoolEnd();
 
         // Verify at least one Transition is created for each zone.
         // Note: (end-start) is supposed to return an integer of type `ssize_t`,
@@ -52,6 +52,37 @@ test(DateTuple, dateTupleOperatorEquals) {
       == DateTuple{2001, 1, 2, 3, kSuffixW}));
 }
 
+test(DateTuple, packDateTuple) {
+  // The packed values sort in the same order as operator<(), including
+  // negative seconds and seconds beyond 24 hours, ignoring the suffix.
+  const DateTuple tuples[] = {
+    {-1, 12, 31, 86399, kSuffixW},
+    {0, 1, 1, 0, kSuffixW},
+    {1999, 12, 31, 90000, kSuffixW},
+    {2000, 1, 1, -3600, kSuffixW},
+    {2000, 1, 1, 0, kSuffixW},
+    {2000, 1, 1, 3, kSuffixW},
+    {2000, 1, 1, 86400, kSuffixW},
+    {2000, 1, 2, -86399, kSuffixW},
+    {2000, 1, 2, 3, kSuffixW},
+    {2000, 1, 31, 0, kSuffixW},
+    {2000, 2, 1, 0, kSuffixW},
+    {2000, 12, 31, 0, kSuffixW},
+    {10000, 1, 1, 0, kSuffixW},
+  };
+  const uint8_t num = sizeof(tuples) / sizeof(tuples[0]);
+  for (uint8_t i = 0; i < num; i++) {
+    for (uint8_t j = 0; j < num; j++) {
+      assertEqual(tuples[i] < tuples[j],
+          packDateTuple(tuples[i]) < packDateTuple(tuples[j]));
+    }
+  }
+
+  assertEqual(
+      packDateTuple(DateTuple{2000, 1, 2, 3, kSuffixW}),
+      packDateTuple(DateTuple{2000, 1, 2, 3, kSuffixU}));
+}
+
 test(DateTuple, normalizeDateTuple) {
   DateTuple dtp;
 
@@ -124,6 +124,48 @@ test(EpochConverterHinnantTest, allDays) {
 #endif
 }
 
+// Convert one month at a time, which keeps the arrays small enough for the
+// stack of an 8-bit processor, and also exercises the scalar tail of the SIMD
+// kernels since 29, 30 and 31 are not multiples of 4 or 8.
+test(EpochConverterHinnantTest, allDaysBatch) {
+  int16_t years[31];
+  uint8_t months[31];
+  uint8_t days[31];
+  int32_t epochDays[31];
+  int16_t obsYears[31];
+  uint8_t obsMonths[31];
+  uint8_t obsDays[31];
+  int32_t obsEpochDays[31];
+
+  int32_t startOfMonth = startEpochDays;
+  for (int16_t year = startYear; year < untilYear; year++) {
+#if ! defined(EPOXY_DUINO)
+    yield(); // Prevent watch dog timer on ESP8266.
+#endif
+    for (uint8_t month = 1; month <= 12; month++) {
+      uint8_t n = LocalDate::daysInMonth(year, month);
+      for (uint8_t i = 0; i < n; i++) {
+        years[i] = year;
+        months[i] = month;
+        days[i] = i + 1;
+        epochDays[i] = startOfMonth + i;
+      }
+
+      EpochConverterHinnant::toEpochDaysBatch(
+          years, months, days, n, obsEpochDays);
+      EpochConverterHinnant::fromEpochDaysBatch(
+          epochDays, n, obsYears, obsMonths, obsDays);
+      for (uint8_t i = 0; i < n; i++) {
+        assertEqual(epochDays[i], obsEpochDays[i]);
+        assertEqual(years[i], obsYears[i]);
+        assertEqual(months[i], obsMonths[i]);
+        assertEqual(days[i], obsDays[i]);
+      }
+      startOfMonth += n;
+    }
+  }
+}
+
 //---------------------------------------------------------------------------
 
 void setup() {
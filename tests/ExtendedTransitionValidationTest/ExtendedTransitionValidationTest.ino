@@ -67,9 +67,9 @@ class ExtendedTransitionValidation : public aunit::TestOnce {
         }
 
         ExtendedZoneProcessor::Transition** start =
-            zoneProcessor.mTransitionStorage.getActivePoolBegin();
+            zoneProcessor.mCurrentYearSlot->transitionStorage.getActivePoolBegin();
         ExtendedZoneProcessor::Transition** end =
-            zoneProcessor.mTransitionStorage.getActivePoolEnd();
+            zoneProcessor.mCurrentYearSlot->transitionStorage.getActivePoolEnd();
 
         // Verify at least one Transition is created for each zone.
         // Note: (end-start) is supposed to return an integer of type `ssize_t`,
@@ -66,6 +66,54 @@ test(ExtendedZoneManagerTest, createForZoneName) {
   assertTrue(tz == tzn);
 }
 
+test(ExtendedZoneManagerTest, warmUpZoneNames) {
+  // Warm up a fresh cache, since the global one is already in use.
+  ExtendedZoneProcessorCache<1> cache;
+  ExtendedZoneManager manager(
+      kExtendedZoneRegistrySize, kExtendedZoneRegistry, cache);
+  const char* const names[] = {
+    "America/Los_Angeles",
+    "America/Does_Not_Exist",
+  };
+  ZoneWarmUpResult result = manager.warmUpZoneNames(names, 2, 2025, 2026);
+  assertFalse(result.rejected);
+  assertEqual(1, result.numZones);
+  assertEqual(1, result.numNotFound);
+  assertEqual(0, result.numSkipped);
+  assertEqual(1, result.numThreads);
+
+  // The zone is already bound, and its transitions are already calculated.
+  ExtendedZoneProcessor* zoneProcessor =
+      manager.getZoneProcessor("America/Los_Angeles");
+  assertMore(zoneProcessor->getTransitionAllocSize(), (uint8_t) 0);
+  TimeZone tz = manager.createForZoneName("America/Los_Angeles");
+  ZonedDateTime zdt = ZonedDateTime::forComponents(2025, 7, 1, 0, 0, 0, tz);
+  assertEqual(-7 * 60, zdt.timeOffset().toMinutes());
+
+  // Once the cache is in use, another warm up is rejected.
+  result = manager.warmUpZoneNames(names, 1, 2025, 2026);
+  assertTrue(result.rejected);
+  assertEqual(0, result.numZones);
+}
+
+test(ExtendedZoneManagerTest, warmUpZoneIds) {
+  ExtendedZoneProcessorCache<1> cache;
+  ExtendedZoneManager manager(
+      kExtendedZoneRegistrySize, kExtendedZoneRegistry, cache);
+  const uint32_t ids[] = {
+    kZoneIdAmerica_New_York,
+    0x12345678,
+    kZoneIdAmerica_Chicago, // does not fit in the cache
+  };
+  ZoneWarmUpResult result = manager.warmUpZoneIds(ids, 3, 2025, 2026);
+  assertFalse(result.rejected);
+  assertEqual(1, result.numZones);
+  assertEqual(1, result.numNotFound);
+  assertEqual(1, result.numSkipped);
+  assertTrue(manager.getZoneProcessor("America/New_York")
+      ->equalsZoneKey((uintptr_t) &kZoneAmerica_New_York));
+}
+
 test(ExtendedZoneManagerTest, createForZoneId) {
   TimeZone tz = extendedZoneManager.createForZoneInfo(
       &kZoneAmerica_New_York);
@@ -14,6 +14,7 @@ using ace_time::extended::TransitionStorageTemplate;
 using ace_time::extended::YearMonthTuple;
 using ace_time::extended::Info;
 using ace_time::extended::normalizeDateTuple;
+using ace_time::extended::packDateTuple;
 using ace_time::extended::subtractDateTuple;
 using ace_time::testing::EpochYearContext;
 using ace_time::testingzonedbx::kZoneContext;
@@ -339,7 +340,10 @@ test(ExtendedZoneProcessorTest, compareTransitionToMatchFuzzy) {
   #if ACE_TIME_EXTENDED_ZONE_PROCESSOR_DEBUG
     EMPTY_DATE,
   #endif
-    0, 0, 0, {0}, false
+    0, 0, 0, {0}, false,
+  #if ACE_TIME_TRANSITION_SEARCH_KEYS
+    0, 0, 0,
+  #endif
   };
   assertEqual(
       (uint8_t) CompareStatus::kPrior,
@@ -353,7 +357,10 @@ test(ExtendedZoneProcessorTest, compareTransitionToMatchFuzzy) {
   #if ACE_TIME_EXTENDED_ZONE_PROCESSOR_DEBUG
     EMPTY_DATE,
   #endif
-    0, 0, 0, {0}, false
+    0, 0, 0, {0}, false,
+  #if ACE_TIME_TRANSITION_SEARCH_KEYS
+    0, 0, 0,
+  #endif
   };
   assertEqual(
       (uint8_t) CompareStatus::kWithinMatch,
@@ -367,7 +374,10 @@ test(ExtendedZoneProcessorTest, compareTransitionToMatchFuzzy) {
   #if ACE_TIME_EXTENDED_ZONE_PROCESSOR_DEBUG
     EMPTY_DATE,
   #endif
-    0, 0, 0, {0}, false
+    0, 0, 0, {0}, false,
+  #if ACE_TIME_TRANSITION_SEARCH_KEYS
+    0, 0, 0,
+  #endif
   };
   assertEqual(
       (uint8_t) CompareStatus::kWithinMatch,
@@ -381,7 +391,10 @@ test(ExtendedZoneProcessorTest, compareTransitionToMatchFuzzy) {
   #if ACE_TIME_EXTENDED_ZONE_PROCESSOR_DEBUG
     EMPTY_DATE,
   #endif
-    0, 0, 0, {0}, false
+    0, 0, 0, {0}, false,
+  #if ACE_TIME_TRANSITION_SEARCH_KEYS
+    0, 0, 0,
+  #endif
   };
   assertEqual(
       (uint8_t) CompareStatus::kWithinMatch,
@@ -395,7 +408,10 @@ test(ExtendedZoneProcessorTest, compareTransitionToMatchFuzzy) {
   #if ACE_TIME_EXTENDED_ZONE_PROCESSOR_DEBUG
     EMPTY_DATE,
   #endif
-    0, 0, 0, {0}, false
+    0, 0, 0, {0}, false,
+  #if ACE_TIME_TRANSITION_SEARCH_KEYS
+    0, 0, 0,
+  #endif
   };
   assertEqual(
       (uint8_t) CompareStatus::kWithinMatch,
@@ -409,7 +425,10 @@ test(ExtendedZoneProcessorTest, compareTransitionToMatchFuzzy) {
   #if ACE_TIME_EXTENDED_ZONE_PROCESSOR_DEBUG
     EMPTY_DATE,
   #endif
-    0, 0, 0, {0}, false
+    0, 0, 0, {0}, false,
+  #if ACE_TIME_TRANSITION_SEARCH_KEYS
+    0, 0, 0,
+  #endif
   };
   assertEqual(
       (uint8_t) CompareStatus::kFarFuture,
@@ -511,7 +530,10 @@ test(ExtendedZoneProcessorTest, compareTransitionToMatch) {
   #if ACE_TIME_EXTENDED_ZONE_PROCESSOR_DEBUG
     EMPTY_DATE, /* originalTransitionTime */
   #endif
-    0, 0, 0, {0}, false
+    0, 0, 0, {0}, false,
+  #if ACE_TIME_TRANSITION_SEARCH_KEYS
+    0, 0, 0,
+  #endif
   };
 
   // transitionTime = 2000-01-01
@@ -522,7 +544,10 @@ test(ExtendedZoneProcessorTest, compareTransitionToMatch) {
   #if ACE_TIME_EXTENDED_ZONE_PROCESSOR_DEBUG
     EMPTY_DATE,
   #endif
-    0, 0, 0, {0}, false
+    0, 0, 0, {0}, false,
+  #if ACE_TIME_TRANSITION_SEARCH_KEYS
+    0, 0, 0,
+  #endif
   };
 
   // transitionTime = 2000-01-02
@@ -533,7 +558,10 @@ test(ExtendedZoneProcessorTest, compareTransitionToMatch) {
   #if ACE_TIME_EXTENDED_ZONE_PROCESSOR_DEBUG
     EMPTY_DATE,
   #endif
-    0, 0, 0, {0}, false
+    0, 0, 0, {0}, false,
+  #if ACE_TIME_TRANSITION_SEARCH_KEYS
+    0, 0, 0,
+  #endif
   };
 
   // transitionTime = 2001-02-03
@@ -544,7 +572,10 @@ test(ExtendedZoneProcessorTest, compareTransitionToMatch) {
   #if ACE_TIME_EXTENDED_ZONE_PROCESSOR_DEBUG
     EMPTY_DATE,
   #endif
-    0, 0, 0, {0}, false
+    0, 0, 0, {0}, false,
+  #if ACE_TIME_TRANSITION_SEARCH_KEYS
+    0, 0, 0,
+  #endif
   };
 
   ExtendedZoneProcessor::Transition* transitions[] = {
@@ -634,7 +665,10 @@ test(ExtendedZoneProcessorTest, processTransitionCompareStatus) {
   #if ACE_TIME_EXTENDED_ZONE_PROCESSOR_DEBUG
     EMPTY_DATE,
   #endif
-    0, 0, 0, {0}, false
+    0, 0, 0, {0}, false,
+  #if ACE_TIME_TRANSITION_SEARCH_KEYS
+    0, 0, 0,
+  #endif
   };
 
   // This occurs at exactly match.startDateTime, so should replace the prior.
@@ -646,7 +680,10 @@ test(ExtendedZoneProcessorTest, processTransitionCompareStatus) {
   #if ACE_TIME_EXTENDED_ZONE_PROCESSOR_DEBUG
     EMPTY_DATE,
   #endif
-    0, 0, 0, {0}, false
+    0, 0, 0, {0}, false,
+  #if ACE_TIME_TRANSITION_SEARCH_KEYS
+    0, 0, 0,
+  #endif
   };
 
   // An interior transition. Prior should not change.
@@ -658,7 +695,10 @@ test(ExtendedZoneProcessorTest, processTransitionCompareStatus) {
   #if ACE_TIME_EXTENDED_ZONE_PROCESSOR_DEBUG
     EMPTY_DATE,
   #endif
-    0, 0, 0, {0}, false
+    0, 0, 0, {0}, false,
+  #if ACE_TIME_TRANSITION_SEARCH_KEYS
+    0, 0, 0,
+  #endif
   };
 
   // Occurs after match.untilDateTime, so should be rejected.
@@ -670,7 +710,10 @@ test(ExtendedZoneProcessorTest, processTransitionCompareStatus) {
   #if ACE_TIME_EXTENDED_ZONE_PROCESSOR_DEBUG
     EMPTY_DATE,
   #endif
-    0, 0, 0, {0}, false
+    0, 0, 0, {0}, false,
+  #if ACE_TIME_TRANSITION_SEARCH_KEYS
+    0, 0, 0,
+  #endif
   };
 
   ExtendedZoneProcessor::Transition* transitions[] = {
@@ -757,14 +800,14 @@ test(ExtendedZoneProcessorTest, fixTransitionTimes_generateStartUntilTimes) {
   YearMonthTuple untilYm = {2019, 2};
   uint8_t numMatches = ExtendedZoneProcessor::findMatches(
       Info::ZoneInfoBroker(&kZoneAmerica_Los_Angeles), startYm, untilYm,
-      zoneProcessor.mMatches, zoneProcessor.kMaxMatches);
+      zoneProcessor.mYearSlot.matches, zoneProcessor.kMaxMatches);
   assertEqual(1, numMatches);
 
   // Step 2: Create transitions.
-  zoneProcessor.mTransitionStorage.init();
+  zoneProcessor.mYearSlot.transitionStorage.init();
   ExtendedZoneProcessor::createTransitions(
-      zoneProcessor.mTransitionStorage,
-      zoneProcessor.mMatches,
+      zoneProcessor.mYearSlot.transitionStorage,
+      zoneProcessor.mYearSlot.matches,
       numMatches);
 
   // Step 2: Verification: there are 3 transitions:
@@ -772,9 +815,9 @@ test(ExtendedZoneProcessorTest, fixTransitionTimes_generateStartUntilTimes) {
   //  * [2018-03-07, 2018-11-07)
   //  * [2018-11-07, 2019-02-01)
   ExtendedZoneProcessor::Transition** begin =
-      zoneProcessor.mTransitionStorage.getActivePoolBegin();
+      zoneProcessor.mYearSlot.transitionStorage.getActivePoolBegin();
   ExtendedZoneProcessor::Transition** end =
-      zoneProcessor.mTransitionStorage.getActivePoolEnd();
+      zoneProcessor.mYearSlot.transitionStorage.getActivePoolEnd();
   assertEqual(3, (int) (end - begin));
   ExtendedZoneProcessor::Transition* transition0 = begin[0];
   ExtendedZoneProcessor::Transition* transition1 = begin[1];
@@ -840,6 +883,16 @@ test(ExtendedZoneProcessorTest, fixTransitionTimes_generateStartUntilTimes) {
   epochSecs = OffsetDateTime::forComponents(
       2018, 11, 4, 1, 0, 0, TimeOffset::forHours(-8)).toEpochSeconds();
   assertEqual(epochSecs, transition2->startEpochSeconds);
+
+#if ACE_TIME_TRANSITION_SEARCH_KEYS
+  // Step 4: Verification: The packed versions of startDateTime and
+  // untilDateTime are calculated at the same time.
+  for (ExtendedZoneProcessor::Transition** iter = begin; iter != end; ++iter) {
+    const ExtendedZoneProcessor::Transition* t = *iter;
+    assertEqual(packDateTuple(t->startDateTime), t->packedStartDateTime);
+    assertEqual(packDateTuple(t->untilDateTime), t->packedUntilDateTime);
+  }
+#endif
 }
 
 //---------------------------------------------------------------------------
@@ -862,6 +915,309 @@ test(ExtendedZoneProcessorTest, setZoneKey) {
   assertNotEqual(zoneProcessor.mYear, LocalDate::kInvalidYear);
 }
 
+test(ExtendedZoneProcessorTest, multiYear) {
+  ExtendedZoneProcessor singleYear(&kZoneAmerica_Los_Angeles);
+  ExtendedZoneProcessorMultiYear<2> multiYear(&kZoneAmerica_Los_Angeles);
+  assertEqual(1, singleYear.getNumYearSlots());
+  assertEqual(2, multiYear.getNumYearSlots());
+
+  // Alternate between 2 timestamps which straddle the end of the year.
+  acetime_t before = OffsetDateTime::forComponents(2018, 12, 31, 23, 0, 0,
+      TimeOffset()).toEpochSeconds();
+  acetime_t after = OffsetDateTime::forComponents(2019, 1, 1, 1, 0, 0,
+      TimeOffset()).toEpochSeconds();
+  for (int i = 0; i < 3; i++) {
+    FindResult expected = singleYear.findByEpochSeconds(before);
+    FindResult result = multiYear.findByEpochSeconds(before);
+    assertEqual(result.type, expected.type);
+    assertEqual(result.stdOffsetSeconds, expected.stdOffsetSeconds);
+    assertEqual(result.dstOffsetSeconds, expected.dstOffsetSeconds);
+    assertEqual(result.abbrev, expected.abbrev);
+
+    expected = singleYear.findByEpochSeconds(after);
+    result = multiYear.findByEpochSeconds(after);
+    assertEqual(result.type, expected.type);
+    assertEqual(result.stdOffsetSeconds, expected.stdOffsetSeconds);
+    assertEqual(result.dstOffsetSeconds, expected.dstOffsetSeconds);
+    assertEqual(result.abbrev, expected.abbrev);
+  }
+
+  // A third year evicts the least recently used year, 2018.
+  LocalDateTime ldt = LocalDateTime::forComponents(2020, 6, 1, 0, 0, 0);
+  FindResult result = multiYear.findByLocalDateTime(ldt);
+  assertEqual(result.type, FindResult::kTypeExact);
+  assertEqual("PDT", result.abbrev);
+  result = multiYear.findByEpochSeconds(before);
+  assertEqual("PST", result.abbrev);
+
+  // Changing the zone invalidates all years.
+  multiYear.setZoneKey((uintptr_t) &kZoneAustralia_Darwin);
+  result = multiYear.findByEpochSeconds(before);
+  assertEqual("ACST", result.abbrev);
+}
+
+test(ExtendedZoneProcessorTest, findByEpochSeconds_validInterval) {
+  ExtendedZoneProcessor zoneProcessor(&kZoneAmerica_Los_Angeles);
+  ExtendedZoneProcessor reference(&kZoneAmerica_Los_Angeles);
+
+  // 2018-11-04 01:00 PST, the end of the fall-back overlap.
+  acetime_t fallBack = OffsetDateTime::forComponents(2018, 11, 4, 1, 0, 0,
+      TimeOffset::forHours(-8)).toEpochSeconds();
+  // 2019-03-10 02:00 PST, spring forward.
+  acetime_t springForward = OffsetDateTime::forComponents(2019, 3, 10, 2, 0,
+      0, TimeOffset::forHours(-8)).toEpochSeconds();
+
+  // Walk through the overlap shadows, and across the year boundary, in 15
+  // minute steps. The results must be the same as a fresh search.
+  for (acetime_t t = fallBack - 7200; t < springForward + 7200; t += 900) {
+    FindResult expected = reference.findByEpochSeconds(t);
+    reference.setZoneKey((uintptr_t) &kZoneAustralia_Darwin);
+    reference.setZoneKey((uintptr_t) &kZoneAmerica_Los_Angeles);
+    FindResult result = zoneProcessor.findByEpochSeconds(t);
+    assertEqual(expected.type, result.type);
+    assertEqual(expected.fold, result.fold);
+    assertEqual(expected.stdOffsetSeconds, result.stdOffsetSeconds);
+    assertEqual(expected.dstOffsetSeconds, result.dstOffsetSeconds);
+    assertEqual(expected.reqStdOffsetSeconds, result.reqStdOffsetSeconds);
+    assertEqual(expected.reqDstOffsetSeconds, result.reqDstOffsetSeconds);
+    assertEqual(expected.abbrev, result.abbrev);
+  }
+
+  // Changing the zone invalidates the interval.
+  zoneProcessor.setZoneKey((uintptr_t) &kZoneAustralia_Darwin);
+  FindResult result = zoneProcessor.findByEpochSeconds(springForward);
+  assertEqual((int32_t) (9*3600 + 1800), result.stdOffsetSeconds);
+  assertEqual("ACST", result.abbrev);
+}
+
+test(ExtendedZoneProcessorTest, findByEpochSecondsBatch) {
+  ExtendedZoneProcessor zoneProcessor(&kZoneAmerica_Los_Angeles);
+  ExtendedZoneProcessor reference(&kZoneAmerica_Los_Angeles);
+
+  // Sorted within 2018 across the fall-back overlap, then across the year
+  // boundary, then backwards (unsorted), then an invalid value.
+  acetime_t fallBack = OffsetDateTime::forComponents(2018, 11, 4, 1, 30, 0,
+      TimeOffset::forHours(-7)).toEpochSeconds();
+  acetime_t newYear = OffsetDateTime::forComponents(2019, 1, 1, 0, 0, 0,
+      TimeOffset()).toEpochSeconds();
+  const acetime_t epochSeconds[] = {
+    fallBack - 3600,
+    fallBack,
+    fallBack + 3600,
+    fallBack + 2 * 3600,
+    newYear - 1,
+    newYear,
+    newYear + 86400 * 100,
+    fallBack,
+    LocalDate::kInvalidEpochSeconds,
+  };
+  const size_t num = sizeof(epochSeconds) / sizeof(epochSeconds[0]);
+  FindResult results[num];
+  zoneProcessor.findByEpochSecondsBatch(epochSeconds, results, num);
+
+  for (size_t i = 0; i < num; i++) {
+    FindResult expected = reference.findByEpochSeconds(epochSeconds[i]);
+    assertEqual(expected.type, results[i].type);
+    assertEqual(expected.fold, results[i].fold);
+    assertEqual(expected.stdOffsetSeconds, results[i].stdOffsetSeconds);
+    assertEqual(expected.dstOffsetSeconds, results[i].dstOffsetSeconds);
+    assertEqual(expected.reqStdOffsetSeconds, results[i].reqStdOffsetSeconds);
+    assertEqual(expected.reqDstOffsetSeconds, results[i].reqDstOffsetSeconds);
+    if (expected.type != FindResult::kTypeNotFound) {
+      assertEqual(expected.abbrev, results[i].abbrev);
+    }
+  }
+
+  // Spot check the overlap.
+  assertEqual(FindResult::kTypeOverlap, results[1].type);
+  assertEqual(0, results[1].fold);
+  assertEqual(FindResult::kTypeOverlap, results[2].type);
+  assertEqual(1, results[2].fold);
+  assertEqual(FindResult::kTypeNotFound, results[8].type);
+}
+
+test(ExtendedZoneProcessorTest, findByEpochSecondsBatch_chunks) {
+  ExtendedZoneProcessor zoneProcessor(&kZoneAmerica_Los_Angeles);
+  ExtendedZoneProcessor reference(&kZoneAmerica_Los_Angeles);
+
+  // One element every 10 days across 2018 and 2019, converted in chunks of
+  // 3 elements. Each chunk resumes the walk where the previous one stopped.
+  acetime_t start = OffsetDateTime::forComponents(2018, 1, 1, 0, 0, 0,
+      TimeOffset()).toEpochSeconds();
+  const size_t num = 73;
+  acetime_t epochSeconds[num];
+  for (size_t i = 0; i < num; i++) {
+    epochSeconds[i] = start + (acetime_t) i * 86400 * 10;
+  }
+  FindResult results[num];
+  for (size_t i = 0; i < num; i += 3) {
+    size_t n = (num - i < 3) ? num - i : 3;
+    zoneProcessor.findByEpochSecondsBatch(epochSeconds + i, results + i, n);
+  }
+
+  for (size_t i = 0; i < num; i++) {
+    FindResult expected = reference.findByEpochSeconds(epochSeconds[i]);
+    assertEqual(expected.type, results[i].type);
+    assertEqual(expected.stdOffsetSeconds, results[i].stdOffsetSeconds);
+    assertEqual(expected.dstOffsetSeconds, results[i].dstOffsetSeconds);
+    assertEqual(expected.abbrev, results[i].abbrev);
+  }
+}
+
+test(ExtendedZoneProcessorTest, transitions) {
+  ExtendedZoneProcessor zoneProcessor(&kZoneAmerica_Los_Angeles);
+  ExtendedZoneProcessor reference(&kZoneAmerica_Los_Angeles);
+  acetime_t startSeconds = LocalDate::forComponents(2000, 1, 1)
+      .toEpochSeconds();
+  acetime_t untilSeconds = LocalDate::forComponents(2020, 1, 1)
+      .toEpochSeconds();
+
+  // 2 transitions per year.
+  uint16_t count = 0;
+  acetime_t prevSeconds = startSeconds;
+  for (const ZoneTransition& t : zoneProcessor.transitions(2000, 2020)) {
+    assertLess(prevSeconds, t.epochSeconds);
+    assertLess(t.epochSeconds, untilSeconds);
+    assertEqual(
+        t.epochSeconds + Epoch::secondsToCurrentEpochFromUnixEpoch64(),
+        t.unixSeconds);
+
+    // The offsets match findByEpochSeconds() on both sides.
+    FindResult before = reference.findByEpochSeconds(t.epochSeconds - 1);
+    FindResult after = reference.findByEpochSeconds(t.epochSeconds);
+    assertEqual(before.stdOffsetSeconds, t.stdOffsetSecondsBefore);
+    assertEqual(before.dstOffsetSeconds, t.dstOffsetSecondsBefore);
+    assertEqual(after.stdOffsetSeconds, t.stdOffsetSecondsAfter);
+    assertEqual(after.dstOffsetSeconds, t.dstOffsetSecondsAfter);
+    assertEqual(after.abbrev, t.abbrevAfter);
+
+    prevSeconds = t.epochSeconds;
+    count++;
+  }
+  assertEqual(40, count);
+
+  // Empty ranges.
+  ZoneTransitionRange range = zoneProcessor.transitions(2020, 2020);
+  assertTrue(range.begin() == range.end());
+  zoneProcessor.setZoneKey((uintptr_t) &kZoneAustralia_Darwin);
+  range = zoneProcessor.transitions(2000, 2020);
+  assertTrue(range.begin() == range.end());
+
+  // Processors without findNextTransition() return an empty range.
+  BasicZoneProcessor basicZoneProcessor;
+  range = basicZoneProcessor.transitions(2000, 2020);
+  assertTrue(range.begin() == range.end());
+}
+
+// The years outside of the current epoch [2000, 2100) are iterated using the
+// 64-bit unixSeconds.
+test(ExtendedZoneProcessorTest, transitions_allYears) {
+  ExtendedZoneProcessor zoneProcessor(&kZoneAmerica_Los_Angeles);
+  ExtendedZoneProcessor reference(&kZoneAmerica_Los_Angeles);
+  int64_t startSeconds = LocalDate::forComponents(1900, 1, 1)
+      .toUnixSeconds64();
+  int64_t untilSeconds = LocalDate::forComponents(2100, 1, 1)
+      .toUnixSeconds64();
+
+  uint16_t count = 0;
+  uint16_t numInEpoch = 0;
+  int64_t prevSeconds = startSeconds;
+  for (const ZoneTransition& t : zoneProcessor.transitions(1900, 2100)) {
+    assertFalse(t.isError());
+    assertLess(prevSeconds, t.unixSeconds);
+    assertLess(t.unixSeconds, untilSeconds);
+
+    // The offsets match findByUnixSeconds64() on both sides.
+    FindResult before = reference.findByUnixSeconds64(t.unixSeconds - 1);
+    FindResult after = reference.findByUnixSeconds64(t.unixSeconds);
+    assertEqual(before.stdOffsetSeconds, t.stdOffsetSecondsBefore);
+    assertEqual(before.dstOffsetSeconds, t.dstOffsetSecondsBefore);
+    assertEqual(after.stdOffsetSeconds, t.stdOffsetSecondsAfter);
+    assertEqual(after.dstOffsetSeconds, t.dstOffsetSecondsAfter);
+
+    // The epochSeconds is set only within the range of the epoch.
+    if (t.epochSeconds != LocalDate::kInvalidEpochSeconds) {
+      numInEpoch++;
+      assertEqual(
+          t.epochSeconds + Epoch::secondsToCurrentEpochFromUnixEpoch64(),
+          t.unixSeconds);
+    }
+
+    prevSeconds = t.unixSeconds;
+    count++;
+  }
+  // 2 per year in [1975, 2100) of the test zonedbx. The 32-bit epochSeconds
+  // of the 2050 epoch cannot represent the 14 transitions before 1982.
+  assertEqual(250, count);
+  assertEqual(236, numInEpoch);
+
+  // The same transitions as findNextTransition() within the epoch.
+  acetime_t epochSeconds = LocalDate::forComponents(2000, 1, 1)
+      .toEpochSeconds() - 1;
+  for (const ZoneTransition& t : zoneProcessor.transitions(2000, 2100)) {
+    ZoneTransition expected = reference.findNextTransition(epochSeconds);
+    assertEqual(expected.unixSeconds, t.unixSeconds);
+    assertEqual(expected.epochSeconds, t.epochSeconds);
+    epochSeconds = t.epochSeconds;
+  }
+  assertTrue(reference.findNextTransition(epochSeconds).isError());
+}
+
+// findNextTransition() and findPrevTransition() must not evict the year that
+// was loaded by the caller.
+test(ExtendedZoneProcessorTest, findNextTransition_yearCache) {
+  ExtendedZoneProcessor zoneProcessor(&kZoneAmerica_Los_Angeles);
+  ExtendedZoneProcessor reference(&kZoneAmerica_Los_Angeles);
+  zoneProcessor.initForYear(2010);
+  assertEqual(2010, zoneProcessor.mYear);
+
+  // 2015-03-08 02:00 PST, 2015-11-01 02:00 PDT
+  acetime_t seconds = LocalDate::forComponents(2015, 6, 1).toEpochSeconds();
+  ZoneTransition next = zoneProcessor.findNextTransition(seconds);
+  ZoneTransition prev = zoneProcessor.findPrevTransition(seconds);
+
+  // The year is loaded into the single YearSlot, instead of a temporary
+  // YearSlot on the stack.
+  assertEqual(2015, zoneProcessor.mYear);
+  assertTrue(zoneProcessor.isFilled(2015));
+
+  assertEqual(
+      LocalDateTime::forComponents(2015, 11, 1, 9, 0, 0).toEpochSeconds(),
+      next.epochSeconds);
+  assertEqual(
+      LocalDateTime::forComponents(2015, 3, 8, 10, 0, 0).toEpochSeconds(),
+      prev.epochSeconds);
+  FindResult after = reference.findByEpochSeconds(next.epochSeconds);
+  assertEqual(after.stdOffsetSeconds, next.stdOffsetSecondsAfter);
+  assertEqual(after.dstOffsetSeconds, next.dstOffsetSecondsAfter);
+  after = reference.findByEpochSeconds(prev.epochSeconds);
+  assertEqual(after.dstOffsetSeconds, prev.dstOffsetSecondsAfter);
+
+  // Walking many years leaves a cache which still answers correctly.
+  for (int16_t year = 2001; year < 2099; year++) {
+    seconds = LocalDate::forComponents(year, 6, 1).toEpochSeconds();
+    assertFalse(zoneProcessor.findNextTransition(seconds).isError());
+  }
+  seconds = LocalDate::forComponents(2010, 1, 1).toEpochSeconds();
+  FindResult result = zoneProcessor.findByEpochSeconds(seconds);
+  FindResult expected = reference.findByEpochSeconds(seconds);
+  assertEqual(expected.stdOffsetSeconds, result.stdOffsetSeconds);
+  assertEqual(expected.dstOffsetSeconds, result.dstOffsetSeconds);
+}
+
+test(ExtendedZoneProcessorTest, findNextTransition_multiYear) {
+  // A MultiYear processor keeps the year of the previous lookup when the
+  // search needs only one other year.
+  ExtendedZoneProcessorMultiYear<2> zoneProcessor(&kZoneAmerica_Los_Angeles);
+  const ExtendedZoneProcessor& base = zoneProcessor;
+  int16_t epochYear = Epoch::currentEpochYear();
+  zoneProcessor.initForYear(2010);
+  acetime_t seconds = LocalDate::forComponents(2015, 6, 1).toEpochSeconds();
+  assertFalse(zoneProcessor.findNextTransition(seconds).isError());
+  assertTrue(base.findYearSlot(2015, epochYear) != nullptr);
+  assertTrue(base.findYearSlot(2010, epochYear) != nullptr);
+}
+
 test(ExtendedZoneProcessorTest, printNameTo) {
   ExtendedZoneProcessor zoneProcessor(&kZoneAmerica_Los_Angeles);
   PrintStr<32> printStr;
@@ -1013,6 +1369,36 @@ test(ExtendedZoneProcessorTest, findByEpochSeconds_outOfBounds) {
   assertEqual(result.type, FindResult::kTypeNotFound);
 }
 
+// The 64-bit findByUnixSeconds64() generates Transitions for years which are
+// too far from the epoch for the 32-bit startEpochSeconds.
+test(ExtendedZoneProcessorTest, findByUnixSeconds64_outOfBounds) {
+  EpochYearContext context(2000); // epoch to 2000 temporarily
+  ExtendedZoneProcessor zoneProcessor(&kZoneAmerica_Los_Angeles);
+
+  // 2150-03-08 03:00 PDT is the spring forward of 2150.
+  int64_t unixSeconds = OffsetDateTime::forComponents(
+      2150, 3, 8, 3, 0, 0, TimeOffset::forHours(-7)).toUnixSeconds64();
+  FindResult result = zoneProcessor.findByUnixSeconds64(unixSeconds);
+  assertEqual(result.type, FindResult::kTypeExact);
+  assertEqual(-7 * 3600, result.stdOffsetSeconds + result.dstOffsetSeconds);
+  result = zoneProcessor.findByUnixSeconds64(unixSeconds - 1);
+  assertEqual(-8 * 3600, result.stdOffsetSeconds + result.dstOffsetSeconds);
+
+  // The startEpochSeconds is clamped, but startUnixSeconds64() is exact.
+  const ExtendedZoneProcessor::Transition* const* begin =
+      zoneProcessor.getActiveTransitionsBegin();
+  const ExtendedZoneProcessor::Transition* const* end =
+      zoneProcessor.getActiveTransitionsEnd();
+  bool found = false;
+  for (const ExtendedZoneProcessor::Transition* const* iter = begin;
+      iter != end; ++iter) {
+    const ExtendedZoneProcessor::Transition* t = *iter;
+    assertEqual(LocalDate::kMaxEpochSeconds, t->startEpochSeconds);
+    if (t->startUnixSeconds64() == unixSeconds) found = true;
+  }
+  assertTrue(found);
+}
+
 //---------------------------------------------------------------------------
 
 // Test that getOffsetDateTime(const LocalDateTime&) handles fold parameter
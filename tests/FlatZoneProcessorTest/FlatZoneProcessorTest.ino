@@ -0,0 +1,279 @@
+#line 2 "FlatZoneProcessorTest.ino"
+
+#include <AUnitVerbose.h>
+#include <AceCommon.h> // PrintStr<>
+#include <AceTime.h>
+#include <ace_time/testing/EpochYearContext.h>
+#include <testingzonedbx/zone_infos.h>
+#include <testingzonedbx/zone_registry.h>
+
+using ace_common::PrintStr;
+using namespace ace_time;
+using ace_time::testing::EpochYearContext;
+using ace_time::testingzonedbx::kZoneAmerica_Los_Angeles;
+using ace_time::testingzonedbx::kZoneAustralia_Darwin;
+using ace_time::testingzonedbx::kZonePacific_Apia;
+using ace_time::testingzonedbx::kZoneRegistry;
+using ace_time::testingzonedbx::kZoneRegistrySize;
+
+//---------------------------------------------------------------------------
+
+test(FlatZoneProcessorTest, initTransitions) {
+  FlatZoneProcessor zoneProcessor(&kZoneAmerica_Los_Angeles, 2000, 2010);
+  assertTrue(zoneProcessor.initTransitions());
+
+  // 1 transition at the start of the range, followed by 2 per year.
+  assertEqual(21, zoneProcessor.getNumTransitions());
+  assertEqual(2, zoneProcessor.getNumAbbrevs());
+
+  // Transitions are strictly increasing and always change something.
+  for (uint16_t i = 1; i < zoneProcessor.mNumTransitions; i++) {
+    const flat::FlatTransition& prev = zoneProcessor.mTransitions[i - 1];
+    const flat::FlatTransition& curr = zoneProcessor.mTransitions[i];
+    assertLess(prev.startEpochSeconds, curr.startEpochSeconds);
+    assertTrue(prev.abbrevIndex != curr.abbrevIndex
+        || prev.dstOffsetSeconds != curr.dstOffsetSeconds
+        || prev.stdOffsetSeconds != curr.stdOffsetSeconds);
+  }
+}
+
+// A table with room for only 5 transitions, to test the truncation.
+class SmallFlatZoneProcessor: public FlatZoneProcessorTemplate<
+    ExtendedZoneProcessor, 5 /*SIZE*/, 2 /*NUM_ABBREVS*/> {
+  public:
+    explicit SmallFlatZoneProcessor(
+        const extended::Info::ZoneInfo* zoneInfo,
+        int16_t startYear,
+        int16_t untilYear)
+      : FlatZoneProcessorTemplate(
+          FlatZoneProcessor::kTypeFlat, (uintptr_t) zoneInfo,
+          startYear, untilYear)
+    {}
+};
+
+test(FlatZoneProcessorTest, isTruncated) {
+  FlatZoneProcessor zoneProcessor(&kZoneAmerica_Los_Angeles, 2000, 2010);
+  assertFalse(zoneProcessor.isTruncated());
+  assertEqual(LocalDate::forComponents(2010, 1, 1).toEpochSeconds(),
+      zoneProcessor.getUntilEpochSeconds());
+
+  // The anchor transition at the start of 2000, then 2 per year. The table
+  // fills up with the transitions of 2001, so it ends at 2002-04-07 10:00 UTC
+  // when DST starts.
+  SmallFlatZoneProcessor smallProcessor(&kZoneAmerica_Los_Angeles, 2000, 2010);
+  assertTrue(smallProcessor.isTruncated());
+  assertEqual(5, smallProcessor.getNumTransitions());
+  acetime_t untilEpochSeconds =
+      LocalDateTime::forComponents(2002, 4, 7, 10, 0, 0).toEpochSeconds();
+  assertEqual(untilEpochSeconds, smallProcessor.getUntilEpochSeconds());
+  assertEqual(FindResult::kTypeExact,
+      smallProcessor.findByEpochSeconds(untilEpochSeconds - 1).type);
+  assertEqual(FindResult::kTypeNotFound,
+      smallProcessor.findByEpochSeconds(untilEpochSeconds).type);
+
+  // A shorter year range fits into the small table.
+  SmallFlatZoneProcessor shortProcessor(&kZoneAmerica_Los_Angeles, 2000, 2002);
+  assertFalse(shortProcessor.isTruncated());
+  assertEqual(5, shortProcessor.getNumTransitions());
+}
+
+test(FlatZoneProcessorTest, setZoneKey) {
+  FlatZoneProcessor zoneProcessor(&kZoneAmerica_Los_Angeles);
+  assertTrue(zoneProcessor.getNumTransitions() > 0);
+  assertTrue(zoneProcessor.equalsZoneKey((uintptr_t) &kZoneAmerica_Los_Angeles));
+
+  // Darwin has no DST, so a single transition covers the entire range.
+  zoneProcessor.setZoneKey((uintptr_t) &kZoneAustralia_Darwin);
+  assertTrue(zoneProcessor.equalsZoneKey((uintptr_t) &kZoneAustralia_Darwin));
+  assertEqual(1, zoneProcessor.getNumTransitions());
+
+  PrintStr<32> printStr;
+  zoneProcessor.printNameTo(printStr);
+  assertEqual(F("Australia/Darwin"), printStr.cstr());
+}
+
+// Compare findByEpochSeconds() against ExtendedZoneProcessor every 3 hours,
+// and at each transition, for all zones in the testing registry.
+test(FlatZoneProcessorTest, findByEpochSeconds) {
+  ExtendedZoneProcessor extendedProcessor;
+  FlatZoneProcessor flatProcessor(nullptr, 2000, 2050);
+  acetime_t startSeconds = LocalDate::forComponents(2000, 1, 1)
+      .toEpochSeconds();
+  acetime_t untilSeconds = LocalDate::forComponents(2050, 1, 1)
+      .toEpochSeconds();
+
+  for (uint16_t i = 0; i < kZoneRegistrySize; i++) {
+    extendedProcessor.setZoneKey((uintptr_t) kZoneRegistry[i]);
+    flatProcessor.setZoneKey((uintptr_t) kZoneRegistry[i]);
+    assertTrue(flatProcessor.getNumTransitions() > 0);
+
+    for (acetime_t t = startSeconds; t < untilSeconds; t += 3 * 3600) {
+      FindResult expected = extendedProcessor.findByEpochSeconds(t);
+      FindResult result = flatProcessor.findByEpochSeconds(t);
+      assertEqual(expected.type, result.type);
+      assertEqual(expected.fold, result.fold);
+      assertEqual(expected.stdOffsetSeconds, result.stdOffsetSeconds);
+      assertEqual(expected.dstOffsetSeconds, result.dstOffsetSeconds);
+      assertEqual(expected.abbrev, result.abbrev);
+    }
+
+    for (uint16_t j = 1; j < flatProcessor.getNumTransitions(); j++) {
+      FindResult expected;
+      FindResult result;
+      acetime_t t = flatProcessor.mTransitions[j].startEpochSeconds;
+      for (acetime_t s = t - 3601; s <= t + 3601; s += 1800) {
+        expected = extendedProcessor.findByEpochSeconds(s);
+        result = flatProcessor.findByEpochSeconds(s);
+        assertEqual(expected.type, result.type);
+        assertEqual(expected.fold, result.fold);
+        assertEqual(expected.stdOffsetSeconds, result.stdOffsetSeconds);
+        assertEqual(expected.dstOffsetSeconds, result.dstOffsetSeconds);
+      }
+    }
+  }
+}
+
+// Walk the transitions of ExtendedZoneProcessor using findNextTransition(),
+// and compare against the table, and against findPrevTransition().
+test(FlatZoneProcessorTest, findNextTransition) {
+  ExtendedZoneProcessor extendedProcessor;
+  FlatZoneProcessor flatProcessor(nullptr, 2000, 2050);
+  acetime_t startSeconds = LocalDate::forComponents(2000, 1, 1)
+      .toEpochSeconds();
+  acetime_t untilSeconds = LocalDate::forComponents(2050, 1, 1)
+      .toEpochSeconds();
+
+  for (uint16_t i = 0; i < kZoneRegistrySize; i++) {
+    extendedProcessor.setZoneKey((uintptr_t) kZoneRegistry[i]);
+    flatProcessor.setZoneKey((uintptr_t) kZoneRegistry[i]);
+
+    uint16_t j = 1;
+    acetime_t t = startSeconds;
+    while (true) {
+      ZoneTransition expected = extendedProcessor.findNextTransition(t);
+      if (expected.isError() || expected.epochSeconds >= untilSeconds) break;
+      ZoneTransition result = flatProcessor.findNextTransition(t);
+      assertFalse(result.isError());
+      assertEqual(expected.epochSeconds, result.epochSeconds);
+      assertEqual(expected.epochSeconds,
+          flatProcessor.mTransitions[j].startEpochSeconds);
+      assertEqual(expected.stdOffsetSecondsBefore,
+          result.stdOffsetSecondsBefore);
+      assertEqual(expected.dstOffsetSecondsBefore,
+          result.dstOffsetSecondsBefore);
+      assertEqual(expected.stdOffsetSecondsAfter, result.stdOffsetSecondsAfter);
+      assertEqual(expected.dstOffsetSecondsAfter, result.dstOffsetSecondsAfter);
+      assertEqual(expected.abbrevBefore, result.abbrevBefore);
+      assertEqual(expected.abbrevAfter, result.abbrevAfter);
+
+      // The transition is its own previous transition.
+      t = expected.epochSeconds;
+      assertEqual(t, extendedProcessor.findPrevTransition(t).epochSeconds);
+      assertEqual(t, flatProcessor.findPrevTransition(t).epochSeconds);
+      j++;
+    }
+    assertEqual(j, flatProcessor.getNumTransitions());
+    assertTrue(flatProcessor.findNextTransition(t).isError());
+  }
+}
+
+test(FlatZoneProcessorTest, findByEpochSeconds_outOfBounds) {
+  FlatZoneProcessor zoneProcessor(&kZoneAmerica_Los_Angeles, 2000, 2010);
+  acetime_t before = LocalDate::forComponents(1999, 1, 1).toEpochSeconds();
+  acetime_t after = LocalDate::forComponents(2010, 1, 1).toEpochSeconds();
+  assertEqual(FindResult::kTypeNotFound,
+      zoneProcessor.findByEpochSeconds(before).type);
+  assertEqual(FindResult::kTypeNotFound,
+      zoneProcessor.findByEpochSeconds(after).type);
+  assertEqual(FindResult::kTypeExact,
+      zoneProcessor.findByEpochSeconds(after - 1).type);
+  assertEqual(FindResult::kTypeNotFound,
+      zoneProcessor.findByEpochSeconds(LocalDate::kInvalidEpochSeconds).type);
+}
+
+// Pacific/Apia abolished DST with a "fall back" in April 2021. A lookup near
+// the end of the table is more than 68 years after that last transition, so
+// the overlap check must not overflow the 32-bit difference of epochSeconds.
+test(FlatZoneProcessorTest, findByEpochSeconds_farFromTransition) {
+  FlatZoneProcessor zoneProcessor(&kZonePacific_Apia);
+  acetime_t epochSeconds = LocalDate::forComponents(2099, 12, 1)
+      .toEpochSeconds();
+  FindResult result = zoneProcessor.findByEpochSeconds(epochSeconds);
+  assertEqual(FindResult::kTypeExact, result.type);
+  assertEqual(0, result.fold);
+  assertEqual(13 * 3600, result.stdOffsetSeconds + result.dstOffsetSeconds);
+}
+
+// Compare findByLocalDateTime() against ExtendedZoneProcessor around the
+// gaps and overlaps of America/Los_Angeles, using both fold=0 and fold=1.
+test(FlatZoneProcessorTest, findByLocalDateTime) {
+  ExtendedZoneProcessor extendedProcessor(&kZoneAmerica_Los_Angeles);
+  FlatZoneProcessor flatProcessor(&kZoneAmerica_Los_Angeles, 2000, 2050);
+
+  for (int16_t year = 2001; year < 2049; year++) {
+    for (uint8_t month = 1; month <= 12; month++) {
+      for (uint8_t day = 1; day <= 28; day++) {
+        for (uint8_t hour = 0; hour < 4; hour++) {
+          for (uint8_t fold = 0; fold < 2; fold++) {
+            LocalDateTime ldt = LocalDateTime::forComponents(
+                year, month, day, hour, 30, 0, fold);
+            FindResult expected = extendedProcessor.findByLocalDateTime(ldt);
+            FindResult result = flatProcessor.findByLocalDateTime(ldt);
+            assertEqual(expected.type, result.type);
+            assertEqual(expected.fold, result.fold);
+            assertEqual(expected.stdOffsetSeconds, result.stdOffsetSeconds);
+            assertEqual(expected.dstOffsetSeconds, result.dstOffsetSeconds);
+            assertEqual(
+                expected.reqStdOffsetSeconds, result.reqStdOffsetSeconds);
+            assertEqual(
+                expected.reqDstOffsetSeconds, result.reqDstOffsetSeconds);
+            assertEqual(expected.abbrev, result.abbrev);
+          }
+        }
+      }
+    }
+  }
+}
+
+test(FlatZoneProcessorTest, epochYearChange) {
+  FlatZoneProcessor zoneProcessor(&kZoneAmerica_Los_Angeles);
+  LocalDateTime ldt = LocalDateTime::forComponents(2018, 6, 1, 0, 0, 0);
+  FindResult result = zoneProcessor.findByLocalDateTime(ldt);
+  assertEqual(FindResult::kTypeExact, result.type);
+  assertEqual("PDT", result.abbrev);
+
+  // Changing the current epoch year recalculates the table.
+  EpochYearContext context(2100);
+  ldt = LocalDateTime::forComponents(2118, 1, 1, 0, 0, 0);
+  result = zoneProcessor.findByLocalDateTime(ldt);
+  assertEqual(FindResult::kTypeExact, result.type);
+  assertEqual("PST", result.abbrev);
+}
+
+test(FlatZoneProcessorTest, timeZone) {
+  FlatZoneProcessor zoneProcessor;
+  TimeZone tz = TimeZone::forZoneInfo(&kZoneAmerica_Los_Angeles,
+      &zoneProcessor);
+  ZonedDateTime zdt = ZonedDateTime::forComponents(2018, 11, 4, 1, 30, 0, tz);
+  assertEqual(-7*60, zdt.timeOffset().toMinutes());
+  zdt = ZonedDateTime::forEpochSeconds(zdt.toEpochSeconds() + 3600, tz);
+  assertEqual(-8*60, zdt.timeOffset().toMinutes());
+  assertEqual(1, zdt.fold());
+}
+
+//---------------------------------------------------------------------------
+
+void setup() {
+#if ! defined(EPOXY_DUINO)
+  delay(1000); // wait to prevent garbage on SERIAL_PORT_MONITOR
+#endif
+  SERIAL_PORT_MONITOR.begin(115200);
+  while (!SERIAL_PORT_MONITOR); // Leonardo/Micro
+#if defined(EPOXY_DUINO)
+  SERIAL_PORT_MONITOR.setLineModeUnix();
+#endif
+}
+
+void loop() {
+  aunit::TestRunner::run();
+}
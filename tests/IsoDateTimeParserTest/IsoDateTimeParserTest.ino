@@ -0,0 +1,251 @@
+#line 2 "IsoDateTimeParserTest.ino"
+
+#include <string.h>
+#include <AUnit.h>
+#include <AceTime.h>
+
+using namespace ace_time;
+
+static uint8_t parse(IsoDateTimeParser& parser, const char* s) {
+  return parser.parse(s, strlen(s));
+}
+
+//---------------------------------------------------------------------------
+
+test(IsoDateTimeParserTest, parse) {
+  IsoDateTimeParser parser;
+
+  assertEqual(IsoDateTimeParser::kStatusOk,
+      parse(parser, "2018-08-31T13:48:01-07:00"));
+  assertEqual((size_t) 25, parser.position());
+  auto expected = OffsetDateTime::forComponents(2018, 8, 31, 13, 48, 1,
+      TimeOffset::forHours(-7));
+  assertTrue(expected == parser.dateTime());
+  assertEqual((uint32_t) 0, parser.nanos());
+
+  assertEqual(IsoDateTimeParser::kStatusOk,
+      parse(parser, "0001-01-01 00:00:00Z"));
+  assertEqual((size_t) 20, parser.position());
+  expected = OffsetDateTime::forComponents(1, 1, 1, 0, 0, 0, TimeOffset());
+  assertTrue(expected == parser.dateTime());
+
+  assertEqual(IsoDateTimeParser::kStatusOk,
+      parse(parser, "9999-12-31t23:59:59+14:00"));
+  expected = OffsetDateTime::forComponents(9999, 12, 31, 23, 59, 59,
+      TimeOffset::forHours(14));
+  assertTrue(expected == parser.dateTime());
+
+  // Offset with seconds, and trailing characters which are not examined.
+  assertEqual(IsoDateTimeParser::kStatusOk,
+      parse(parser, "1883-11-18T12:07:01-07:52:58 more"));
+  assertEqual((size_t) 28, parser.position());
+  assertEqual((int32_t) -(7*3600 + 52*60 + 58),
+      parser.dateTime().timeOffset().toSeconds());
+
+  // Leap day
+  assertEqual(IsoDateTimeParser::kStatusOk,
+      parse(parser, "2000-02-29T00:00:00Z"));
+}
+
+test(IsoDateTimeParserTest, parse_formatTo_roundTrip) {
+  IsoDateTimeParser parser;
+  char buf[OffsetDateTime::kFormatBufferSize];
+  for (int32_t seconds = -1000000000; seconds < 1000000000;
+      seconds += 12345679) {
+    auto dt = OffsetDateTime::forEpochSeconds(seconds,
+        TimeOffset::forMinutes((seconds / 7) % (14 * 60)));
+    size_t len = dt.formatTo(buf, sizeof(buf));
+    assertEqual(IsoDateTimeParser::kStatusOk, parser.parse(buf, len));
+    assertEqual(len, parser.position());
+    assertTrue(dt == parser.dateTime());
+  }
+}
+
+test(IsoDateTimeParserTest, fraction) {
+  IsoDateTimeParser strict;
+  assertEqual(IsoDateTimeParser::kStatusBadOffset,
+      parse(strict, "2018-08-31T13:48:01.5Z"));
+  assertEqual((size_t) 19, strict.position());
+
+  IsoDateTimeParser parser(true /*allowFraction*/);
+  assertEqual(IsoDateTimeParser::kStatusOk,
+      parse(parser, "2018-08-31T13:48:01.5Z"));
+  assertEqual((uint32_t) 500000000, parser.nanos());
+  assertEqual((size_t) 22, parser.position());
+
+  assertEqual(IsoDateTimeParser::kStatusOk,
+      parse(parser, "2018-08-31T13:48:01,123456789123+01:00"));
+  assertEqual((uint32_t) 123456789, parser.nanos());
+  assertEqual(1, parser.dateTime().second());
+
+  assertEqual(IsoDateTimeParser::kStatusBadDigit,
+      parse(parser, "2018-08-31T13:48:01.Z"));
+  assertEqual((size_t) 20, parser.position());
+  assertEqual(IsoDateTimeParser::kStatusTooShort,
+      parse(parser, "2018-08-31T13:48:01.001"));
+  assertEqual((size_t) 23, parser.position());
+}
+
+test(IsoDateTimeParserTest, errors) {
+  IsoDateTimeParser parser;
+
+  assertEqual(IsoDateTimeParser::kStatusTooShort, parse(parser, "2018-08-3"));
+  assertEqual((size_t) 9, parser.position());
+  assertTrue(parser.dateTime().isError());
+  assertEqual(IsoDateTimeParser::kStatusBadSeparator,
+      parse(parser, "2018/08-3"));
+  assertEqual((size_t) 4, parser.position());
+  assertEqual(IsoDateTimeParser::kStatusBadDigit, parse(parser, "2018-0x"));
+  assertEqual((size_t) 6, parser.position());
+
+  // Errors in each of the 3 words, the first error is reported.
+  assertEqual(IsoDateTimeParser::kStatusBadDigit,
+      parse(parser, "20a8/08-31T13:48:01Z"));
+  assertEqual((size_t) 2, parser.position());
+  assertEqual(IsoDateTimeParser::kStatusBadSeparator,
+      parse(parser, "2018/08-31T13:48:01Z"));
+  assertEqual((size_t) 4, parser.position());
+  assertEqual(IsoDateTimeParser::kStatusBadSeparator,
+      parse(parser, "2018-08-31X13:48:01Z"));
+  assertEqual((size_t) 10, parser.position());
+  assertEqual(IsoDateTimeParser::kStatusBadDigit,
+      parse(parser, "2018-08-3\xb1T13:48:01Z"));
+  assertEqual((size_t) 9, parser.position());
+  assertEqual(IsoDateTimeParser::kStatusBadSeparator,
+      parse(parser, "2018-08-31T13:48-01Z"));
+  assertEqual((size_t) 16, parser.position());
+  assertEqual(IsoDateTimeParser::kStatusBadDigit,
+      parse(parser, "2018-08-31T13:48:0:Z"));
+  assertEqual((size_t) 18, parser.position());
+
+  // Range errors
+  assertEqual(IsoDateTimeParser::kStatusOutOfRange,
+      parse(parser, "2018-13-01T00:00:00Z"));
+  assertEqual((size_t) 5, parser.position());
+  assertEqual(IsoDateTimeParser::kStatusOutOfRange,
+      parse(parser, "2018-02-29T00:00:00Z"));
+  assertEqual((size_t) 8, parser.position());
+  assertEqual(IsoDateTimeParser::kStatusOutOfRange,
+      parse(parser, "2018-02-00T00:00:00Z"));
+  assertEqual(IsoDateTimeParser::kStatusOutOfRange,
+      parse(parser, "2018-02-01T24:00:00Z"));
+  assertEqual((size_t) 11, parser.position());
+  assertEqual(IsoDateTimeParser::kStatusOutOfRange,
+      parse(parser, "2018-02-01T00:60:00Z"));
+  assertEqual(IsoDateTimeParser::kStatusOutOfRange,
+      parse(parser, "2018-02-01T00:00:60Z"));
+  assertEqual((size_t) 17, parser.position());
+
+  // Offset errors
+  assertEqual(IsoDateTimeParser::kStatusTooShort,
+      parse(parser, "2018-02-01T00:00:00"));
+  assertEqual((size_t) 19, parser.position());
+  assertEqual(IsoDateTimeParser::kStatusBadOffset,
+      parse(parser, "2018-02-01T00:00:00 08:00"));
+  assertEqual(IsoDateTimeParser::kStatusTooShort,
+      parse(parser, "2018-02-01T00:00:00+08:0"));
+  assertEqual((size_t) 24, parser.position());
+  assertEqual(IsoDateTimeParser::kStatusBadSeparator,
+      parse(parser, "2018-02-01T00:00:00+0800"));
+  assertEqual((size_t) 22, parser.position());
+  assertEqual(IsoDateTimeParser::kStatusOutOfRange,
+      parse(parser, "2018-02-01T00:00:00+24:00"));
+  assertEqual((size_t) 20, parser.position());
+  assertEqual(IsoDateTimeParser::kStatusOutOfRange,
+      parse(parser, "2018-02-01T00:00:00+08:00:99"));
+  assertEqual((size_t) 26, parser.position());
+}
+
+test(IsoDateTimeParserTest, parseLines) {
+  const char input[] =
+      "2018-08-31T13:48:01-07:00\n"
+      "2018-08-31T13:48:01.25Z\r\n"
+      "2018-13-31T13:48:01Z\n"
+      "2018-08-31T13:48:01Z extra\n"
+      "\n"
+      "2000-01-01T00:00:00+01:00";
+  const size_t len = sizeof(input) - 1;
+  OffsetDateTime dateTimes[4];
+  uint32_t nanos[4];
+  uint8_t statuses[4];
+  IsoDateTimeParser parser(true /*allowFraction*/);
+
+  size_t n = parser.parseLines(input, len, dateTimes, 4, nanos, statuses);
+  assertEqual((size_t) 4, n);
+  assertEqual(IsoDateTimeParser::kStatusOk, statuses[0]);
+  assertEqual(13, dateTimes[0].hour());
+  assertEqual(IsoDateTimeParser::kStatusOk, statuses[1]);
+  assertEqual((uint32_t) 250000000, nanos[1]);
+  assertEqual(IsoDateTimeParser::kStatusOutOfRange, statuses[2]);
+  assertTrue(dateTimes[2].isError());
+  assertEqual(IsoDateTimeParser::kStatusTrailing, statuses[3]);
+  assertTrue(dateTimes[3].isError());
+
+  // Continue with the remainder.
+  size_t pos = parser.position();
+  n = parser.parseLines(input + pos, len - pos, dateTimes, 4, nullptr,
+      statuses);
+  assertEqual((size_t) 2, n);
+  assertEqual(IsoDateTimeParser::kStatusTooShort, statuses[0]);
+  assertEqual(IsoDateTimeParser::kStatusOk, statuses[1]);
+  assertEqual((int16_t) 2000, dateTimes[1].year());
+  assertEqual(len - pos, parser.position());
+
+  // A trailing newline does not create an empty line.
+  n = parser.parseLines("2000-01-01T00:00:00Z\n", 21, dateTimes, 4);
+  assertEqual((size_t) 1, n);
+}
+
+test(IsoDateTimeParserTest, parseLines_chunked) {
+  const char input[] =
+      "2018-08-31T13:48:01-07:00\n"
+      "2000-01-01T00:00:00+01:00\n";
+  OffsetDateTime dateTimes[4];
+  uint8_t statuses[4];
+  IsoDateTimeParser parser;
+
+  // The first chunk ends in the middle of the second line, which is left for
+  // the next chunk.
+  size_t n = parser.parseLines(input, 36, dateTimes, 4, nullptr, statuses,
+      false /*endOfInput*/);
+  assertEqual((size_t) 1, n);
+  assertEqual(IsoDateTimeParser::kStatusOk, statuses[0]);
+  assertEqual((size_t) 26, parser.position());
+
+  // The next chunk starts at the unconsumed line.
+  size_t pos = parser.position();
+  n = parser.parseLines(input + pos, sizeof(input) - 1 - pos, dateTimes, 4,
+      nullptr, statuses, false /*endOfInput*/);
+  assertEqual((size_t) 1, n);
+  assertEqual(IsoDateTimeParser::kStatusOk, statuses[0]);
+  assertEqual((int16_t) 2000, dateTimes[0].year());
+  assertEqual(sizeof(input) - 1 - pos, parser.position());
+
+  // Without a '\n', the final line is parsed only at the end of the input.
+  n = parser.parseLines("2000-01-01T00:00:00Z", 20, dateTimes, 4, nullptr,
+      statuses, false /*endOfInput*/);
+  assertEqual((size_t) 0, n);
+  assertEqual((size_t) 0, parser.position());
+  n = parser.parseLines("2000-01-01T00:00:00Z", 20, dateTimes, 4, nullptr,
+      statuses, true /*endOfInput*/);
+  assertEqual((size_t) 1, n);
+  assertEqual(IsoDateTimeParser::kStatusOk, statuses[0]);
+  assertEqual((size_t) 20, parser.position());
+}
+
+//---------------------------------------------------------------------------
+
+void setup() {
+#if ! defined(EPOXY_DUINO)
+  delay(1000); // wait to prevent garbage on SERIAL_PORT_MONITOR
+#endif
+  SERIAL_PORT_MONITOR.begin(115200);
+  while (!SERIAL_PORT_MONITOR); // Leonardo/Micro
+#if defined(EPOXY_DUINO)
+  SERIAL_PORT_MONITOR.setLineModeUnix();
+#endif
+}
+
+void loop() {
+  aunit::TestRunner::run();
+}
@@ -310,6 +310,60 @@ test(LocalDateTest, toAndFromEpochDays_epoch2100) {
   assertTrue(ld == LocalDate::forEpochDays(largestEpochDays));
 }
 
+test(LocalDateTest, yearStartEpochSeconds) {
+  for (int16_t year = 1; year <= 10000; year++) {
+    assertEqual(Epoch::daysFromInternalEpoch(year),
+        Epoch::daysToYearStartFromInternalEpoch(year));
+  }
+
+  testing::EpochYearContext context(2100);
+  assertEqual((int32_t) 0, Epoch::yearStartEpochSeconds(2100));
+  assertEqual(LocalDate::forComponents(2101, 1, 1).toEpochSeconds(),
+      Epoch::yearStartEpochSeconds(2101));
+
+  // One day of margin at both ends of the 32-bit range.
+  assertEqual(LocalDate::forComponents(2032, 1, 1).toEpochSeconds(),
+      Epoch::yearStartEpochSeconds(2032));
+  assertEqual(INT32_MIN, Epoch::yearStartEpochSeconds(2031));
+  assertEqual(LocalDate::forComponents(2168, 1, 1).toEpochSeconds(),
+      Epoch::yearStartEpochSeconds(2168));
+  assertEqual(INT32_MIN, Epoch::yearStartEpochSeconds(2169));
+}
+
+test(LocalDateTest, epochContext) {
+  static constexpr EpochContext kEpoch2100(2100);
+  static_assert(kEpoch2100.yearStartEpochSeconds(2100) == 0, "2100");
+
+  // The current epoch is the default 2050.
+  assertEqual(2050, Epoch::currentContext().epochYear());
+  assertEqual(Epoch::secondsToCurrentEpochFromUnixEpoch64(),
+      EpochContext().secondsToEpochFromUnixEpoch64());
+
+  // An explicit context does not depend on the current epoch.
+  LocalDate ld = LocalDate::forComponents(2101, 1, 1);
+  assertEqual((int32_t) 365, ld.toEpochDays(kEpoch2100));
+  assertEqual((acetime_t) 365 * 86400, ld.toEpochSeconds(kEpoch2100));
+  assertTrue(ld == LocalDate::forEpochDays(365, kEpoch2100));
+  assertTrue(ld == LocalDate::forEpochSeconds(365 * (acetime_t) 86400 + 1,
+      kEpoch2100));
+
+  {
+    testing::EpochYearContext context(2100);
+    assertEqual(kEpoch2100.daysToEpochFromUnixEpoch(),
+        Epoch::daysToCurrentEpochFromUnixEpoch());
+    assertEqual(ld.toEpochSeconds(), ld.toEpochSeconds(kEpoch2100));
+
+    // Save the current context, and restore it later.
+    EpochContext saved = Epoch::currentContext();
+    Epoch::currentEpochYear(2000);
+    assertEqual((int32_t) 365, ld.toEpochDays(kEpoch2100));
+    assertEqual((int32_t) 36890, ld.toEpochDays());
+    Epoch::currentContext(saved);
+    assertEqual(2100, Epoch::currentEpochYear());
+  }
+  assertEqual(2050, Epoch::currentEpochYear());
+}
+
 // Same as toAndFromEpochDays, shifted 30 years
 test(LocalDateTest, toAndFromUnixDays) {
   LocalDate ld;
@@ -491,6 +545,23 @@ test(LocalDateTest, forDateString_invalid) {
   assertTrue(ld.isError());
 }
 
+test(LocalDateTest, formatTo) {
+  char buf[LocalDate::kFormatBufferSize];
+  assertEqual((size_t) 10,
+      LocalDate::forComponents(2018, 1, 2).formatTo(buf, sizeof(buf)));
+  assertEqual(buf, "2018-01-02");
+  assertEqual((size_t) 10,
+      LocalDate::forComponents(1, 12, 31).formatTo(buf, sizeof(buf)));
+  assertEqual(buf, "0001-12-31");
+
+  assertEqual((size_t) 0,
+      LocalDate::forComponents(2018, 1, 2).formatTo(buf, sizeof(buf) - 1));
+  assertEqual(buf, "");
+  assertEqual((size_t) 0, LocalDate::forError().formatTo(buf, sizeof(buf)));
+  assertEqual((size_t) 0,
+      LocalDate::forComponents(10000, 1, 1).formatTo(buf, sizeof(buf)));
+}
+
 test(LocalDateTest, isLeapYear) {
   assertFalse(LocalDate::isLeapYear(1900));
   assertTrue(LocalDate::isLeapYear(2000));
@@ -178,6 +178,35 @@ test(LocalDateTimeTest, forComponents) {
   assertEqual(LocalDate::kThursday, dt.dayOfWeek());
 }
 
+test(LocalDateTimeTest, toEpochSeconds_outOfRange) {
+  testing::EpochYearContext context(2000);
+  LocalDateTime dt;
+
+  // 1931-12-13 20:45:52Z, one second before kMinEpochSeconds
+  dt = LocalDateTime::forComponents(1931, 12, 13, 20, 45, 52);
+  assertEqual(LocalDate::kInvalidEpochSeconds, dt.toEpochSeconds());
+
+  // The first second of the day of kMinEpochSeconds, and the day before.
+  dt = LocalDateTime::forComponents(1931, 12, 13, 0, 0, 0);
+  assertEqual(LocalDate::kInvalidEpochSeconds, dt.toEpochSeconds());
+  dt = LocalDateTime::forComponents(1931, 12, 12, 23, 59, 59);
+  assertEqual(LocalDate::kInvalidEpochSeconds, dt.toEpochSeconds());
+
+  // The last second of the day of kMinEpochSeconds.
+  dt = LocalDateTime::forComponents(1931, 12, 13, 23, 59, 59);
+  assertEqual(LocalDate::kMinEpochSeconds + 11646, dt.toEpochSeconds());
+
+  // 2068-01-19 03:14:08Z, one second after kMaxEpochSeconds
+  dt = LocalDateTime::forComponents(2068, 1, 19, 3, 14, 8);
+  assertEqual(LocalDate::kInvalidEpochSeconds, dt.toEpochSeconds());
+
+  // The first second of the day of kMaxEpochSeconds, and the day after.
+  dt = LocalDateTime::forComponents(2068, 1, 19, 0, 0, 0);
+  assertEqual(LocalDate::kMaxEpochSeconds - 11647, dt.toEpochSeconds());
+  dt = LocalDateTime::forComponents(2068, 1, 20, 0, 0, 0);
+  assertEqual(LocalDate::kInvalidEpochSeconds, dt.toEpochSeconds());
+}
+
 test(LocalDateTimeTest, toAndForUnixSeconds64) {
   LocalDateTime dt;
   LocalDateTime udt;
@@ -393,6 +422,28 @@ test(LocalDateTimeTest, printTo) {
   assertEqual(dateString.cstr(), "2020-10-30T01:02:03");
 }
 
+test(LocalDateTimeTest, formatTo) {
+  char buf[LocalDateTime::kFormatBufferSize];
+  LocalDateTime dt = LocalDateTime::forComponents(2020, 10, 30, 1, 2, 3);
+  assertEqual((size_t) 19, dt.formatTo(buf, sizeof(buf)));
+  assertEqual(buf, "2020-10-30T01:02:03");
+
+  // Same as printTo() over a range of dates and times.
+  PrintStr<30> dateString;
+  for (int32_t seconds = -1000000000; seconds < 1000000000;
+      seconds += 12345679) {
+    dt = LocalDateTime::forEpochSeconds(seconds);
+    dateString.flush();
+    dt.printTo(dateString);
+    assertEqual((size_t) 19, dt.formatTo(buf, sizeof(buf)));
+    assertEqual(dateString.cstr(), buf);
+  }
+
+  assertEqual((size_t) 0, dt.formatTo(buf, sizeof(buf) - 1));
+  assertEqual(buf, "");
+  assertEqual((size_t) 0, LocalDateTime::forError().formatTo(buf, sizeof(buf)));
+}
+
 //---------------------------------------------------------------------------
 
 test(LocalDateTimeTest, spotcheck_epoch2000) {
@@ -464,6 +515,23 @@ test(LocalDateTimeTest, spotcheck_epoch2100) {
   assertEqual((int32_t) 24855, dt.toUnixDays());
 }
 
+test(LocalDateTimeTest, epochContext) {
+  // Same as spotcheck_epoch2100, using an explicit EpochContext instead of
+  // changing the current epoch year.
+  const EpochContext epoch2100(2100);
+  auto minDt = LocalDateTime::forEpochSeconds(LocalDate::kMinEpochSeconds,
+      epoch2100);
+  auto expected = LocalDateTime::forComponents(2031, 12, 13, 20, 45, 53);
+  assertTrue(expected == minDt);
+  assertEqual(LocalDate::kMinEpochSeconds, minDt.toEpochSeconds(epoch2100));
+
+  auto dt = LocalDateTime::forEpochSeconds(-1, epoch2100, 1 /*fold*/);
+  expected = LocalDateTime::forComponents(2099, 12, 31, 23, 59, 59);
+  assertTrue(expected == dt);
+  assertEqual(1, dt.fold());
+  assertEqual(2050, Epoch::currentEpochYear());
+}
+
 //---------------------------------------------------------------------------
 
 void setup() {
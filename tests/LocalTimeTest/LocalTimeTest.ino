@@ -36,6 +36,21 @@ test(LocalTimeTest, constructor_with_fold) {
   assertEqual(1, lt.fold());
 }
 
+test(LocalTimeTest, formatTo) {
+  char buf[LocalTime::kFormatBufferSize];
+  assertEqual((size_t) 8,
+      LocalTime::forComponents(1, 2, 3).formatTo(buf, sizeof(buf)));
+  assertEqual(buf, "01:02:03");
+  assertEqual((size_t) 8,
+      LocalTime::forComponents(23, 59, 59).formatTo(buf, sizeof(buf)));
+  assertEqual(buf, "23:59:59");
+
+  assertEqual((size_t) 0,
+      LocalTime::forComponents(1, 2, 3).formatTo(buf, sizeof(buf) - 1));
+  assertEqual(buf, "");
+  assertEqual((size_t) 0, LocalTime::forError().formatTo(buf, sizeof(buf)));
+}
+
 test(LocalTimeTest, isError) {
   assertFalse(LocalTime::forComponents(0, 0, 0).isError());
   assertFalse(LocalTime::forComponents(0, 59, 0).isError());
@@ -0,0 +1,278 @@
+#line 2 "MappedZoneProcessorTest.ino"
+
+#include <stdio.h> // fopen(), remove()
+#include <string.h> // strcmp()
+#include <AUnitVerbose.h>
+#include <AceCommon.h> // PrintStr<>
+#include <AceTime.h>
+
+using ace_common::PrintStr;
+using namespace ace_time;
+using ace_time::zonedbc::kZoneAndLinkRegistry;
+using ace_time::zonedbc::kZoneAndLinkRegistrySize;
+using ace_time::zonedbc::kZoneIdAmerica_Los_Angeles;
+using ace_time::zonedbc::kZoneIdUS_Pacific;
+
+// Large enough for the entire 'zonedbc' database, 4-byte aligned.
+static uint32_t database[48 * 1024];
+static size_t databaseSize;
+
+// Write the 'zonedbc' database into the buffer, once.
+static const MappedZoneDatabase& getDatabase() {
+  static MappedZoneDatabase mappedDatabase;
+  if (databaseSize == 0) {
+    MappedZoneDatabaseWriter writer(
+        kZoneAndLinkRegistrySize, kZoneAndLinkRegistry);
+    databaseSize = writer.writeTo(
+        (uint8_t*) database, sizeof(database));
+    mappedDatabase.initFromBuffer(database, databaseSize);
+  }
+  return mappedDatabase;
+}
+
+// Return true if the two FindResults are identical.
+static bool equalsFindResult(const FindResult& a, const FindResult& b) {
+  return a.type == b.type
+      && a.fold == b.fold
+      && a.stdOffsetSeconds == b.stdOffsetSeconds
+      && a.dstOffsetSeconds == b.dstOffsetSeconds
+      && a.reqStdOffsetSeconds == b.reqStdOffsetSeconds
+      && a.reqDstOffsetSeconds == b.reqDstOffsetSeconds
+      && strcmp(a.abbrev, b.abbrev) == 0;
+}
+
+//---------------------------------------------------------------------------
+
+test(MappedZoneDatabaseWriterTest, writeTo) {
+  MappedZoneDatabaseWriter writer(
+      kZoneAndLinkRegistrySize, kZoneAndLinkRegistry);
+  size_t size = writer.writeTo(nullptr, 0);
+  assertTrue(size > 0);
+  assertLessOrEqual(size, sizeof(database));
+  assertEqual(0, (int) (size % 4));
+
+  // A buffer which is too small is not written.
+  uint32_t small[8] = {0};
+  assertEqual(size, writer.writeTo((uint8_t*) small, sizeof(small)));
+  assertEqual((uint32_t) 0, small[0]);
+
+  // An empty registry produces nothing.
+  MappedZoneDatabaseWriter emptyWriter(0, kZoneAndLinkRegistry);
+  assertEqual((size_t) 0, emptyWriter.writeTo(nullptr, 0));
+
+  const MappedZoneDatabase& mappedDatabase = getDatabase();
+  assertEqual(size, databaseSize);
+  assertTrue(mappedDatabase.isValid());
+}
+
+test(MappedZoneDatabaseTest, initFromBuffer_errors) {
+  getDatabase();
+  MappedZoneDatabase mappedDatabase;
+  assertFalse(mappedDatabase.isValid());
+  assertEqual(MappedZoneDatabase::kStatusNotLoaded, mappedDatabase.status());
+  assertEqual(0, mappedDatabase.zoneRegistrySize());
+  assertEqual(nullptr, mappedDatabase.zoneRegistry());
+
+  // Too short for the header, or for the whole file.
+  assertEqual(MappedZoneDatabase::kStatusBadSize,
+      mappedDatabase.initFromBuffer(database, 16));
+  assertEqual(MappedZoneDatabase::kStatusBadSize,
+      mappedDatabase.initFromBuffer(database, databaseSize - 4));
+
+  // Misaligned buffer.
+  assertEqual(MappedZoneDatabase::kStatusBadAlignment,
+      mappedDatabase.initFromBuffer((uint8_t*) database + 1, databaseSize));
+
+  // Corrupted magic number.
+  uint8_t* bytes = (uint8_t*) database;
+  bytes[0] = 'X';
+  assertEqual(MappedZoneDatabase::kStatusBadHeader,
+      mappedDatabase.initFromBuffer(database, databaseSize));
+  bytes[0] = 'A';
+
+  // Offsets of a ZoneInfo which point outside of the file.
+  const int32_t* registry = (const int32_t*) getDatabase().zoneRegistry();
+  mapped::Info::ZoneInfo* info = (mapped::Info::ZoneInfo*)
+      mapped::Info::resolve<mapped::Info::ZoneInfo>(registry[0]);
+  int32_t savedName = info->name;
+  info->name = (int32_t) databaseSize;
+  assertEqual(MappedZoneDatabase::kStatusBadSize,
+      mappedDatabase.initFromBuffer(database, databaseSize));
+  info->name = savedName;
+  int32_t savedEras = info->eras;
+  info->eras = -info->eras;
+  assertEqual(MappedZoneDatabase::kStatusBadSize,
+      mappedDatabase.initFromBuffer(database, databaseSize));
+  info->eras = savedEras;
+
+  // A rule which refers to a letter which does not exist.
+  const mapped::Info::ZoneEra* era = nullptr;
+  const mapped::Info::ZoneEra* eras =
+      mapped::Info::resolve<mapped::Info::ZoneEra>(info->eras);
+  for (uint8_t e = 0; e < info->numEras; e++) {
+    if (eras[e].zonePolicy != 0) {
+      era = &eras[e];
+      break;
+    }
+  }
+  assertTrue(era != nullptr);
+  mapped::Info::ZoneRule* rule = (mapped::Info::ZoneRule*)
+      mapped::Info::resolve<mapped::Info::ZoneRule>(
+          mapped::Info::resolve<mapped::Info::ZonePolicy>(era->zonePolicy)
+              ->rules);
+  uint8_t savedLetterIndex = rule->letterIndex;
+  rule->letterIndex = 255;
+  assertEqual(MappedZoneDatabase::kStatusBadSize,
+      mappedDatabase.initFromBuffer(database, databaseSize));
+  rule->letterIndex = savedLetterIndex;
+
+  assertEqual(MappedZoneDatabase::kStatusOk,
+      mappedDatabase.initFromBuffer(database, databaseSize));
+  mappedDatabase.close();
+  assertFalse(mappedDatabase.isValid());
+}
+
+// Every zone and link is present, in the same order, with the same name.
+test(MappedZoneDatabaseTest, zoneRegistry) {
+  const MappedZoneDatabase& mappedDatabase = getDatabase();
+  assertEqual(kZoneAndLinkRegistrySize, mappedDatabase.zoneRegistrySize());
+
+  mapped::ZoneRegistrar mappedRegistrar(
+      mappedDatabase.zoneRegistrySize(), mappedDatabase.zoneRegistry());
+  for (uint16_t i = 0; i < kZoneAndLinkRegistrySize; i++) {
+    CompleteZone expected(kZoneAndLinkRegistry[i]);
+    MappedZone zone(mappedRegistrar.getZoneInfoForIndex(i));
+    assertEqual(expected.zoneId(), zone.zoneId());
+
+    PrintStr<64> expectedName;
+    PrintStr<64> name;
+    expected.printNameTo(expectedName);
+    zone.printNameTo(name);
+    assertEqual(expectedName.cstr(), name.cstr());
+    assertEqual(i, mappedRegistrar.findIndexForName(name.cstr()));
+  }
+
+  mapped::Info::ZoneContextBroker context(mappedDatabase.zoneContext());
+  complete::Info::ZoneContextBroker expectedContext(&zonedbc::kZoneContext);
+  assertEqual(expectedContext.tzVersion(), context.tzVersion());
+  assertEqual(expectedContext.startYear(), context.startYear());
+  assertEqual(expectedContext.untilYear(), context.untilYear());
+}
+
+// Compare findByEpochSeconds() and findByLocalDateTime() against the
+// CompleteZoneProcessor for all zones and links of 'zonedbc'.
+test(MappedZoneProcessorTest, compareToCompleteZoneProcessor) {
+  const MappedZoneDatabase& mappedDatabase = getDatabase();
+  mapped::ZoneRegistrar mappedRegistrar(
+      mappedDatabase.zoneRegistrySize(), mappedDatabase.zoneRegistry());
+  CompleteZoneProcessor completeProcessor;
+  MappedZoneProcessor mappedProcessor;
+
+  for (uint16_t i = 0; i < kZoneAndLinkRegistrySize; i++) {
+    completeProcessor.setZoneKey((uintptr_t) kZoneAndLinkRegistry[i]);
+    mappedProcessor.setZoneKey(
+        (uintptr_t) mappedRegistrar.getZoneInfoForIndex(i));
+    assertEqual(completeProcessor.isLink(), mappedProcessor.isLink());
+
+    for (int16_t year = 1900; year < 2100; year += 7) {
+      for (uint8_t month = 1; month <= 12; month += 3) {
+        LocalDateTime ldt = LocalDateTime::forComponents(
+            year, month, 1, 2, 30, 0);
+        assertTrue(equalsFindResult(
+            completeProcessor.findByLocalDateTime(ldt),
+            mappedProcessor.findByLocalDateTime(ldt)));
+
+        // The epochSeconds overflows outside of the valid years of the epoch.
+        if (year < Epoch::epochValidYearLower()
+            || year >= Epoch::epochValidYearUpper()) {
+          continue;
+        }
+        acetime_t epochSeconds = ldt.toEpochSeconds();
+        assertTrue(equalsFindResult(
+            completeProcessor.findByEpochSeconds(epochSeconds),
+            mappedProcessor.findByEpochSeconds(epochSeconds)));
+      }
+    }
+  }
+}
+
+test(MappedZoneManagerTest, createForZoneName) {
+  const MappedZoneDatabase& mappedDatabase = getDatabase();
+  MappedZoneProcessorHashedCache<2> cache;
+  MappedZoneManager manager(
+      mappedDatabase.zoneRegistrySize(), mappedDatabase.zoneRegistry(), cache);
+
+  TimeZone tz = manager.createForZoneName("America/Los_Angeles");
+  assertFalse(tz.isError());
+  assertEqual(MappedZoneProcessor::kTypeMapped, tz.getType());
+  assertEqual(kZoneIdAmerica_Los_Angeles, tz.getZoneId());
+  assertFalse(tz.isLink());
+
+  ZonedDateTime zdt = ZonedDateTime::forComponents(2023, 7, 1, 12, 0, 0, tz);
+  assertEqual(-7*60, zdt.timeOffset().toMinutes());
+  zdt = ZonedDateTime::forComponents(2023, 1, 1, 12, 0, 0, tz);
+  assertEqual(-8*60, zdt.timeOffset().toMinutes());
+
+  PrintStr<32> printStr;
+  tz.printShortTo(printStr);
+  assertEqual(F("Los Angeles"), printStr.cstr());
+
+  // Link
+  TimeZone link = manager.createForZoneId(kZoneIdUS_Pacific);
+  assertTrue(link.isLink());
+  printStr.flush();
+  link.printTargetNameTo(printStr);
+  assertEqual(F("America/Los_Angeles"), printStr.cstr());
+
+  assertTrue(manager.createForZoneName("Not/Found").isError());
+}
+
+#if ACE_TIME_HAS_MMAP
+
+test(MappedZoneDatabaseTest, openFile) {
+  getDatabase();
+  const char fileName[] = "MappedZoneProcessorTest.bin";
+  FILE* file = fopen(fileName, "wb");
+  assertTrue(file != nullptr);
+  assertEqual(databaseSize, fwrite(database, 1, databaseSize, file));
+  fclose(file);
+
+  MappedZoneDatabase mappedDatabase;
+  assertEqual(MappedZoneDatabase::kStatusOk, mappedDatabase.openFile(fileName));
+  assertEqual(kZoneAndLinkRegistrySize, mappedDatabase.zoneRegistrySize());
+
+  MappedZoneProcessor processor;
+  TimeZone tz = TimeZone::forZoneInfo(
+      mapped::ZoneRegistrar(
+          mappedDatabase.zoneRegistrySize(), mappedDatabase.zoneRegistry())
+          .getZoneInfoForId(kZoneIdAmerica_Los_Angeles),
+      &processor);
+  ZonedDateTime zdt = ZonedDateTime::forComponents(2023, 7, 1, 12, 0, 0, tz);
+  assertEqual(-7*60, zdt.timeOffset().toMinutes());
+
+  mappedDatabase.close();
+  assertFalse(mappedDatabase.isValid());
+  remove(fileName);
+
+  assertEqual(MappedZoneDatabase::kStatusOpenError,
+      mappedDatabase.openFile("does-not-exist.bin"));
+}
+
+#endif
+
+//---------------------------------------------------------------------------
+
+void setup() {
+#if ! defined(EPOXY_DUINO)
+  delay(1000); // wait to prevent garbage on SERIAL_PORT_MONITOR
+#endif
+  SERIAL_PORT_MONITOR.begin(115200);
+  while (!SERIAL_PORT_MONITOR); // Leonardo/Micro
+#if defined(EPOXY_DUINO)
+  SERIAL_PORT_MONITOR.setLineModeUnix();
+#endif
+}
+
+void loop() {
+  aunit::TestRunner::run();
+}
@@ -484,6 +484,40 @@ test(OffsetDateTimeTest, forDateString) {
   assertEqual(LocalDate::kFriday, dt.dayOfWeek());
 }
 
+test(OffsetDateTimeTest, formatTo) {
+  char buf[OffsetDateTime::kFormatBufferSize];
+  auto dt = OffsetDateTime::forComponents(2018, 8, 31, 13, 48, 1,
+      TimeOffset::forHours(-7));
+  assertEqual((size_t) 25, dt.formatTo(buf, sizeof(buf)));
+  assertEqual(buf, "2018-08-31T13:48:01-07:00");
+
+  // Round trip through forDateString().
+  auto parsed = OffsetDateTime::forDateString(buf);
+  assertTrue(dt == parsed);
+
+  // LMT offsets include the seconds.
+  dt = OffsetDateTime::forComponents(1883, 11, 18, 12, 7, 1,
+      TimeOffset::forHourMinuteSecond(-7, -52, -58));
+  assertEqual((size_t) 28, dt.formatTo(buf, sizeof(buf)));
+  assertEqual(buf, "1883-11-18T12:07:01-07:52:58");
+  assertEqual((size_t) 0, dt.formatTo(buf, 28));
+
+  dt = OffsetDateTime::forComponents(2018, 8, 31, 13, 48, 1,
+      TimeOffset::forHours(5));
+  assertEqual((size_t) 25, dt.formatTo(buf, 26));
+  assertEqual(buf, "2018-08-31T13:48:01+05:00");
+  assertEqual((size_t) 0, dt.formatTo(buf, 25));
+  assertEqual(buf, "");
+  assertEqual((size_t) 0,
+      OffsetDateTime::forError().formatTo(buf, sizeof(buf)));
+
+  // UTC offset too large for "hh"
+  dt = OffsetDateTime::forComponents(2018, 8, 31, 13, 48, 1,
+      TimeOffset::forSeconds(300 * 3600));
+  assertEqual((size_t) 0, dt.formatTo(buf, sizeof(buf)));
+  assertEqual(buf, "");
+}
+
 test(OffsetDateTimeTest, forDateString_errors) {
   // empty string, too short
   OffsetDateTime dt = OffsetDateTime::forDateString("");
@@ -689,6 +723,18 @@ test(OffsetDateTimeTest, spotcheck_epoch2100) {
   assertEqual((int32_t) 24855, dt.toUnixDays());
 }
 
+test(OffsetDateTimeTest, epochContext) {
+  // Same as spotcheck_epoch2100, using an explicit EpochContext instead of
+  // changing the current epoch year.
+  const EpochContext epoch2100(2100);
+  auto maxDt = OffsetDateTime::forEpochSeconds(LocalDate::kMaxEpochSeconds,
+      TimeOffset::forHours(-8), epoch2100);
+  auto expected = OffsetDateTime::forComponents(2168, 1, 19, 19, 14, 7,
+      TimeOffset::forHours(-8));
+  assertTrue(expected == maxDt);
+  assertEqual(LocalDate::kMaxEpochSeconds, maxDt.toEpochSeconds(epoch2100));
+}
+
 //---------------------------------------------------------------------------
 
 void setup() {
@@ -0,0 +1,292 @@
+#line 2 "PrecomputedZoneManagerTest.ino"
+
+#include <string.h> // memcmp(), memcpy()
+#include <AUnitVerbose.h>
+#include <AceCommon.h> // PrintStr<>
+#include <AceTime.h>
+#include <ace_time/testing/EpochYearContext.h>
+#include <testingzonedbc/zone_infos.h>
+#include <testingzonedbc/zone_registry.h>
+
+using ace_common::PrintStr;
+using namespace ace_time;
+using ace_time::testing::EpochYearContext;
+using ace_time::testingzonedbc::kZoneAmerica_Los_Angeles;
+using ace_time::testingzonedbc::kZoneIdAmerica_Los_Angeles;
+using ace_time::testingzonedbc::kZoneAndLinkRegistry;
+using ace_time::testingzonedbc::kZoneAndLinkRegistrySize;
+using ace_time::testingzonedbc::kZoneRegistry;
+using ace_time::testingzonedbc::kZoneRegistrySize;
+
+//---------------------------------------------------------------------------
+
+test(PrecomputedZoneManagerTest, build) {
+  PrecomputedZoneManager manager(
+      kZoneAndLinkRegistrySize, kZoneAndLinkRegistry);
+  assertEqual(PrecomputedZoneTable::kStatusNotLoaded, manager.status());
+  assertTrue(manager.createForZoneName("America/Los_Angeles").isError());
+
+  assertEqual(PrecomputedZoneTable::kStatusOk, manager.build(2000, 2050));
+  const PrecomputedZoneTable& table = manager.table();
+  assertEqual(kZoneAndLinkRegistrySize, table.numZones());
+  assertEqual(2000, table.startYear());
+  assertEqual(2050, table.untilYear());
+  assertEqual(PrecomputedZoneTable::calcTableSize(
+      table.numZones(), table.numTransitions(), table.numAbbrevs()),
+      table.size());
+
+  // Transitions are strictly increasing and always change something.
+  for (uint16_t i = 0; i < table.numZones(); i++) {
+    const precomputed::ZoneEntry& entry = table.zoneEntry(i);
+    assertMore(entry.numTransitions, 0);
+    const flat::FlatTransition* transitions =
+        &table.transitions()[entry.transitionIndex];
+    for (uint16_t j = 1; j < entry.numTransitions; j++) {
+      const flat::FlatTransition& prev = transitions[j - 1];
+      const flat::FlatTransition& curr = transitions[j];
+      assertLess(prev.startEpochSeconds, curr.startEpochSeconds);
+      assertTrue(prev.abbrevIndex != curr.abbrevIndex
+          || prev.dstOffsetSeconds != curr.dstOffsetSeconds
+          || prev.stdOffsetSeconds != curr.stdOffsetSeconds);
+    }
+  }
+
+  // A Link shares the transitions of its Zone.
+  uint16_t linkIndex = manager.indexForZoneName("US/Pacific");
+  uint16_t zoneIndex = manager.indexForZoneName("America/Los_Angeles");
+  assertNotEqual(ZoneManager::kInvalidIndex, linkIndex);
+  assertEqual(table.zoneEntry(zoneIndex).transitionIndex,
+      table.zoneEntry(linkIndex).transitionIndex);
+  assertNotEqual(table.zoneEntry(zoneIndex).zoneId,
+      table.zoneEntry(linkIndex).zoneId);
+}
+
+test(PrecomputedZoneManagerTest, build_isDeterministic) {
+  PrecomputedZoneManager serialManager(
+      kZoneAndLinkRegistrySize, kZoneAndLinkRegistry);
+  PrecomputedZoneManager parallelManager(
+      kZoneAndLinkRegistrySize, kZoneAndLinkRegistry);
+  assertEqual(PrecomputedZoneTable::kStatusOk,
+      serialManager.build(2000, 2100, 1));
+  assertEqual(PrecomputedZoneTable::kStatusOk,
+      parallelManager.build(2000, 2100, 4));
+
+  // The table does not depend on the order in which the threads finish.
+  const PrecomputedZoneTable& serial = serialManager.table();
+  const PrecomputedZoneTable& parallel = parallelManager.table();
+  assertEqual(serial.size(), parallel.size());
+  assertEqual(0, memcmp(serial.data(), parallel.data(), serial.size()));
+}
+
+// Compare findByEpochSeconds() against CompleteZoneProcessor every 3 hours
+// and around each transition, for all zones and links in the testing registry.
+// The findByLocalDateTime() is compared against FlatCompleteZoneProcessor,
+// which uses the same search of the flattened transitions.
+test(PrecomputedZoneManagerTest, build_badYearRange) {
+  PrecomputedZoneManager manager(
+      kZoneAndLinkRegistrySize, kZoneAndLinkRegistry);
+  assertEqual(PrecomputedZoneTable::kStatusOk, manager.build(2000, 2050));
+
+  // Years outside of the valid range of the epoch year 2050 are rejected,
+  // instead of being clamped, and the previous table is closed.
+  assertEqual(2000, Epoch::epochValidYearLower());
+  assertEqual(2100, Epoch::epochValidYearUpper());
+  assertEqual(PrecomputedZoneTable::kStatusBadYearRange,
+      manager.build(1980, 2050));
+  assertEqual(PrecomputedZoneTable::kStatusBadYearRange, manager.status());
+  assertTrue(manager.createForZoneName("America/Los_Angeles").isError());
+  assertEqual(PrecomputedZoneTable::kStatusBadYearRange,
+      manager.build(2000, 2101));
+  assertEqual(PrecomputedZoneTable::kStatusBadYearRange,
+      manager.build(2050, 2050));
+
+  assertEqual(PrecomputedZoneTable::kStatusOk, manager.build(2000, 2100));
+  assertEqual(2000, manager.table().startYear());
+  assertEqual(2100, manager.table().untilYear());
+}
+
+test(PrecomputedZoneManagerTest, findByEpochSeconds) {
+  PrecomputedZoneManager manager(
+      kZoneAndLinkRegistrySize, kZoneAndLinkRegistry);
+  assertEqual(PrecomputedZoneTable::kStatusOk, manager.build(2000, 2050));
+  CompleteZoneProcessor completeProcessor;
+  FlatCompleteZoneProcessor flatProcessor(nullptr, 2000, 2050);
+  acetime_t startSeconds = LocalDate::forComponents(2000, 1, 1)
+      .toEpochSeconds();
+  acetime_t untilSeconds = LocalDate::forComponents(2050, 1, 1)
+      .toEpochSeconds();
+
+  for (uint16_t i = 0; i < kZoneAndLinkRegistrySize; i++) {
+    completeProcessor.setZoneKey((uintptr_t) kZoneAndLinkRegistry[i]);
+    flatProcessor.setZoneKey((uintptr_t) kZoneAndLinkRegistry[i]);
+    TimeZone tz = manager.createForZoneIndex(i);
+    assertFalse(tz.isError());
+
+    for (acetime_t t = startSeconds; t < untilSeconds; t += 3 * 3600 + 61) {
+      FindResult expected = completeProcessor.findByEpochSeconds(t);
+      ZonedExtra extra = tz.getZonedExtra(t);
+      assertEqual(expected.type, extra.type());
+      assertEqual(expected.stdOffsetSeconds,
+          extra.stdOffset().toSeconds());
+      assertEqual(expected.dstOffsetSeconds,
+          extra.dstOffset().toSeconds());
+      assertEqual(expected.abbrev, extra.abbrev());
+
+      for (uint8_t fold = 0; fold < 2; fold++) {
+        LocalDateTime ldt = LocalDateTime::forEpochSeconds(t, fold);
+        FindResult expectedLocal = flatProcessor.findByLocalDateTime(ldt);
+        ZonedExtra extraLocal = tz.getZonedExtra(ldt);
+        assertEqual(expectedLocal.type, extraLocal.type());
+        if (expectedLocal.type == FindResult::kTypeNotFound) continue;
+        assertEqual(expectedLocal.stdOffsetSeconds,
+            extraLocal.stdOffset().toSeconds());
+        assertEqual(expectedLocal.reqDstOffsetSeconds,
+            extraLocal.reqDstOffset().toSeconds());
+        assertEqual(expectedLocal.abbrev, extraLocal.abbrev());
+      }
+    }
+
+    acetime_t t = startSeconds;
+    while (true) {
+      ZoneTransition expected = completeProcessor.findNextTransition(t);
+      if (expected.isError() || expected.epochSeconds >= untilSeconds) break;
+      t = expected.epochSeconds;
+      for (acetime_t s = t - 3601; s <= t + 3601; s += 1800) {
+        FindResult expectedResult = completeProcessor.findByEpochSeconds(s);
+        ZonedExtra extra = tz.getZonedExtra(s);
+        assertEqual(expectedResult.type, extra.type());
+        assertEqual(expectedResult.stdOffsetSeconds,
+            extra.stdOffset().toSeconds());
+        assertEqual(expectedResult.dstOffsetSeconds,
+            extra.dstOffset().toSeconds());
+      }
+    }
+  }
+}
+
+test(PrecomputedZoneManagerTest, createForZoneName) {
+  PrecomputedZoneManager manager(
+      kZoneAndLinkRegistrySize, kZoneAndLinkRegistry);
+  manager.build(2000, 2050);
+
+  TimeZone tz = manager.createForZoneName("America/Los_Angeles");
+  assertEqual(PrecomputedZoneProcessor::kTypePrecomputed, tz.getType());
+  assertEqual(kZoneIdAmerica_Los_Angeles, tz.getZoneId());
+  assertFalse(tz.isLink());
+  assertTrue(tz == manager.createForZoneId(kZoneIdAmerica_Los_Angeles));
+  assertTrue(tz == manager.createForZoneInfo(&kZoneAmerica_Los_Angeles));
+  assertTrue(tz == manager.createForTimeZoneData(tz.toTimeZoneData()));
+  assertTrue(manager.createForZoneName("America/Does_Not_Exist").isError());
+
+  PrintStr<32> printStr;
+  tz.printTo(printStr);
+  assertEqual(F("America/Los_Angeles"), printStr.cstr());
+
+  TimeZone link = manager.createForZoneName("US/Pacific");
+  assertTrue(link.isLink());
+  assertFalse(tz == link);
+  printStr.flush();
+  link.printTargetNameTo(printStr);
+  assertEqual(F("America/Los_Angeles"), printStr.cstr());
+
+  // 2018-03-11 02:30 is in the gap of America/Los_Angeles.
+  ZonedDateTime zdt = ZonedDateTime::forComponents(2018, 3, 11, 2, 30, 0, tz);
+  assertEqual(3, zdt.hour());
+  assertEqual(-7 * 60, zdt.timeOffset().toMinutes());
+
+  // Outside of the year range.
+  zdt = ZonedDateTime::forComponents(2060, 1, 1, 0, 0, 0, tz);
+  assertTrue(zdt.isError());
+}
+
+test(PrecomputedZoneManagerTest, changeEpochYear) {
+  PrecomputedZoneManager manager(
+      kZoneAndLinkRegistrySize, kZoneAndLinkRegistry);
+  manager.build(2000, 2050);
+  TimeZone tz = manager.createForZoneName("America/Los_Angeles");
+  acetime_t epochSeconds = LocalDate::forComponents(2018, 1, 1)
+      .toEpochSeconds();
+  assertFalse(tz.getZonedExtra(epochSeconds).isError());
+
+  // The transitions are stored in the epochSeconds of the old epoch year.
+  EpochYearContext context(2100);
+  assertTrue(tz.getZonedExtra(epochSeconds).isError());
+}
+
+//---------------------------------------------------------------------------
+
+test(PrecomputedZoneManagerTest, initFromBuffer) {
+  PrecomputedZoneManager builder(
+      kZoneAndLinkRegistrySize, kZoneAndLinkRegistry);
+  builder.build(2000, 2050);
+  const PrecomputedZoneTable& table = builder.table();
+
+  // Copy the table, as if it was saved to a file and loaded again.
+  static uint32_t buffer[16384];
+  assertLessOrEqual(table.size(), sizeof(buffer));
+  memcpy(buffer, table.data(), table.size());
+
+  PrecomputedZoneManager manager(
+      kZoneAndLinkRegistrySize, kZoneAndLinkRegistry);
+  assertEqual(PrecomputedZoneTable::kStatusOk,
+      manager.initFromBuffer(buffer, table.size()));
+  acetime_t epochSeconds = LocalDate::forComponents(2018, 7, 1)
+      .toEpochSeconds();
+  ZonedExtra extra = manager.createForZoneName("America/Los_Angeles")
+      .getZonedExtra(epochSeconds);
+  assertEqual("PDT", extra.abbrev());
+
+  // A table built for a different registry is rejected.
+  PrecomputedZoneManager otherManager(kZoneRegistrySize, kZoneRegistry);
+  assertEqual(PrecomputedZoneTable::kStatusRegistryMismatch,
+      otherManager.initFromBuffer(buffer, table.size()));
+  assertTrue(otherManager.createForZoneName("America/Los_Angeles").isError());
+
+  // Transitions which refer to an abbreviation outside of their zone, or
+  // which are not sorted, are rejected.
+  const precomputed::ZoneEntry& entry = table.zoneEntry(
+      builder.indexForZoneName("America/Los_Angeles"));
+  flat::FlatTransition* transitions = (flat::FlatTransition*)
+      ((uint8_t*) buffer + PrecomputedZoneTable::calcTableSize(
+          table.numZones(), 0, 0));
+  flat::FlatTransition& t = transitions[entry.transitionIndex + 1];
+  uint8_t savedAbbrevIndex = t.abbrevIndex;
+  t.abbrevIndex = entry.numAbbrevs;
+  assertEqual(PrecomputedZoneTable::kStatusBadSize,
+      manager.initFromBuffer(buffer, table.size()));
+  t.abbrevIndex = savedAbbrevIndex;
+  acetime_t savedStart = t.startEpochSeconds;
+  t.startEpochSeconds = transitions[entry.transitionIndex].startEpochSeconds;
+  assertEqual(PrecomputedZoneTable::kStatusBadSize,
+      manager.initFromBuffer(buffer, table.size()));
+  t.startEpochSeconds = savedStart;
+  assertEqual(PrecomputedZoneTable::kStatusOk,
+      manager.initFromBuffer(buffer, table.size()));
+
+  // Truncated or corrupted tables.
+  assertEqual(PrecomputedZoneTable::kStatusBadSize,
+      manager.initFromBuffer(buffer, table.size() - 1));
+  assertEqual(PrecomputedZoneTable::kStatusBadAlignment,
+      manager.initFromBuffer((const uint8_t*) buffer + 1, table.size()));
+  buffer[0] ^= 0xFF;
+  assertEqual(PrecomputedZoneTable::kStatusBadHeader,
+      manager.initFromBuffer(buffer, table.size()));
+  assertTrue(manager.createForZoneName("America/Los_Angeles").isError());
+}
+
+//---------------------------------------------------------------------------
+
+void setup() {
+#if ! defined(EPOXY_DUINO)
+  delay(1000); // wait to prevent garbage on SERIAL_PORT_MONITOR
+#endif
+  SERIAL_PORT_MONITOR.begin(115200);
+  while (!SERIAL_PORT_MONITOR); // Leonardo/Micro
+#if defined(EPOXY_DUINO)
+  SERIAL_PORT_MONITOR.setLineModeUnix();
+#endif
+}
+
+void loop() {
+  aunit::TestRunner::run();
+}
@@ -0,0 +1,215 @@
+#line 2 "SwappableZoneDatabaseTest.ino"
+
+#include <AUnitVerbose.h>
+#include <AceTime.h>
+#include <testingzonedbc/zone_infos.h>
+#include <testingzonedbc/zone_registry.h>
+#if defined(EPOXY_DUINO)
+  #include <atomic>
+  #include <thread>
+#endif
+
+using namespace ace_time;
+using ace_time::zonedbc::kZoneIdAmerica_Los_Angeles;
+
+#if ACE_TIME_HAS_ATOMIC
+
+// Two different versions of the database: the full 'zonedbc', and the 16
+// zones and links of 'testingzonedbc'. Both are 4-byte aligned.
+static uint32_t bufferFull[48 * 1024];
+static size_t sizeFull;
+static uint32_t bufferSmall[4 * 1024];
+static size_t sizeSmall;
+
+static void writeDatabases() {
+  if (sizeFull != 0) return;
+  sizeFull = MappedZoneDatabaseWriter(
+      zonedbc::kZoneAndLinkRegistrySize, zonedbc::kZoneAndLinkRegistry)
+      .writeTo((uint8_t*) bufferFull, sizeof(bufferFull));
+  sizeSmall = MappedZoneDatabaseWriter(
+      testingzonedbc::kZoneAndLinkRegistrySize,
+      testingzonedbc::kZoneAndLinkRegistry)
+      .writeTo((uint8_t*) bufferSmall, sizeof(bufferSmall));
+}
+
+static int32_t offsetMinutes(const TimeZone& tz, int16_t year, uint8_t month) {
+  return ZonedDateTime::forComponents(year, month, 1, 12, 0, 0, tz)
+      .timeOffset().toMinutes();
+}
+
+//---------------------------------------------------------------------------
+
+test(SwappableZoneDatabaseTest, acquireBeforePublish) {
+  SwappableZoneDatabase<2> database;
+  assertEqual((uint32_t) 0, database.generation());
+
+  ZoneDatabaseSnapshot snapshot = database.acquire();
+  assertFalse(snapshot.isValid());
+  assertEqual((uint32_t) 0, snapshot.generation());
+  assertEqual(0, snapshot.zoneRegistrySize());
+
+  SwappableZoneManager<2> manager(database);
+  assertTrue(manager.createForZoneName(snapshot, "America/Los_Angeles")
+      .isError());
+}
+
+test(SwappableZoneDatabaseTest, publishAndSwap) {
+  writeDatabases();
+  SwappableZoneDatabase<2> database;
+  SwappableZoneManager<4> manager(database);
+
+  assertEqual(MappedZoneDatabase::kStatusOk,
+      database.publishBuffer(bufferFull, sizeFull));
+  assertEqual((uint32_t) 1, database.generation());
+
+  // A TimeZone of generation 1.
+  ZoneDatabaseSnapshot snapshot1 = manager.acquire();
+  assertEqual((uint32_t) 1, snapshot1.generation());
+  assertEqual(zonedbc::kZoneAndLinkRegistrySize,
+      snapshot1.zoneRegistrySize());
+  TimeZone tz1 = manager.createForZoneName(snapshot1, "America/Los_Angeles");
+  assertFalse(tz1.isError());
+  assertEqual(-7*60, offsetMinutes(tz1, 2023, 7));
+
+  // Swap to generation 2, while generation 1 is still held.
+  assertEqual(MappedZoneDatabase::kStatusOk,
+      database.publishBuffer(bufferSmall, sizeSmall));
+  assertEqual((uint32_t) 2, database.generation());
+  ZoneDatabaseSnapshot snapshot2 = manager.acquire();
+  assertEqual((uint32_t) 2, snapshot2.generation());
+  assertEqual(testingzonedbc::kZoneAndLinkRegistrySize,
+      snapshot2.zoneRegistrySize());
+  TimeZone tz2 = manager.createForZoneId(snapshot2,
+      kZoneIdAmerica_Los_Angeles);
+  assertFalse(tz2.isError());
+  assertEqual((uint32_t) 2, manager.generation());
+  assertTrue(manager.createForZoneName(snapshot2, "Europe/Paris").isError());
+
+  // Both TimeZones resolve against their own generation.
+  assertEqual(-8*60, offsetMinutes(tz1, 2023, 1));
+  assertEqual(-8*60, offsetMinutes(tz2, 2023, 1));
+  assertFalse(manager.createForZoneName(snapshot1, "Europe/Paris").isError());
+  assertEqual((uint32_t) 2, manager.generation());
+
+  // Both versions are in use, so nothing can be published.
+  assertEqual(SwappableZoneDatabaseBase::kStatusBusy,
+      database.publishBuffer(bufferFull, sizeFull));
+  assertEqual(0, database.reclaim());
+
+  // Releasing generation 1 allows its version to be reused.
+  snapshot1.release();
+  assertFalse(snapshot1.isValid());
+  assertEqual(MappedZoneDatabase::kStatusOk,
+      database.publishBuffer(bufferFull, sizeFull));
+  assertEqual((uint32_t) 3, database.generation());
+
+  // Generation 3 reuses the buffer of generation 1, so its zoneKeys are
+  // identical, and the cache must have been cleared.
+  ZoneDatabaseSnapshot snapshot3 = manager.acquire();
+  TimeZone tz3 = manager.createForZoneName(snapshot3, "America/Los_Angeles");
+  assertEqual((uint32_t) 3, manager.generation());
+  assertEqual(-7*60, offsetMinutes(tz3, 2023, 7));
+
+  // Generation 2 is no longer current, and can be reclaimed after release.
+  assertEqual(0, database.reclaim());
+  snapshot2.release();
+  assertEqual(1, database.reclaim());
+  assertEqual(0, database.reclaim());
+
+  // A failed publish does not change the current version.
+  assertEqual(MappedZoneDatabase::kStatusBadSize,
+      database.publishBuffer(bufferFull, 16));
+  assertEqual((uint32_t) 3, database.generation());
+  assertEqual(-8*60, offsetMinutes(tz3, 2023, 1));
+}
+
+test(SwappableZoneDatabaseTest, snapshotMove) {
+  writeDatabases();
+  SwappableZoneDatabase<2> database;
+  database.publishBuffer(bufferSmall, sizeSmall);
+
+  ZoneDatabaseSnapshot snapshot = database.acquire();
+  ZoneDatabaseSnapshot moved(static_cast<ZoneDatabaseSnapshot&&>(snapshot));
+  assertFalse(snapshot.isValid());
+  assertTrue(moved.isValid());
+  snapshot = static_cast<ZoneDatabaseSnapshot&&>(moved);
+  assertTrue(snapshot.isValid());
+  assertFalse(moved.isValid());
+
+  // Only one reader is counted, so one release frees the old version.
+  database.publishBuffer(bufferFull, sizeFull);
+  assertEqual(SwappableZoneDatabaseBase::kStatusBusy,
+      database.publishBuffer(bufferSmall, sizeSmall));
+  snapshot.release();
+  assertEqual(MappedZoneDatabase::kStatusOk,
+      database.publishBuffer(bufferSmall, sizeSmall));
+}
+
+#if defined(EPOXY_DUINO)
+
+// Reader threads convert timestamps continuously while the main thread swaps
+// between the two versions of the database.
+test(SwappableZoneDatabaseTest, concurrentSwaps) {
+  writeDatabases();
+  static SwappableZoneDatabase<4> database;
+  database.publishBuffer(bufferFull, sizeFull);
+
+  const uint8_t kNumThreads = 3;
+  std::atomic<bool> done{false};
+  std::atomic<uint32_t> numErrors{0};
+  std::atomic<uint32_t> numLookups{0};
+  std::thread threads[kNumThreads];
+  for (uint8_t t = 0; t < kNumThreads; t++) {
+    threads[t] = std::thread([&]() {
+      SwappableZoneManager<4> manager(database);
+      while (! done.load()) {
+        ZoneDatabaseSnapshot snapshot = manager.acquire();
+        TimeZone tz = manager.createForZoneId(
+            snapshot, kZoneIdAmerica_Los_Angeles);
+        if (tz.isError()
+            || offsetMinutes(tz, 2023, 7) != -7*60
+            || offsetMinutes(tz, 2023, 1) != -8*60) {
+          numErrors.fetch_add(1);
+        }
+        numLookups.fetch_add(1);
+      }
+    });
+  }
+
+  uint16_t numSwaps = 0;
+  while (numSwaps < 200) {
+    uint8_t status = (numSwaps % 2 == 0)
+        ? database.publishBuffer(bufferSmall, sizeSmall)
+        : database.publishBuffer(bufferFull, sizeFull);
+    if (status == MappedZoneDatabase::kStatusOk) numSwaps++;
+    std::this_thread::yield();
+  }
+  done.store(true);
+  for (uint8_t t = 0; t < kNumThreads; t++) {
+    threads[t].join();
+  }
+
+  assertEqual((uint32_t) 0, numErrors.load());
+  assertTrue(numLookups.load() > 0);
+}
+
+#endif
+
+#endif
+
+//---------------------------------------------------------------------------
+
+void setup() {
+#if ! defined(EPOXY_DUINO)
+  delay(1000); // wait to prevent garbage on SERIAL_PORT_MONITOR
+#endif
+  SERIAL_PORT_MONITOR.begin(115200);
+  while (!SERIAL_PORT_MONITOR); // Leonardo/Micro
+#if defined(EPOXY_DUINO)
+  SERIAL_PORT_MONITOR.setLineModeUnix();
+#endif
+}
+
+void loop() {
+  aunit::TestRunner::run();
+}
@@ -0,0 +1,135 @@
+#line 2 "ThreadLocalZoneProcessorTest.ino"
+
+#include <AUnitVerbose.h>
+#include <AceTime.h>
+#include <testingzonedbx/zone_infos.h>
+#include <testingzonedbx/zone_registry.h>
+#if defined(EPOXY_DUINO)
+  #include <thread>
+#endif
+
+using namespace ace_time;
+using ace_time::testingzonedbx::kZoneAmerica_Los_Angeles;
+using ace_time::testingzonedbx::kZoneAustralia_Darwin;
+using ace_time::testingzonedbx::kZoneRegistry;
+using ace_time::testingzonedbx::kZoneRegistrySize;
+
+//---------------------------------------------------------------------------
+
+static bool findResultEquals(const FindResult& a, const FindResult& b) {
+  return a.type == b.type
+      && a.fold == b.fold
+      && a.stdOffsetSeconds == b.stdOffsetSeconds
+      && a.dstOffsetSeconds == b.dstOffsetSeconds
+      && strcmp(a.abbrev, b.abbrev) == 0;
+}
+
+test(ThreadLocalZoneProcessorTest, findByEpochSeconds) {
+  ThreadLocalExtendedZoneProcessor<2> zoneProcessor(&kZoneAmerica_Los_Angeles);
+  ExtendedZoneProcessor reference(&kZoneAmerica_Los_Angeles);
+  assertEqual(ThreadLocalExtendedZoneProcessor<2>::kTypeThreadLocalExtended,
+      zoneProcessor.getType());
+  assertEqual(reference.getZoneId(), zoneProcessor.getZoneId());
+
+  acetime_t epochSeconds = OffsetDateTime::forComponents(
+      2018, 11, 4, 1, 30, 0, TimeOffset::forHours(-7)).toEpochSeconds();
+  for (int i = 0; i < 4; i++) {
+    acetime_t seconds = epochSeconds + i * 1800;
+    FindResult expected = reference.findByEpochSeconds(seconds);
+    FindResult result = zoneProcessor.findByEpochSeconds(seconds);
+    assertTrue(findResultEquals(expected, result));
+  }
+
+  LocalDateTime ldt = LocalDateTime::forComponents(2018, 3, 11, 2, 30, 0);
+  assertTrue(findResultEquals(
+      reference.findByLocalDateTime(ldt),
+      zoneProcessor.findByLocalDateTime(ldt)));
+}
+
+test(ThreadLocalZoneProcessorTest, sharesThreadCache) {
+  ThreadLocalExtendedZoneProcessor<2> losAngeles(&kZoneAmerica_Los_Angeles);
+  ThreadLocalExtendedZoneProcessor<2> darwin(&kZoneAustralia_Darwin);
+
+  // Both instances use the same per-thread cache, with a different
+  // ZoneProcessor for each zone.
+  ExtendedZoneProcessor* p1 = losAngeles.getLocalZoneProcessor();
+  ExtendedZoneProcessor* p2 = darwin.getLocalZoneProcessor();
+  assertNotEqual(p1, p2);
+  assertTrue(p1->equalsZoneKey((uintptr_t) &kZoneAmerica_Los_Angeles));
+  assertTrue(p2->equalsZoneKey((uintptr_t) &kZoneAustralia_Darwin));
+
+  // Changing the zone of an instance only changes its key.
+  darwin.setZoneKey((uintptr_t) &kZoneAmerica_Los_Angeles);
+  assertTrue(darwin == losAngeles);
+  assertEqual(p1, darwin.getLocalZoneProcessor());
+}
+
+test(ThreadLocalZoneProcessorTest, timeZone) {
+  ThreadLocalExtendedZoneProcessor<2> zoneProcessor;
+  TimeZone tz = TimeZone::forZoneInfo(
+      &kZoneAmerica_Los_Angeles, &zoneProcessor);
+  ZonedDateTime zdt = ZonedDateTime::forComponents(2018, 7, 1, 0, 0, 0, tz);
+  assertEqual(-7 * 60, zdt.timeOffset().toMinutes());
+}
+
+#if defined(EPOXY_DUINO)
+
+test(ThreadLocalZoneProcessorTest, multipleThreads) {
+  // Share a single TimeZone for each zone across all threads.
+  static ThreadLocalExtendedZoneProcessor<4> zoneProcessors[kZoneRegistrySize];
+  TimeZone timeZones[kZoneRegistrySize];
+  for (uint16_t i = 0; i < kZoneRegistrySize; i++) {
+    timeZones[i] = TimeZone::forZoneInfo(kZoneRegistry[i], &zoneProcessors[i]);
+  }
+
+  const uint8_t kNumThreads = 4;
+  const uint16_t kNumSamples = 500;
+  static int32_t offsets[kNumThreads][kNumSamples];
+  acetime_t start = LocalDate::forComponents(2000, 1, 1).toEpochSeconds();
+
+  std::thread threads[kNumThreads];
+  for (uint8_t t = 0; t < kNumThreads; t++) {
+    threads[t] = std::thread([&timeZones, start, t]() {
+      for (uint16_t n = 0; n < kNumSamples; n++) {
+        const TimeZone& tz = timeZones[(n + t) % kZoneRegistrySize];
+        acetime_t seconds = start + (acetime_t) n * 86400 * 29;
+        offsets[t][n] = tz.getOffsetDateTime(seconds)
+            .timeOffset().toSeconds();
+      }
+    });
+  }
+  for (uint8_t t = 0; t < kNumThreads; t++) {
+    threads[t].join();
+  }
+
+  // Compare against a single-threaded ExtendedZoneProcessor.
+  ExtendedZoneProcessor reference;
+  for (uint8_t t = 0; t < kNumThreads; t++) {
+    for (uint16_t n = 0; n < kNumSamples; n++) {
+      TimeZone tz = TimeZone::forZoneInfo(
+          kZoneRegistry[(n + t) % kZoneRegistrySize], &reference);
+      acetime_t seconds = start + (acetime_t) n * 86400 * 29;
+      assertEqual(tz.getOffsetDateTime(seconds).timeOffset().toSeconds(),
+          offsets[t][n]);
+    }
+  }
+}
+
+#endif
+
+//---------------------------------------------------------------------------
+
+void setup() {
+#if ! defined(EPOXY_DUINO)
+  delay(1000); // wait to prevent garbage on SERIAL_PORT_MONITOR
+#endif
+  SERIAL_PORT_MONITOR.begin(115200);
+  while (!SERIAL_PORT_MONITOR); // Leonardo/Micro
+#if defined(EPOXY_DUINO)
+  SERIAL_PORT_MONITOR.setLineModeUnix();
+#endif
+}
+
+void loop() {
+  aunit::TestRunner::run();
+}
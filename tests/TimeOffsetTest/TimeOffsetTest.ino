@@ -123,6 +123,35 @@ test(TimeOffsetTest, printTo) {
   assertEqual(str.cstr(), "-01:02:03");
 }
 
+test(TimeOffsetTest, formatTo) {
+  char buf[TimeOffset::kFormatBufferSize];
+  assertEqual((size_t) 6,
+      TimeOffset::forHourMinuteSecond(1, 2, 0).formatTo(buf, sizeof(buf)));
+  assertEqual(buf, "+01:02");
+  assertEqual((size_t) 9,
+      TimeOffset::forHourMinuteSecond(-1, -2, -3).formatTo(buf, sizeof(buf)));
+  assertEqual(buf, "-01:02:03");
+  assertEqual((size_t) 6, TimeOffset().formatTo(buf, sizeof(buf)));
+  assertEqual(buf, "+00:00");
+
+  // buffer too small for the seconds
+  assertEqual((size_t) 0,
+      TimeOffset::forHourMinuteSecond(1, 2, 3).formatTo(buf, 9));
+  assertEqual(buf, "");
+  assertEqual((size_t) 0, TimeOffset::forError().formatTo(buf, sizeof(buf)));
+
+  // "hh" cannot hold 100 hours or more
+  assertEqual((size_t) 9,
+      TimeOffset::forSeconds(-(99 * 3600 + 59 * 60 + 59))
+          .formatTo(buf, sizeof(buf)));
+  assertEqual(buf, "-99:59:59");
+  assertEqual((size_t) 0,
+      TimeOffset::forSeconds(100 * 3600).formatTo(buf, sizeof(buf)));
+  assertEqual(buf, "");
+  assertEqual((size_t) 0,
+      TimeOffset::forSeconds(-1000 * 3600).formatTo(buf, sizeof(buf)));
+}
+
 test(TimeOffsetTest, toHourMinute) {
   int8_t hour;
   int8_t minute;
@@ -611,6 +611,66 @@ test(TimeZoneExtendedTest, link) {
   assertEqual(F("PDT"), ze.abbrev());
 }
 
+test(TimeZoneExtendedTest, nextTransition_prevTransition) {
+  ExtendedZoneProcessor zoneProcessor;
+  TimeZone tz = TimeZone::forZoneInfo(
+      &testingzonedbx::kZoneAmerica_Los_Angeles,
+      &zoneProcessor);
+
+  // 2018-03-11 02:00 PST, spring forward to PDT
+  acetime_t springForward = OffsetDateTime::forComponents(
+      2018, 3, 11, 2, 0, 0, TimeOffset::forHours(-8)).toEpochSeconds();
+  // 2018-11-04 02:00 PDT, fall back to PST
+  acetime_t fallBack = OffsetDateTime::forComponents(
+      2018, 11, 4, 2, 0, 0, TimeOffset::forHours(-7)).toEpochSeconds();
+
+  ZoneTransition transition = tz.nextTransition(springForward - 1);
+  assertFalse(transition.isError());
+  assertEqual(springForward, transition.epochSeconds);
+  assertEqual((int32_t) -8*3600, transition.stdOffsetSecondsBefore);
+  assertEqual((int32_t) 0, transition.dstOffsetSecondsBefore);
+  assertEqual((int32_t) -8*3600, transition.stdOffsetSecondsAfter);
+  assertEqual((int32_t) 1*3600, transition.dstOffsetSecondsAfter);
+  assertEqual("PST", transition.abbrevBefore);
+  assertEqual("PDT", transition.abbrevAfter);
+
+  // The next transition is strictly after the given time.
+  transition = tz.nextTransition(springForward);
+  assertEqual(fallBack, transition.epochSeconds);
+  assertEqual("PDT", transition.abbrevBefore);
+  assertEqual("PST", transition.abbrevAfter);
+
+  // The previous transition is at or before the given time.
+  transition = tz.prevTransition(springForward);
+  assertEqual(springForward, transition.epochSeconds);
+  transition = tz.prevTransition(springForward - 1);
+  assertEqual("PDT", transition.abbrevBefore);
+  assertEqual("PST", transition.abbrevAfter);
+  assertEqual(
+      OffsetDateTime::forComponents(2017, 11, 5, 2, 0, 0,
+          TimeOffset::forHours(-7)).toEpochSeconds(),
+      transition.epochSeconds);
+
+  // Crosses into the next year.
+  transition = tz.nextTransition(fallBack);
+  assertEqual(
+      OffsetDateTime::forComponents(2019, 3, 10, 2, 0, 0,
+          TimeOffset::forHours(-8)).toEpochSeconds(),
+      transition.epochSeconds);
+
+  // Australia/Darwin has not changed since 1944.
+  TimeZone darwin = TimeZone::forZoneInfo(
+      &testingzonedbx::kZoneAustralia_Darwin,
+      &zoneProcessor);
+  assertTrue(darwin.nextTransition(springForward).isError());
+  assertTrue(darwin.prevTransition(springForward).isError());
+
+  // Manual zones never change.
+  TimeZone manual = TimeZone::forHours(-8);
+  assertTrue(manual.nextTransition(springForward).isError());
+  assertTrue(manual.prevTransition(springForward).isError());
+}
+
 //---------------------------------------------------------------------------
 // TimeZone (CompleteZoneProcessor::kTypeComplete)
 //---------------------------------------------------------------------------
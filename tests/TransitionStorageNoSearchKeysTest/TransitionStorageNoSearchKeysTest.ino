@@ -0,0 +1,9 @@
+#line 2 "TransitionStorageNoSearchKeysTest.ino"
+
+/*
+ * Runs the tests of TransitionStorageTest with
+ * ACE_TIME_TRANSITION_SEARCH_KEYS set to 0 by the Makefile, which is the
+ * Transition layout of the microcontrollers other than the ESP32.
+ */
+
+#include "../TransitionStorageTest/TransitionStorageTest.ino"
@@ -289,7 +289,7 @@ test(TransitionStorageTest, resetCandidatePool) {
 
 //---------------------------------------------------------------------------
 
-test(TransitionStorageTest, findTransitionForSeconds) {
+test(TransitionStorageTest, findTransitionForSecondsFrom) {
   TransitionStorage storage;
   using TransitionForSeconds = TransitionStorage::TransitionForSeconds;
   storage.init();
@@ -313,37 +313,57 @@ test(TransitionStorageTest, findTransitionForSeconds) {
   freeAgent->startEpochSeconds = 2002000; // synthetic epochSeconds
   storage.addFreeAgentToCandidatePool();
 
-  // Add the actives to the Active pool.
+  // Add the actives to the Active pool, then copy them into the search
+  // arrays.
   storage.addActiveCandidatesToActivePool();
+  storage.compactActivePool();
 
-  // Check that we can find the transitions using the startEpochSeconds.
+  // Check that we can find the transitions using the startEpochSeconds,
+  // starting each scan from the first transition.
 
   // epochSeconds=1 far past
+  uint8_t index = 0;
   TransitionForSeconds transitionForSeconds =
-      storage.findTransitionForSeconds(1);
+      storage.findTransitionForSecondsFrom(1, &index);
   const Transition* t = transitionForSeconds.curr;
   assertEqual(t, nullptr);
+  assertEqual(0, index);
 
   // epochSeconds=2000001 found
-  transitionForSeconds = storage.findTransitionForSeconds(2000001);
+  index = 0;
+  transitionForSeconds = storage.findTransitionForSecondsFrom(2000001, &index);
   t = transitionForSeconds.curr;
   assertEqual(2000, t->transitionTime.year);
+  assertEqual(0, index);
 
   // epochSeconds=2001000 found
-  transitionForSeconds = storage.findTransitionForSeconds(2001000);
+  index = 0;
+  transitionForSeconds = storage.findTransitionForSecondsFrom(2001000, &index);
   t = transitionForSeconds.curr;
   assertEqual(2001, t->transitionTime.year);
+  assertEqual(1, index);
 
   // epochSeconds=2002000 found
-  transitionForSeconds = storage.findTransitionForSeconds(2002000);
+  index = 0;
+  transitionForSeconds = storage.findTransitionForSecondsFrom(2002000, &index);
   t = transitionForSeconds.curr;
   assertEqual(2002, t->transitionTime.year);
+  assertEqual(2, index);
 
   // epochSeconds=3000000 far future, matches the last transition
-  transitionForSeconds = storage.findTransitionForSeconds(3000000);
+  index = 0;
+  transitionForSeconds = storage.findTransitionForSecondsFrom(3000000, &index);
   t = transitionForSeconds.curr;
   assertNotEqual(t, nullptr);
   assertEqual(2002, t->transitionTime.year);
+  assertEqual(2, index);
+
+  // Resuming from a later index finds an earlier transition too.
+  index = 2;
+  transitionForSeconds = storage.findTransitionForSecondsFrom(2000001, &index);
+  t = transitionForSeconds.curr;
+  assertEqual(2000, t->transitionTime.year);
+  assertEqual(0, index);
 }
 
 test(TransitionStorageTest, findTransitionForDateTime) {
@@ -355,6 +375,10 @@ test(TransitionStorageTest, findTransitionForDateTime) {
   freeAgent->transitionTime = {2000, 1, 2, 1*60*60, kSuffixW};
   freeAgent->startDateTime = freeAgent->transitionTime;
   freeAgent->untilDateTime = {2001, 4, 1, 2*60*60, kSuffixW};
+#if ACE_TIME_TRANSITION_SEARCH_KEYS
+  freeAgent->packedStartDateTime = packDateTuple(freeAgent->startDateTime);
+  freeAgent->packedUntilDateTime = packDateTuple(freeAgent->untilDateTime);
+#endif
   freeAgent->compareStatus = CompareStatus::kWithinMatch;
   storage.addFreeAgentToCandidatePool();
 
@@ -364,6 +388,10 @@ test(TransitionStorageTest, findTransitionForDateTime) {
   freeAgent->transitionTime = {2001, 4, 1, 3*60*60, kSuffixW};
   freeAgent->startDateTime = freeAgent->transitionTime;
   freeAgent->untilDateTime = {2002, 10, 27, 2*60*60, kSuffixW};
+#if ACE_TIME_TRANSITION_SEARCH_KEYS
+  freeAgent->packedStartDateTime = packDateTuple(freeAgent->startDateTime);
+  freeAgent->packedUntilDateTime = packDateTuple(freeAgent->untilDateTime);
+#endif
   freeAgent->compareStatus = CompareStatus::kWithinMatch;
   storage.addFreeAgentToCandidatePool();
 
@@ -373,6 +401,10 @@ test(TransitionStorageTest, findTransitionForDateTime) {
   freeAgent->transitionTime = {2002, 10, 27, 1*60*60, kSuffixW};
   freeAgent->startDateTime = freeAgent->transitionTime;
   freeAgent->untilDateTime = {2003, 12, 13, 0, kSuffixW};
+#if ACE_TIME_TRANSITION_SEARCH_KEYS
+  freeAgent->packedStartDateTime = packDateTuple(freeAgent->startDateTime);
+  freeAgent->packedUntilDateTime = packDateTuple(freeAgent->untilDateTime);
+#endif
   freeAgent->compareStatus = CompareStatus::kWithinMatch;
   storage.addFreeAgentToCandidatePool();
 
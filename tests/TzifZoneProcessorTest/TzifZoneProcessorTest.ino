@@ -0,0 +1,459 @@
+#line 2 "TzifZoneProcessorTest.ino"
+
+#include <stdio.h> // snprintf()
+#include <string.h> // strcmp(), strlen(), memcpy()
+#include <AUnitVerbose.h>
+#include <AceCommon.h> // PrintStr<>
+#include <AceTime.h>
+
+using ace_common::PrintStr;
+using namespace ace_time;
+using ace_time::zonedbc::kZoneIdAmerica_Los_Angeles;
+
+//---------------------------------------------------------------------------
+// A hand-built TZif version 2 file for a zone "Test/Zone" at UTC-08:00, with
+// DST (UTC-07:00) from 2000-04-02 02:00 to 2000-10-29 02:00, and the same
+// rules in the footer for later years.
+//---------------------------------------------------------------------------
+
+static const char kFooter[] = "\nTST8TDT,M4.1.0,M10.5.0\n";
+
+static uint8_t* writeUint32(uint8_t* p, uint32_t value) {
+  *p++ = value >> 24;
+  *p++ = value >> 16;
+  *p++ = value >> 8;
+  *p++ = value;
+  return p;
+}
+
+static uint8_t* writeHeader(uint8_t* p, char version, uint32_t leapcnt,
+    uint32_t timecnt, uint32_t typecnt, uint32_t charcnt) {
+  memcpy(p, "TZif", 4);
+  p[4] = version;
+  memset(p + 5, 0, 15);
+  p += 20;
+  p = writeUint32(p, 0); // isutcnt
+  p = writeUint32(p, 0); // isstdcnt
+  p = writeUint32(p, leapcnt);
+  p = writeUint32(p, timecnt);
+  p = writeUint32(p, typecnt);
+  p = writeUint32(p, charcnt);
+  return p;
+}
+
+static uint8_t* writeTimeType(uint8_t* p, int32_t utoff, uint8_t isdst,
+    uint8_t desigidx) {
+  p = writeUint32(p, (uint32_t) utoff);
+  *p++ = isdst;
+  *p++ = desigidx;
+  return p;
+}
+
+// Write the TZif file into buffer and return its size. The version and the
+// leapcnt can be changed to create invalid files.
+static size_t buildTzif(uint8_t* buffer, char version = '2',
+    uint32_t leapcnt = 0) {
+  uint8_t* p = buffer;
+
+  // Minimal version 1 block, which is skipped by the reader.
+  p = writeHeader(p, version, 0, 0, 1, 1);
+  p = writeTimeType(p, 0, 0, 0);
+  *p++ = '\0';
+
+  // Version 2 block with 64-bit transition times.
+  p = writeHeader(p, version, leapcnt, 2, 2, 8);
+  int64_t times[2] = {
+    LocalDateTime::forComponents(2000, 4, 2, 10, 0, 0).toUnixSeconds64(),
+    LocalDateTime::forComponents(2000, 10, 29, 9, 0, 0).toUnixSeconds64(),
+  };
+  for (int64_t t : times) {
+    p = writeUint32(p, (uint32_t) ((uint64_t) t >> 32));
+    p = writeUint32(p, (uint32_t) t);
+  }
+  *p++ = 1; // type index of each transition
+  *p++ = 0;
+  p = writeTimeType(p, -8 * 3600, 0, 0);
+  p = writeTimeType(p, -7 * 3600, 1, 4);
+  memcpy(p, "TST\0TDT\0", 8);
+  p += 8;
+  for (uint32_t i = 0; i < leapcnt * 12; i++) *p++ = 0;
+  memcpy(p, kFooter, strlen(kFooter));
+  p += strlen(kFooter);
+  return p - buffer;
+}
+
+static uint8_t tzifBuffer[512];
+
+// Return true if the result has the expected type, fold, offsets and abbrev.
+static bool isFindResult(const FindResult& result, uint8_t type, uint8_t fold,
+    int32_t stdMinutes, int32_t dstMinutes,
+    int32_t reqStdMinutes, int32_t reqDstMinutes, const char* abbrev) {
+  return result.type == type
+      && result.fold == fold
+      && result.stdOffsetSeconds == stdMinutes * 60
+      && result.dstOffsetSeconds == dstMinutes * 60
+      && result.reqStdOffsetSeconds == reqStdMinutes * 60
+      && result.reqDstOffsetSeconds == reqDstMinutes * 60
+      && strcmp(result.abbrev, abbrev) == 0;
+}
+
+// Return true if the two FindResults are identical.
+static bool equalsFindResult(const FindResult& a, const FindResult& b) {
+  return a.type == b.type
+      && a.fold == b.fold
+      && a.stdOffsetSeconds == b.stdOffsetSeconds
+      && a.dstOffsetSeconds == b.dstOffsetSeconds
+      && a.reqStdOffsetSeconds == b.reqStdOffsetSeconds
+      && a.reqDstOffsetSeconds == b.reqDstOffsetSeconds
+      && strcmp(a.abbrev, b.abbrev) == 0;
+}
+
+// Return the UTC offset in minutes of the PosixTimeZone at the given UTC.
+static int32_t posixOffsetMinutes(const PosixTimeZone& tz,
+    int16_t year, uint8_t month, uint8_t day, uint8_t hour, uint8_t minute) {
+  PosixTimeZone::LocalTimeType type;
+  tz.findForUnixSeconds(
+      LocalDateTime::forComponents(year, month, day, hour, minute, 0)
+          .toUnixSeconds64(),
+      type);
+  return type.utcOffsetSeconds / 60;
+}
+
+//---------------------------------------------------------------------------
+
+test(PosixTimeZoneTest, parse) {
+  PosixTimeZone tz;
+  const char s1[] = "PST8PDT,M3.2.0,M11.1.0";
+  assertTrue(tz.parse(s1, strlen(s1)));
+  assertTrue(tz.hasDst());
+  assertEqual(-8 * 3600, tz.stdOffsetSeconds());
+  assertEqual(-7 * 3600, tz.dstOffsetSeconds());
+  assertEqual("PST", tz.stdAbbrev());
+  assertEqual("PDT", tz.dstAbbrev());
+
+  // Quoted abbreviations, minutes, and no DST.
+  const char s2[] = "<+0530>-5:30";
+  assertTrue(tz.parse(s2, strlen(s2)));
+  assertFalse(tz.hasDst());
+  assertEqual(5 * 3600 + 30 * 60, tz.stdOffsetSeconds());
+  assertEqual("+0530", tz.stdAbbrev());
+  assertEqual("", tz.dstAbbrev());
+
+  // The string does not need to be NUL-terminated.
+  assertTrue(tz.parse("UTC0\n", 4));
+  assertEqual(0, tz.stdOffsetSeconds());
+
+  // Default DST offset and rules.
+  const char s3[] = "EST5EDT";
+  assertTrue(tz.parse(s3, strlen(s3)));
+  assertTrue(tz.hasDst());
+  assertEqual(-4 * 3600, tz.dstOffsetSeconds());
+  assertEqual(-4 * 60, posixOffsetMinutes(tz, 2023, 7, 1, 0, 0));
+
+  // Invalid strings.
+  const char* const invalids[] = {
+    "", "8", "PST", "PST25", "PST8PDT,M3.2.0", "PST8PDT,M13.2.0,M11.1.0",
+    "PST8PDT,M3.6.0,M11.1.0", "PST8PDT,M3.2.0,M11.1.0x", "<PST8",
+    "PST8PDT,J0,J365",
+  };
+  for (const char* s : invalids) {
+    assertFalse(tz.parse(s, strlen(s)));
+    assertFalse(tz.isValid());
+  }
+}
+
+test(PosixTimeZoneTest, findForUnixSeconds) {
+  PosixTimeZone tz;
+
+  // Northern hemisphere. DST starts at 02:00 PST, ends at 02:00 PDT.
+  const char la[] = "PST8PDT,M3.2.0,M11.1.0";
+  assertTrue(tz.parse(la, strlen(la)));
+  assertEqual(-8 * 60, posixOffsetMinutes(tz, 2023, 3, 12, 9, 59));
+  assertEqual(-7 * 60, posixOffsetMinutes(tz, 2023, 3, 12, 10, 0));
+  assertEqual(-7 * 60, posixOffsetMinutes(tz, 2023, 11, 5, 8, 59));
+  assertEqual(-8 * 60, posixOffsetMinutes(tz, 2023, 11, 5, 9, 0));
+
+  // Southern hemisphere, with an explicit end time of 03:00 AEDT.
+  const char sydney[] = "AEST-10AEDT,M10.1.0,M4.1.0/3";
+  assertTrue(tz.parse(sydney, strlen(sydney)));
+  assertEqual(11 * 60, posixOffsetMinutes(tz, 2023, 1, 15, 0, 0));
+  assertEqual(11 * 60, posixOffsetMinutes(tz, 2023, 4, 1, 15, 59));
+  assertEqual(10 * 60, posixOffsetMinutes(tz, 2023, 4, 1, 16, 0));
+  assertEqual(10 * 60, posixOffsetMinutes(tz, 2023, 7, 1, 0, 0));
+  assertEqual(10 * 60, posixOffsetMinutes(tz, 2023, 9, 30, 15, 59));
+  assertEqual(11 * 60, posixOffsetMinutes(tz, 2023, 9, 30, 16, 0));
+
+  // Negative transition times of TZif version 3 (America/Nuuk).
+  const char nuuk[] = "<-02>2<-01>,M3.5.0/-1,M10.5.0/0";
+  assertTrue(tz.parse(nuuk, strlen(nuuk)));
+  assertEqual(-2 * 60, posixOffsetMinutes(tz, 2023, 3, 26, 0, 59));
+  assertEqual(-1 * 60, posixOffsetMinutes(tz, 2023, 3, 26, 1, 0));
+
+  // Permanent DST of TZif version 3.
+  const char permanent[] = "<+03>-3<+04>,0/0,J365/25";
+  assertTrue(tz.parse(permanent, strlen(permanent)));
+  assertEqual(4 * 60, posixOffsetMinutes(tz, 2023, 1, 1, 0, 0));
+  assertEqual(4 * 60, posixOffsetMinutes(tz, 2024, 12, 31, 23, 59));
+}
+
+test(TzifZoneInfoTest, initFromBuffer) {
+  TzifZoneInfo zoneInfo;
+  assertFalse(zoneInfo.isValid());
+  assertEqual(TzifZoneInfo::kStatusNotLoaded, zoneInfo.status());
+
+  size_t size = buildTzif(tzifBuffer);
+  assertEqual(TzifZoneInfo::kStatusOk,
+      zoneInfo.initFromBuffer("Test/Zone", tzifBuffer, size));
+  assertEqual("Test/Zone", zoneInfo.name());
+  assertEqual(ace_common::hashDjb2("Test/Zone"), zoneInfo.zoneId());
+  assertEqual((uint32_t) 2, zoneInfo.numTransitions());
+  assertTrue(zoneInfo.footer().isValid());
+
+  // Truncated data or footer.
+  assertEqual(TzifZoneInfo::kStatusBadSize,
+      zoneInfo.initFromBuffer("Test/Zone", tzifBuffer, 40));
+  assertEqual(TzifZoneInfo::kStatusBadSize,
+      zoneInfo.initFromBuffer("Test/Zone", tzifBuffer, size - 1));
+  assertFalse(zoneInfo.isValid());
+
+  // Invalid names.
+  assertEqual(TzifZoneInfo::kStatusBadName,
+      zoneInfo.initFromBuffer("", tzifBuffer, size));
+  char longName[TzifZoneInfo::kMaxNameSize + 1];
+  memset(longName, 'A', sizeof(longName) - 1);
+  longName[sizeof(longName) - 1] = '\0';
+  assertEqual(TzifZoneInfo::kStatusBadName,
+      zoneInfo.initFromBuffer(longName, tzifBuffer, size));
+
+  // Version 1 files have no 64-bit data.
+  size = buildTzif(tzifBuffer, '\0');
+  assertEqual(TzifZoneInfo::kStatusBadHeader,
+      zoneInfo.initFromBuffer("Test/Zone", tzifBuffer, size));
+
+  // Version 3 files are accepted.
+  size = buildTzif(tzifBuffer, '3');
+  assertEqual(TzifZoneInfo::kStatusOk,
+      zoneInfo.initFromBuffer("Test/Zone", tzifBuffer, size));
+
+  // Leap seconds are not supported.
+  size = buildTzif(tzifBuffer, '2', 1);
+  assertEqual(TzifZoneInfo::kStatusUnsupported,
+      zoneInfo.initFromBuffer("Test/Zone", tzifBuffer, size));
+
+  // Corrupted magic string, or type index out of range.
+  size = buildTzif(tzifBuffer);
+  tzifBuffer[0] = 'X';
+  assertEqual(TzifZoneInfo::kStatusBadHeader,
+      zoneInfo.initFromBuffer("Test/Zone", tzifBuffer, size));
+  size = buildTzif(tzifBuffer);
+  tzifBuffer[51 + 44 + 16] = 2; // first type index of the version 2 block
+  assertEqual(TzifZoneInfo::kStatusBadData,
+      zoneInfo.initFromBuffer("Test/Zone", tzifBuffer, size));
+
+  zoneInfo.close();
+  assertFalse(zoneInfo.isValid());
+  assertEqual("", zoneInfo.name());
+}
+
+test(TzifZoneProcessorTest, findByLocalDateTime) {
+  TzifZoneInfo zoneInfo;
+  size_t size = buildTzif(tzifBuffer);
+  assertEqual(TzifZoneInfo::kStatusOk,
+      zoneInfo.initFromBuffer("Test/Zone", tzifBuffer, size));
+  TzifZoneProcessor processor(&zoneInfo);
+  assertEqual(TzifZoneProcessor::kTypeTzif, processor.getType());
+  assertEqual(zoneInfo.zoneId(), processor.getZoneId());
+  assertFalse(processor.isLink());
+
+  // Exact, before the first transition.
+  auto ldt = LocalDateTime::forComponents(2000, 1, 1, 0, 0, 0);
+  assertTrue(isFindResult(processor.findByLocalDateTime(ldt),
+      FindResult::kTypeExact, 0, -8*60, 0, -8*60, 0, "TST"));
+
+  // Gap at 02:30
+  ldt = LocalDateTime::forComponents(2000, 4, 2, 2, 30, 0, 0 /*fold*/);
+  assertTrue(isFindResult(processor.findByLocalDateTime(ldt),
+      FindResult::kTypeGap, 0, -8*60, 60, -8*60, 0, "TDT"));
+  ldt = LocalDateTime::forComponents(2000, 4, 2, 2, 30, 0, 1 /*fold*/);
+  assertTrue(isFindResult(processor.findByLocalDateTime(ldt),
+      FindResult::kTypeGap, 0, -8*60, 0, -8*60, 60, "TST"));
+
+  // Overlap at 01:30
+  ldt = LocalDateTime::forComponents(2000, 10, 29, 1, 30, 0, 0 /*fold*/);
+  assertTrue(isFindResult(processor.findByLocalDateTime(ldt),
+      FindResult::kTypeOverlap, 0, -8*60, 60, -8*60, 60, "TDT"));
+  ldt = LocalDateTime::forComponents(2000, 10, 29, 1, 30, 0, 1 /*fold*/);
+  assertTrue(isFindResult(processor.findByLocalDateTime(ldt),
+      FindResult::kTypeOverlap, 1, -8*60, 0, -8*60, 0, "TST"));
+
+  // After the last transition, using the footer.
+  ldt = LocalDateTime::forComponents(2030, 7, 1, 0, 0, 0);
+  assertTrue(isFindResult(processor.findByLocalDateTime(ldt),
+      FindResult::kTypeExact, 0, -8*60, 60, -8*60, 60, "TDT"));
+  ldt = LocalDateTime::forComponents(2030, 3, 31, 2, 30, 0);
+  assertEqual(FindResult::kTypeExact, processor.findByLocalDateTime(ldt).type);
+  ldt = LocalDateTime::forComponents(2030, 4, 7, 2, 30, 0);
+  assertEqual(FindResult::kTypeGap, processor.findByLocalDateTime(ldt).type);
+
+  // Unbound processor.
+  TzifZoneProcessor unbound;
+  assertEqual(FindResult::kTypeNotFound,
+      unbound.findByLocalDateTime(ldt).type);
+}
+
+test(TzifZoneProcessorTest, findByEpochSeconds) {
+  TzifZoneInfo zoneInfo;
+  size_t size = buildTzif(tzifBuffer);
+  zoneInfo.initFromBuffer("Test/Zone", tzifBuffer, size);
+  TzifZoneProcessor processor(&zoneInfo);
+
+  // 01:30 TDT and 01:30 TST on 2000-10-29 occur in the overlap.
+  acetime_t first = LocalDateTime::forComponents(2000, 10, 29, 8, 30, 0)
+      .toEpochSeconds();
+  assertTrue(isFindResult(processor.findByEpochSeconds(first),
+      FindResult::kTypeOverlap, 0, -8*60, 60, -8*60, 60, "TDT"));
+  assertTrue(isFindResult(processor.findByEpochSeconds(first + 3600),
+      FindResult::kTypeOverlap, 1, -8*60, 0, -8*60, 0, "TST"));
+  assertTrue(isFindResult(processor.findByEpochSeconds(first + 7200),
+      FindResult::kTypeExact, 0, -8*60, 0, -8*60, 0, "TST"));
+
+  assertEqual(FindResult::kTypeNotFound,
+      processor.findByEpochSeconds(LocalDate::kInvalidEpochSeconds).type);
+}
+
+test(TzifZoneManagerTest, createForTzifData) {
+  size_t size = buildTzif(tzifBuffer);
+  TzifZoneManager<1> manager("/does/not/exist");
+  assertEqual(0, manager.zoneRegistrySize());
+
+  TimeZone tz = manager.createForTzifData("Test/Zone", tzifBuffer, size);
+  assertFalse(tz.isError());
+  assertEqual(TzifZoneProcessor::kTypeTzif, tz.getType());
+  assertEqual(1, manager.zoneRegistrySize());
+  assertEqual(0, manager.indexForZoneName("Test/Zone"));
+
+  ZonedDateTime zdt = ZonedDateTime::forComponents(2023, 7, 1, 12, 0, 0, tz);
+  assertEqual(-7*60, zdt.timeOffset().toMinutes());
+
+  PrintStr<32> printStr;
+  tz.printTo(printStr);
+  assertEqual(F("Test/Zone"), printStr.cstr());
+  printStr.flush();
+  tz.printShortTo(printStr);
+  assertEqual(F("Zone"), printStr.cstr());
+
+  // Already loaded, by name, id, index, and TimeZoneData.
+  assertTrue(tz == manager.createForTzifData("Test/Zone", tzifBuffer, size));
+  assertTrue(tz == manager.createForZoneName("Test/Zone"));
+  assertTrue(tz == manager.createForZoneId(tz.getZoneId()));
+  assertTrue(tz == manager.createForZoneIndex(0));
+  assertTrue(tz == manager.createForTimeZoneData(tz.toTimeZoneData()));
+
+  // Full, not found, or invalid.
+  assertTrue(manager.createForTzifData("Other/Zone", tzifBuffer, size)
+      .isError());
+  assertTrue(manager.createForZoneIndex(1).isError());
+  assertTrue(manager.createForZoneId(0).isError());
+}
+
+#if ACE_TIME_HAS_MMAP
+
+// Compare the TZif files of the operating system against the
+// CompleteZoneProcessor, using the transition table of the files before 2037
+// and mostly the footer after 2037. Skipped if the files are not installed,
+// and limited to zones whose rules have been stable since 2000, so that the
+// comparison does not depend on the version of the TZ Database.
+test(TzifZoneProcessorTest, compareToCompleteZoneProcessor) {
+  static const char* const kNames[] = {
+    "America/Los_Angeles",
+    "America/New_York",
+    "Europe/London",
+    "Australia/Sydney",
+    "Asia/Kolkata",
+  };
+  CompleteZoneProcessor completeProcessor;
+  complete::ZoneRegistrar registrar(
+      zonedbc::kZoneAndLinkRegistrySize, zonedbc::kZoneAndLinkRegistry);
+
+  for (const char* name : kNames) {
+    char path[TzifZoneManagerBase::kMaxPathSize];
+    snprintf(path, sizeof(path), "%s/%s",
+        TzifZoneManagerBase::kDefaultZoneInfoDir, name);
+    TzifZoneInfo zoneInfo;
+    if (zoneInfo.openFile(name, path) != TzifZoneInfo::kStatusOk) continue;
+    TzifZoneProcessor processor(&zoneInfo);
+    completeProcessor.setZoneKey(
+        (uintptr_t) registrar.getZoneInfoForName(name));
+    assertEqual(completeProcessor.getZoneId(), processor.getZoneId());
+
+    for (int16_t year = 2000; year < 2100; year++) {
+      for (uint8_t month = 1; month <= 12; month++) {
+        uint8_t daysInMonth = LocalDate::daysInMonth(year, month);
+        for (uint8_t day = 1; day <= daysInMonth; day += 3) {
+          for (uint8_t hour = 0; hour < 24; hour++) {
+            for (uint8_t fold = 0; fold < 2; fold++) {
+              auto ldt = LocalDateTime::forComponents(
+                  year, month, day, hour, 30, 0, fold);
+              assertTrue(equalsFindResult(
+                  completeProcessor.findByLocalDateTime(ldt),
+                  processor.findByLocalDateTime(ldt)));
+            }
+            acetime_t epochSeconds = LocalDateTime::forComponents(
+                year, month, day, hour, 0, 0).toEpochSeconds();
+            for (acetime_t s = epochSeconds; s < epochSeconds + 3600;
+                s += 1800) {
+              assertTrue(equalsFindResult(
+                  completeProcessor.findByEpochSeconds(s),
+                  processor.findByEpochSeconds(s)));
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+test(TzifZoneManagerTest, createForZoneName) {
+  TzifZoneManager<2> manager;
+  TimeZone tz = manager.createForZoneName("America/Los_Angeles");
+  if (tz.isError()) return; // TZif files not installed
+  assertEqual(kZoneIdAmerica_Los_Angeles, tz.getZoneId());
+  assertFalse(tz.isLink());
+
+  ZonedDateTime zdt = ZonedDateTime::forComponents(2023, 7, 1, 12, 0, 0, tz);
+  assertEqual(-7*60, zdt.timeOffset().toMinutes());
+  zdt = ZonedDateTime::forComponents(2023, 1, 1, 12, 0, 0, tz);
+  assertEqual(-8*60, zdt.timeOffset().toMinutes());
+
+  PrintStr<32> printStr;
+  tz.printShortTo(printStr);
+  assertEqual(F("Los Angeles"), printStr.cstr());
+
+  assertTrue(tz == manager.createForZoneId(kZoneIdAmerica_Los_Angeles));
+
+  // Missing files and paths outside of the zoneinfo directory.
+  assertTrue(manager.createForZoneName("Not/Found").isError());
+  assertEqual(TzifZoneInfo::kStatusOpenError, manager.status());
+  assertTrue(manager.createForZoneName("../zoneinfo/UTC").isError());
+  assertTrue(manager.createForZoneName("/etc/localtime").isError());
+  assertEqual(1, manager.zoneRegistrySize());
+}
+
+#endif
+
+//---------------------------------------------------------------------------
+
+void setup() {
+#if ! defined(EPOXY_DUINO)
+  delay(1000); // wait to prevent garbage on SERIAL_PORT_MONITOR
+#endif
+  SERIAL_PORT_MONITOR.begin(115200);
+  while (!SERIAL_PORT_MONITOR); // Leonardo/Micro
+#if defined(EPOXY_DUINO)
+  SERIAL_PORT_MONITOR.setLineModeUnix();
+#endif
+}
+
+void loop() {
+  aunit::TestRunner::run();
+}
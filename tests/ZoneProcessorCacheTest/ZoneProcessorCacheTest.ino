@@ -4,6 +4,7 @@
 #include <AceTime.h>
 #include <testingzonedb/zone_infos.h>
 #include <testingzonedbx/zone_infos.h>
+#include <testingzonedbx/zone_registry.h>
 #include <testingzonedbc/zone_infos.h>
 
 using namespace ace_time;
@@ -56,6 +57,189 @@ test(ExtendedZoneProcessorCacheTest, getZoneProcessor) {
   assertEqual(zoneProcessor1, zoneProcessor4);
 }
 
+//---------------------------------------------------------------------------
+// ExtendedZoneProcessorHashedCache
+//---------------------------------------------------------------------------
+
+test(ExtendedZoneProcessorHashedCacheTest, getZoneProcessor) {
+  ExtendedZoneProcessorHashedCache<2> cache;
+  assertEqual(2, cache.size());
+
+  ZoneProcessor* zoneProcessor1 = cache.getZoneProcessor(
+      (uintptr_t) &testingzonedbx::kZoneAmerica_Los_Angeles);
+
+  ZoneProcessor* zoneProcessor2 = cache.getZoneProcessor(
+      (uintptr_t) &testingzonedbx::kZoneAmerica_Los_Angeles);
+  assertEqual(zoneProcessor1, zoneProcessor2);
+
+  ZoneProcessor* zoneProcessor3 = cache.getZoneProcessor(
+      (uintptr_t) &testingzonedbx::kZoneAmerica_New_York);
+  assertNotEqual(zoneProcessor1, zoneProcessor3);
+
+  // Both are referenced, so CLOCK clears both, then reuses zoneProcessor1.
+  ZoneProcessor* zoneProcessor4 = cache.getZoneProcessor(
+      (uintptr_t) &testingzonedbx::kZoneAmerica_Denver);
+  assertEqual(zoneProcessor1, zoneProcessor4);
+
+  // New_York was not referenced since the sweep, so it is evicted next,
+  // even though Denver was the most recent.
+  ZoneProcessor* zoneProcessor5 = cache.getZoneProcessor(
+      (uintptr_t) &testingzonedbx::kZoneAmerica_Chicago);
+  assertEqual(zoneProcessor3, zoneProcessor5);
+  assertTrue(zoneProcessor4->equalsZoneKey(
+      (uintptr_t) &testingzonedbx::kZoneAmerica_Denver));
+}
+
+test(ExtendedZoneProcessorHashedCacheTest, pinZoneProcessor) {
+  ExtendedZoneProcessorHashedCache<2> cache;
+
+  ZoneProcessor* pinned = cache.pinZoneProcessor(
+      (uintptr_t) &testingzonedbx::kZoneAmerica_Los_Angeles);
+
+  // Cycling through other zones never evicts the pinned processor.
+  for (uint16_t i = 0; i < testingzonedbx::kZoneRegistrySize; i++) {
+    uintptr_t zoneKey = (uintptr_t) testingzonedbx::kZoneRegistry[i];
+    if (zoneKey == (uintptr_t) &testingzonedbx::kZoneAmerica_Los_Angeles) {
+      continue;
+    }
+    ZoneProcessor* zoneProcessor = cache.getZoneProcessor(zoneKey);
+    assertNotEqual(pinned, zoneProcessor);
+  }
+  assertEqual(pinned, cache.getZoneProcessor(
+      (uintptr_t) &testingzonedbx::kZoneAmerica_Los_Angeles));
+
+  // After unpinning, it can be evicted again.
+  cache.unpinZoneProcessor(
+      (uintptr_t) &testingzonedbx::kZoneAmerica_Los_Angeles);
+  bool evicted = false;
+  for (uint16_t i = 0; i < testingzonedbx::kZoneRegistrySize; i++) {
+    uintptr_t zoneKey = (uintptr_t) testingzonedbx::kZoneRegistry[i];
+    if (cache.getZoneProcessor(zoneKey) == pinned) evicted = true;
+  }
+  assertTrue(evicted);
+}
+
+test(ExtendedZoneProcessorHashedCacheTest, clear) {
+  ExtendedZoneProcessorHashedCache<2> cache;
+  uintptr_t zoneKey = (uintptr_t) &testingzonedbx::kZoneAmerica_Los_Angeles;
+  ZoneProcessor* pinned = cache.pinZoneProcessor(zoneKey);
+  cache.getZoneProcessor(
+      (uintptr_t) &testingzonedbx::kZoneAmerica_New_York);
+
+  // Every processor is unbound, including the pinned one.
+  cache.clear();
+  for (uint16_t i = 0; i < cache.size(); i++) {
+    assertFalse(cache.getZoneProcessorAtIndex(i)->equalsZoneKey(zoneKey));
+  }
+
+  // The cache is usable again, and the pin was dropped.
+  ZoneProcessor* zoneProcessor = cache.getZoneProcessor(zoneKey);
+  assertTrue(zoneProcessor->equalsZoneKey(zoneKey));
+  assertEqual(zoneProcessor, cache.getZoneProcessor(zoneKey));
+  cache.getZoneProcessor((uintptr_t) &testingzonedbx::kZoneAmerica_Denver);
+  cache.getZoneProcessor((uintptr_t) &testingzonedbx::kZoneAmerica_Chicago);
+  cache.getZoneProcessor((uintptr_t) &testingzonedbx::kZoneAmerica_New_York);
+  assertFalse(pinned->equalsZoneKey(zoneKey));
+}
+
+test(ExtendedZoneProcessorHashedCacheTest, getZoneProcessor_churn) {
+  // Far more zones than processors, to exercise the deletion from the hash
+  // table.
+  ExtendedZoneProcessorHashedCache<5> cache;
+  const uint16_t numZones = testingzonedbx::kZoneRegistrySize;
+
+  uint16_t j = 0;
+  for (uint16_t n = 0; n < 200; n++) {
+    j = (j * 7 + 3) % numZones;
+    uintptr_t zoneKey = (uintptr_t) testingzonedbx::kZoneRegistry[j];
+    ZoneProcessor* zoneProcessor = cache.getZoneProcessor(zoneKey);
+    assertTrue(zoneProcessor->equalsZoneKey(zoneKey));
+    // An immediate repeat must hit the same processor.
+    assertEqual(zoneProcessor, cache.getZoneProcessor(zoneKey));
+
+    // Every processor is bound to a distinct zone.
+    for (uint16_t a = 0; a < cache.size(); a++) {
+      for (uint16_t b = a + 1; b < cache.size(); b++) {
+        for (uint16_t z = 0; z < numZones; z++) {
+          uintptr_t key = (uintptr_t) testingzonedbx::kZoneRegistry[z];
+          assertFalse(cache.getZoneProcessorAtIndex(a)->equalsZoneKey(key)
+              && cache.getZoneProcessorAtIndex(b)->equalsZoneKey(key));
+        }
+      }
+    }
+  }
+}
+
+test(ExtendedZoneProcessorHashedCacheTest, warmUp) {
+  ExtendedZoneProcessorHashedCache<4> cache;
+  const uintptr_t zoneKeys[] = {
+    (uintptr_t) &testingzonedbx::kZoneAmerica_Los_Angeles,
+    (uintptr_t) &testingzonedbx::kZoneAmerica_New_York,
+    (uintptr_t) &testingzonedbx::kZoneAmerica_Denver,
+    (uintptr_t) &testingzonedbx::kZoneAmerica_Los_Angeles, // duplicate
+  };
+
+  ZoneWarmUpResult result = cache.warmUp(zoneKeys, 4, 2025, 2026, 2);
+  assertFalse(result.rejected);
+  assertEqual(3, result.numZones);
+  assertEqual(0, result.numNotFound);
+  assertEqual(0, result.numSkipped);
+#if ACE_TIME_HAS_THREADS
+  assertEqual(2, result.numThreads);
+#else
+  assertEqual(1, result.numThreads);
+#endif
+
+  // Each zone calculated its transitions.
+  acetime_t epochSeconds = LocalDateTime::forComponents(2025, 3, 1, 0, 0, 0)
+      .toEpochSeconds();
+  for (uint8_t i = 0; i < 3; i++) {
+    ExtendedZoneProcessor* zoneProcessor = cache.getZoneProcessor(zoneKeys[i]);
+    assertMore(zoneProcessor->getTransitionAllocSize(), (uint8_t) 0);
+    assertFalse(zoneProcessor->findByEpochSeconds(epochSeconds).type
+        == FindResult::kTypeNotFound);
+  }
+
+  // The unbound processor was skipped.
+  uint8_t numUnbound = 0;
+  for (uint16_t i = 0; i < cache.size(); i++) {
+    if (cache.getZoneProcessorAtIndex(i)->equalsZoneKey(0)) numUnbound++;
+  }
+  assertEqual(1, numUnbound);
+
+  // The ZoneProcessors have been handed out, so a second warm up could
+  // modify them under a TimeZone, and is rejected.
+  assertTrue(cache.isInUse());
+  result = cache.warmUp(zoneKeys, 1, 2025, 2026, 2);
+  assertTrue(result.rejected);
+  assertEqual(0, result.numZones);
+  assertEqual(1, numUnbound);
+}
+
+test(ExtendedZoneProcessorHashedCacheTest, warmUp_tooManyZones) {
+  ExtendedZoneProcessorHashedCache<2> cache;
+  const uintptr_t zoneKeys[] = {
+    (uintptr_t) &testingzonedbx::kZoneAmerica_Los_Angeles,
+    (uintptr_t) &testingzonedbx::kZoneAmerica_New_York,
+    (uintptr_t) &testingzonedbx::kZoneAmerica_Denver,
+    (uintptr_t) &testingzonedbx::kZoneAmerica_New_York, // duplicate
+  };
+
+  // The zones which do not fit are skipped, instead of evicting the
+  // zones which were already warmed up.
+  ZoneWarmUpResult result = cache.warmUp(zoneKeys, 4, 2025, 2026, 1);
+  assertFalse(result.rejected);
+  assertEqual(2, result.numZones);
+  assertEqual(1, result.numSkipped);
+  assertFalse(cache.isInUse());
+  for (uint16_t i = 0; i < cache.size(); i++) {
+    assertFalse(cache.getZoneProcessorAtIndex(i)->equalsZoneKey(
+        (uintptr_t) &testingzonedbx::kZoneAmerica_Denver));
+  }
+  assertTrue(cache.getZoneProcessorAtIndex(0)->equalsZoneKey(zoneKeys[0])
+      || cache.getZoneProcessorAtIndex(1)->equalsZoneKey(zoneKeys[0]));
+}
+
 //---------------------------------------------------------------------------
 // CompleteZoneProcessorCache
 //---------------------------------------------------------------------------
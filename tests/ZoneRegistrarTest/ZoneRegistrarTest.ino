@@ -225,6 +225,77 @@ test(ZoneRegistrarTest_Unsorted, linearSearchById_not_found) {
   assertEqual(ZoneRegistrar::kInvalidIndex, index);
 }
 
+//---------------------------------------------------------------------------
+// ZoneIdIndex, the perfect hash index used by ZoneRegistrar.
+//---------------------------------------------------------------------------
+
+test(ZoneIdIndexTest, unsortedRegistry) {
+  basic::ZoneIdIndex<kNumUnsortedEntries> zoneIdIndex(
+      kNumUnsortedEntries, kUnsortedRegistry);
+  assertTrue(zoneIdIndex.isValid());
+  assertEqual(kNumUnsortedEntries, zoneIdIndex.numSlots());
+
+  assertEqual((uint16_t) 0, zoneIdIndex.findIndexForId(kZoneIdAmerica_Chicago));
+  assertEqual((uint16_t) 1, zoneIdIndex.findIndexForId(kZoneIdAmerica_Denver));
+  assertEqual((uint16_t) 2,
+      zoneIdIndex.findIndexForId(kZoneIdAmerica_Los_Angeles));
+  assertEqual((uint16_t) 3,
+      zoneIdIndex.findIndexForId(kZoneIdAmerica_New_York));
+  assertEqual(ZoneIdIndexBase::kInvalidIndex, zoneIdIndex.findIndexForId(0));
+}
+
+test(ZoneIdIndexTest, tooSmall) {
+  // Registry larger than SIZE leaves the index invalid, and the registrar
+  // falls back to the linear search.
+  basic::ZoneIdIndex<2> zoneIdIndex(kNumUnsortedEntries, kUnsortedRegistry);
+  assertFalse(zoneIdIndex.isValid());
+  assertEqual(ZoneIdIndexBase::kInvalidIndex,
+      zoneIdIndex.findIndexForId(kZoneIdAmerica_Chicago));
+
+  ZoneRegistrar registrar(kNumUnsortedEntries, kUnsortedRegistry,
+      &zoneIdIndex);
+  assertEqual((uint16_t) 2,
+      registrar.findIndexForId(kZoneIdAmerica_Los_Angeles));
+}
+
+test(ZoneIdIndexTest, zonedb) {
+  static basic::ZoneIdIndex<zonedb::kZoneAndLinkRegistrySize> zoneIdIndex(
+      zonedb::kZoneAndLinkRegistrySize, zonedb::kZoneAndLinkRegistry);
+  assertTrue(zoneIdIndex.isValid());
+  ZoneRegistrar registrar(zonedb::kZoneAndLinkRegistrySize,
+      zonedb::kZoneAndLinkRegistry, &zoneIdIndex);
+  ZoneRegistrar binaryRegistrar(zonedb::kZoneAndLinkRegistrySize,
+      zonedb::kZoneAndLinkRegistry);
+
+  for (uint16_t i = 0; i < zonedb::kZoneAndLinkRegistrySize; i++) {
+    const Info::ZoneInfo* info = registrar.getZoneInfoForIndex(i);
+    uint32_t zoneId = Info::ZoneInfoBroker(info).zoneId();
+    assertEqual(i, registrar.findIndexForId(zoneId));
+    assertEqual(i, zoneIdIndex.findIndexForId(zoneId));
+    // Must agree with the binary search for ids which may not exist.
+    assertEqual(binaryRegistrar.findIndexForId(zoneId + 1),
+        zoneIdIndex.findIndexForId(zoneId + 1));
+  }
+  assertEqual(binaryRegistrar.findIndexForName("America/Los_Angeles"),
+      registrar.findIndexForName("America/Los_Angeles"));
+  assertEqual(ZoneRegistrar::kInvalidIndex,
+      registrar.findIndexForName("America/Not_Found"));
+}
+
+test(ZoneIdIndexTest, zonedbc) {
+  static complete::ZoneIdIndex<zonedbc::kZoneAndLinkRegistrySize> zoneIdIndex(
+      zonedbc::kZoneAndLinkRegistrySize, zonedbc::kZoneAndLinkRegistry);
+  assertTrue(zoneIdIndex.isValid());
+
+  const complete::Info::ZoneRegistryBroker registry(
+      zonedbc::kZoneAndLinkRegistry);
+  for (uint16_t i = 0; i < zonedbc::kZoneAndLinkRegistrySize; i++) {
+    uint32_t zoneId = complete::Info::ZoneInfoBroker(
+        registry.zoneInfo(i)).zoneId();
+    assertEqual(i, zoneIdIndex.findIndexForId(zoneId));
+  }
+}
+
 //---------------------------------------------------------------------------
 
 void setup() {
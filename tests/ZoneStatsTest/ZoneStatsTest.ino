@@ -0,0 +1,389 @@
+#line 2 "ZoneStatsTest.ino"
+
+// The Makefile compiles the whole program, including the AceTime library,
+// with ACE_TIME_ZONE_STATS=1, because the macro changes the layout of the
+// classes which are instrumented.
+
+#include <AUnit.h>
+#include <AceTime.h>
+#include <testingzonedb/zone_infos.h>
+#include <testingzonedbx/zone_infos.h>
+#include <testingzonedbx/zone_registry.h>
+
+using namespace ace_time;
+
+#if ACE_TIME_ZONE_STATS
+
+//---------------------------------------------------------------------------
+// StatsCounter, StatsHistogram
+//---------------------------------------------------------------------------
+
+test(StatsCounterTest, addAndRecordMax) {
+  StatsCounter counter;
+  assertEqual((uint32_t) 0, counter.value());
+
+  counter.increment();
+  counter.add(3);
+  assertEqual((uint32_t) 4, counter.value());
+
+  counter.recordMax(2);
+  assertEqual((uint32_t) 4, counter.value());
+  counter.recordMax(10);
+  assertEqual((uint32_t) 10, counter.value());
+
+  counter.reset();
+  assertEqual((uint32_t) 0, counter.value());
+}
+
+test(StatsHistogramTest, bucketIndex) {
+  assertEqual(0, StatsHistogram::bucketIndex(0));
+  assertEqual(1, StatsHistogram::bucketIndex(1));
+  assertEqual(2, StatsHistogram::bucketIndex(2));
+  assertEqual(2, StatsHistogram::bucketIndex(3));
+  assertEqual(3, StatsHistogram::bucketIndex(4));
+  assertEqual(14, StatsHistogram::bucketIndex(16383));
+  assertEqual(15, StatsHistogram::bucketIndex(16384));
+  assertEqual(15, StatsHistogram::bucketIndex(UINT32_MAX));
+
+  // Every duration is below the upper bound of its bucket, and at or above
+  // the upper bound of the previous bucket.
+  for (uint32_t micros = 0; micros < 40000; micros++) {
+    uint8_t i = StatsHistogram::bucketIndex(micros);
+    assertLess(micros, StatsHistogram::bucketUpperMicros(i));
+    if (i > 0) {
+      assertMoreOrEqual(micros, StatsHistogram::bucketUpperMicros(i - 1));
+    }
+  }
+}
+
+test(StatsHistogramTest, record) {
+  StatsHistogram histogram;
+  histogram.record(0);
+  histogram.record(5);
+  histogram.record(6);
+  histogram.record(100000);
+  assertEqual((uint32_t) 4, histogram.count());
+  assertEqual((uint32_t) 1, histogram.bucket(0));
+  assertEqual((uint32_t) 2, histogram.bucket(3));
+  assertEqual((uint32_t) 1, histogram.bucket(15));
+
+  StatsHistogram::Snapshot snapshot;
+  histogram.snapshot(snapshot);
+  assertEqual((uint32_t) 2, snapshot.buckets[3]);
+
+  histogram.reset();
+  assertEqual((uint32_t) 0, histogram.count());
+}
+
+//---------------------------------------------------------------------------
+// ZoneProcessors
+//---------------------------------------------------------------------------
+
+test(ZoneStatsTest, ExtendedZoneProcessor) {
+  ExtendedZoneProcessor zoneProcessor(
+      &testingzonedbx::kZoneAmerica_Los_Angeles);
+  const ZoneProcessorStats& stats = zoneProcessor.getStats();
+
+  zoneProcessor.initForYear(2018);
+  zoneProcessor.initForYear(2018);
+  assertEqual((uint32_t) 1, stats.rebuilds.value());
+  assertEqual((uint32_t) 1, stats.yearCacheHits.value());
+  assertEqual((uint32_t) 0, stats.evictions.value());
+  uint32_t generated = stats.transitionsGenerated.value();
+  assertMore(generated, (uint32_t) 0);
+  assertEqual((uint32_t) zoneProcessor.getTransitionAllocSize(),
+      stats.transitionsHighWater.value());
+
+  // A different year replaces the only year slot.
+  zoneProcessor.initForYear(2019);
+  assertEqual((uint32_t) 2, stats.rebuilds.value());
+  assertEqual((uint32_t) 1, stats.evictions.value());
+  assertMore(stats.transitionsGenerated.value(), generated);
+  assertEqual((uint32_t) 2, stats.rebuildMicros.count());
+
+  // Unlike getTransitionAllocSize(), the statistics survive a new zone.
+  uint32_t highWater = stats.transitionsHighWater.value();
+  zoneProcessor.setZoneKey(
+      (uintptr_t) &testingzonedbx::kZoneAmerica_New_York);
+  assertEqual(0, zoneProcessor.getTransitionAllocSize());
+  assertEqual(highWater, stats.transitionsHighWater.value());
+
+  // Binding a new zone clears the year slots, so this is not an eviction.
+  zoneProcessor.initForYear(2019);
+  assertEqual((uint32_t) 3, stats.rebuilds.value());
+  assertEqual((uint32_t) 1, stats.evictions.value());
+
+  ZoneProcessorStats::Snapshot snapshot;
+  stats.snapshot(snapshot);
+  assertEqual((uint32_t) 3, snapshot.rebuilds);
+  assertEqual((uint32_t) 1, snapshot.yearCacheHits);
+  assertEqual((uint32_t) 1, snapshot.evictions);
+  assertEqual(stats.transitionsGenerated.value(),
+      snapshot.transitionsGenerated);
+
+  zoneProcessor.resetStats();
+  assertEqual((uint32_t) 0, stats.rebuilds.value());
+  assertEqual((uint32_t) 0, stats.transitionsHighWater.value());
+  assertEqual((uint32_t) 0, stats.rebuildMicros.count());
+}
+
+test(ZoneStatsTest, ExtendedZoneProcessorMultiYear) {
+  ExtendedZoneProcessor singleYear(&testingzonedbx::kZoneAmerica_Los_Angeles);
+  ExtendedZoneProcessorMultiYear<2> multiYear(
+      &testingzonedbx::kZoneAmerica_Los_Angeles);
+  const ZoneProcessorStats& singleStats = singleYear.getStats();
+  const ZoneProcessorStats& stats = multiYear.getStats();
+
+  // Alternate between 2 years. initForEpochSeconds() is called directly,
+  // because findByEpochSeconds() would return the valid interval of the
+  // previous lookup.
+  acetime_t before = LocalDateTime::forComponents(2018, 12, 31, 23, 0, 0)
+      .toEpochSeconds();
+  acetime_t after = LocalDateTime::forComponents(2019, 1, 1, 1, 0, 0)
+      .toEpochSeconds();
+  for (int i = 0; i < 3; i++) {
+    singleYear.initForEpochSeconds(before);
+    singleYear.initForEpochSeconds(after);
+    multiYear.initForEpochSeconds(before);
+    multiYear.initForEpochSeconds(after);
+  }
+  assertEqual((uint32_t) 0, singleStats.yearCacheHits.value());
+  assertEqual((uint32_t) 6, singleStats.rebuilds.value());
+  assertEqual((uint32_t) 4, stats.yearCacheHits.value());
+  assertEqual((uint32_t) 2, stats.rebuilds.value());
+  assertEqual((uint32_t) 0, stats.evictions.value());
+
+  // A third year evicts the least recently used year, 2018.
+  multiYear.resetStats();
+  multiYear.initForYear(2020);
+  multiYear.initForEpochSeconds(after);
+  assertEqual((uint32_t) 1, stats.rebuilds.value());
+  assertEqual((uint32_t) 1, stats.yearCacheHits.value());
+  multiYear.initForEpochSeconds(before);
+  assertEqual((uint32_t) 2, stats.rebuilds.value());
+  assertEqual((uint32_t) 2, stats.evictions.value());
+
+  // The transition search loads each year into the year cache, so a
+  // search in the last 2 years iterated does not rebuild anything.
+  multiYear.resetStats();
+  for (const ZoneTransition& t : multiYear.transitions(2000, 2020)) {
+    (void) t;
+  }
+  assertEqual((uint32_t) 20, stats.rebuilds.value());
+  multiYear.findNextTransition(before);
+  assertEqual((uint32_t) 20, stats.rebuilds.value());
+}
+
+test(ZoneStatsTest, ExtendedZoneProcessor_validInterval) {
+  ExtendedZoneProcessor zoneProcessor(
+      &testingzonedbx::kZoneAmerica_Los_Angeles);
+  const ZoneProcessorStats& stats = zoneProcessor.getStats();
+
+  // 2018-11-04 01:00 PST, the end of the fall-back overlap.
+  acetime_t fallBack = OffsetDateTime::forComponents(2018, 11, 4, 1, 0, 0,
+      TimeOffset::forHours(-8)).toEpochSeconds();
+  // 2019-03-10 02:00 PST, spring forward.
+  acetime_t springForward = OffsetDateTime::forComponents(2019, 3, 10, 2, 0,
+      0, TimeOffset::forHours(-8)).toEpochSeconds();
+
+  uint32_t num = 0;
+  for (acetime_t t = fallBack - 7200; t < springForward + 7200; t += 900) {
+    zoneProcessor.findByEpochSeconds(t);
+    num++;
+  }
+  // Searches: the first lookup, the 4 steps in each of the 2 overlap shadows
+  // (which are never cached), the first lookup after the overlap, the start of
+  // 2019, and the start of DST in 2019.
+  assertEqual(num - 12, stats.validIntervalHits.value());
+
+  ZoneProcessorStats::Snapshot snapshot;
+  stats.snapshot(snapshot);
+  assertEqual(num - 12, snapshot.validIntervalHits);
+  zoneProcessor.resetStats();
+  assertEqual((uint32_t) 0, stats.validIntervalHits.value());
+}
+
+test(ZoneStatsTest, BasicZoneProcessor) {
+  BasicZoneProcessor zoneProcessor(&testingzonedb::kZoneAmerica_Los_Angeles);
+  const ZoneProcessorStats& stats = zoneProcessor.getStats();
+
+  // 2018-06-01 and 2018-07-01 UTC
+  zoneProcessor.findByEpochSeconds(
+      LocalDateTime::forComponents(2018, 6, 1, 0, 0, 0).toEpochSeconds());
+  zoneProcessor.findByEpochSeconds(
+      LocalDateTime::forComponents(2018, 7, 1, 0, 0, 0).toEpochSeconds());
+  assertEqual((uint32_t) 1, stats.rebuilds.value());
+  assertEqual((uint32_t) 1, stats.yearCacheHits.value());
+  assertEqual((uint32_t) 0, stats.evictions.value());
+  assertMore(stats.transitionsGenerated.value(), (uint32_t) 0);
+  assertMore(stats.transitionsHighWater.value(), (uint32_t) 0);
+
+  zoneProcessor.findByEpochSeconds(
+      LocalDateTime::forComponents(2019, 6, 1, 0, 0, 0).toEpochSeconds());
+  assertEqual((uint32_t) 2, stats.rebuilds.value());
+  assertEqual((uint32_t) 1, stats.evictions.value());
+  assertEqual((uint32_t) 2, stats.rebuildMicros.count());
+}
+
+test(ZoneStatsTest, BasicZoneProcessorMultiYear) {
+  BasicZoneProcessor singleYear(&testingzonedb::kZoneAmerica_Los_Angeles);
+  BasicZoneProcessorMultiYear<2> multiYear(
+      &testingzonedb::kZoneAmerica_Los_Angeles);
+  const ZoneProcessorStats& singleStats = singleYear.getStats();
+  const ZoneProcessorStats& stats = multiYear.getStats();
+
+  // Alternate between 2 years. The cached year of the BasicZoneProcessor
+  // starts on Jan 2.
+  acetime_t before = LocalDateTime::forComponents(2018, 12, 31, 23, 0, 0)
+      .toEpochSeconds();
+  acetime_t after = LocalDateTime::forComponents(2019, 1, 2, 1, 0, 0)
+      .toEpochSeconds();
+  for (int i = 0; i < 3; i++) {
+    singleYear.findByEpochSeconds(before);
+    singleYear.findByEpochSeconds(after);
+    multiYear.findByEpochSeconds(before);
+    multiYear.findByEpochSeconds(after);
+  }
+  assertEqual((uint32_t) 0, singleStats.yearCacheHits.value());
+  assertEqual((uint32_t) 6, singleStats.rebuilds.value());
+  assertEqual((uint32_t) 4, stats.yearCacheHits.value());
+  assertEqual((uint32_t) 2, stats.rebuilds.value());
+
+  // A third year evicts the least recently used year, 2018.
+  multiYear.resetStats();
+  multiYear.findByLocalDateTime(
+      LocalDateTime::forComponents(2020, 6, 1, 0, 0, 0));
+  assertEqual((uint32_t) 1, stats.rebuilds.value());
+  multiYear.resetStats();
+  multiYear.findByEpochSeconds(after);
+  assertEqual((uint32_t) 1, stats.yearCacheHits.value());
+  multiYear.findByEpochSeconds(before);
+  assertEqual((uint32_t) 1, stats.rebuilds.value());
+  assertEqual((uint32_t) 1, stats.evictions.value());
+
+  // Changing the zone invalidates all years.
+  multiYear.setZoneKey((uintptr_t) &testingzonedb::kZoneAustralia_Darwin);
+  multiYear.findByEpochSeconds(after);
+  assertEqual((uint32_t) 2, stats.rebuilds.value());
+  assertEqual((uint32_t) 1, stats.yearCacheHits.value());
+  assertEqual((uint32_t) 1, stats.evictions.value());
+}
+
+//---------------------------------------------------------------------------
+// ZoneProcessorCache
+//---------------------------------------------------------------------------
+
+template <typename CACHE>
+static void getZoneProcessor(
+    CACHE& cache, const extended::Info::ZoneInfo* zoneInfo) {
+  cache.getZoneProcessor((uintptr_t) zoneInfo);
+}
+
+test(ZoneStatsTest, ExtendedZoneProcessorCache) {
+  ExtendedZoneProcessorCache<2> cache;
+  const ZoneProcessorCacheStats& stats = cache.getStats();
+
+  getZoneProcessor(cache, &testingzonedbx::kZoneAmerica_Los_Angeles);
+  getZoneProcessor(cache, &testingzonedbx::kZoneAmerica_Los_Angeles);
+  getZoneProcessor(cache, &testingzonedbx::kZoneAmerica_New_York);
+  assertEqual((uint32_t) 1, stats.hits.value());
+  assertEqual((uint32_t) 2, stats.misses.value());
+  assertEqual((uint32_t) 0, stats.evictions.value());
+
+  // The 3rd zone reuses the ZoneProcessor of the 1st.
+  getZoneProcessor(cache, &testingzonedbx::kZoneAmerica_Denver);
+  assertEqual((uint32_t) 3, stats.misses.value());
+  assertEqual((uint32_t) 1, stats.evictions.value());
+
+  ZoneProcessorCacheStats::Snapshot snapshot;
+  stats.snapshot(snapshot);
+  assertEqual((uint32_t) 1, snapshot.hits);
+  assertEqual((uint32_t) 3, snapshot.misses);
+  assertEqual((uint32_t) 1, snapshot.evictions);
+
+  cache.resetStats();
+  assertEqual((uint32_t) 0, stats.misses.value());
+}
+
+test(ZoneStatsTest, ExtendedZoneProcessorCache_warmUp) {
+  ExtendedZoneProcessorCache<2> cache;
+  const uintptr_t zoneKeys[] = {
+    (uintptr_t) &testingzonedbx::kZoneAmerica_Los_Angeles,
+    (uintptr_t) &testingzonedbx::kZoneAmerica_New_York,
+  };
+  // The years are clamped to the single year slot of the ZoneProcessors.
+  cache.warmUp(zoneKeys, 2, 2025, 2030, 1);
+
+  // Each zone calculated its year once, and a lookup in the warmed year uses
+  // it without recalculating.
+  acetime_t epochSeconds = LocalDateTime::forComponents(2025, 3, 1, 0, 0, 0)
+      .toEpochSeconds();
+  for (uint8_t i = 0; i < 2; i++) {
+    ExtendedZoneProcessor* zoneProcessor = cache.getZoneProcessor(zoneKeys[i]);
+    const ZoneProcessorStats& stats = zoneProcessor->getStats();
+    assertEqual((uint32_t) 1, stats.rebuilds.value());
+    zoneProcessor->findByEpochSeconds(epochSeconds);
+    assertEqual((uint32_t) 1, stats.rebuilds.value());
+  }
+}
+
+test(ZoneStatsTest, ExtendedZoneProcessorHashedCache) {
+  ExtendedZoneProcessorHashedCache<2> cache;
+  const ZoneProcessorCacheStats& stats = cache.getStats();
+
+  getZoneProcessor(cache, &testingzonedbx::kZoneAmerica_Los_Angeles);
+  getZoneProcessor(cache, &testingzonedbx::kZoneAmerica_Los_Angeles);
+  getZoneProcessor(cache, &testingzonedbx::kZoneAmerica_New_York);
+  assertEqual((uint32_t) 1, stats.hits.value());
+  assertEqual((uint32_t) 2, stats.misses.value());
+  assertEqual((uint32_t) 0, stats.evictions.value());
+
+  getZoneProcessor(cache, &testingzonedbx::kZoneAmerica_Denver);
+  assertEqual((uint32_t) 3, stats.misses.value());
+  assertEqual((uint32_t) 1, stats.evictions.value());
+}
+
+//---------------------------------------------------------------------------
+// ZoneRegistrar
+//---------------------------------------------------------------------------
+
+test(ZoneStatsTest, ZoneRegistrar) {
+  extended::ZoneRegistrar zoneRegistrar(
+      testingzonedbx::kZoneRegistrySize, testingzonedbx::kZoneRegistry);
+  const ZoneRegistrarStats& stats = zoneRegistrar.getStats();
+  const uint16_t kInvalidIndex = extended::ZoneRegistrar::kInvalidIndex;
+
+  assertNotEqual(kInvalidIndex,
+      zoneRegistrar.findIndexForName("America/Los_Angeles"));
+  assertEqual((uint32_t) 1, stats.lookups.value());
+  assertEqual((uint32_t) 0, stats.notFound.value());
+
+  assertEqual(kInvalidIndex,
+      zoneRegistrar.findIndexForName("America/Does_Not_Exist"));
+  assertEqual(nullptr, zoneRegistrar.getZoneInfoForId(0));
+  assertEqual((uint32_t) 3, stats.lookups.value());
+  assertEqual((uint32_t) 2, stats.notFound.value());
+  assertEqual((uint32_t) 0, stats.nameMismatches.value());
+
+  zoneRegistrar.resetStats();
+  assertEqual((uint32_t) 0, stats.lookups.value());
+}
+
+#endif
+
+//---------------------------------------------------------------------------
+
+void setup() {
+#if ! defined(EPOXY_DUINO)
+  delay(1000); // wait to prevent garbage on SERIAL_PORT_MONITOR
+#endif
+  SERIAL_PORT_MONITOR.begin(115200);
+  while (!SERIAL_PORT_MONITOR); // Leonardo/Micro
+#if defined(EPOXY_DUINO)
+  SERIAL_PORT_MONITOR.setLineModeUnix();
+#endif
+}
+
+void loop() {
+  aunit::TestRunner::run();
+}
@@ -134,6 +134,24 @@ test(ZonedDateTimeBasicTest, forComponents_afterOverlap) {
   assertTrue(expected == dt.localDateTime());
 }
 
+// BasicZoneProcessor uses the default ZoneProcessor::findByUnixSeconds64()
+// which is limited to the range of the 32-bit epochSeconds.
+test(ZonedDateTimeBasicTest, forUnixSeconds64) {
+  TimeZone tz = basicZoneManager.createForZoneInfo(&kZoneAmerica_Los_Angeles);
+
+  int64_t unixSeconds = OffsetDateTime::forComponents(
+      2018, 11, 4, 1, 1, 0, TimeOffset::forHours(-8)).toUnixSeconds64();
+  auto dt = ZonedDateTime::forUnixSeconds64(unixSeconds, tz);
+  assertEqual(-8*60, dt.timeOffset().toMinutes());
+  assertEqual(1, dt.hour());
+  assertEqual(unixSeconds, dt.toUnixSeconds64());
+
+  // 1900 is more than 68 years before the current epoch year.
+  unixSeconds = LocalDateTime::forComponents(1900, 1, 1, 0, 0, 0)
+      .toUnixSeconds64();
+  assertTrue(ZonedDateTime::forUnixSeconds64(unixSeconds, tz).isError());
+}
+
 // --------------------------------------------------------------------------
 
 test(ZonedDateTimeBasicTest, normalize) {
@@ -287,6 +287,70 @@ test(ZonedDateTimeCompleteTest, forEpochSecond_fall_back) {
   assertEqual(0, dt.fold());  // only occurrence
 }
 
+test(ZonedDateTimeCompleteTest, forUnixSeconds64_fall_back) {
+  TimeZone tz = completeZoneManager.createForZoneInfo(
+      &kZoneAmerica_Los_Angeles);
+
+  // The 64-bit path must produce the same fold as the 32-bit path.
+  int64_t unixSeconds = OffsetDateTime::forComponents(
+      2022, 11, 6, 1, 29, 0, TimeOffset::forHours(-7)).toUnixSeconds64();
+  for (int i = 0; i < 3; i++) {
+    auto dt = ZonedDateTime::forUnixSeconds64(unixSeconds, tz);
+    auto expected = ZonedDateTime::forEpochSeconds(
+        unixSeconds - Epoch::secondsToCurrentEpochFromUnixEpoch64(), tz);
+    assertTrue(expected == dt);
+    assertEqual(expected.fold(), dt.fold());
+    assertEqual(unixSeconds, dt.toUnixSeconds64());
+    unixSeconds += 3600;
+  }
+
+  assertTrue(ZonedDateTime::forUnixSeconds64(
+      LocalDate::kInvalidUnixSeconds64, tz).isError());
+}
+
+// The full zonedbc database covers [1800,2200), which is beyond the +/- 68
+// years that can be reached by a 32-bit epochSeconds from the default epoch
+// year 2050.
+test(ZonedDateTimeCompleteTest, forUnixSeconds64_centuries) {
+  TimeZone tz = completeZoneManager.createForZoneInfo(
+      &zonedbc::kZoneAmerica_Los_Angeles);
+
+  // Los Angeles used its local mean time (-07:52:58) before 1883-11-18.
+  int64_t unixSeconds = LocalDateTime::forComponents(1850, 1, 1, 0, 0, 0)
+      .toUnixSeconds64();
+  auto dt = ZonedDateTime::forUnixSeconds64(unixSeconds, tz);
+  assertFalse(dt.isError());
+  assertEqual(1849, dt.year());
+  assertEqual(12, dt.month());
+  assertEqual(31, dt.day());
+  assertEqual(16, dt.hour());
+  assertEqual(7, dt.minute());
+  assertEqual(2, dt.second());
+  assertEqual((int32_t) -(7*3600 + 52*60 + 58), dt.timeOffset().toSeconds());
+  assertEqual(unixSeconds, dt.toUnixSeconds64());
+
+  // Summer of 2150 is PDT.
+  unixSeconds = LocalDateTime::forComponents(2150, 7, 1, 0, 0, 0)
+      .toUnixSeconds64();
+  dt = ZonedDateTime::forUnixSeconds64(unixSeconds, tz);
+  assertEqual(2150, dt.year());
+  assertEqual(6, dt.month());
+  assertEqual(30, dt.day());
+  assertEqual(17, dt.hour());
+  assertEqual(-7*60, dt.timeOffset().toMinutes());
+  assertEqual(unixSeconds, dt.toUnixSeconds64());
+
+  // The fall back of 2150 (first Sunday of November, Nov 1) is in the
+  // overlap, so the second 01:30 has fold=1.
+  unixSeconds = OffsetDateTime::forComponents(
+      2150, 11, 1, 1, 30, 0, TimeOffset::forHours(-8)).toUnixSeconds64();
+  dt = ZonedDateTime::forUnixSeconds64(unixSeconds, tz);
+  assertEqual(1, dt.hour());
+  assertEqual(30, dt.minute());
+  assertEqual(-8*60, dt.timeOffset().toMinutes());
+  assertEqual(1, dt.fold());
+}
+
 test(ZonedDateTimeCompleteTest, forEpochSecond_spring_forward) {
   TimeZone tz = completeZoneManager.createForZoneInfo(
       &kZoneAmerica_Los_Angeles);
@@ -0,0 +1,9 @@
+#line 2 "ZonedDateTimeExtendedNoSearchKeysTest.ino"
+
+/*
+ * Runs the tests of ZonedDateTimeExtendedTest with
+ * ACE_TIME_TRANSITION_SEARCH_KEYS set to 0 by the Makefile, which is the
+ * Transition layout of the microcontrollers other than the ESP32.
+ */
+
+#include "../ZonedDateTimeExtendedTest/ZonedDateTimeExtendedTest.ino"
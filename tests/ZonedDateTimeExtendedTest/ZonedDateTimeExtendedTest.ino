@@ -286,6 +286,38 @@ test(ZonedDateTimeExtendedTest, forEpochSecond_fall_back) {
   assertEqual(0, dt.fold());  // only occurrence
 }
 
+test(ZonedDateTimeExtendedTest, forEpochSecondsBatch) {
+  TimeZone tz = extendedZoneManager.createForZoneInfo(
+      &kZoneAmerica_Los_Angeles);
+
+  // More elements than the internal chunk size, hourly across the fall-back.
+  const size_t num = 20;
+  acetime_t epochSeconds[num];
+  acetime_t start = OffsetDateTime::forComponents(
+      2022, 11, 5, 20, 0, 0, TimeOffset::forHours(-7)).toEpochSeconds();
+  for (size_t i = 0; i < num; i++) {
+    epochSeconds[i] = start + (acetime_t) i * 3600;
+  }
+  epochSeconds[num - 1] = LocalDate::kInvalidEpochSeconds;
+
+  ZonedDateTime zdts[num];
+  ZonedDateTime::forEpochSecondsBatch(epochSeconds, zdts, num, tz);
+  for (size_t i = 0; i < num; i++) {
+    auto expected = ZonedDateTime::forEpochSeconds(epochSeconds[i], tz);
+    assertTrue(expected == zdts[i]);
+    assertEqual(expected.fold(), zdts[i].fold());
+  }
+  assertTrue(zdts[num - 1].isError());
+
+  // Manual TimeZone.
+  TimeZone manual = TimeZone::forHours(-8);
+  ZonedDateTime::forEpochSecondsBatch(epochSeconds, zdts, num, manual);
+  for (size_t i = 0; i < num - 1; i++) {
+    auto expected = ZonedDateTime::forEpochSeconds(epochSeconds[i], manual);
+    assertTrue(expected == zdts[i]);
+  }
+}
+
 test(ZonedDateTimeExtendedTest, forEpochSecond_spring_forward) {
   TimeZone tz = extendedZoneManager.createForZoneInfo(
       &kZoneAmerica_Los_Angeles);
@@ -197,10 +197,13 @@ test(ZonedDateTimeTest_Manual, toAndForUnixSeconds64_extended) {
   udt = ZonedDateTime::forUnixSeconds64(dt.toUnixSeconds64(), TimeZone());
   assertTrue(dt == udt);
 
-  // One second after that, forUnixSeconds64() should fail because we cannot
-  // represent this datetime using 32-bit AceTime seconds internally.
+  // One second after that, forUnixSeconds64() continues to work because it
+  // does not convert to the 32-bit AceTime seconds internally.
   dt = ZonedDateTime::forUnixSeconds64((int64_t) 3094168447 + 1, TimeZone());
-  assertTrue(dt.isError());
+  assertFalse(dt.isError());
+  assertEqual(2068, dt.year());
+  assertEqual(8, dt.second());
+  assertEqual((int64_t) 3094168447 + 1, dt.toUnixSeconds64());
 
   // Verify error sentinel.
   dt = ZonedDateTime::forUnixSeconds64(